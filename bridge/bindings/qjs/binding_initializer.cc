@@ -93,6 +93,7 @@
 #include "qjs_widget_element.h"
 #include "qjs_window.h"
 #include "qjs_window_or_worker_global_scope.h"
+#include "qjs_worker.h"
 
 namespace webf {
 
@@ -172,6 +173,7 @@ void InstallBindings(ExecutingContext* context) {
   QJSPerformanceMeasure::Install(context);
   QJSHTMLCollection::Install(context);
   QJSHTMLAllCollection::Install(context);
+  QJSWorker::Install(context);
 
   // SVG
   QJSSVGElement::Install(context);
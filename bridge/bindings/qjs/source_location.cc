@@ -12,9 +12,50 @@ std::unique_ptr<SourceLocation> SourceLocation::Capture(const std::string& url,
   return std::make_unique<SourceLocation>(url, line_number, column_number);
 }
 
+std::unique_ptr<SourceLocation> SourceLocation::Capture(JSContext* ctx) {
+  std::string url;
+  JSAtom script_name = JS_GetScriptOrModuleName(ctx, 1);
+  if (script_name != JS_ATOM_NULL) {
+    const char* name = JS_AtomToCString(ctx, script_name);
+    if (name != nullptr) {
+      url = name;
+    }
+    JS_FreeCString(ctx, name);
+    JS_FreeAtom(ctx, script_name);
+  }
+
+  // The Error constructor records the backtrace of the caller into the stack property of the new error.
+  std::string stack_trace;
+  JSValue global = JS_GetGlobalObject(ctx);
+  JSValue error_constructor = JS_GetPropertyStr(ctx, global, "Error");
+  JSValue error = JS_CallConstructor(ctx, error_constructor, 0, nullptr);
+  if (JS_IsException(error)) {
+    JS_FreeValue(ctx, JS_GetException(ctx));
+  } else {
+    JSValue stack = JS_GetPropertyStr(ctx, error, "stack");
+    const char* stack_string = JS_IsString(stack) ? JS_ToCString(ctx, stack) : nullptr;
+    if (stack_string != nullptr) {
+      stack_trace = stack_string;
+    }
+    JS_FreeCString(ctx, stack_string);
+    JS_FreeValue(ctx, stack);
+  }
+  JS_FreeValue(ctx, error);
+  JS_FreeValue(ctx, error_constructor);
+  JS_FreeValue(ctx, global);
+
+  return std::make_unique<SourceLocation>(url, 0, 0, std::move(stack_trace));
+}
+
 SourceLocation::SourceLocation(const std::string& url, unsigned int line_number, unsigned int column_number)
     : url_(url), line_number_(line_number), column_number_(column_number) {}
 
+SourceLocation::SourceLocation(const std::string& url,
+                               unsigned int line_number,
+                               unsigned int column_number,
+                               std::string stack_trace)
+    : url_(url), line_number_(line_number), column_number_(column_number), stack_trace_(std::move(stack_trace)) {}
+
 SourceLocation::~SourceLocation() {}
 
 }  // namespace webf
@@ -5,6 +5,7 @@
 #ifndef BRIDGE_BINDINGS_QJS_SOURCE_LOCATION_H_
 #define BRIDGE_BINDINGS_QJS_SOURCE_LOCATION_H_
 
+#include <quickjs/quickjs.h>
 #include <memory>
 #include <string>
 
@@ -17,18 +18,24 @@ class SourceLocation {
   // Zero lineNumber and columnNumber mean unknown. Captures current stack
   // trace.
   static std::unique_ptr<SourceLocation> Capture(const std::string& url, unsigned line_number, unsigned column_number);
+  // Captures the stack trace of the running script.
+  static std::unique_ptr<SourceLocation> Capture(JSContext* ctx);
 
   SourceLocation(const std::string& url, unsigned line_number, unsigned column_number);
+  SourceLocation(const std::string& url, unsigned line_number, unsigned column_number, std::string stack_trace);
   ~SourceLocation();
 
   const std::string& Url() const { return url_; }
   unsigned LineNumber() const { return line_number_; }
   unsigned ColumnNumber() const { return column_number_; }
+  // Empty when the stack trace was not captured.
+  const std::string& StackTrace() const { return stack_trace_; }
 
  private:
   std::string url_;
   unsigned line_number_;
   unsigned column_number_;
+  std::string stack_trace_;
 };
 
 }  // namespace webf
@@ -88,6 +88,7 @@ enum {
 
   JS_CLASS_DOM_TOKEN_LIST,
   JS_CLASS_DOM_STRING_MAP,
+  JS_CLASS_WORKER,
 
   // SVG
   JS_CLASS_SVG_ELEMENT,
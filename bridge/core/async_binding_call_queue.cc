@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "async_binding_call_queue.h"
+#include <algorithm>
+#include "bindings/qjs/exception_state.h"
+#include "bindings/qjs/script_promise_resolver.h"
+#include "core/binding_object.h"
+#include "core/executing_context.h"
+#include "foundation/native_value_converter.h"
+
+namespace webf {
+
+static void RejectWithMessage(ExecutingContext* context,
+                              ScriptPromiseResolver* promise_resolver,
+                              const std::string& message) {
+  ExceptionState exception_state;
+  exception_state.ThrowException(context->ctx(), ErrorType::TypeError, message);
+  JSValue error_object = JS_GetException(context->ctx());
+  promise_resolver->Reject(error_object);
+  JS_FreeValue(context->ctx(), error_object);
+}
+
+AsyncBindingCallQueue::~AsyncBindingCallQueue() {
+  // Dart side may answer after the context was destroyed.
+  for (auto* batch : in_flight_batches_) {
+    batch->queue = nullptr;
+    batch->promise_contexts.clear();
+  }
+  for (auto& call : queued_calls_) {
+    delete[] static_cast<NativeValue*>(call.u.ptr);
+  }
+}
+
+ScriptValue AsyncBindingCallQueue::Enqueue(BindingObject* binding_object,
+                                           NativeValue method_name,
+                                           std::vector<NativeValue>&& arguments) {
+  BindingObjectPromiseContext* promise_context = AllocatePromiseContext();
+  promise_context->promise_resolver = ScriptPromiseResolver::Create(context_);
+
+  size_t length = arguments.size() + 2;
+  auto* call = new NativeValue[length];
+  call[0] = Native_NewPtr(JSPointerType::NativeBindingObject, binding_object->bindingObject());
+  call[1] = method_name;
+  std::copy(arguments.begin(), arguments.end(), call + 2);
+
+  queued_calls_.emplace_back(Native_NewList(length, call));
+  queued_targets_.emplace_back(binding_object->ToValue());
+  queued_promise_contexts_.emplace_back(promise_context);
+  return promise_context->promise_resolver->Promise().ToValue();
+}
+
+void AsyncBindingCallQueue::Flush() {
+  if (queued_calls_.empty())
+    return;
+
+  std::vector<NativeValue> calls = std::move(queued_calls_);
+  std::vector<ScriptValue> targets = std::move(queued_targets_);
+  queued_calls_.clear();
+  queued_targets_.clear();
+
+  auto* batch = new AsyncBindingCallBatch{this, std::move(queued_promise_contexts_)};
+  queued_promise_contexts_.clear();
+  in_flight_batches_.emplace(batch);
+
+  // The batch is received by the binding object of the first call, the others are looked up by dart side.
+  auto* receiver = toScriptWrappable<BindingObject>(targets[0].QJSValue());
+  const NativeValue arguments[] = {
+      NativeValueConverter<NativeTypeInt64>::ToNativeValue(context_->contextId()),
+      NativeValueConverter<NativeTypePointer<void>>::ToNativeValue(batch),
+      NativeValueConverter<NativeTypePointer<void>>::ToNativeValue(reinterpret_cast<void*>(HandleBatchCalledFromDart)),
+      Native_NewList(calls.size(), calls.data())};
+
+  ExceptionState exception_state;
+  receiver->InvokeBindingMethod(BindingMethodCallOperations::kAsyncAnonymousFunctionBatch, 4, arguments,
+                                exception_state);
+
+  for (auto& call : calls) {
+    delete[] static_cast<NativeValue*>(call.u.ptr);
+  }
+
+  if (UNLIKELY(exception_state.HasException())) {
+    JSValue error = JS_GetException(context_->ctx());
+    for (auto* promise_context : batch->promise_contexts) {
+      promise_context->promise_resolver->Reject(error);
+      ReleasePromiseContext(promise_context);
+    }
+    JS_FreeValue(context_->ctx(), error);
+    in_flight_batches_.erase(batch);
+    delete batch;
+  }
+}
+
+void AsyncBindingCallQueue::HandleBatchCalledFromDart(void* ptr,
+                                                      NativeValue* results,
+                                                      int32_t context_id,
+                                                      const char* errmsg) {
+  if (JSThreadDispatcher* dispatcher = JSThreadDispatcher::FromDartThread()) {
+    dispatcher->PostCallbackToJS(context_id, HandleBatchCalledFromDart, ptr, results, context_id, errmsg);
+    return;
+  }
+
+  auto* batch = static_cast<AsyncBindingCallBatch*>(ptr);
+  AsyncBindingCallQueue* queue = batch->queue;
+  if (queue == nullptr || queue->context_->contextId() != context_id || !queue->context_->IsContextValid()) {
+    // Nobody waits for the results anymore, only release the lists dart side allocated.
+    if (results != nullptr && results->tag == NativeTag::TAG_LIST) {
+      auto* list = static_cast<NativeValue*>(results->u.ptr);
+      for (uint32_t i = 0; i < results->uint32; i++) {
+        if (list[i].tag == NativeTag::TAG_LIST)
+          FreeDartAllocated(list[i].u.ptr);
+      }
+      FreeDartAllocated(list);
+    }
+    if (results != nullptr)
+      FreeDartAllocated(results);
+    delete batch;
+    return;
+  }
+  queue->SettleBatch(batch, results, errmsg);
+}
+
+void AsyncBindingCallQueue::SettleBatch(AsyncBindingCallBatch* batch, NativeValue* results, const char* errmsg) {
+  JSContext* ctx = context_->ctx();
+  in_flight_batches_.erase(batch);
+
+  // Each result is a list of the value and the error message.
+  NativeValue* list = nullptr;
+  size_t length = 0;
+  if (results != nullptr && results->tag == NativeTag::TAG_LIST) {
+    list = static_cast<NativeValue*>(results->u.ptr);
+    length = results->uint32;
+  }
+
+  for (size_t i = 0; i < batch->promise_contexts.size(); i++) {
+    BindingObjectPromiseContext* promise_context = batch->promise_contexts[i];
+    ScriptPromiseResolver* promise_resolver = promise_context->promise_resolver.get();
+    if (errmsg != nullptr) {
+      RejectWithMessage(context_, promise_resolver, errmsg);
+    } else if (i >= length || list[i].tag != NativeTag::TAG_LIST || list[i].uint32 != 2) {
+      RejectWithMessage(context_, promise_resolver, "Failed to call async method: no result from dart side.");
+    } else {
+      auto* result = static_cast<NativeValue*>(list[i].u.ptr);
+      if (result[1].tag == NativeTag::TAG_STRING) {
+        AtomicString message = NativeValueConverter<NativeTypeString>::FromNativeValue(ctx, std::move(result[1]));
+        RejectWithMessage(context_, promise_resolver, message.ToStdString(ctx));
+      } else {
+        ScriptValue value = ScriptValue(ctx, result[0]);
+        promise_resolver->Resolve(value.QJSValue());
+      }
+      FreeDartAllocated(result);
+    }
+    ReleasePromiseContext(promise_context);
+  }
+
+  if (list != nullptr)
+    FreeDartAllocated(list);
+  if (results != nullptr)
+    FreeDartAllocated(results);
+  delete batch;
+}
+
+BindingObjectPromiseContext* AsyncBindingCallQueue::AllocatePromiseContext() {
+  if (free_promise_contexts_ == nullptr) {
+    slabs_.emplace_back(std::make_unique<BindingObjectPromiseContext[]>(kPromiseContextsPerSlab));
+    BindingObjectPromiseContext* slab = slabs_.back().get();
+    for (size_t i = 0; i < kPromiseContextsPerSlab; i++) {
+      slab[i].next_free = i + 1 < kPromiseContextsPerSlab ? &slab[i + 1] : nullptr;
+    }
+    free_promise_contexts_ = slab;
+  }
+
+  BindingObjectPromiseContext* promise_context = free_promise_contexts_;
+  free_promise_contexts_ = promise_context->next_free;
+  promise_context->next_free = nullptr;
+  return promise_context;
+}
+
+void AsyncBindingCallQueue::ReleasePromiseContext(BindingObjectPromiseContext* promise_context) {
+  promise_context->promise_resolver = nullptr;
+  promise_context->next_free = free_promise_contexts_;
+  free_promise_contexts_ = promise_context;
+}
+
+}  // namespace webf
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_ASYNC_BINDING_CALL_QUEUE_H_
+#define BRIDGE_CORE_ASYNC_BINDING_CALL_QUEUE_H_
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+#include "bindings/qjs/script_value.h"
+#include "foundation/macros.h"
+#include "foundation/native_value.h"
+
+namespace webf {
+
+class BindingObject;
+class ExecutingContext;
+class ScriptPromiseResolver;
+
+// A promise returned to JS by an async method implemented at dart side.
+struct BindingObjectPromiseContext {
+  std::shared_ptr<ScriptPromiseResolver> promise_resolver;
+  // Links the free contexts of the pool.
+  BindingObjectPromiseContext* next_free{nullptr};
+};
+
+class AsyncBindingCallQueue;
+
+// Called by dart side with the results of a batch, each result is a list of the value and the error message.
+using AsyncBindingCallBatchCallback = void (*)(void* batch,
+                                               NativeValue* results,
+                                               int32_t context_id,
+                                               const char* errmsg);
+
+// The calls sent to dart side at once, answered by AsyncBindingCallQueue::HandleBatchCalledFromDart.
+struct AsyncBindingCallBatch {
+  // Set to nullptr when the context was destroyed before dart side answered.
+  AsyncBindingCallQueue* queue;
+  std::vector<BindingObjectPromiseContext*> promise_contexts;
+};
+
+// Async methods of binding objects, e.g. the async methods of widget elements, called in a JS task are queued here
+// and sent to dart side with one call at the microtask checkpoint. Dart side returns all the results with one
+// callback once every call of the batch settled.
+class AsyncBindingCallQueue {
+  WEBF_DISALLOW_COPY_AND_ASSIGN(AsyncBindingCallQueue);
+
+ public:
+  explicit AsyncBindingCallQueue(ExecutingContext* context) : context_(context){};
+  ~AsyncBindingCallQueue();
+
+  // Queue a call of |method_name| of |binding_object|, the returned promise is settled by the result from dart side.
+  ScriptValue Enqueue(BindingObject* binding_object, NativeValue method_name, std::vector<NativeValue>&& arguments);
+  // Send the queued calls to dart side. Called at the microtask checkpoint and before any synchronous call into dart
+  // side, which keeps the order of calls seen by dart side.
+  void Flush();
+  bool HasQueuedCalls() const { return !queued_calls_.empty(); }
+
+  static void HandleBatchCalledFromDart(void* ptr, NativeValue* results, int32_t context_id, const char* errmsg);
+
+ private:
+  static constexpr size_t kPromiseContextsPerSlab = 64;
+
+  BindingObjectPromiseContext* AllocatePromiseContext();
+  void ReleasePromiseContext(BindingObjectPromiseContext* promise_context);
+  void SettleBatch(AsyncBindingCallBatch* batch, NativeValue* results, const char* errmsg);
+
+  ExecutingContext* context_;
+  // Each call is a list of the binding object, the method name and the arguments.
+  std::vector<NativeValue> queued_calls_;
+  // Keep the binding objects alive until the calls are sent.
+  std::vector<ScriptValue> queued_targets_;
+  std::vector<BindingObjectPromiseContext*> queued_promise_contexts_;
+  std::unordered_set<AsyncBindingCallBatch*> in_flight_batches_;
+  // Promise contexts are pooled in slabs instead of allocated one by one.
+  std::vector<std::unique_ptr<BindingObjectPromiseContext[]>> slabs_;
+  BindingObjectPromiseContext* free_promise_contexts_{nullptr};
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_ASYNC_BINDING_CALL_QUEUE_H_
@@ -6,7 +6,6 @@
 #include "binding_object.h"
 #include "binding_call_methods.h"
 #include "bindings/qjs/exception_state.h"
-#include "bindings/qjs/script_promise_resolver.h"
 #include "core/dom/events/event_target.h"
 #include "core/executing_context.h"
 #include "foundation/native_string.h"
@@ -14,21 +13,61 @@
 
 namespace webf {
 
+// Names not declared in binding_call_methods.json5, e.g. properties of widget elements, are sent as strings.
+static NativeValue NativeValueOfName(JSContext* ctx, const AtomicString& name) {
+  int64_t index = binding_call_methods::IndexOf(name);
+  if (LIKELY(index >= 0)) {
+    return Native_NewInt64(kBindingCallMethodIdOffset + index);
+  }
+  return Native_NewString(name.ToNativeString(ctx).release());
+}
+
+// The binding methods of dart side are only callable on the dart thread.
+static void InvokeDartBindingMethod(ExecutingContext* context,
+                                    const NativeBindingObject* binding_object,
+                                    NativeValue* return_value,
+                                    NativeValue* method,
+                                    int32_t argc,
+                                    const NativeValue* argv) {
+  JSThreadDispatcher* dispatcher = context->dartIsolateContext()->dispatcher();
+  if (LIKELY(dispatcher == nullptr)) {
+    binding_object->invoke_bindings_methods_from_native(binding_object, return_value, method, argc, argv);
+    return;
+  }
+  dispatcher->PostToDartSync<void>([&]() {
+    binding_object->invoke_bindings_methods_from_native(binding_object, return_value, method, argc, argv);
+  });
+}
+
 void NativeBindingObject::HandleCallFromDartSide(NativeBindingObject* binding_object,
                                                  NativeValue* return_value,
                                                  NativeValue* native_method,
                                                  int32_t argc,
                                                  NativeValue* argv,
                                                  Dart_Handle dart_object) {
-  AtomicString method = AtomicString(
-      binding_object->binding_target_->ctx(),
-      std::unique_ptr<AutoFreeNativeString>(reinterpret_cast<AutoFreeNativeString*>(native_method->u.ptr)));
+  if (JSThreadDispatcher* dispatcher = JSThreadDispatcher::FromDartThread()) {
+    dispatcher->PostToJSSync<void>(binding_object->context_id_, [&]() {
+      HandleCallFromDartSide(binding_object, return_value, native_method, argc, argv, dart_object);
+    });
+    return;
+  }
+
+  AtomicString method =
+      native_method->tag == NativeTag::TAG_INT
+          ? binding_call_methods::NameAt(native_method->u.int64 - kBindingCallMethodIdOffset)
+          : AtomicString(
+                binding_object->binding_target_->ctx(),
+                std::unique_ptr<AutoFreeNativeString>(reinterpret_cast<AutoFreeNativeString*>(native_method->u.ptr)));
+  // Calls from dart side are made when the state at dart side changed, e.g. events.
+  binding_object->binding_target_->GetExecutingContext()->uiCommandBuffer()->InvalidateLayout();
   NativeValue result = binding_object->binding_target_->HandleCallFromDartSide(method, argc, argv, dart_object);
   if (return_value != nullptr)
     *return_value = result;
 }
 
-BindingObject::BindingObject(JSContext* ctx) : ScriptWrappable(ctx), binding_object_(new NativeBindingObject(this)) {}
+BindingObject::BindingObject(JSContext* ctx) : ScriptWrappable(ctx), binding_object_(new NativeBindingObject(this)) {
+  binding_object_->context_id_ = contextId();
+}
 BindingObject::~BindingObject() {
   // Set below properties to nullptr to avoid dart callback to native.
   binding_object_->disposed_ = true;
@@ -47,17 +86,10 @@ BindingObject::~BindingObject() {
 BindingObject::BindingObject(JSContext* ctx, NativeBindingObject* native_binding_object) : ScriptWrappable(ctx) {
   native_binding_object->binding_target_ = this;
   native_binding_object->invoke_binding_methods_from_dart = NativeBindingObject::HandleCallFromDartSide;
+  native_binding_object->context_id_ = contextId();
   binding_object_ = native_binding_object;
 }
 
-void BindingObject::TrackPendingPromiseBindingContext(BindingObjectPromiseContext* binding_object_promise_context) {
-  pending_promise_contexts_.emplace(binding_object_promise_context);
-}
-
-void BindingObject::FullFillPendingPromise(BindingObjectPromiseContext* binding_object_promise_context) {
-  pending_promise_contexts_.erase(binding_object_promise_context);
-}
-
 NativeValue BindingObject::HandleCallFromDartSide(const AtomicString& method,
                                                   int32_t argc,
                                                   const NativeValue* argv,
@@ -69,6 +101,8 @@ NativeValue BindingObject::InvokeBindingMethod(const AtomicString& method,
                                                int32_t argc,
                                                const NativeValue* argv,
                                                ExceptionState& exception_state) const {
+  // Keep the order of calls seen by dart side.
+  GetExecutingContext()->asyncBindingCalls()->Flush();
   GetExecutingContext()->FlushUICommand();
   if (binding_object_->invoke_bindings_methods_from_native == nullptr) {
     exception_state.ThrowException(GetExecutingContext()->ctx(), ErrorType::InternalError,
@@ -76,10 +110,14 @@ NativeValue BindingObject::InvokeBindingMethod(const AtomicString& method,
     return Native_NewNull();
   }
 
+  // Reading the layout metrics and the computed style are the only methods known to leave the layout untouched.
+  if (method != binding_call_methods::kgetLayoutMetrics && method != binding_call_methods::kgetPropertyValues) {
+    GetExecutingContext()->uiCommandBuffer()->InvalidateLayout();
+  }
+
   NativeValue return_value = Native_NewNull();
-  NativeValue native_method =
-      NativeValueConverter<NativeTypeString>::ToNativeValue(GetExecutingContext()->ctx(), method);
-  binding_object_->invoke_bindings_methods_from_native(binding_object_, &return_value, &native_method, argc, argv);
+  NativeValue native_method = NativeValueOfName(GetExecutingContext()->ctx(), method);
+  InvokeDartBindingMethod(GetExecutingContext(), binding_object_, &return_value, &native_method, argc, argv);
   return return_value;
 }
 
@@ -87,6 +125,8 @@ NativeValue BindingObject::InvokeBindingMethod(BindingMethodCallOperations bindi
                                                size_t argc,
                                                const NativeValue* argv,
                                                ExceptionState& exception_state) const {
+  // Keep the order of calls seen by dart side.
+  GetExecutingContext()->asyncBindingCalls()->Flush();
   GetExecutingContext()->FlushUICommand();
   if (binding_object_->invoke_bindings_methods_from_native == nullptr) {
     exception_state.ThrowException(GetExecutingContext()->ctx(), ErrorType::InternalError,
@@ -94,9 +134,15 @@ NativeValue BindingObject::InvokeBindingMethod(BindingMethodCallOperations bindi
     return Native_NewNull();
   }
 
+  if (binding_method_call_operation != BindingMethodCallOperations::kGetProperty &&
+      binding_method_call_operation != BindingMethodCallOperations::kGetProperties &&
+      binding_method_call_operation != BindingMethodCallOperations::kGetAllPropertyNames) {
+    GetExecutingContext()->uiCommandBuffer()->InvalidateLayout();
+  }
+
   NativeValue return_value = Native_NewNull();
   NativeValue native_method = NativeValueConverter<NativeTypeInt64>::ToNativeValue(binding_method_call_operation);
-  binding_object_->invoke_bindings_methods_from_native(binding_object_, &return_value, &native_method, argc, argv);
+  InvokeDartBindingMethod(GetExecutingContext(), binding_object_, &return_value, &native_method, argc, argv);
   return return_value;
 }
 
@@ -108,10 +154,61 @@ NativeValue BindingObject::GetBindingProperty(const AtomicString& prop, Exceptio
     return Native_NewNull();
   }
   GetExecutingContext()->FlushUICommand();
-  const NativeValue argv[] = {Native_NewString(prop.ToNativeString(GetExecutingContext()->ctx()).release())};
+  const NativeValue argv[] = {NativeValueOfName(GetExecutingContext()->ctx(), prop)};
   return InvokeBindingMethod(BindingMethodCallOperations::kGetProperty, 1, argv, exception_state);
 }
 
+std::vector<NativeValue> BindingObject::GetBindingProperties(const AtomicString* const* props,
+                                                            size_t count,
+                                                            ExceptionState& exception_state) const {
+  if (UNLIKELY(binding_object_->disposed_)) {
+    exception_state.ThrowException(
+        ctx(), ErrorType::InternalError,
+        "Can not get binding properties on BindingObject, dart binding object had been disposed");
+    return {};
+  }
+  GetExecutingContext()->FlushUICommand();
+  std::vector<NativeValue> argv;
+  argv.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    argv.emplace_back(NativeValueOfName(ctx(), *props[i]));
+  }
+  NativeValue result =
+      InvokeBindingMethod(BindingMethodCallOperations::kGetProperties, count, argv.data(), exception_state);
+  if (UNLIKELY(exception_state.HasException() || result.tag != NativeTag::TAG_LIST || result.uint32 != count)) {
+    return {};
+  }
+
+  auto* list = static_cast<NativeValue*>(result.u.ptr);
+  std::vector<NativeValue> values(list, list + count);
+  FreeDartAllocated(list);
+  return values;
+}
+
+NativeValue BindingObject::GetBindingPropertyInGroup(size_t index,
+                                                     const BindingPropertyGroup& group,
+                                                     ExceptionState& exception_state) const {
+  assert(index < group.count);
+  ExecutingContext* context = GetExecutingContext();
+  PropertyGroupCache* cache = property_group_cache_.get();
+  if (cache != nullptr && cache->group == group.props[0] &&
+      cache->layout_generation == context->uiCommandBuffer()->layoutGeneration() &&
+      cache->task_sequence == context->taskSequence()) {
+    return cache->values[index];
+  }
+
+  std::vector<NativeValue> values = GetBindingProperties(group.props, group.count, exception_state);
+  if (UNLIKELY(values.size() != group.count)) {
+    property_group_cache_ = nullptr;
+    return Native_NewNull();
+  }
+  NativeValue result = values[index];
+  property_group_cache_ = std::make_unique<PropertyGroupCache>(
+      PropertyGroupCache{group.props[0], context->uiCommandBuffer()->layoutGeneration(), context->taskSequence(),
+                         std::move(values)});
+  return result;
+}
+
 NativeValue BindingObject::SetBindingProperty(const AtomicString& prop,
                                               NativeValue value,
                                               ExceptionState& exception_state) const {
@@ -122,7 +219,7 @@ NativeValue BindingObject::SetBindingProperty(const AtomicString& prop,
     return Native_NewNull();
   }
   GetExecutingContext()->FlushUICommand();
-  const NativeValue argv[] = {Native_NewString(prop.ToNativeString(GetExecutingContext()->ctx()).release()), value};
+  const NativeValue argv[] = {NativeValueOfName(GetExecutingContext()->ctx(), prop), value};
   return InvokeBindingMethod(BindingMethodCallOperations::kSetProperty, 2, argv, exception_state);
 }
 
@@ -159,34 +256,6 @@ ScriptValue BindingObject::AnonymousFunctionCallback(JSContext* ctx,
   return ScriptValue(ctx, result);
 }
 
-void BindingObject::HandleAnonymousAsyncCalledFromDart(void* ptr,
-                                                       NativeValue* native_value,
-                                                       int32_t contextId,
-                                                       const char* errmsg) {
-  auto* promise_context = static_cast<BindingObjectPromiseContext*>(ptr);
-  if (!promise_context->context->IsContextValid())
-    return;
-  if (promise_context->context->contextId() != contextId)
-    return;
-
-  auto* context = promise_context->context;
-
-  if (native_value != nullptr) {
-    ScriptValue params = ScriptValue(context->ctx(), *native_value);
-    promise_context->promise_resolver->Resolve(params.QJSValue());
-  } else if (errmsg != nullptr) {
-    ExceptionState exception_state;
-    exception_state.ThrowException(context->ctx(), ErrorType::TypeError, errmsg);
-    JSValue error_object = JS_GetException(context->ctx());
-    promise_context->promise_resolver->Reject(error_object);
-    JS_FreeValue(context->ctx(), error_object);
-  }
-
-  promise_context->binding_object->FullFillPendingPromise(promise_context);
-
-  delete promise_context;
-}
-
 ScriptValue BindingObject::AnonymousAsyncFunctionCallback(JSContext* ctx,
                                                           const ScriptValue& this_val,
                                                           uint32_t argc,
@@ -195,22 +264,8 @@ ScriptValue BindingObject::AnonymousAsyncFunctionCallback(JSContext* ctx,
   auto* data = reinterpret_cast<AnonymousFunctionData*>(private_data);
   auto* event_target = toScriptWrappable<EventTarget>(this_val.QJSValue());
 
-  auto promise_resolver = ScriptPromiseResolver::Create(event_target->GetExecutingContext());
-
-  auto* promise_context =
-      new BindingObjectPromiseContext{{}, event_target->GetExecutingContext(), event_target, promise_resolver};
-  event_target->TrackPendingPromiseBindingContext(promise_context);
-
   std::vector<NativeValue> arguments;
-  arguments.reserve(argc + 4);
-
-  arguments.emplace_back(NativeValueConverter<NativeTypeString>::ToNativeValue(data->method_name));
-  arguments.emplace_back(
-      NativeValueConverter<NativeTypeInt64>::ToNativeValue(event_target->GetExecutingContext()->contextId()));
-  arguments.emplace_back(
-      NativeValueConverter<NativeTypePointer<BindingObjectPromiseContext>>::ToNativeValue(promise_context));
-  arguments.emplace_back(NativeValueConverter<NativeTypePointer<void>>::ToNativeValue(
-      reinterpret_cast<void*>(HandleAnonymousAsyncCalledFromDart)));
+  arguments.reserve(argc);
 
   ExceptionState exception_state;
 
@@ -218,15 +273,13 @@ ScriptValue BindingObject::AnonymousAsyncFunctionCallback(JSContext* ctx,
     arguments.emplace_back(argv[i].ToNative(exception_state));
   }
 
-  event_target->InvokeBindingMethod(BindingMethodCallOperations::kAsyncAnonymousFunction, argc + 4, arguments.data(),
-                                    exception_state);
-
   if (exception_state.HasException()) {
     event_target->GetExecutingContext()->HandleException(exception_state);
     return ScriptValue::Empty(ctx);
   }
 
-  return promise_resolver->Promise().ToValue();
+  return event_target->GetExecutingContext()->asyncBindingCalls()->Enqueue(
+      event_target, NativeValueConverter<NativeTypeString>::ToNativeValue(data->method_name), std::move(arguments));
 }
 
 NativeValue BindingObject::GetAllBindingPropertyNames(ExceptionState& exception_state) const {
@@ -234,11 +287,7 @@ NativeValue BindingObject::GetAllBindingPropertyNames(ExceptionState& exception_
   return InvokeBindingMethod(BindingMethodCallOperations::kGetAllPropertyNames, 0, nullptr, exception_state);
 }
 
-void BindingObject::Trace(GCVisitor* visitor) const {
-  for (auto&& promise_context : pending_promise_contexts_) {
-    promise_context->promise_resolver->Trace(visitor);
-  }
-}
+void BindingObject::Trace(GCVisitor* visitor) const {}
 
 bool BindingObject::IsEventTarget() const {
   return false;
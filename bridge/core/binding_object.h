@@ -8,7 +8,8 @@
 
 #include <include/dart_api_dl.h>
 #include <cinttypes>
-#include <set>
+#include <memory>
+#include <vector>
 #include "bindings/qjs/atomic_string.h"
 #include "bindings/qjs/script_wrappable.h"
 #include "foundation/native_type.h"
@@ -20,7 +21,6 @@ class BindingObject;
 struct NativeBindingObject;
 class ExceptionState;
 class GCVisitor;
-class ScriptPromiseResolver;
 
 using InvokeBindingsMethodsFromNative = void (*)(const NativeBindingObject* binding_object,
                                                  NativeValue* return_value,
@@ -51,6 +51,8 @@ struct NativeBindingObject : public DartReadable {
   BindingObject* binding_target_{nullptr};
   InvokeBindingMethodsFromDart invoke_binding_methods_from_dart{nullptr};
   InvokeBindingsMethodsFromNative invoke_bindings_methods_from_native{nullptr};
+  // The context owning the binding target, calls from dart side are forwarded to the JS thread of this context.
+  int64_t context_id_{0};
 };
 
 enum BindingMethodCallOperations {
@@ -59,14 +61,19 @@ enum BindingMethodCallOperations {
   kGetAllPropertyNames,
   kAnonymousFunctionCall,
   kAsyncAnonymousFunction,
+  kGetProperties,
+  kAsyncAnonymousFunctionBatch,
 };
 
-enum CreateBindingObjectType { kCreateDOMMatrix = 0 };
+// The names in binding_call_methods.json5 are exchanged with dart side as integers, the id of a name is its position
+// in the file plus the offset, which keeps them apart from BindingMethodCallOperations.
+constexpr int64_t kBindingCallMethodIdOffset = 1 << 16;
 
-struct BindingObjectPromiseContext : public DartReadable {
-  ExecutingContext* context;
-  BindingObject* binding_object;
-  std::shared_ptr<ScriptPromiseResolver> promise_resolver;
+// Properties of a binding object which are commonly read together, see BindingObject::GetBindingPropertyInGroup().
+// Only properties of numbers and booleans can be grouped, their values own no memory.
+struct BindingPropertyGroup {
+  const AtomicString* const* props;
+  size_t count;
 };
 
 class BindingObject : public ScriptWrappable {
@@ -81,15 +88,12 @@ class BindingObject : public ScriptWrappable {
                                                uint32_t argc,
                                                const ScriptValue* argv,
                                                void* private_data);
+  // The calls are queued and sent to dart side in batch, see AsyncBindingCallQueue.
   static ScriptValue AnonymousAsyncFunctionCallback(JSContext* ctx,
                                                     const ScriptValue& this_val,
                                                     uint32_t argc,
                                                     const ScriptValue* argv,
                                                     void* private_data);
-  static void HandleAnonymousAsyncCalledFromDart(void* ptr,
-                                                 NativeValue* native_value,
-                                                 int32_t contextId,
-                                                 const char* errmsg);
 
   BindingObject() = delete;
   ~BindingObject();
@@ -106,6 +110,15 @@ class BindingObject : public ScriptWrappable {
                                   const NativeValue* args,
                                   ExceptionState& exception_state) const;
   NativeValue GetBindingProperty(const AtomicString& prop, ExceptionState& exception_state) const;
+  // Read the properties with one call into dart side, the values are in the same order as |props|.
+  std::vector<NativeValue> GetBindingProperties(const AtomicString* const* props,
+                                                size_t count,
+                                                ExceptionState& exception_state) const;
+  // Read the property at |index| of |group|. The whole group is read at once and the other members are served from
+  // the cache until the layout may have changed or the current task finished.
+  NativeValue GetBindingPropertyInGroup(size_t index,
+                                        const BindingPropertyGroup& group,
+                                        ExceptionState& exception_state) const;
   NativeValue SetBindingProperty(const AtomicString& prop, NativeValue value, ExceptionState& exception_state) const;
   NativeValue GetAllBindingPropertyNames(ExceptionState& exception_state) const;
 
@@ -126,8 +139,6 @@ class BindingObject : public ScriptWrappable {
   virtual bool IsCanvasGradient() const;
 
  protected:
-  void TrackPendingPromiseBindingContext(BindingObjectPromiseContext* binding_object_promise_context);
-  void FullFillPendingPromise(BindingObjectPromiseContext* binding_object_promise_context);
   NativeValue InvokeBindingMethod(BindingMethodCallOperations binding_method_call_operation,
                                   size_t argc,
                                   const NativeValue* args,
@@ -137,8 +148,18 @@ class BindingObject : public ScriptWrappable {
   explicit BindingObject(JSContext* ctx, NativeBindingObject* native_binding_object);
 
  private:
+  friend class AsyncBindingCallQueue;
+
+  struct PropertyGroupCache {
+    // Groups are identified by their first member.
+    const AtomicString* group;
+    int64_t layout_generation;
+    int64_t task_sequence;
+    std::vector<NativeValue> values;
+  };
+
   NativeBindingObject* binding_object_ = nullptr;
-  std::set<BindingObjectPromiseContext*> pending_promise_contexts_;
+  mutable std::unique_ptr<PropertyGroupCache> property_group_cache_;
 };
 
 }  // namespace webf
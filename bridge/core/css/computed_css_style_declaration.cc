@@ -3,6 +3,7 @@
  */
 
 #include "computed_css_style_declaration.h"
+#include <algorithm>
 #include "binding_call_methods.h"
 #include "core/binding_object.h"
 #include "core/dom/element.h"
@@ -20,10 +21,70 @@ ScriptValue ComputedCssStyleDeclaration::item(const AtomicString& key, Exception
     return ScriptValue::Undefined(ctx());
   }
 
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), key)};
+  return ScriptValue(ctx(), GetResolvedValue(key, exception_state));
+}
 
-  NativeValue result = InvokeBindingMethod(binding_call_methods::kgetPropertyValue, 1, arguments, exception_state);
-  return ScriptValue(ctx(), NativeValueConverter<NativeTypeString>::FromNativeValue(ctx(), std::move(result)));
+bool ComputedCssStyleDeclaration::IsSnapshotValid() const {
+  return snapshot_layout_generation_ == GetExecutingContext()->uiCommandBuffer()->layoutGeneration();
+}
+
+AtomicString ComputedCssStyleDeclaration::GetResolvedValue(const AtomicString& key, ExceptionState& exception_state) {
+  if (IsSnapshotValid()) {
+    auto it = snapshot_values_.find(key);
+    if (it != snapshot_values_.end())
+      return it->second;
+  } else {
+    snapshot_values_.clear();
+  }
+
+  // A stale snapshot is fetched again with every property read so far, a valid one only misses |key|.
+  std::vector<AtomicString> properties;
+  if (snapshot_values_.empty()) {
+    properties = snapshot_properties_;
+  }
+  if (std::find(properties.begin(), properties.end(), key) == properties.end()) {
+    properties.emplace_back(key);
+  }
+  std::vector<NativeValue> arguments;
+  arguments.reserve(properties.size());
+  for (auto& property : properties) {
+    arguments.emplace_back(NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), property));
+  }
+
+  NativeValue result = InvokeBindingMethod(binding_call_methods::kgetPropertyValues, arguments.size(),
+                                           arguments.data(), exception_state);
+  if (UNLIKELY(exception_state.HasException() || result.tag != NativeTag::TAG_LIST ||
+               result.uint32 != properties.size())) {
+    snapshot_layout_generation_ = -1;
+    return AtomicString::Empty();
+  }
+
+  auto* list = static_cast<NativeValue*>(result.u.ptr);
+  for (size_t i = 0; i < properties.size(); i++) {
+    snapshot_values_[properties[i]] =
+        NativeValueConverter<NativeTypeString>::FromNativeValue(ctx(), std::move(list[i]));
+  }
+  FreeDartAllocated(list);
+
+  if (snapshot_properties_.size() < kMaximumSnapshotProperties &&
+      std::find(snapshot_properties_.begin(), snapshot_properties_.end(), key) == snapshot_properties_.end()) {
+    snapshot_properties_.emplace_back(key);
+  }
+  snapshot_layout_generation_ = GetExecutingContext()->uiCommandBuffer()->layoutGeneration();
+  return snapshot_values_[key];
+}
+
+const std::unordered_set<AtomicString, AtomicString::KeyHasher>& ComputedCssStyleDeclaration::EnsurePropertyNames(
+    ExceptionState& exception_state) {
+  if (!property_names_.empty())
+    return property_name_set_;
+
+  NativeValue result = InvokeBindingMethod(binding_call_methods::kgetFullCSSPropertyList, 0, nullptr, exception_state);
+  if (UNLIKELY(exception_state.HasException() || result.tag != NativeTag::TAG_LIST))
+    return property_name_set_;
+  property_names_ = NativeValueConverter<NativeTypeArray<NativeTypeString>>::FromNativeValue(ctx(), result);
+  property_name_set_.insert(property_names_.begin(), property_names_.end());
+  return property_name_set_;
 }
 
 bool ComputedCssStyleDeclaration::SetItem(const AtomicString& key,
@@ -40,8 +101,12 @@ bool ComputedCssStyleDeclaration::DeleteItem(const webf::AtomicString& key, webf
 }
 
 int64_t ComputedCssStyleDeclaration::length() const {
-  NativeValue result = GetBindingProperty(binding_call_methods::klength, ASSERT_NO_EXCEPTION());
-  return NativeValueConverter<NativeTypeInt64>::FromNativeValue(result);
+  // The number of CSS properties known by dart side, which never changes.
+  if (length_ < 0) {
+    NativeValue result = GetBindingProperty(binding_call_methods::klength, ASSERT_NO_EXCEPTION());
+    length_ = NativeValueConverter<NativeTypeInt64>::FromNativeValue(result);
+  }
+  return length_;
 }
 
 AtomicString ComputedCssStyleDeclaration::getPropertyValue(const AtomicString& key, ExceptionState& exception_state) {
@@ -61,18 +126,13 @@ AtomicString ComputedCssStyleDeclaration::removeProperty(const AtomicString& key
 }
 
 bool ComputedCssStyleDeclaration::NamedPropertyQuery(const AtomicString& key, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), key)};
-  NativeValue result = InvokeBindingMethod(binding_call_methods::kcheckCSSProperty, 1, arguments, exception_state);
-  return NativeValueConverter<NativeTypeBool>::FromNativeValue(result);
+  return EnsurePropertyNames(exception_state).count(key) > 0;
 }
 
 void ComputedCssStyleDeclaration::NamedPropertyEnumerator(std::vector<AtomicString>& names,
                                                           ExceptionState& exception_state) {
-  NativeValue result = InvokeBindingMethod(binding_call_methods::kgetFullCSSPropertyList, 0, nullptr, exception_state);
-  auto&& arr = NativeValueConverter<NativeTypeArray<NativeTypeString>>::FromNativeValue(ctx(), result);
-  for (auto& i : arr) {
-    names.emplace_back(i);
-  }
+  EnsurePropertyNames(exception_state);
+  names.insert(names.end(), property_names_.begin(), property_names_.end());
 }
 
 bool ComputedCssStyleDeclaration::IsComputedCssStyleDeclaration() const {
@@ -5,6 +5,9 @@
 #ifndef WEBF_CORE_CSS_COMPUTED_CSS_STYLE_DECLARATION_H_
 #define WEBF_CORE_CSS_COMPUTED_CSS_STYLE_DECLARATION_H_
 
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include "bindings/qjs/cppgc/member.h"
 #include "core/binding_object.h"
 #include "css_style_declaration.h"
@@ -40,6 +43,23 @@ class ComputedCssStyleDeclaration : public CSSStyleDeclaration {
   void setCssText(const AtomicString& value, ExceptionState& exception_state) override;
 
  private:
+  // Resolved values are read from a snapshot, which is valid until the layout generation changes: on a flush of
+  // commands which may restyle the element, or when dart side invalidates it, e.g. on an animation frame. A stale
+  // snapshot is fetched again in one call with every property read so far, so the properties polled each frame
+  // take a single round-trip.
+  AtomicString GetResolvedValue(const AtomicString& key, ExceptionState& exception_state);
+  bool IsSnapshotValid() const;
+  // Names of all the CSS properties, they never change.
+  const std::unordered_set<AtomicString, AtomicString::KeyHasher>& EnsurePropertyNames(ExceptionState& exception_state);
+
+  static constexpr size_t kMaximumSnapshotProperties = 64;
+
+  std::vector<AtomicString> snapshot_properties_;
+  std::unordered_map<AtomicString, AtomicString, AtomicString::KeyHasher> snapshot_values_;
+  int64_t snapshot_layout_generation_{-1};
+  std::vector<AtomicString> property_names_;
+  std::unordered_set<AtomicString, AtomicString::KeyHasher> property_name_set_;
+  mutable int64_t length_{-1};
 };
 
 template <>
@@ -0,0 +1,391 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "css_selector.h"
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include "core/css/selector_filter.h"
+
+namespace webf {
+
+static bool IsSelectorWhitespace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+static bool IsNameStart(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || static_cast<unsigned char>(c) >= 0x80;
+}
+
+static bool IsName(char c) {
+  return IsNameStart(c) || (c >= '0' && c <= '9') || c == '-';
+}
+
+static std::string ToASCIILower(std::string string) {
+  std::transform(string.begin(), string.end(), string.begin(),
+                 [](char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; });
+  return string;
+}
+
+// Parses the selectors supported by SelectorChecker, the grammar is from https://drafts.csswg.org/selectors-4/.
+// Any syntax not understood fails the parsing, the caller falls back to the selector engine at dart side.
+class CSSSelectorParser {
+ public:
+  CSSSelectorParser(JSContext* ctx, const std::string& text) : ctx_(ctx), text_(text) {}
+
+  bool ParseSelectorList(CSSSelectorList& list, bool nested) {
+    do {
+      SkipWhitespace();
+      CSSComplexSelector complex;
+      if (!ParseComplexSelector(complex))
+        return false;
+      SelectorFilter::CollectIdentifierHashes(complex);
+      list.selectors_.emplace_back(std::move(complex));
+    } while (Consume(','));
+    SkipWhitespace();
+    return nested ? Peek() == ')' : AtEnd();
+  }
+
+ private:
+  bool ParseComplexSelector(CSSComplexSelector& complex) {
+    CSSCompoundSelector compound;
+    if (!ParseCompoundSelector(compound))
+      return false;
+    complex.compounds.emplace_back(std::move(compound));
+
+    while (true) {
+      bool has_whitespace = SkipWhitespace();
+      char c = Peek();
+      CSSSelectorRelation relation;
+      if (AtEnd() || c == ',' || c == ')') {
+        break;
+      } else if (c == '>') {
+        relation = CSSSelectorRelation::kChild;
+      } else if (c == '+') {
+        relation = CSSSelectorRelation::kDirectAdjacent;
+      } else if (c == '~') {
+        relation = CSSSelectorRelation::kIndirectAdjacent;
+      } else if (has_whitespace) {
+        relation = CSSSelectorRelation::kDescendant;
+      } else {
+        return false;
+      }
+      if (relation != CSSSelectorRelation::kDescendant) {
+        pos_++;
+        SkipWhitespace();
+      }
+
+      CSSCompoundSelector next;
+      if (!ParseCompoundSelector(next))
+        return false;
+      next.relation = relation;
+      complex.compounds.emplace_back(std::move(next));
+    }
+
+    // Compound selectors are matched from right to left.
+    std::reverse(complex.compounds.begin(), complex.compounds.end());
+    return true;
+  }
+
+  bool ParseCompoundSelector(CSSCompoundSelector& compound) {
+    bool has_selector = false;
+    if (Consume('*')) {
+      has_selector = true;
+    } else if (IsNameStart(Peek()) || Peek() == '-') {
+      std::string name;
+      if (!ParseIdentifier(name))
+        return false;
+      compound.selectors.emplace_back(CSSSelector{CSSSelector::kTag});
+      compound.selectors.back().value = AtomicString(ctx_, ToASCIILower(name));
+      has_selector = true;
+    }
+    // Namespaces.
+    if (Peek() == '|')
+      return false;
+
+    while (!AtEnd()) {
+      char c = Peek();
+      if (c == '#' || c == '.') {
+        pos_++;
+        std::string name;
+        if (!ParseIdentifier(name))
+          return false;
+        compound.selectors.emplace_back(CSSSelector{c == '#' ? CSSSelector::kId : CSSSelector::kClass});
+        compound.selectors.back().value = AtomicString(ctx_, name);
+      } else if (c == '[') {
+        pos_++;
+        CSSSelector selector{CSSSelector::kAttributeSet};
+        if (!ParseAttributeSelector(selector))
+          return false;
+        compound.selectors.emplace_back(std::move(selector));
+      } else if (c == ':') {
+        pos_++;
+        // Pseudo elements.
+        if (Peek() == ':')
+          return false;
+        CSSSelector selector{CSSSelector::kPseudoClass};
+        if (!ParsePseudoClass(selector))
+          return false;
+        compound.selectors.emplace_back(std::move(selector));
+      } else {
+        break;
+      }
+      has_selector = true;
+    }
+    return has_selector;
+  }
+
+  bool ParseAttributeSelector(CSSSelector& selector) {
+    SkipWhitespace();
+    std::string name;
+    if (!ParseIdentifier(name))
+      return false;
+    selector.attribute = AtomicString(ctx_, ToASCIILower(name));
+    SkipWhitespace();
+    if (Consume(']'))
+      return true;
+
+    char c = Peek();
+    if (c == '=') {
+      selector.match = CSSSelector::kAttributeExact;
+    } else {
+      switch (c) {
+        case '~':
+          selector.match = CSSSelector::kAttributeList;
+          break;
+        case '|':
+          selector.match = CSSSelector::kAttributeHyphen;
+          break;
+        case '^':
+          selector.match = CSSSelector::kAttributeBegin;
+          break;
+        case '$':
+          selector.match = CSSSelector::kAttributeEnd;
+          break;
+        case '*':
+          selector.match = CSSSelector::kAttributeContain;
+          break;
+        default:
+          return false;
+      }
+      pos_++;
+      if (Peek() != '=')
+        return false;
+    }
+    pos_++;
+    SkipWhitespace();
+
+    std::string value;
+    if (Peek() == '"' || Peek() == '\'') {
+      if (!ParseString(value))
+        return false;
+    } else if (!ParseIdentifier(value)) {
+      return false;
+    }
+    SkipWhitespace();
+    if (Peek() == 'i' || Peek() == 'I') {
+      pos_++;
+      selector.attribute_case_insensitive = true;
+      value = ToASCIILower(value);
+      SkipWhitespace();
+    } else if (Peek() == 's' || Peek() == 'S') {
+      pos_++;
+      SkipWhitespace();
+    }
+    selector.value = AtomicString(ctx_, value);
+    return Consume(']');
+  }
+
+  bool ParsePseudoClass(CSSSelector& selector) {
+    std::string name;
+    if (!ParseIdentifier(name))
+      return false;
+    name = ToASCIILower(name);
+
+    if (!Consume('(')) {
+      if (name == "root") {
+        selector.pseudo = CSSSelector::kPseudoRoot;
+      } else if (name == "scope") {
+        selector.pseudo = CSSSelector::kPseudoScope;
+      } else if (name == "empty") {
+        selector.pseudo = CSSSelector::kPseudoEmpty;
+      } else if (name == "link" || name == "any-link") {
+        selector.pseudo = CSSSelector::kPseudoLink;
+      } else if (name == "first-child") {
+        selector.pseudo = CSSSelector::kPseudoFirstChild;
+      } else if (name == "last-child") {
+        selector.pseudo = CSSSelector::kPseudoLastChild;
+      } else if (name == "only-child") {
+        selector.pseudo = CSSSelector::kPseudoOnlyChild;
+      } else if (name == "first-of-type") {
+        selector.pseudo = CSSSelector::kPseudoFirstOfType;
+      } else if (name == "last-of-type") {
+        selector.pseudo = CSSSelector::kPseudoLastOfType;
+      } else if (name == "only-of-type") {
+        selector.pseudo = CSSSelector::kPseudoOnlyOfType;
+      } else {
+        // State based pseudo classes like :hover are only known by dart side.
+        return false;
+      }
+      return true;
+    }
+
+    if (name == "not" || name == "is" || name == "where") {
+      selector.pseudo = name == "not" ? CSSSelector::kPseudoNot : CSSSelector::kPseudoIs;
+      auto argument = std::make_shared<CSSSelectorList>();
+      if (!ParseSelectorList(*argument, true))
+        return false;
+      selector.argument = std::move(argument);
+    } else if (name == "nth-child" || name == "nth-last-child" || name == "nth-of-type" ||
+               name == "nth-last-of-type") {
+      if (name == "nth-child") {
+        selector.pseudo = CSSSelector::kPseudoNthChild;
+      } else if (name == "nth-last-child") {
+        selector.pseudo = CSSSelector::kPseudoNthLastChild;
+      } else if (name == "nth-of-type") {
+        selector.pseudo = CSSSelector::kPseudoNthOfType;
+      } else {
+        selector.pseudo = CSSSelector::kPseudoNthLastOfType;
+      }
+      size_t end = text_.find(')', pos_);
+      if (end == std::string::npos)
+        return false;
+      if (!ParseNth(ToASCIILower(text_.substr(pos_, end - pos_)), selector.nth_a, selector.nth_b))
+        return false;
+      pos_ = end;
+    } else {
+      return false;
+    }
+    return Consume(')');
+  }
+
+  // https://drafts.csswg.org/css-syntax-3/#anb-microsyntax
+  static bool ParseNth(const std::string& text, int32_t& a, int32_t& b) {
+    size_t begin = text.find_first_not_of(" \t\n\r\f");
+    size_t end = text.find_last_not_of(" \t\n\r\f");
+    if (begin == std::string::npos)
+      return false;
+    std::string expression = text.substr(begin, end - begin + 1);
+    if (expression == "odd") {
+      a = 2;
+      b = 1;
+      return true;
+    }
+    if (expression == "even") {
+      a = 2;
+      b = 0;
+      return true;
+    }
+
+    size_t pos = 0;
+    auto parse_integer = [&expression, &pos](int32_t& result) {
+      size_t start = pos;
+      while (pos < expression.size() && expression[pos] >= '0' && expression[pos] <= '9')
+        pos++;
+      if (pos == start)
+        return false;
+      result = static_cast<int32_t>(std::strtol(expression.c_str() + start, nullptr, 10));
+      return true;
+    };
+    auto skip_whitespace = [&expression, &pos]() {
+      while (pos < expression.size() && IsSelectorWhitespace(expression[pos]))
+        pos++;
+    };
+
+    int32_t sign = 1;
+    if (expression[pos] == '+' || expression[pos] == '-') {
+      sign = expression[pos] == '-' ? -1 : 1;
+      pos++;
+    }
+    int32_t number = 1;
+    bool has_number = parse_integer(number);
+    if (pos == expression.size() || expression[pos] != 'n') {
+      if (!has_number || pos != expression.size())
+        return false;
+      a = 0;
+      b = sign * number;
+      return true;
+    }
+
+    pos++;
+    a = sign * number;
+    b = 0;
+    skip_whitespace();
+    if (pos == expression.size())
+      return true;
+    if (expression[pos] != '+' && expression[pos] != '-')
+      return false;
+    int32_t b_sign = expression[pos] == '-' ? -1 : 1;
+    pos++;
+    skip_whitespace();
+    if (!parse_integer(b))
+      return false;
+    b *= b_sign;
+    return pos == expression.size();
+  }
+
+  bool ParseIdentifier(std::string& result) {
+    size_t start = pos_;
+    if (Peek() == '-')
+      pos_++;
+    if (Peek() == '-') {
+      pos_++;
+    } else if (!IsNameStart(Peek())) {
+      pos_ = start;
+      return false;
+    }
+    while (!AtEnd() && IsName(Peek()))
+      pos_++;
+    // Escapes.
+    if (Peek() == '\\')
+      return false;
+    result = text_.substr(start, pos_ - start);
+    return true;
+  }
+
+  bool ParseString(std::string& result) {
+    char quote = text_[pos_++];
+    size_t end = text_.find(quote, pos_);
+    if (end == std::string::npos)
+      return false;
+    result = text_.substr(pos_, end - pos_);
+    // Escapes.
+    if (result.find('\\') != std::string::npos)
+      return false;
+    pos_ = end + 1;
+    return true;
+  }
+
+  bool SkipWhitespace() {
+    size_t start = pos_;
+    while (!AtEnd() && IsSelectorWhitespace(text_[pos_]))
+      pos_++;
+    return pos_ != start;
+  }
+
+  bool Consume(char c) {
+    if (Peek() != c)
+      return false;
+    pos_++;
+    return true;
+  }
+
+  bool AtEnd() const { return pos_ >= text_.size(); }
+  char Peek() const { return AtEnd() ? '\0' : text_[pos_]; }
+
+  JSContext* ctx_;
+  const std::string& text_;
+  size_t pos_{0};
+};
+
+std::unique_ptr<CSSSelectorList> CSSSelectorList::Parse(JSContext* ctx, const AtomicString& text) {
+  std::string string = text.ToStdString(ctx);
+  auto list = std::make_unique<CSSSelectorList>();
+  CSSSelectorParser parser(ctx, string);
+  if (!parser.ParseSelectorList(*list, false))
+    return nullptr;
+  return list;
+}
+
+}  // namespace webf
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_CSS_CSS_SELECTOR_H_
+#define BRIDGE_CORE_CSS_CSS_SELECTOR_H_
+
+#include <memory>
+#include <vector>
+#include "bindings/qjs/atomic_string.h"
+
+namespace webf {
+
+class CSSSelectorList;
+
+// A simple selector, e.g. `div`, `.item`, `[href^="https"]` or `:nth-child(2n+1)`.
+struct CSSSelector {
+  enum MatchType {
+    kTag,
+    kId,
+    kClass,
+    // [name]
+    kAttributeSet,
+    // [name=value]
+    kAttributeExact,
+    // [name~=value]
+    kAttributeList,
+    // [name|=value]
+    kAttributeHyphen,
+    // [name^=value]
+    kAttributeBegin,
+    // [name$=value]
+    kAttributeEnd,
+    // [name*=value]
+    kAttributeContain,
+    kPseudoClass,
+  };
+
+  enum PseudoType {
+    kPseudoUnknown,
+    kPseudoRoot,
+    kPseudoScope,
+    kPseudoEmpty,
+    kPseudoLink,
+    kPseudoFirstChild,
+    kPseudoLastChild,
+    kPseudoOnlyChild,
+    kPseudoFirstOfType,
+    kPseudoLastOfType,
+    kPseudoOnlyOfType,
+    kPseudoNthChild,
+    kPseudoNthLastChild,
+    kPseudoNthOfType,
+    kPseudoNthLastOfType,
+    kPseudoNot,
+    kPseudoIs,
+  };
+
+  MatchType match;
+  PseudoType pseudo{kPseudoUnknown};
+  // The lowercase tag name, the id, the class or the value of attribute selectors.
+  AtomicString value;
+  // The lowercase name of attribute selectors.
+  AtomicString attribute;
+  // [name=value i]
+  bool attribute_case_insensitive{false};
+  // a and b of the an+b argument of :nth-* pseudo classes.
+  int32_t nth_a{0};
+  int32_t nth_b{0};
+  // The argument of :not(), :is() and :where().
+  std::shared_ptr<CSSSelectorList> argument;
+};
+
+// How a compound selector relates to the compound selector on its left.
+enum class CSSSelectorRelation {
+  // The leftmost compound selector.
+  kNone,
+  // A B
+  kDescendant,
+  // A > B
+  kChild,
+  // A + B
+  kDirectAdjacent,
+  // A ~ B
+  kIndirectAdjacent,
+};
+
+// Simple selectors without combinators between them, e.g. `div.item[hidden]`.
+struct CSSCompoundSelector {
+  std::vector<CSSSelector> selectors;
+  CSSSelectorRelation relation{CSSSelectorRelation::kNone};
+};
+
+struct CSSComplexSelector {
+  // From the rightmost compound selector to the leftmost one, in the order they are matched.
+  std::vector<CSSCompoundSelector> compounds;
+  // Hashes of the tag names, ids and classes an ancestor of the matched element must have, see SelectorFilter.
+  std::vector<unsigned> ancestor_identifier_hashes;
+};
+
+// A parsed selector list like the argument of querySelector(), e.g. `ul > li.item, a[href]`.
+class CSSSelectorList {
+ public:
+  // Returns nullptr when |text| is invalid or uses syntax which is not supported yet, e.g. pseudo elements, namespaces
+  // and escapes.
+  static std::unique_ptr<CSSSelectorList> Parse(JSContext* ctx, const AtomicString& text);
+
+  const std::vector<CSSComplexSelector>& selectors() const { return selectors_; }
+
+ private:
+  friend class CSSSelectorParser;
+
+  std::vector<CSSComplexSelector> selectors_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_CSS_CSS_SELECTOR_H_
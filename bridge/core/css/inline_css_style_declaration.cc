@@ -3,6 +3,7 @@
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
 #include "inline_css_style_declaration.h"
+#include <algorithm>
 #include <vector>
 #include "core/dom/element.h"
 #include "core/executing_context.h"
@@ -61,6 +62,14 @@ InlineCssStyleDeclaration* InlineCssStyleDeclaration::Create(ExecutingContext* c
 InlineCssStyleDeclaration::InlineCssStyleDeclaration(ExecutingContext* context, Element* owner_element_)
     : CSSStyleDeclaration(context->ctx()), owner_element_(owner_element_) {}
 
+InlineCssStyleDeclaration::~InlineCssStyleDeclaration() {
+  // The owner element is collected together with this declaration, its pending changes are no longer needed. They are
+  // dropped with kDisposeBindingObject when the element goes first.
+  if (!pending_properties_.empty()) {
+    GetExecutingContext()->uiCommandBuffer()->removePendingStyle(owner_element_->bindingObject());
+  }
+}
+
 ScriptValue InlineCssStyleDeclaration::item(const AtomicString& key, ExceptionState& exception_state) {
   if (IsPrototypeMethods(key)) {
     return ScriptValue::Undefined(ctx());
@@ -196,10 +205,7 @@ bool InlineCssStyleDeclaration::InternalSetProperty(std::string& name, const Ato
   }
 
   properties_[name] = value;
-
-  std::unique_ptr<SharedNativeString> args_01 = stringToNativeString(name);
-  GetExecutingContext()->uiCommandBuffer()->addCommand(
-      UICommand::kSetStyle, std::move(args_01), owner_element_->bindingObject(), value.ToNativeString(ctx()).release());
+  MarkPropertyDirty(name);
 
   return true;
 }
@@ -213,10 +219,7 @@ AtomicString InlineCssStyleDeclaration::InternalRemoveProperty(std::string& name
 
   AtomicString return_value = properties_[name];
   properties_.erase(name);
-
-  std::unique_ptr<SharedNativeString> args_01 = stringToNativeString(name);
-  GetExecutingContext()->uiCommandBuffer()->addCommand(UICommand::kSetStyle, std::move(args_01),
-                                                       owner_element_->bindingObject(), nullptr);
+  MarkPropertyDirty(name);
 
   return return_value;
 }
@@ -225,8 +228,77 @@ void InlineCssStyleDeclaration::InternalClearProperty() {
   if (properties_.empty())
     return;
   properties_.clear();
+  // Pending changes are overridden by kClearStyle.
+  if (!pending_properties_.empty()) {
+    GetExecutingContext()->uiCommandBuffer()->removePendingStyle(owner_element_->bindingObject());
+    ClearPendingProperties();
+  }
   GetExecutingContext()->uiCommandBuffer()->addCommand(UICommand::kClearStyle, nullptr, owner_element_->bindingObject(),
                                                        nullptr);
 }
 
+void InlineCssStyleDeclaration::MarkPropertyDirty(const std::string& name) {
+  auto* buffer = GetExecutingContext()->uiCommandBuffer();
+  // The element is being built inside a SubtreeCommandScope, which sends all of its properties.
+  if (buffer->nodeCommandsSuspended())
+    return;
+  if (pending_properties_.empty()) {
+    buffer->addPendingStyle(this, owner_element_->bindingObject());
+  }
+  if (pending_property_set_.emplace(name).second) {
+    pending_properties_.emplace_back(name);
+  }
+}
+
+static void AppendUTF16(std::u16string& packed, const std::string& string) {
+  bool is_ascii = std::all_of(string.begin(), string.end(), [](char c) { return static_cast<unsigned char>(c) < 0x80; });
+  if (LIKELY(is_ascii)) {
+    packed.append(string.begin(), string.end());
+    return;
+  }
+  std::u16string utf16;
+  fromUTF8(string, utf16);
+  packed += utf16;
+}
+
+static void AppendUTF16(std::u16string& packed, const AtomicString& string) {
+  if (string.IsEmpty())
+    return;
+  if (string.Is8Bit()) {
+    const uint8_t* characters = string.Character8();
+    packed.append(characters, characters + string.length());
+  } else {
+    const uint16_t* characters = string.Character16();
+    packed.append(characters, characters + string.length());
+  }
+}
+
+void InlineCssStyleDeclaration::FlushPendingProperties() {
+  if (pending_properties_.empty())
+    return;
+
+  std::u16string packed;
+  for (auto& name : pending_properties_) {
+    AppendUTF16(packed, name);
+    packed += u'\0';
+    auto it = properties_.find(name);
+    if (it != properties_.end()) {
+      AppendUTF16(packed, it->second);
+    }
+    packed += u'\0';
+  }
+  ClearPendingProperties();
+
+  auto* buffer = GetExecutingContext()->uiCommandBuffer();
+  buffer->addCommand(UICommand::kSetStyleBatch,
+                     buffer->NewString(reinterpret_cast<const uint16_t*>(packed.data()),
+                                       static_cast<uint32_t>(packed.size())),
+                     owner_element_->bindingObject(), nullptr, false);
+}
+
+void InlineCssStyleDeclaration::ClearPendingProperties() {
+  pending_properties_.clear();
+  pending_property_set_.clear();
+}
+
 }  // namespace webf
@@ -6,6 +6,8 @@
 #define BRIDGE_CSS_STYLE_DECLARATION_H
 
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include "bindings/qjs/atomic_string.h"
 #include "bindings/qjs/cppgc/member.h"
 #include "bindings/qjs/exception_state.h"
@@ -24,6 +26,7 @@ class InlineCssStyleDeclaration : public CSSStyleDeclaration {
   using ImplType = InlineCssStyleDeclaration*;
   static InlineCssStyleDeclaration* Create(ExecutingContext* context, ExceptionState& exception_state);
   explicit InlineCssStyleDeclaration(ExecutingContext* context, Element* owner_element_);
+  ~InlineCssStyleDeclaration() override;
 
   ScriptValue item(const AtomicString& key, ExceptionState& exception_state) override;
   bool SetItem(const AtomicString& key, const ScriptValue& value, ExceptionState& exception_state) override;
@@ -47,12 +50,22 @@ class InlineCssStyleDeclaration : public CSSStyleDeclaration {
 
   void Trace(GCVisitor* visitor) const override;
 
+  const std::unordered_map<std::string, AtomicString>& properties() const { return properties_; }
+
+  // Send the changed properties since last flush to dart side with a single kSetStyleBatch command.
+  void FlushPendingProperties();
+  void ClearPendingProperties();
+
  private:
+  void MarkPropertyDirty(const std::string& name);
   AtomicString InternalGetPropertyValue(std::string& name);
   bool InternalSetProperty(std::string& name, const AtomicString& value);
   AtomicString InternalRemoveProperty(std::string& name);
   void InternalClearProperty();
   std::unordered_map<std::string, AtomicString> properties_;
+  // Properties changed since last flush, in the order they were first changed.
+  std::vector<std::string> pending_properties_;
+  std::unordered_set<std::string> pending_property_set_;
   Member<Element> owner_element_;
 };
 
@@ -52,20 +52,15 @@ document.body.style.setProperty('--blue', 'lightblue'); console.assert(document.
 document.body.style.setProperty('--main-color', 'lightblue'); console.assert(document.body.style.getPropertyValue('--main-color') === 'lightblue');
 )";
   env->page()->evaluateScript(code, strlen(code), "vm://", 0);
-  UICommandItem* data = context->uiCommandBuffer()->data();
+  // Style changes are packed into one command per element when flushing.
+  context->uiCommandBuffer()->flushPendingStyles();
   size_t commandSize = context->uiCommandBuffer()->size();
 
-  UICommandItem& last = data[commandSize - 1];
+  UICommandItem& last = *context->uiCommandBuffer()->at(commandSize - 1);
 
-  EXPECT_EQ(last.type, (int32_t)UICommand::kSetStyle);
-  uint16_t* last_key = (uint16_t*)last.string_01;
-
-  auto native_str = new SharedNativeString(last_key, last.args_01_length);
-  EXPECT_STREQ(AtomicString(context->ctx(),
-                            std::unique_ptr<AutoFreeNativeString>(static_cast<AutoFreeNativeString*>(native_str)))
-                   .ToStdString(context->ctx())
-                   .c_str(),
-               "--main-color");
+  EXPECT_EQ(last.type, (int32_t)UICommand::kSetStyleBatch);
+  std::u16string packed(reinterpret_cast<const char16_t*>(last.string_01), last.args_01_length);
+  EXPECT_EQ(packed, std::u16string(u"--blue\0lightblue\0--main-color\0lightblue\0", 40));
 
   EXPECT_EQ(errorCalled, false);
 }
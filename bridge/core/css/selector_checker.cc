@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "selector_checker.h"
+#include <algorithm>
+#include <string>
+#include "bindings/qjs/exception_state.h"
+#include "core/dom/element.h"
+#include "core/dom/element_traversal.h"
+#include "core/dom/text.h"
+#include "element_namespace_uris.h"
+#include "html_names.h"
+
+namespace webf {
+
+static bool IsSameType(const Element& element, const Element& other) {
+  return element.localName() == other.localName();
+}
+
+// https://html.spec.whatwg.org/multipage/semantics-other.html#selector-link
+static bool IsLink(const Element& element) {
+  if (element.namespaceURI() != element_namespace_uris::khtml)
+    return false;
+  const AtomicString& local_name = element.localName();
+  if (local_name != html_names::ka && local_name != html_names::karea)
+    return false;
+  ElementAttributes* attributes = element.attributesIfExists();
+  return attributes != nullptr && attributes->hasAttribute(html_names::kHrefAttr, ASSERT_NO_EXCEPTION());
+}
+
+// The position of |element| among its element siblings which pass |filter|, starting from 1.
+template <bool kFromLast, typename Filter>
+static int32_t NthIndex(Element& element, Filter filter) {
+  int32_t index = 1;
+  for (Element* sibling = kFromLast ? ElementTraversal::NextSibling(element) : ElementTraversal::PreviousSibling(element);
+       sibling != nullptr;
+       sibling = kFromLast ? ElementTraversal::NextSibling(*sibling) : ElementTraversal::PreviousSibling(*sibling)) {
+    if (filter(*sibling))
+      index++;
+  }
+  return index;
+}
+
+static bool MatchesNth(int32_t index, int32_t a, int32_t b) {
+  if (a == 0)
+    return index == b;
+  int32_t n = index - b;
+  return n % a == 0 && n / a >= 0;
+}
+
+bool SelectorChecker::Match(const CSSSelectorList& list, Element& element, const Element* scope) {
+  for (const CSSComplexSelector& selector : list.selectors()) {
+    if (Match(selector, element, scope))
+      return true;
+  }
+  return false;
+}
+
+bool SelectorChecker::Match(const CSSComplexSelector& selector, Element& element, const Element* scope) {
+  return MatchFrom(selector, 0, element, scope);
+}
+
+bool SelectorChecker::MatchFrom(const CSSComplexSelector& selector,
+                                size_t index,
+                                Element& element,
+                                const Element* scope) {
+  const CSSCompoundSelector& compound = selector.compounds[index];
+  if (!MatchCompound(compound, element, scope))
+    return false;
+  if (index + 1 == selector.compounds.size())
+    return true;
+
+  switch (compound.relation) {
+    case CSSSelectorRelation::kDescendant:
+      for (Element* ancestor = element.parentElement(); ancestor != nullptr; ancestor = ancestor->parentElement()) {
+        if (MatchFrom(selector, index + 1, *ancestor, scope))
+          return true;
+      }
+      return false;
+    case CSSSelectorRelation::kChild: {
+      Element* parent = element.parentElement();
+      return parent != nullptr && MatchFrom(selector, index + 1, *parent, scope);
+    }
+    case CSSSelectorRelation::kDirectAdjacent: {
+      Element* sibling = ElementTraversal::PreviousSibling(element);
+      return sibling != nullptr && MatchFrom(selector, index + 1, *sibling, scope);
+    }
+    case CSSSelectorRelation::kIndirectAdjacent:
+      for (Element* sibling = ElementTraversal::PreviousSibling(element); sibling != nullptr;
+           sibling = ElementTraversal::PreviousSibling(*sibling)) {
+        if (MatchFrom(selector, index + 1, *sibling, scope))
+          return true;
+      }
+      return false;
+    case CSSSelectorRelation::kNone:
+      break;
+  }
+  return false;
+}
+
+bool SelectorChecker::MatchCompound(const CSSCompoundSelector& compound, Element& element, const Element* scope) {
+  for (const CSSSelector& selector : compound.selectors) {
+    if (!MatchSelector(selector, element, scope))
+      return false;
+  }
+  return true;
+}
+
+bool SelectorChecker::MatchSelector(const CSSSelector& selector, Element& element, const Element* scope) {
+  switch (selector.match) {
+    case CSSSelector::kTag: {
+      AtomicString local_name = element.localName();
+      return local_name == selector.value || local_name.ToLowerIfNecessary(element.ctx()) == selector.value;
+    }
+    case CSSSelector::kId:
+      return element.IdForTreeScope() == selector.value;
+    case CSSSelector::kClass:
+      return element.ClassNames().Contains(selector.value);
+    case CSSSelector::kPseudoClass:
+      return MatchPseudoClass(selector, element, scope);
+    default:
+      return MatchAttribute(selector, element);
+  }
+}
+
+bool SelectorChecker::MatchAttribute(const CSSSelector& selector, Element& element) {
+  ElementAttributes* attributes = element.attributesIfExists();
+  if (attributes == nullptr || !attributes->hasAttribute(selector.attribute, ASSERT_NO_EXCEPTION()))
+    return false;
+  if (selector.match == CSSSelector::kAttributeSet)
+    return true;
+
+  AtomicString value = attributes->GetAttributeWithoutFallback(selector.attribute);
+  if (selector.match == CSSSelector::kAttributeExact && !selector.attribute_case_insensitive)
+    return value == selector.value;
+
+  JSContext* ctx = element.ctx();
+  std::string actual = value.ToStdString(ctx);
+  std::string expected = selector.value.ToStdString(ctx);
+  if (selector.attribute_case_insensitive) {
+    std::transform(actual.begin(), actual.end(), actual.begin(),
+                   [](char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; });
+  }
+
+  switch (selector.match) {
+    case CSSSelector::kAttributeExact:
+      return actual == expected;
+    case CSSSelector::kAttributeList: {
+      if (expected.empty() || expected.find_first_of(" \t\n\r\f") != std::string::npos)
+        return false;
+      size_t start = 0;
+      while (start < actual.size()) {
+        size_t end = actual.find_first_of(" \t\n\r\f", start);
+        if (end == std::string::npos)
+          end = actual.size();
+        if (actual.compare(start, end - start, expected) == 0)
+          return true;
+        start = end + 1;
+      }
+      return false;
+    }
+    case CSSSelector::kAttributeHyphen:
+      return actual.compare(0, expected.size(), expected) == 0 &&
+             (actual.size() == expected.size() || actual[expected.size()] == '-');
+    case CSSSelector::kAttributeBegin:
+      return !expected.empty() && actual.compare(0, expected.size(), expected) == 0;
+    case CSSSelector::kAttributeEnd:
+      return !expected.empty() && actual.size() >= expected.size() &&
+             actual.compare(actual.size() - expected.size(), expected.size(), expected) == 0;
+    case CSSSelector::kAttributeContain:
+      return !expected.empty() && actual.find(expected) != std::string::npos;
+    default:
+      return false;
+  }
+}
+
+bool SelectorChecker::MatchPseudoClass(const CSSSelector& selector, Element& element, const Element* scope) {
+  switch (selector.pseudo) {
+    case CSSSelector::kPseudoRoot: {
+      ContainerNode* parent = element.parentNode();
+      return parent != nullptr && parent->IsDocumentNode();
+    }
+    case CSSSelector::kPseudoScope: {
+      if (scope != nullptr)
+        return &element == scope;
+      ContainerNode* parent = element.parentNode();
+      return parent != nullptr && parent->IsDocumentNode();
+    }
+    case CSSSelector::kPseudoEmpty:
+      for (Node* child = element.firstChild(); child != nullptr; child = child->nextSibling()) {
+        if (child->IsElementNode())
+          return false;
+        if (auto* text = DynamicTo<Text>(child)) {
+          if (!text->data().IsEmpty())
+            return false;
+        }
+      }
+      return true;
+    case CSSSelector::kPseudoLink:
+      return IsLink(element);
+    case CSSSelector::kPseudoFirstChild:
+      return ElementTraversal::PreviousSibling(element) == nullptr;
+    case CSSSelector::kPseudoLastChild:
+      return ElementTraversal::NextSibling(element) == nullptr;
+    case CSSSelector::kPseudoOnlyChild:
+      return ElementTraversal::PreviousSibling(element) == nullptr && ElementTraversal::NextSibling(element) == nullptr;
+    case CSSSelector::kPseudoFirstOfType:
+      return NthIndex<false>(element, [&element](Element& sibling) { return IsSameType(element, sibling); }) == 1;
+    case CSSSelector::kPseudoLastOfType:
+      return NthIndex<true>(element, [&element](Element& sibling) { return IsSameType(element, sibling); }) == 1;
+    case CSSSelector::kPseudoOnlyOfType:
+      return NthIndex<false>(element, [&element](Element& sibling) { return IsSameType(element, sibling); }) == 1 &&
+             NthIndex<true>(element, [&element](Element& sibling) { return IsSameType(element, sibling); }) == 1;
+    case CSSSelector::kPseudoNthChild:
+      return MatchesNth(NthIndex<false>(element, [](Element&) { return true; }), selector.nth_a, selector.nth_b);
+    case CSSSelector::kPseudoNthLastChild:
+      return MatchesNth(NthIndex<true>(element, [](Element&) { return true; }), selector.nth_a, selector.nth_b);
+    case CSSSelector::kPseudoNthOfType:
+      return MatchesNth(
+          NthIndex<false>(element, [&element](Element& sibling) { return IsSameType(element, sibling); }),
+          selector.nth_a, selector.nth_b);
+    case CSSSelector::kPseudoNthLastOfType:
+      return MatchesNth(NthIndex<true>(element, [&element](Element& sibling) { return IsSameType(element, sibling); }),
+                        selector.nth_a, selector.nth_b);
+    case CSSSelector::kPseudoNot:
+      return !Match(*selector.argument, element, scope);
+    case CSSSelector::kPseudoIs:
+      return Match(*selector.argument, element, scope);
+    case CSSSelector::kPseudoUnknown:
+      break;
+  }
+  return false;
+}
+
+}  // namespace webf
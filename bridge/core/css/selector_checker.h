@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_CSS_SELECTOR_CHECKER_H_
+#define BRIDGE_CORE_CSS_SELECTOR_CHECKER_H_
+
+#include "core/css/css_selector.h"
+
+namespace webf {
+
+class Element;
+
+// Matches parsed selectors against the DOM tree at C++ side, from the rightmost compound selector to the left.
+class SelectorChecker {
+ public:
+  // |scope| is the element :scope matches, :scope matches the root element when it is nullptr.
+  static bool Match(const CSSSelectorList& list, Element& element, const Element* scope);
+  static bool Match(const CSSComplexSelector& selector, Element& element, const Element* scope);
+
+ private:
+  static bool MatchFrom(const CSSComplexSelector& selector, size_t index, Element& element, const Element* scope);
+  static bool MatchCompound(const CSSCompoundSelector& compound, Element& element, const Element* scope);
+  static bool MatchSelector(const CSSSelector& selector, Element& element, const Element* scope);
+  static bool MatchAttribute(const CSSSelector& selector, Element& element);
+  static bool MatchPseudoClass(const CSSSelector& selector, Element& element, const Element* scope);
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_CSS_SELECTOR_CHECKER_H_
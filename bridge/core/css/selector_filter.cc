@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "selector_filter.h"
+#include "core/css/css_selector.h"
+#include "core/dom/element.h"
+
+namespace webf {
+
+void SelectorFilter::CollectIdentifierHashes(CSSComplexSelector& selector) {
+  std::vector<unsigned>& hashes = selector.ancestor_identifier_hashes;
+  hashes.clear();
+  // The compound selectors on the left of a descendant or a child combinator match ancestors of the element, or
+  // ancestors of its siblings, which are the same elements.
+  for (size_t i = 1; i < selector.compounds.size(); i++) {
+    CSSSelectorRelation relation = selector.compounds[i - 1].relation;
+    if (relation != CSSSelectorRelation::kDescendant && relation != CSSSelectorRelation::kChild)
+      continue;
+    for (const CSSSelector& simple : selector.compounds[i].selectors) {
+      if (hashes.size() == kMaximumIdentifierCount)
+        return;
+      switch (simple.match) {
+        case CSSSelector::kTag:
+          hashes.emplace_back(TagHash(simple.value));
+          break;
+        case CSSSelector::kId:
+          hashes.emplace_back(IdHash(simple.value));
+          break;
+        case CSSSelector::kClass:
+          hashes.emplace_back(ClassHash(simple.value));
+          break;
+        default:
+          break;
+      }
+    }
+  }
+}
+
+template <typename Function>
+void SelectorFilter::ForEachIdentifierHash(Element& element, Function function) {
+  function(TagHash(element.localName().ToLowerIfNecessary(element.ctx())));
+  AtomicString id = element.IdForTreeScope();
+  if (!id.IsEmpty()) {
+    function(IdHash(id));
+  }
+  const SpaceSplitString& class_names = element.ClassNames();
+  for (size_t i = 0; i < class_names.size(); i++) {
+    function(ClassHash(class_names[i]));
+  }
+}
+
+void SelectorFilter::PushParent(Element& parent) {
+  ForEachIdentifierHash(parent, [this](unsigned hash) { Add(hash); });
+}
+
+void SelectorFilter::PopParent(Element& parent) {
+  ForEachIdentifierHash(parent, [this](unsigned hash) { Remove(hash); });
+}
+
+bool SelectorFilter::FastRejectSelector(const CSSComplexSelector& selector) const {
+  for (unsigned hash : selector.ancestor_identifier_hashes) {
+    if (!MayContain(hash))
+      return true;
+  }
+  return false;
+}
+
+void SelectorFilter::Add(unsigned hash) {
+  uint8_t& first = counts_[hash & kKeyMask];
+  if (first != UINT8_MAX)
+    first++;
+  uint8_t& second = counts_[(hash >> kKeyBits) & kKeyMask];
+  if (second != UINT8_MAX)
+    second++;
+}
+
+void SelectorFilter::Remove(unsigned hash) {
+  uint8_t& first = counts_[hash & kKeyMask];
+  if (first != UINT8_MAX)
+    first--;
+  uint8_t& second = counts_[(hash >> kKeyBits) & kKeyMask];
+  if (second != UINT8_MAX)
+    second--;
+}
+
+}  // namespace webf
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_CSS_SELECTOR_FILTER_H_
+#define BRIDGE_CORE_CSS_SELECTOR_FILTER_H_
+
+#include <array>
+#include <cinttypes>
+#include <vector>
+#include "bindings/qjs/atomic_string.h"
+
+namespace webf {
+
+class Element;
+struct CSSComplexSelector;
+
+// A counting bloom filter of the tag names, ids and classes of the ancestors of the elements being matched. Selectors
+// which require an ancestor the filter has never seen are rejected without walking up the tree.
+class SelectorFilter {
+ public:
+  // At most this many hashes are collected for a selector, checking more rarely rejects more.
+  static constexpr size_t kMaximumIdentifierCount = 4;
+
+  static unsigned TagHash(const AtomicString& tag_name) { return Hash(tag_name, kTagSalt); }
+  static unsigned IdHash(const AtomicString& id) { return Hash(id, kIdSalt); }
+  static unsigned ClassHash(const AtomicString& class_name) { return Hash(class_name, kClassSalt); }
+
+  // Fills CSSComplexSelector::ancestor_identifier_hashes.
+  static void CollectIdentifierHashes(CSSComplexSelector& selector);
+
+  void PushParent(Element& parent);
+  void PopParent(Element& parent);
+
+  // False positives are possible, false negatives are not.
+  bool FastRejectSelector(const CSSComplexSelector& selector) const;
+
+ private:
+  static constexpr unsigned kTagSalt = 13;
+  static constexpr unsigned kIdSalt = 17;
+  static constexpr unsigned kClassSalt = 19;
+  static constexpr unsigned kKeyBits = 12;
+  static constexpr unsigned kKeyMask = (1 << kKeyBits) - 1;
+
+  static unsigned Hash(const AtomicString& string, unsigned salt) {
+    // Spread the atom over the bits, atoms of strings created together are close to each other.
+    uint32_t hash = static_cast<uint32_t>(string.Impl()) * salt;
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    return hash;
+  }
+
+  template <typename Function>
+  void ForEachIdentifierHash(Element& element, Function function);
+
+  void Add(unsigned hash);
+  void Remove(unsigned hash);
+  bool MayContain(unsigned hash) const {
+    return counts_[hash & kKeyMask] && counts_[(hash >> kKeyBits) & kKeyMask];
+  }
+
+  // Saturated counts stay at the maximum, which only costs false positives.
+  std::array<uint8_t, 1 << kKeyBits> counts_{};
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_CSS_SELECTOR_FILTER_H_
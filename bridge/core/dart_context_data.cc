@@ -7,7 +7,8 @@
 namespace webf {
 
 const WidgetElementShape* DartContextData::GetWidgetElementShape(const AtomicString& key) {
-  return widget_element_shapes_[key].get();
+  auto it = widget_element_shapes_.find(key);
+  return it != widget_element_shapes_.end() ? it->second.get() : nullptr;
 }
 
 bool DartContextData::HasWidgetElementShape(const AtomicString& key) {
@@ -11,10 +11,22 @@
 
 namespace webf {
 
+// How a WidgetElement caches the value of a property at C++ side, declared by the property in dart side.
+enum class WidgetPropertyCachePolicy : int32_t {
+  // Every read goes to dart side.
+  kNone = 0,
+  // Read from dart side once, the value only changes when JS sets the property.
+  kImmutable = 1,
+  // Read again once a ui command which may change the layout was recorded or dart side called in.
+  kInvalidateOnCommand = 2,
+};
+
 struct WidgetElementShape {
   std::set<AtomicString> built_in_properties_;
   std::set<AtomicString> built_in_methods_;
   std::set<AtomicString> built_in_async_methods_;
+  // Properties without an entry use WidgetPropertyCachePolicy::kNone.
+  std::unordered_map<AtomicString, WidgetPropertyCachePolicy, AtomicString::KeyHasher> property_cache_policies_;
 };
 
 class DartContextData {
@@ -25,9 +37,10 @@ class DartContextData {
 
  private:
   // WidgetElements' properties and methods are defined in the dart Side.
-  // When a new kind of WidgetElement first created, Dart code will sync properties and methods to C++ code to generate
-  // prop getter and setter and functions for JS code. This map store the properties and methods of WidgetElement which
-  // already created.
+  // Dart code syncs properties and methods of every kind of WidgetElement to C++ code when a page is allocated or the
+  // custom element is defined later, so JS code can use them without flushing. Kinds which dart side failed to describe
+  // ahead are synced when their first element is created. This map store the properties and methods of WidgetElement
+  // which already synced.
   std::unordered_map<AtomicString, std::shared_ptr<WidgetElementShape>, AtomicString::KeyHasher> widget_element_shapes_;
 };
 
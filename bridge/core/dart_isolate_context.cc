@@ -3,6 +3,7 @@
  */
 
 #include "dart_isolate_context.h"
+#include <algorithm>
 #include <set>
 #include "defined_properties_initializer.h"
 #include "event_factory.h"
@@ -35,6 +36,8 @@ static void ClearUpWires() {
   alive_wires.clear();
 }
 
+thread_local std::unique_ptr<DartContextData> DartIsolateContext::data_{nullptr};
+
 const std::unique_ptr<DartContextData>& DartIsolateContext::EnsureData() const {
   if (data_ == nullptr) {
     data_ = std::make_unique<DartContextData>();
@@ -53,10 +56,39 @@ void InitializeBuiltInStrings(JSContext* ctx) {
   }
 }
 
-DartIsolateContext::DartIsolateContext(const uint64_t* dart_methods, int32_t dart_methods_length)
+DartIsolateContext::DartIsolateContext(const uint64_t* dart_methods,
+                                       int32_t dart_methods_length,
+                                       Dart_Port js_thread_port,
+                                       int32_t js_thread_count)
     : is_valid_(true),
       running_thread_(std::this_thread::get_id()),
       dart_method_ptr_(std::make_unique<DartMethodPointer>(dart_methods, dart_methods_length)) {
+  if (js_thread_port == ILLEGAL_PORT) {
+    InitializeJSRuntime();
+    return;
+  }
+
+  dispatcher_ = std::make_unique<JSThreadDispatcher>(js_thread_port, std::max(js_thread_count, 1));
+  dart_method_ptr_->ForwardToDartThread(dispatcher_.get());
+  // The JS threads are initialized one after another, class ids are allocated from a global counter of quickjs.
+  dispatcher_->PostToAllJSThreadsSync([this]() {
+    InitializeJSRuntime();
+    dart_method_ptr_->AttachToJSThread();
+  });
+}
+
+DartIsolateContext::~DartIsolateContext() {
+  is_valid_ = false;
+  if (dispatcher_ == nullptr) {
+    DisposeJSRuntime();
+    return;
+  }
+
+  // The runtimes and the pages belong to the JS threads.
+  dispatcher_->Dispose([this]() { DisposeJSRuntime(); });
+}
+
+void DartIsolateContext::InitializeJSRuntime() {
   if (runtime_ == nullptr) {
     runtime_ = JS_NewRuntime();
   }
@@ -68,12 +100,22 @@ DartIsolateContext::DartIsolateContext(const uint64_t* dart_methods, int32_t dar
     JSClassID id{0};
     JS_NewClassID(&id);
   }
-  is_valid_ = true;
 }
 
-DartIsolateContext::~DartIsolateContext() {
-  is_valid_ = false;
-  pages_.clear();
+void DartIsolateContext::DisposeJSRuntime() {
+  std::set<std::unique_ptr<WebFPage>> pages;
+  {
+    std::lock_guard<std::mutex> guard(pages_mutex_);
+    for (auto it = pages_.begin(); it != pages_.end();) {
+      if ((*it)->currentThread() == std::this_thread::get_id()) {
+        pages.insert(pages_.extract(it++));
+      } else {
+        ++it;
+      }
+    }
+  }
+  // Pages are disposed outside the lock, disposing a page may call back into this context.
+  pages.clear();
   running_isolates_--;
 
   if (running_isolates_ == 0) {
@@ -91,16 +133,22 @@ DartIsolateContext::~DartIsolateContext() {
 }
 
 void DartIsolateContext::AddNewPage(std::unique_ptr<WebFPage>&& new_page) {
+  std::lock_guard<std::mutex> guard(pages_mutex_);
   pages_.insert(std::move(new_page));
 }
 
 void DartIsolateContext::RemovePage(const webf::WebFPage* page) {
-  for (auto it = pages_.begin(); it != pages_.end(); ++it) {
-    if (it->get() == page) {
-      pages_.erase(it);
-      break;
+  std::unique_ptr<WebFPage> removed;
+  {
+    std::lock_guard<std::mutex> guard(pages_mutex_);
+    for (auto it = pages_.begin(); it != pages_.end(); ++it) {
+      if (it->get() == page) {
+        removed = std::move(pages_.extract(it).value());
+        break;
+      }
     }
   }
+  // |removed| is disposed outside the lock.
 }
 
 }  // namespace webf
\ No newline at end of file
@@ -5,10 +5,12 @@
 #ifndef WEBF_DART_CONTEXT_H_
 #define WEBF_DART_CONTEXT_H_
 
+#include <mutex>
 #include <set>
 #include "bindings/qjs/script_value.h"
 #include "dart_context_data.h"
 #include "dart_methods.h"
+#include "js_thread_dispatcher.h"
 
 namespace webf {
 
@@ -17,6 +19,7 @@ class DartIsolateContext;
 
 struct DartWireContext {
   ScriptValue jsObject;
+  int64_t context_id{0};
 };
 
 void InitializeBuiltInStrings(JSContext* ctx);
@@ -26,17 +29,25 @@ bool IsDartWireAlive(DartWireContext* wire);
 void DeleteDartWire(DartWireContext* wire);
 
 // DartIsolateContext has a 1:1 correspondence with a dart isolates.
+// JS runs on the dart thread, or on a pool of dedicated JS threads with one JSRuntime each when a port to notify the
+// dart thread is given, see JSThreadDispatcher.
 class DartIsolateContext {
  public:
-  explicit DartIsolateContext(const uint64_t* dart_methods, int32_t dart_methods_length);
+  explicit DartIsolateContext(const uint64_t* dart_methods,
+                              int32_t dart_methods_length,
+                              Dart_Port js_thread_port = ILLEGAL_PORT,
+                              int32_t js_thread_count = 1);
 
   FORCE_INLINE JSRuntime* runtime() { return runtime_; }
-  FORCE_INLINE bool valid() { return is_valid_ && std::this_thread::get_id() == running_thread_; }
+  // nullptr when JS runs on the dart thread.
+  FORCE_INLINE JSThreadDispatcher* dispatcher() const { return dispatcher_.get(); }
+  FORCE_INLINE bool valid() { return is_valid_ && IsRunningThread(); }
   FORCE_INLINE const std::unique_ptr<DartMethodPointer>& dartMethodPtr() const {
-    assert(std::this_thread::get_id() == running_thread_);
+    assert(IsRunningThread());
     return dart_method_ptr_;
   }
 
+  // The data of the JSRuntime running on the current thread.
   const std::unique_ptr<DartContextData>& EnsureData() const;
 
   void AddNewPage(std::unique_ptr<WebFPage>&& new_page);
@@ -45,13 +56,22 @@ class DartIsolateContext {
   ~DartIsolateContext();
 
  private:
+  void InitializeJSRuntime();
+  void DisposeJSRuntime();
+  FORCE_INLINE bool IsRunningThread() const {
+    return dispatcher_ != nullptr ? dispatcher_->IsJSThread() : std::this_thread::get_id() == running_thread_;
+  }
+
   int is_valid_{false};
+  // Pages of all the JS threads, each thread only touches its own ones.
+  std::mutex pages_mutex_;
   std::set<std::unique_ptr<WebFPage>> pages_;
   std::thread::id running_thread_;
-  mutable std::unique_ptr<DartContextData> data_;
+  static thread_local std::unique_ptr<DartContextData> data_;
   static thread_local JSRuntime* runtime_;
   // Dart methods ptr should keep alive when ExecutingContext is disposing.
   const std::unique_ptr<DartMethodPointer> dart_method_ptr_ = nullptr;
+  std::unique_ptr<JSThreadDispatcher> dispatcher_;
 };
 
 }  // namespace webf
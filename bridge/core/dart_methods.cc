@@ -5,9 +5,41 @@
 
 #include "dart_methods.h"
 #include <cassert>
+#include "core/js_thread_dispatcher.h"
 
 namespace webf {
 
+struct DartThreadMethods {
+  JSThreadDispatcher* dispatcher;
+  // The methods implemented at dart side, which are only callable on the dart thread.
+  DartMethodPointer methods;
+};
+
+namespace {
+
+thread_local DartThreadMethods* dart_thread_methods{nullptr};
+
+template <typename Method, Method DartMethodPointer::*field>
+struct DartThreadTrampoline;
+
+// Calls the dart method on the dart thread and waits for its result.
+template <typename R, typename... Args, R (*DartMethodPointer::*field)(Args...)>
+struct DartThreadTrampoline<R (*)(Args...), field> {
+  static R Call(Args... args) {
+    DartThreadMethods* dart_thread = dart_thread_methods;
+    return dart_thread->dispatcher->PostToDartSync<R>([&]() { return (dart_thread->methods.*field)(args...); });
+  }
+};
+
+// Nothing is waiting for the new frame, so the request is not blocking.
+void RequestBatchUpdateOnDartThread(int32_t context_id) {
+  DartThreadMethods* dart_thread = dart_thread_methods;
+  RequestBatchUpdate request_batch_update = dart_thread->methods.requestBatchUpdate;
+  dart_thread->dispatcher->PostToDart([request_batch_update, context_id]() { request_batch_update(context_id); });
+}
+
+}  // namespace
+
 webf::DartMethodPointer::DartMethodPointer(const uint64_t* dart_methods, int32_t dart_methods_length) {
   size_t i = 0;
   invokeModule = reinterpret_cast<InvokeModule>(dart_methods[i++]);
@@ -20,7 +52,6 @@ webf::DartMethodPointer::DartMethodPointer(const uint64_t* dart_methods, int32_t
   cancelAnimationFrame = reinterpret_cast<CancelAnimationFrame>(dart_methods[i++]);
   toBlob = reinterpret_cast<ToBlob>(dart_methods[i++]);
   flushUICommand = reinterpret_cast<FlushUICommand>(dart_methods[i++]);
-  create_binding_object = reinterpret_cast<CreateBindingObject>(dart_methods[i++]);
 
 #if ENABLE_PROFILE
   getPerformanceEntries = reinterpret_cast<GetPerformanceEntries>(dart_methods[i++]);
@@ -33,4 +64,41 @@ webf::DartMethodPointer::DartMethodPointer(const uint64_t* dart_methods, int32_t
 
   assert_m(i == dart_methods_length, "Dart native methods count is not equal with C++ side method registrations.");
 }
+
+#define FORWARD_TO_DART_THREAD(method) \
+  if (method != nullptr)               \
+    method = DartThreadTrampoline<decltype(DartMethodPointer::method), &DartMethodPointer::method>::Call;
+
+void DartMethodPointer::ForwardToDartThread(JSThreadDispatcher* dispatcher) {
+  dart_thread_methods_ = std::make_shared<DartThreadMethods>(DartThreadMethods{dispatcher, *this});
+
+  FORWARD_TO_DART_THREAD(invokeModule);
+  FORWARD_TO_DART_THREAD(reloadApp);
+  FORWARD_TO_DART_THREAD(setTimeout);
+  FORWARD_TO_DART_THREAD(setInterval);
+  FORWARD_TO_DART_THREAD(clearTimeout);
+  FORWARD_TO_DART_THREAD(requestAnimationFrame);
+  FORWARD_TO_DART_THREAD(cancelAnimationFrame);
+  FORWARD_TO_DART_THREAD(toBlob);
+  FORWARD_TO_DART_THREAD(onJsError);
+  FORWARD_TO_DART_THREAD(onJsLog);
+  FORWARD_TO_DART_THREAD(matchImageSnapshot);
+  FORWARD_TO_DART_THREAD(matchImageSnapshotBytes);
+  FORWARD_TO_DART_THREAD(environment);
+  FORWARD_TO_DART_THREAD(simulatePointer);
+  FORWARD_TO_DART_THREAD(simulateInputText);
+  FORWARD_TO_DART_THREAD(flushUICommand);
+#if ENABLE_PROFILE
+  FORWARD_TO_DART_THREAD(getPerformanceEntries);
+#endif
+  if (requestBatchUpdate != nullptr)
+    requestBatchUpdate = RequestBatchUpdateOnDartThread;
+}
+
+void DartMethodPointer::AttachToJSThread() {
+  dart_thread_methods = dart_thread_methods_.get();
+}
+
+#undef FORWARD_TO_DART_THREAD
+
 }  // namespace webf
@@ -24,6 +24,9 @@
 
 namespace webf {
 
+class JSThreadDispatcher;
+struct DartThreadMethods;
+
 using AsyncCallback = void (*)(void* callback_context, int32_t context_id, const char* errmsg);
 using AsyncRAFCallback = void (*)(void* callback_context, int32_t context_id, double result, const char* errmsg);
 using AsyncModuleCallback = NativeValue* (*)(void* callback_context,
@@ -53,8 +56,6 @@ typedef void (*ToBlob)(void* callback_context,
 typedef void (*OnJSError)(int32_t context_id, const char*);
 typedef void (*OnJSLog)(int32_t context_id, int32_t level, const char*);
 typedef void (*FlushUICommand)(int32_t context_id);
-typedef void (
-    *CreateBindingObject)(int32_t context_id, void* native_binding_object, int32_t type, void* args, int32_t argc);
 
 using MatchImageSnapshotCallback = void (*)(void* callback_context, int32_t context_id, int8_t, const char* errmsg);
 using MatchImageSnapshot = void (*)(void* callback_context,
@@ -97,6 +98,11 @@ struct DartMethodPointer {
   DartMethodPointer() = delete;
   explicit DartMethodPointer(const uint64_t* dart_methods, int32_t dartMethodsLength);
 
+  // Replace the methods with the ones calling dart side on the dart thread. They are callable on the JS threads which
+  // called AttachToJSThread().
+  void ForwardToDartThread(JSThreadDispatcher* dispatcher);
+  void AttachToJSThread();
+
   InvokeModule invokeModule{nullptr};
   RequestBatchUpdate requestBatchUpdate{nullptr};
   ReloadApp reloadApp{nullptr};
@@ -114,10 +120,12 @@ struct DartMethodPointer {
   SimulatePointer simulatePointer{nullptr};
   SimulateInputText simulateInputText{nullptr};
   FlushUICommand flushUICommand{nullptr};
-  CreateBindingObject create_binding_object{nullptr};
 #if ENABLE_PROFILE
   GetPerformanceEntries getPerformanceEntries{nullptr};
 #endif
+
+ private:
+  std::shared_ptr<DartThreadMethods> dart_thread_methods_;
 };
 
 }  // namespace webf
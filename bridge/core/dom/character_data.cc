@@ -13,10 +13,9 @@ namespace webf {
 void CharacterData::setData(const AtomicString& data, ExceptionState& exception_state) {
   data_ = data;
 
-  std::unique_ptr<SharedNativeString> args_01 = data.ToNativeString(ctx());
-  std::unique_ptr<SharedNativeString> args_02 = stringToNativeString("data");
-  GetExecutingContext()->uiCommandBuffer()->addCommand(UICommand::kSetAttribute, std::move(args_01),
-                                                       (void*)bindingObject(), args_02.release());
+  auto* buffer = GetExecutingContext()->uiCommandBuffer();
+  buffer->addCommand(UICommand::kSetAttribute, buffer->NewString(data), (void*)bindingObject(),
+                     buffer->NewString("data"));
 }
 
 AtomicString CharacterData::nodeValue() const {
@@ -0,0 +1,16 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "class_collection.h"
+
+namespace webf {
+
+ClassCollection::ClassCollection(ContainerNode& root_node, CollectionType type, const AtomicString& class_names)
+    : HTMLCollection(root_node, kClassCollectionType), class_names_(root_node.ctx(), class_names) {
+  assert(type == kClassCollectionType);
+}
+
+ClassCollection::~ClassCollection() = default;
+
+}  // namespace webf
@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_DOM_CLASS_COLLECTION_H_
+#define BRIDGE_CORE_DOM_CLASS_COLLECTION_H_
+
+#include "core/dom/element.h"
+#include "core/dom/space_split_string.h"
+#include "core/html/html_collection.h"
+
+namespace webf {
+
+// The live collection returned by getElementsByClassName().
+class ClassCollection final : public HTMLCollection {
+ public:
+  // classNames argument is an AtomicString because it is common for Elements
+  // to share the same class names.
+  ClassCollection(ContainerNode& root_node, CollectionType type, const AtomicString& class_names);
+  ~ClassCollection() override;
+
+  bool ElementMatches(const Element& element) const {
+    // https://dom.spec.whatwg.org/#concept-getelementsbyclassname: an empty set of classes matches nothing.
+    if (class_names_.IsNull())
+      return false;
+    return element.ClassNames().ContainsAll(class_names_);
+  }
+
+ private:
+  SpaceSplitString class_names_;
+};
+
+template <>
+struct DowncastTraits<ClassCollection> {
+  static bool AllowFrom(const LiveNodeListBase& collection) {
+    return collection.GetType() == kClassCollectionType;
+  }
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_DOM_CLASS_COLLECTION_H_
@@ -451,9 +451,8 @@ void ContainerNode::InsertBeforeCommon(Node& next_child, Node& new_child) {
   new_child.SetPreviousSibling(prev);
   new_child.SetNextSibling(&next_child);
 
-  std::unique_ptr<SharedNativeString> args_01 = stringToNativeString("beforebegin");
-  GetExecutingContext()->uiCommandBuffer()->addCommand(UICommand::kInsertAdjacentNode, std::move(args_01),
-                                                       next_child.bindingObject(), new_child.bindingObject());
+  GetExecutingContext()->uiCommandBuffer()->addInternedCommand(UICommand::kInsertAdjacentNode, "beforebegin",
+                                                               next_child.bindingObject(), new_child.bindingObject());
 }
 
 void ContainerNode::AppendChildCommon(Node& child) {
@@ -466,9 +465,8 @@ void ContainerNode::AppendChildCommon(Node& child) {
   }
   SetLastChild(&child);
 
-  std::unique_ptr<SharedNativeString> args_01 = stringToNativeString("beforeend");
-  GetExecutingContext()->uiCommandBuffer()->addCommand(UICommand::kInsertAdjacentNode, std::move(args_01),
-                                                       bindingObject(), child.bindingObject());
+  GetExecutingContext()->uiCommandBuffer()->addInternedCommand(UICommand::kInsertAdjacentNode, "beforeend",
+                                                               bindingObject(), child.bindingObject());
 }
 
 void ContainerNode::NotifyNodeInsertedInternal(Node& root) {
@@ -493,6 +491,8 @@ void ContainerNode::NotifyNodeRemoved(Node& root) {
 }
 
 void ContainerNode::ChildrenChanged(const webf::ContainerNode::ChildrenChange& change) {
+  if (change.affects_elements == ChildrenChangeAffectsElements::kYes)
+    GetDocument().IncDOMTreeVersion();
   InvalidateNodeListCachesInAncestors(&change);
 }
 
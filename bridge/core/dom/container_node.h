@@ -147,6 +147,8 @@ class ContainerNode : public Node {
   // Utility functions for NodeListsNodeData API.
   template <typename Collection>
   Collection* EnsureCachedCollection(CollectionType);
+  template <typename Collection>
+  Collection* EnsureCachedCollection(CollectionType, const AtomicString& name);
 
   void Trace(GCVisitor* visitor) const override;
 
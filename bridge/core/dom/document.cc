@@ -5,10 +5,13 @@
 #include "document.h"
 #include "binding_call_methods.h"
 #include "bindings/qjs/exception_message.h"
+#include "core/dom/class_collection.h"
 #include "core/dom/comment.h"
 #include "core/dom/document_fragment.h"
 #include "core/dom/element.h"
 #include "core/dom/events/event_target.h"
+#include "core/dom/name_node_list.h"
+#include "core/dom/tag_collection.h"
 #include "core/dom/text.h"
 #include "core/frame/window.h"
 #include "core/html/custom/widget_element.h"
@@ -163,6 +166,9 @@ bool Document::ChildTypeAllowed(NodeType type) const {
 }
 
 Element* Document::querySelector(const AtomicString& selectors, ExceptionState& exception_state) {
+  if (SelectorQuery* query = selector_query_cache_.Add(ctx(), selectors)) {
+    return query->QueryFirst(*this);
+  }
   NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), selectors)};
   NativeValue result = InvokeBindingMethod(binding_call_methods::kquerySelector, 1, arguments, exception_state);
   if (exception_state.HasException()) {
@@ -172,6 +178,9 @@ Element* Document::querySelector(const AtomicString& selectors, ExceptionState&
 }
 
 std::vector<Element*> Document::querySelectorAll(const AtomicString& selectors, ExceptionState& exception_state) {
+  if (SelectorQuery* query = selector_query_cache_.Add(ctx(), selectors)) {
+    return query->QueryAll(*this);
+  }
   NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), selectors)};
   NativeValue result = InvokeBindingMethod(binding_call_methods::kquerySelectorAll, 1, arguments, exception_state);
   if (exception_state.HasException()) {
@@ -181,41 +190,19 @@ std::vector<Element*> Document::querySelectorAll(const AtomicString& selectors,
 }
 
 Element* Document::getElementById(const AtomicString& id, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), id)};
-  NativeValue result = InvokeBindingMethod(binding_call_methods::kgetElementById, 1, arguments, exception_state);
-  if (exception_state.HasException()) {
-    return {};
-  }
-  return NativeValueConverter<NativeTypePointer<Element>>::FromNativeValue(ctx(), result);
+  return TreeScope::getElementById(id);
 }
 
-std::vector<Element*> Document::getElementsByClassName(const AtomicString& class_name,
-                                                       ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), class_name)};
-  NativeValue result =
-      InvokeBindingMethod(binding_call_methods::kgetElementsByClassName, 1, arguments, exception_state);
-  if (exception_state.HasException()) {
-    return {};
-  }
-  return NativeValueConverter<NativeTypeArray<NativeTypePointer<Element>>>::FromNativeValue(ctx(), result);
+HTMLCollection* Document::getElementsByClassName(const AtomicString& class_name, ExceptionState& exception_state) {
+  return EnsureCachedCollection<ClassCollection>(kClassCollectionType, class_name);
 }
 
-std::vector<Element*> Document::getElementsByTagName(const AtomicString& tag_name, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), tag_name)};
-  NativeValue result = InvokeBindingMethod(binding_call_methods::kgetElementsByTagName, 1, arguments, exception_state);
-  if (exception_state.HasException()) {
-    return {};
-  }
-  return NativeValueConverter<NativeTypeArray<NativeTypePointer<Element>>>::FromNativeValue(ctx(), result);
+HTMLCollection* Document::getElementsByTagName(const AtomicString& tag_name, ExceptionState& exception_state) {
+  return EnsureCachedCollection<TagCollection>(kTagCollectionType, tag_name);
 }
 
-std::vector<Element*> Document::getElementsByName(const AtomicString& name, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), name)};
-  NativeValue result = InvokeBindingMethod(binding_call_methods::kgetElementsByName, 1, arguments, exception_state);
-  if (exception_state.HasException()) {
-    return {};
-  }
-  return NativeValueConverter<NativeTypeArray<NativeTypePointer<Element>>>::FromNativeValue(ctx(), result);
+NodeList* Document::getElementsByName(const AtomicString& name, ExceptionState& exception_state) {
+  return EnsureCachedCollection<NameNodeList>(kNameNodeListType, name);
 }
 
 Element* Document::elementFromPoint(double x, double y, ExceptionState& exception_state) {
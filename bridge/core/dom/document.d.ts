@@ -8,6 +8,8 @@ import {HTMLHtmlElement} from "../html/html_html_element";
 import {Element} from "./element";
 import {Event} from "./events/event";
 import {HTMLAllCollection} from "../html/html_all_collection";
+import {HTMLCollection} from "../html/html_collection";
+import {NodeList} from "./node_list";
 import {IDLEventHandler} from "../frame/window_event_handlers";
 import {Window} from "../frame/window";
 import {ParentNode} from "./parent_node";
@@ -36,9 +38,9 @@ interface Document extends Node, ParentNode {
   createEvent(event_type: string): Event;
 
   getElementById(id: string): Element | null;
-  getElementsByClassName(className: string) : Element[];
-  getElementsByTagName(tagName: string): Element[];
-  getElementsByName(name: string): Element[];
+  getElementsByClassName(className: string) : HTMLCollection;
+  getElementsByTagName(tagName: string): HTMLCollection;
+  getElementsByName(name: string): NodeList;
 
   querySelector(selectors: string): Element | null;
   querySelectorAll(selectors: string): Element[];
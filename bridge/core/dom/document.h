@@ -9,6 +9,7 @@
 #include "container_node.h"
 #include "event_type_names.h"
 #include "scripted_animation_controller.h"
+#include "selector_query.h"
 #include "tree_scope.h"
 
 namespace webf {
@@ -17,6 +18,8 @@ class HTMLBodyElement;
 class HTMLHeadElement;
 class HTMLHtmlElement;
 class HTMLAllCollection;
+class HTMLCollection;
+class NodeList;
 class Text;
 class Comment;
 
@@ -67,9 +70,9 @@ class Document : public ContainerNode, public TreeScope {
   std::vector<Element*> querySelectorAll(const AtomicString& selectors, ExceptionState& exception_state);
 
   Element* getElementById(const AtomicString& id, ExceptionState& exception_state);
-  std::vector<Element*> getElementsByClassName(const AtomicString& class_name, ExceptionState& exception_state);
-  std::vector<Element*> getElementsByTagName(const AtomicString& tag_name, ExceptionState& exception_state);
-  std::vector<Element*> getElementsByName(const AtomicString& name, ExceptionState& exception_state);
+  HTMLCollection* getElementsByClassName(const AtomicString& class_name, ExceptionState& exception_state);
+  HTMLCollection* getElementsByTagName(const AtomicString& tag_name, ExceptionState& exception_state);
+  NodeList* getElementsByName(const AtomicString& name, ExceptionState& exception_state);
 
   Element* elementFromPoint(double x, double y, ExceptionState& exception_state);
 
@@ -107,9 +110,16 @@ class Document : public ContainerNode, public TreeScope {
   }
   int NodeCount() const { return node_count_; }
 
+  // Bumped by every change which may affect the content of live collections: element insertions and removals, and
+  // changes of the class or name attribute. Live collections drop their cached items when the version they were
+  // evaluated at is stale.
+  uint64_t DomTreeVersion() const { return dom_tree_version_; }
+  void IncDOMTreeVersion() { dom_tree_version_++; }
+
   uint32_t RequestAnimationFrame(const std::shared_ptr<FrameCallback>& callback, ExceptionState& exception_state);
   void CancelAnimationFrame(uint32_t request_id, ExceptionState& exception_state);
   ScriptAnimationController* script_animations() { return &script_animation_controller_; };
+  SelectorQueryCache& GetSelectorQueryCache() { return selector_query_cache_; }
 
   // Helper functions for forwarding LocalDOMWindow event related tasks to the
   // LocalDOMWindow if it exists.
@@ -122,7 +132,9 @@ class Document : public ContainerNode, public TreeScope {
 
  private:
   int node_count_{0};
+  uint64_t dom_tree_version_{0};
   ScriptAnimationController script_animation_controller_;
+  SelectorQueryCache selector_query_cache_;
 };
 
 template <>
@@ -191,3 +191,36 @@ TEST(document, all) {
   EXPECT_EQ(errorCalled, false);
   EXPECT_EQ(logCalled, true);
 }
+
+TEST(document, getElementById) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "true true true true true true");
+  };
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->GetExecutingContext();
+  const char* code =
+      "let a = document.createElement('div');"
+      "a.id = 'box';"
+      "let detached = document.getElementById('box') === null;"
+      "document.body.appendChild(a);"
+      "let inserted = document.getElementById('box') === a;"
+      "let b = document.createElement('div');"
+      "b.innerHTML = '<span id=\"box\"></span>';"
+      "document.body.insertBefore(b, a);"
+      "let first = document.getElementById('box') === b.firstChild;"
+      "b.firstChild.setAttribute('id', 'inner');"
+      "let renamed = document.getElementById('box') === a && document.getElementById('inner') === b.firstChild;"
+      "document.body.removeChild(a);"
+      "let removed = document.getElementById('box') === null;"
+      "b.firstChild.removeAttribute('id');"
+      "console.log(detached, inserted, first, renamed, removed, document.getElementById('inner') === null);";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
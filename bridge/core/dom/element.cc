@@ -3,13 +3,16 @@
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
 #include "element.h"
+#include <algorithm>
 #include <utility>
 #include "binding_call_methods.h"
 #include "bindings/qjs/exception_state.h"
 #include "bindings/qjs/script_promise.h"
 #include "bindings/qjs/script_promise_resolver.h"
 #include "built_in_string.h"
+#include "class_collection.h"
 #include "comment.h"
+#include "core/dom/document.h"
 #include "core/dom/document_fragment.h"
 #include "core/fileapi/blob.h"
 #include "core/html/html_template_element.h"
@@ -19,6 +22,7 @@
 #include "foundation/native_value_converter.h"
 #include "html_element_type_helper.h"
 #include "qjs_element.h"
+#include "tag_collection.h"
 #include "text.h"
 
 namespace webf {
@@ -31,16 +35,14 @@ Element::Element(const AtomicString& namespace_uri,
     : ContainerNode(document, construction_type), local_name_(local_name), namespace_uri_(namespace_uri) {
   auto buffer = GetExecutingContext()->uiCommandBuffer();
   if (namespace_uri == element_namespace_uris::khtml) {
-    buffer->addCommand(UICommand::kCreateElement, std::move(local_name.ToNativeString(ctx())), (void*)bindingObject(),
-                       nullptr);
+    buffer->addInternedCommand(UICommand::kCreateElement, local_name, (void*)bindingObject(), nullptr);
   } else if (namespace_uri == element_namespace_uris::ksvg) {
     // TODO: SVG element
-    buffer->addCommand(UICommand::kCreateSVGElement, std::move(local_name.ToNativeString(ctx())),
-                       (void*)bindingObject(), nullptr);
+    buffer->addInternedCommand(UICommand::kCreateSVGElement, local_name, (void*)bindingObject(), nullptr);
   } else {
     // TODO: Unknown namespace uri
-    buffer->addCommand(UICommand::kCreateElementNS, std::move(local_name.ToNativeString(ctx())), (void*)bindingObject(),
-                       namespace_uri.ToNativeString(ctx()).release());
+    buffer->addInternedCommand(UICommand::kCreateElementNS, local_name, (void*)bindingObject(),
+                               buffer->NewString(namespace_uri));
   }
 }
 
@@ -84,10 +86,62 @@ void Element::removeAttribute(const AtomicString& name, ExceptionState& exceptio
 }
 
 BoundingClientRect* Element::getBoundingClientRect(ExceptionState& exception_state) {
-  GetExecutingContext()->FlushUICommand();
-  NativeValue result = InvokeBindingMethod(binding_call_methods::kgetBoundingClientRect, 0, nullptr, exception_state);
-  return BoundingClientRect::Create(
-      GetExecutingContext(), NativeValueConverter<NativeTypePointer<NativeBindingObject>>::FromNativeValue(result));
+  const ElementLayoutMetrics* metrics = EnsureLayoutMetrics(exception_state);
+  if (metrics == nullptr) {
+    return nullptr;
+  }
+  return BoundingClientRect::Create(GetExecutingContext(), metrics->Get(LayoutMetric::kBoundingClientRectX),
+                                    metrics->Get(LayoutMetric::kBoundingClientRectY),
+                                    metrics->Get(LayoutMetric::kBoundingClientRectWidth),
+                                    metrics->Get(LayoutMetric::kBoundingClientRectHeight));
+}
+
+const ElementLayoutMetrics* Element::EnsureLayoutMetrics(ExceptionState& exception_state) {
+  UICommandBuffer* buffer = GetExecutingContext()->uiCommandBuffer();
+  if (layout_metrics_ != nullptr && layout_metrics_->generation == buffer->layoutGeneration()) {
+    return layout_metrics_.get();
+  }
+
+  if (layout_metrics_ == nullptr) {
+    layout_metrics_ = std::make_unique<ElementLayoutMetrics>();
+  }
+  GetExecutingContext()->FlushUICommand(UICommandFlushReason::kLayoutMetrics);
+  // Dart side fills all the metrics at once, and keeps them up to date after every frame from now on.
+  const NativeValue args[] = {Native_NewPtr(JSPointerType::Others, layout_metrics_->values)};
+  InvokeBindingMethod(binding_call_methods::kgetLayoutMetrics, 1, args, exception_state);
+  if (UNLIKELY(exception_state.HasException())) {
+    layout_metrics_->generation = -1;
+    return nullptr;
+  }
+  layout_metrics_->generation = buffer->layoutGeneration();
+  return layout_metrics_.get();
+}
+
+double Element::GetLayoutMetric(LayoutMetric metric) {
+  ExceptionState exception_state;
+  const ElementLayoutMetrics* metrics = EnsureLayoutMetrics(exception_state);
+  if (UNLIKELY(metrics == nullptr)) {
+    return 0;
+  }
+  return metrics->Get(metric);
+}
+
+void Element::UpdateLayoutMetrics(const double* values, int64_t generation) {
+  if (layout_metrics_ == nullptr) {
+    layout_metrics_ = std::make_unique<ElementLayoutMetrics>();
+  }
+  std::copy(values, values + kLayoutMetricCount, layout_metrics_->values);
+  layout_metrics_->generation = generation;
+}
+
+void Element::setScrollTop(double value, ExceptionState& exception_state) {
+  SetBindingProperty(binding_call_methods::kscrollTop, NativeValueConverter<NativeTypeDouble>::ToNativeValue(value),
+                     exception_state);
+}
+
+void Element::setScrollLeft(double value, ExceptionState& exception_state) {
+  SetBindingProperty(binding_call_methods::kscrollLeft, NativeValueConverter<NativeTypeDouble>::ToNativeValue(value),
+                     exception_state);
 }
 
 void Element::click(ExceptionState& exception_state) {
@@ -179,26 +233,57 @@ void Element::setId(const AtomicString& value, ExceptionState& exception_state)
   setAttribute(html_names::kIdAttr, value, exception_state);
 }
 
-std::vector<Element*> Element::getElementsByClassName(const AtomicString& class_name, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), class_name)};
-  NativeValue result =
-      InvokeBindingMethod(binding_call_methods::kgetElementsByClassName, 1, arguments, exception_state);
-  if (exception_state.HasException()) {
-    return {};
+AtomicString Element::IdForTreeScope() const {
+  if (attributes_ == nullptr)
+    return AtomicString::Empty();
+  return attributes_->GetAttributeWithoutFallback(html_names::kIdAttr);
+}
+
+void Element::IdAttributeChanged(const AtomicString& old_id, const AtomicString& new_id) {
+  if (!isConnected() || old_id == new_id)
+    return;
+  TreeScope& tree_scope = GetTreeScope();
+  tree_scope.RemoveElementById(old_id, *this);
+  tree_scope.AddElementById(new_id, *this);
+}
+
+const SpaceSplitString& Element::ClassNames() const {
+  AtomicString class_value = attributes_ != nullptr
+                                 ? attributes_->GetAttributeWithoutFallback(html_names::kClassAttr)
+                                 : AtomicString::Empty();
+  if (class_value != class_names_source_) {
+    class_names_.Set(ctx(), class_value);
+    class_names_source_ = class_value;
   }
-  return NativeValueConverter<NativeTypeArray<NativeTypePointer<Element>>>::FromNativeValue(ctx(), result);
+  return class_names_;
 }
 
-std::vector<Element*> Element::getElementsByTagName(const AtomicString& tag_name, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), tag_name)};
-  NativeValue result = InvokeBindingMethod(binding_call_methods::kgetElementsByTagName, 1, arguments, exception_state);
-  if (exception_state.HasException()) {
-    return {};
+void Element::InsertedInto(ContainerNode& insertion_point) {
+  ContainerNode::InsertedInto(insertion_point);
+  if (insertion_point.isConnected()) {
+    GetTreeScope().AddElementById(IdForTreeScope(), *this);
   }
-  return NativeValueConverter<NativeTypeArray<NativeTypePointer<Element>>>::FromNativeValue(ctx(), result);
+}
+
+void Element::RemovedFrom(ContainerNode& insertion_point) {
+  if (insertion_point.isConnected()) {
+    GetTreeScope().RemoveElementById(IdForTreeScope(), *this);
+  }
+  ContainerNode::RemovedFrom(insertion_point);
+}
+
+HTMLCollection* Element::getElementsByClassName(const AtomicString& class_name, ExceptionState& exception_state) {
+  return EnsureCachedCollection<ClassCollection>(kClassCollectionType, class_name);
+}
+
+HTMLCollection* Element::getElementsByTagName(const AtomicString& tag_name, ExceptionState& exception_state) {
+  return EnsureCachedCollection<TagCollection>(kTagCollectionType, tag_name);
 }
 
 Element* Element::querySelector(const AtomicString& selectors, ExceptionState& exception_state) {
+  if (SelectorQuery* query = GetDocument().GetSelectorQueryCache().Add(ctx(), selectors)) {
+    return query->QueryFirst(*this);
+  }
   NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), selectors)};
   NativeValue result = InvokeBindingMethod(binding_call_methods::kquerySelector, 1, arguments, exception_state);
   if (exception_state.HasException()) {
@@ -208,6 +293,9 @@ Element* Element::querySelector(const AtomicString& selectors, ExceptionState& e
 }
 
 std::vector<Element*> Element::querySelectorAll(const AtomicString& selectors, ExceptionState& exception_state) {
+  if (SelectorQuery* query = GetDocument().GetSelectorQueryCache().Add(ctx(), selectors)) {
+    return query->QueryAll(*this);
+  }
   NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), selectors)};
   NativeValue result = InvokeBindingMethod(binding_call_methods::kquerySelectorAll, 1, arguments, exception_state);
   if (exception_state.HasException()) {
@@ -217,6 +305,9 @@ std::vector<Element*> Element::querySelectorAll(const AtomicString& selectors, E
 }
 
 bool Element::matches(const AtomicString& selectors, ExceptionState& exception_state) {
+  if (SelectorQuery* query = GetDocument().GetSelectorQueryCache().Add(ctx(), selectors)) {
+    return query->Matches(*this);
+  }
   NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), selectors)};
   NativeValue result = InvokeBindingMethod(binding_call_methods::kmatches, 1, arguments, exception_state);
   if (exception_state.HasException()) {
@@ -226,6 +317,9 @@ bool Element::matches(const AtomicString& selectors, ExceptionState& exception_s
 }
 
 Element* Element::closest(const AtomicString& selectors, ExceptionState& exception_state) {
+  if (SelectorQuery* query = GetDocument().GetSelectorQueryCache().Add(ctx(), selectors)) {
+    return query->Closest(*this);
+  }
   NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), selectors)};
   NativeValue result = InvokeBindingMethod(binding_call_methods::kclosest, 1, arguments, exception_state);
   if (exception_state.HasException()) {
@@ -310,6 +404,7 @@ bool Element::IsWidgetElement() const {
 void Element::Trace(GCVisitor* visitor) const {
   visitor->TraceMember(attributes_);
   visitor->TraceMember(cssom_wrapper_);
+  visitor->TraceMember(computed_style_);
   if (element_data_ != nullptr) {
     element_data_->Trace(visitor);
   }
@@ -342,6 +437,7 @@ Node* Element::Clone(Document& factory, CloneChildrenFlag flag) const {
     copy = &CloneWithChildren(flag, &factory);
   }
 
+  // Dart side copies the inline styles from this element, kCloneNode sends the pending ones first.
   GetExecutingContext()->uiCommandBuffer()->addCommand(UICommand::kCloneNode, nullptr, bindingObject(),
                                                        copy->bindingObject());
 
@@ -363,6 +459,7 @@ class ElementSnapshotReader {
   };
 
   void Start();
+  static void HandleCallback(void* ptr, int32_t contextId, const char* error, uint8_t* bytes, int32_t length);
   void HandleSnapshot(uint8_t* bytes, int32_t length);
   void HandleFailed(const char* error);
 
@@ -376,20 +473,30 @@ class ElementSnapshotReader {
 void ElementSnapshotReader::Start() {
   context_->FlushUICommand();
 
-  auto callback = [](void* ptr, int32_t contextId, const char* error, uint8_t* bytes, int32_t length) -> void {
-    auto* reader = static_cast<ElementSnapshotReader*>(ptr);
-    if (error != nullptr) {
-      reader->HandleFailed(error);
-    } else {
-      reader->HandleSnapshot(bytes, length);
-    }
-    delete reader;
-  };
-
-  context_->dartMethodPtr()->toBlob(this, context_->contextId(), callback, element_->bindingObject(),
+  context_->dartMethodPtr()->toBlob(this, context_->contextId(), HandleCallback, element_->bindingObject(),
                                     device_pixel_ratio_);
 }
 
+void ElementSnapshotReader::HandleCallback(void* ptr,
+                                           int32_t contextId,
+                                           const char* error,
+                                           uint8_t* bytes,
+                                           int32_t length) {
+  // The bytes are owned by dart side, wait until they are copied.
+  if (JSThreadDispatcher* dispatcher = JSThreadDispatcher::FromDartThread()) {
+    dispatcher->PostToJSSync<void>(contextId, [&]() { HandleCallback(ptr, contextId, error, bytes, length); });
+    return;
+  }
+
+  auto* reader = static_cast<ElementSnapshotReader*>(ptr);
+  if (error != nullptr) {
+    reader->HandleFailed(error);
+  } else {
+    reader->HandleSnapshot(bytes, length);
+  }
+  delete reader;
+}
+
 void ElementSnapshotReader::HandleSnapshot(uint8_t* bytes, int32_t length) {
   MemberMutationScope mutation_scope{context_};
   Blob* blob = Blob::Create(context_);
@@ -5,6 +5,7 @@ import { ElementAttributes } from './legacy/element_attributes';
 import {CSSStyleDeclaration} from "../css/css_style_declaration";
 import {ParentNode} from "./parent_node";
 import {ChildNode} from "./child_node";
+import {HTMLCollection} from "../html/html_collection";
 
 interface Element extends Node, ParentNode, ChildNode {
   id: string;
@@ -14,17 +15,17 @@ interface Element extends Node, ParentNode, ChildNode {
   name: DartImpl<string>;
   readonly attributes: ElementAttributes;
   readonly style: CSSStyleDeclaration;
-  readonly clientHeight: DartImpl<number>;
-  readonly clientLeft: DartImpl<number>;
-  readonly clientTop: DartImpl<number>;
-  readonly clientWidth: DartImpl<number>;
+  readonly clientHeight: number;
+  readonly clientLeft: number;
+  readonly clientTop: number;
+  readonly clientWidth: number;
   readonly outerHTML: string;
   innerHTML: string;
   readonly ownerDocument: Document;
-  scrollLeft: DartImpl<number>;
-  scrollTop: DartImpl<number>;
-  readonly scrollWidth: DartImpl<number>;
-  readonly scrollHeight: DartImpl<number>;
+  scrollLeft: number;
+  scrollTop: number;
+  readonly scrollWidth: number;
+  readonly scrollHeight: number;
   readonly prefix: string | null;
   readonly localName: string;
   readonly namespaceURI: string | null;
@@ -55,8 +56,8 @@ interface Element extends Node, ParentNode, ChildNode {
   // https://drafts.csswg.org/cssom-view/#extension-to-the-element-interface
   getBoundingClientRect(): BoundingClientRect;
 
-  getElementsByClassName(className: string) : Element[];
-  getElementsByTagName(tagName: string): Element[];
+  getElementsByClassName(className: string) : HTMLCollection;
+  getElementsByTagName(tagName: string): HTMLCollection;
 
   querySelector(selectors: string): Element | null;
   querySelectorAll(selectors: string): Element[];
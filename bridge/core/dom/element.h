@@ -8,12 +8,15 @@
 #include "bindings/qjs/cppgc/garbage_collected.h"
 #include "bindings/qjs/script_promise.h"
 #include "container_node.h"
+#include "core/css/computed_css_style_declaration.h"
 #include "core/css/inline_css_style_declaration.h"
 #include "element_data.h"
+#include "element_layout_metrics.h"
 #include "legacy/bounding_client_rect.h"
 #include "legacy/element_attributes.h"
 #include "parent_node.h"
 #include "qjs_scroll_to_options.h"
+#include "space_split_string.h"
 
 namespace webf {
 
@@ -30,6 +33,7 @@ class Element : public ContainerNode {
 
   ElementAttributes* attributes() const { return &EnsureElementAttributes(); }
   ElementAttributes& EnsureElementAttributes() const;
+  ElementAttributes* attributesIfExists() const { return attributes_.Get(); }
 
   bool hasAttribute(const AtomicString&, ExceptionState& exception_state);
   AtomicString getAttribute(const AtomicString&, ExceptionState& exception_state) const;
@@ -51,6 +55,24 @@ class Element : public ContainerNode {
   void scrollBy(double x, double y, ExceptionState& exception_state);
   void scrollBy(const std::shared_ptr<ScrollToOptions>& options, ExceptionState& exception_state);
 
+  // CSSOM View geometry, read from dart side in one call and cached until the layout may have changed.
+  double offsetTop() { return GetLayoutMetric(LayoutMetric::kOffsetTop); }
+  double offsetLeft() { return GetLayoutMetric(LayoutMetric::kOffsetLeft); }
+  double offsetWidth() { return GetLayoutMetric(LayoutMetric::kOffsetWidth); }
+  double offsetHeight() { return GetLayoutMetric(LayoutMetric::kOffsetHeight); }
+  double clientTop() { return GetLayoutMetric(LayoutMetric::kClientTop); }
+  double clientLeft() { return GetLayoutMetric(LayoutMetric::kClientLeft); }
+  double clientWidth() { return GetLayoutMetric(LayoutMetric::kClientWidth); }
+  double clientHeight() { return GetLayoutMetric(LayoutMetric::kClientHeight); }
+  double scrollTop() { return GetLayoutMetric(LayoutMetric::kScrollTop); }
+  void setScrollTop(double value, ExceptionState& exception_state);
+  double scrollLeft() { return GetLayoutMetric(LayoutMetric::kScrollLeft); }
+  void setScrollLeft(double value, ExceptionState& exception_state);
+  double scrollWidth() { return GetLayoutMetric(LayoutMetric::kScrollWidth); }
+  double scrollHeight() { return GetLayoutMetric(LayoutMetric::kScrollHeight); }
+  // Called with the metrics pushed by dart side, see UpdateLayoutMetricsFromDart().
+  void UpdateLayoutMetrics(const double* values, int64_t generation);
+
   ScriptPromise toBlob(double device_pixel_ratio, ExceptionState& exception_state);
   ScriptPromise toBlob(ExceptionState& exception_state);
 
@@ -71,9 +93,18 @@ class Element : public ContainerNode {
 
   AtomicString id() const;
   void setId(const AtomicString& value, ExceptionState& exception_state);
+  // The id the tree scope indexes the element by, read without calling into dart side.
+  AtomicString IdForTreeScope() const;
+  // Called by ElementAttributes after the id attribute changed.
+  void IdAttributeChanged(const AtomicString& old_id, const AtomicString& new_id);
+  // The classes in the class attribute, split again only after the attribute changed.
+  const SpaceSplitString& ClassNames() const;
+
+  void InsertedInto(ContainerNode& insertion_point) override;
+  void RemovedFrom(ContainerNode& insertion_point) override;
 
-  std::vector<Element*> getElementsByClassName(const AtomicString& class_name, ExceptionState& exception_state);
-  std::vector<Element*> getElementsByTagName(const AtomicString& tag_name, ExceptionState& exception_state);
+  HTMLCollection* getElementsByClassName(const AtomicString& class_name, ExceptionState& exception_state);
+  HTMLCollection* getElementsByTagName(const AtomicString& tag_name, ExceptionState& exception_state);
 
   Element* querySelector(const AtomicString& selectors, ExceptionState& exception_state);
   std::vector<Element*> querySelectorAll(const AtomicString& selectors, ExceptionState& exception_state);
@@ -83,6 +114,7 @@ class Element : public ContainerNode {
 
   InlineCssStyleDeclaration* style();
   InlineCssStyleDeclaration& EnsureCSSStyleDeclaration();
+  InlineCssStyleDeclaration* inlineStyleIfExists() const { return cssom_wrapper_.Get(); }
   DOMTokenList* classList();
   DOMStringMap* dataset();
 
@@ -100,6 +132,11 @@ class Element : public ContainerNode {
   virtual void CloneNonAttributePropertiesFrom(const Element&, CloneChildrenFlag) {}
   virtual bool IsWidgetElement() const;
 
+  // The declaration getComputedStyle() returned for this element, reused so its snapshot of resolved values outlives
+  // a single getComputedStyle() call.
+  ComputedCssStyleDeclaration* CachedComputedStyle() const { return computed_style_.Get(); }
+  void SetCachedComputedStyle(ComputedCssStyleDeclaration* style) { computed_style_ = style; }
+
   void Trace(GCVisitor* visitor) const override;
 
  protected:
@@ -123,10 +160,18 @@ class Element : public ContainerNode {
   void _notifyChildInsert();
   void _didModifyAttribute(const AtomicString& name, const AtomicString& oldId, const AtomicString& newId);
   void _beforeUpdateId(JSValue oldIdValue, JSValue newIdValue);
+  // Returns nullptr when dart side failed to report the metrics.
+  const ElementLayoutMetrics* EnsureLayoutMetrics(ExceptionState& exception_state);
+  double GetLayoutMetric(LayoutMetric metric);
 
   mutable std::unique_ptr<ElementData> element_data_;
   mutable Member<ElementAttributes> attributes_;
   Member<InlineCssStyleDeclaration> cssom_wrapper_;
+  Member<ComputedCssStyleDeclaration> computed_style_;
+  std::unique_ptr<ElementLayoutMetrics> layout_metrics_;
+  // The class attribute |class_names_| was split from.
+  mutable AtomicString class_names_source_ = AtomicString::Null();
+  mutable SpaceSplitString class_names_;
 };
 
 template <typename T>
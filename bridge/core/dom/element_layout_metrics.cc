@@ -0,0 +1,28 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "element_layout_metrics.h"
+#include "core/dom/element.h"
+#include "core/executing_context.h"
+
+namespace webf {
+
+void UpdateLayoutMetricsFromDart(ExecutingContext* context, const NativeLayoutMetrics* metrics, int32_t length) {
+  UICommandBuffer* buffer = context->uiCommandBuffer();
+  // Dart side laid out the commands it has received only, values are outdated by the commands still recorded.
+  if (buffer->hasPendingLayoutCommands())
+    return;
+  int64_t generation = buffer->layoutGeneration();
+  for (int32_t i = 0; i < length; i++) {
+    const NativeLayoutMetrics& entry = metrics[i];
+    if (entry.binding_object == nullptr || entry.binding_object->disposed_)
+      continue;
+    auto* element = DynamicTo<Element>(BindingObject::From(entry.binding_object));
+    if (element == nullptr)
+      continue;
+    element->UpdateLayoutMetrics(entry.values, generation);
+  }
+}
+
+}  // namespace webf
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_DOM_ELEMENT_LAYOUT_METRICS_H_
+#define BRIDGE_CORE_DOM_ELEMENT_LAYOUT_METRICS_H_
+
+#include <cinttypes>
+
+namespace webf {
+
+class ExecutingContext;
+struct NativeBindingObject;
+
+// The geometry of an element computed by the layout of dart side, in the order dart side writes them.
+enum class LayoutMetric : int32_t {
+  kOffsetTop,
+  kOffsetLeft,
+  kOffsetWidth,
+  kOffsetHeight,
+  kClientTop,
+  kClientLeft,
+  kClientWidth,
+  kClientHeight,
+  kScrollTop,
+  kScrollLeft,
+  kScrollWidth,
+  kScrollHeight,
+  kBoundingClientRectX,
+  kBoundingClientRectY,
+  kBoundingClientRectWidth,
+  kBoundingClientRectHeight,
+};
+
+constexpr int32_t kLayoutMetricCount = static_cast<int32_t>(LayoutMetric::kBoundingClientRectHeight) + 1;
+
+struct ElementLayoutMetrics {
+  double Get(LayoutMetric metric) const { return values[static_cast<int32_t>(metric)]; }
+
+  double values[kLayoutMetricCount];
+  // The layout generation of the ui command buffer the values were computed at, -1 when never computed.
+  int64_t generation{-1};
+};
+
+// The metrics of one element pushed by dart side after a frame was laid out.
+struct NativeLayoutMetrics {
+  NativeBindingObject* binding_object;
+  double values[kLayoutMetricCount];
+};
+
+// Refresh the metrics cached by the elements. The values are only trusted when dart side has consumed all the
+// commands which may change the layout, otherwise the elements read them again when accessed.
+void UpdateLayoutMetricsFromDart(ExecutingContext* context, const NativeLayoutMetrics* metrics, int32_t length);
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_DOM_ELEMENT_LAYOUT_METRICS_H_
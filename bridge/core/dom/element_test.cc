@@ -3,7 +3,9 @@
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
 
+#include "core/dom/element_layout_metrics.h"
 #include "core/dom/legacy/bounding_client_rect.h"
+#include "core/html/html_body_element.h"
 #include "gtest/gtest.h"
 #include "webf_test_env.h"
 using namespace webf;
@@ -168,4 +170,155 @@ TEST(Element, instanceofEventTarget) {
 
   EXPECT_EQ(errorCalled, false);
   EXPECT_EQ(logCalled, true);
-}
\ No newline at end of file
+}
+
+// A node described by a kCreateSubtree payload, see SubtreeCommandScope.
+struct SubtreeNode {
+  UICommand type;
+  int64_t parent_index;
+  std::u16string text;
+};
+
+static std::vector<SubtreeNode> ParseSubtree(const UICommandItem* item) {
+  std::vector<std::u16string> fields;
+  std::u16string packed(reinterpret_cast<const char16_t*>(item->string_01), item->args_01_length);
+  size_t start = 0;
+  for (size_t end = packed.find(u'\0'); end != std::u16string::npos; end = packed.find(u'\0', start)) {
+    fields.emplace_back(packed.substr(start, end - start));
+    start = end + 1;
+  }
+
+  auto to_int = [](const std::u16string& field) { return std::stoll(std::string(field.begin(), field.end())); };
+  std::vector<SubtreeNode> nodes;
+  size_t field = 0;
+  while (field < fields.size()) {
+    SubtreeNode node{static_cast<UICommand>(to_int(fields[field])), to_int(fields[field + 1]), fields[field + 2]};
+    field += 3;
+    if (node.type != UICommand::kCreateTextNode && node.type != UICommand::kCreateComment) {
+      if (node.type == UICommand::kCreateElementNS)
+        field++;
+      // Attributes and inline styles.
+      field += to_int(fields[field]) * 2 + 1;
+      field += to_int(fields[field]) * 2 + 1;
+    }
+    nodes.emplace_back(node);
+  }
+  return nodes;
+}
+
+TEST(Element, innerHTMLCreatesSubtree) {
+  bool static errorCalled = false;
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->GetExecutingContext();
+  auto* buffer = context->uiCommandBuffer();
+  const char* code =
+      "let div = document.createElement('div');"
+      "document.body.appendChild(div);";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  buffer->clear();
+
+  const char* html_code = "div.innerHTML = '<p id=\"a\" style=\"color: red\">hello</p><span></span>';";
+  env->page()->evaluateScript(html_code, strlen(html_code), "vm://", 0);
+
+  // All the parsed nodes are described by one kCreateSubtree command, in preorder.
+  int64_t subtree_commands = 0;
+  for (int64_t i = 0; i < buffer->size(); i++) {
+    UICommandItem* item = buffer->at(i);
+    EXPECT_NE(item->type, (int32_t)UICommand::kCreateElement);
+    EXPECT_NE(item->type, (int32_t)UICommand::kInsertAdjacentNode);
+    EXPECT_NE(item->type, (int32_t)UICommand::kSetAttribute);
+    if (item->type != (int32_t)UICommand::kCreateSubtree)
+      continue;
+    subtree_commands++;
+
+    std::vector<SubtreeNode> nodes = ParseSubtree(item);
+    ASSERT_EQ(nodes.size(), 3);
+    EXPECT_EQ(nodes[0].type, UICommand::kCreateElement);
+    EXPECT_EQ(nodes[0].parent_index, -1);
+    EXPECT_EQ(nodes[0].text, u"p");
+    EXPECT_EQ(nodes[1].type, UICommand::kCreateTextNode);
+    EXPECT_EQ(nodes[1].parent_index, 0);
+    EXPECT_EQ(nodes[1].text, u"hello");
+    EXPECT_EQ(nodes[2].type, UICommand::kCreateElement);
+    EXPECT_EQ(nodes[2].parent_index, -1);
+    EXPECT_EQ(nodes[2].text, u"span");
+
+    auto* node_list = reinterpret_cast<NativeBindingObject**>(item->nativePtr2);
+    for (size_t j = 0; j < nodes.size(); j++) {
+      EXPECT_NE(node_list[j], nullptr);
+    }
+  }
+  EXPECT_EQ(subtree_commands, 1);
+  EXPECT_EQ(buffer->nodeCommandsSuspended(), false);
+  EXPECT_EQ(errorCalled, false);
+}
+
+static int32_t layout_metrics_calls = 0;
+static double layout_metrics_width = 0;
+
+// Plays the dart side of getLayoutMetrics.
+static void FillLayoutMetrics(const NativeBindingObject* binding_object,
+                              NativeValue* return_value,
+                              NativeValue* method,
+                              int32_t argc,
+                              const NativeValue* argv) {
+  layout_metrics_calls++;
+  auto* values = static_cast<double*>(argv[0].u.ptr);
+  std::fill(values, values + kLayoutMetricCount, 0);
+  values[static_cast<int32_t>(LayoutMetric::kOffsetWidth)] = layout_metrics_width;
+  values[static_cast<int32_t>(LayoutMetric::kBoundingClientRectX)] = 10;
+  values[static_cast<int32_t>(LayoutMetric::kBoundingClientRectWidth)] = layout_metrics_width;
+}
+
+TEST(Element, layoutMetricsCache) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "100 100 110");
+  };
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->GetExecutingContext();
+  HTMLBodyElement* body = context->document()->body();
+  body->bindingObject()->invoke_bindings_methods_from_native = FillLayoutMetrics;
+  layout_metrics_calls = 0;
+  layout_metrics_width = 100;
+
+  // Reads in the same layout generation are served by one call to dart side.
+  const char* code =
+      "let body = document.body;"
+      "let rect = body.getBoundingClientRect();"
+      "console.log(body.offsetWidth, rect.width, rect.right);";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  EXPECT_EQ(layout_metrics_calls, 1);
+  EXPECT_EQ(logCalled, true);
+
+  // Changing the style may change the layout.
+  layout_metrics_width = 200;
+  const char* code2 = "body.style.width = '200px'; body.offsetWidth;";
+  env->page()->evaluateScript(code2, strlen(code2), "vm://", 0);
+  EXPECT_EQ(layout_metrics_calls, 2);
+  EXPECT_EQ(body->offsetWidth(), 200);
+
+  // Metrics pushed after a frame are used without calling dart side.
+  context->FlushUICommand();
+  NativeLayoutMetrics metrics{body->bindingObject()};
+  metrics.values[static_cast<int32_t>(LayoutMetric::kOffsetWidth)] = 300;
+  UpdateLayoutMetricsFromDart(context, &metrics, 1);
+  EXPECT_EQ(body->offsetWidth(), 300);
+  EXPECT_EQ(layout_metrics_calls, 2);
+
+  // Until the layout was invalidated.
+  context->uiCommandBuffer()->InvalidateLayout();
+  EXPECT_EQ(body->offsetWidth(), 200);
+  EXPECT_EQ(layout_metrics_calls, 3);
+
+  body->bindingObject()->invoke_bindings_methods_from_native = nullptr;
+  EXPECT_EQ(errorCalled, false);
+}
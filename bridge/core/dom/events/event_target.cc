@@ -26,15 +26,6 @@ struct EventDispatchResult : public DartReadable {
   bool propagationStopped{false};
 };
 
-struct DartEventListenerOptions : public DartReadable {
-  bool capture{false};
-};
-
-struct DartAddEventListenerOptions : public DartEventListenerOptions {
-  bool passive{false};
-  bool once{false};
-};
-
 Event::PassiveMode EventPassiveMode(const RegisteredEventListener& event_listener) {
   if (!event_listener.Passive()) {
     return Event::PassiveMode::kNotPassiveDefault;
@@ -268,7 +259,8 @@ bool EventTarget::AddEventListenerInternal(const AtomicString& event_type,
                                                            &listener_count);
 
   if (added && listener_count == 1) {
-    auto* listener_options = new DartAddEventListenerOptions{};
+    auto* buffer = GetExecutingContext()->uiCommandBuffer();
+    auto* listener_options = buffer->NewPayload<DartAddEventListenerOptions>();
     if (options->hasOnce()) {
       listener_options->once = options->once();
     }
@@ -279,8 +271,7 @@ bool EventTarget::AddEventListenerInternal(const AtomicString& event_type,
       listener_options->passive = options->passive();
     }
 
-    GetExecutingContext()->uiCommandBuffer()->addCommand(
-        UICommand::kAddEvent, std::move(event_type.ToNativeString(ctx())), bindingObject(), listener_options);
+    buffer->addInternedCommand(UICommand::kAddEvent, event_type, bindingObject(), listener_options);
   }
 
   return added;
@@ -327,9 +318,8 @@ bool EventTarget::RemoveEventListenerInternal(const AtomicString& event_type,
   if (listener_count == 0) {
     bool has_capture = options->hasCapture() && options->capture();
 
-    GetExecutingContext()->uiCommandBuffer()->addCommand(UICommand::kRemoveEvent,
-                                                         std::move(event_type.ToNativeString(ctx())), bindingObject(),
-                                                         has_capture ? (void*)0x01 : nullptr);
+    GetExecutingContext()->uiCommandBuffer()->addInternedCommand(UICommand::kRemoveEvent, event_type, bindingObject(),
+                                                                 has_capture ? (void*)0x01 : nullptr);
   }
 
   return true;
@@ -379,17 +369,36 @@ NativeValue EventTarget::HandleDispatchEventFromDart(int32_t argc, const NativeV
 
   auto* wire = new DartWireContext();
   wire->jsObject = event->ToValue();
+  wire->context_id = contextId();
 
   auto dart_object_finalize_callback = [](void* isolate_callback_data, void* peer) {
     auto* wire = (DartWireContext*)(peer);
+    // The wires are watched on the JS thread of their context.
+    if (JSThreadDispatcher* dispatcher = JSThreadDispatcher::FromDartThread()) {
+      dispatcher->PostToJS(wire->context_id, [wire]() {
+        if (IsDartWireAlive(wire)) {
+          DeleteDartWire(wire);
+        }
+      });
+      return;
+    }
     if (IsDartWireAlive(wire)) {
       DeleteDartWire(wire);
     }
   };
 
   WatchDartWire(wire);
-  Dart_NewFinalizableHandle_DL(dart_object, reinterpret_cast<void*>(wire), sizeof(DartWireContext),
-                               dart_object_finalize_callback);
+  // Dart handles are only usable on the dart thread.
+  JSThreadDispatcher* dispatcher = GetExecutingContext()->dartIsolateContext()->dispatcher();
+  if (dispatcher != nullptr) {
+    dispatcher->PostToDartSync<void>([&]() {
+      Dart_NewFinalizableHandle_DL(dart_object, reinterpret_cast<void*>(wire), sizeof(DartWireContext),
+                                   dart_object_finalize_callback);
+    });
+  } else {
+    Dart_NewFinalizableHandle_DL(dart_object, reinterpret_cast<void*>(wire), sizeof(DartWireContext),
+                                 dart_object_finalize_callback);
+  }
 
   if (exception_state.HasException()) {
     JSValue error = JS_GetException(ctx());
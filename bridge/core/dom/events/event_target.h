@@ -45,6 +45,16 @@ enum class DispatchEventResult {
   kCanceledBeforeDispatch,
 };
 
+// The payload of kAddEvent commands, read by dart side.
+struct DartEventListenerOptions : public DartReadable {
+  bool capture{false};
+};
+
+struct DartAddEventListenerOptions : public DartEventListenerOptions {
+  bool passive{false};
+  bool once{false};
+};
+
 struct FiringEventIterator {
   WEBF_DISALLOW_NEW();
 
@@ -191,10 +201,12 @@ class EventTargetWithInlineData : public EventTarget {
 // Macros to define an attribute event listener.
 //  |lower_name| - Lower-cased event type name.  e.g. |focus|
 //  |symbol_name| - C++ symbol name in event_type_names namespace. e.g. |kFocus|
-#define DEFINE_ATTRIBUTE_EVENT_LISTENER(lower_name, symbol_name)                                       \
-  EventListener* on##lower_name() { return GetAttributeEventListener(event_type_names::symbol_name); } \
-  void setOn##lower_name(EventListener* listener) {                                                    \
-    SetAttributeEventListener(event_type_names::symbol_name, listener);                                \
+#define DEFINE_ATTRIBUTE_EVENT_LISTENER(lower_name, symbol_name)                                            \
+  std::shared_ptr<EventListener> on##lower_name() {                                                         \
+    return GetAttributeEventListener(event_type_names::symbol_name);                                        \
+  }                                                                                                         \
+  void setOn##lower_name(const std::shared_ptr<EventListener>& listener, ExceptionState& exception_state) { \
+    SetAttributeEventListener(event_type_names::symbol_name, listener, exception_state);                    \
   }
 
 #define DEFINE_STATIC_ATTRIBUTE_EVENT_LISTENER(lower_name, symbol_name)                                   \
@@ -8,12 +8,25 @@
 
 namespace webf {
 
-BoundingClientRect* BoundingClientRect::Create(ExecutingContext* context, NativeBindingObject* native_binding_object) {
-  return MakeGarbageCollected<BoundingClientRect>(context, native_binding_object);
+BoundingClientRect* BoundingClientRect::Create(ExecutingContext* context,
+                                               double x,
+                                               double y,
+                                               double width,
+                                               double height) {
+  return MakeGarbageCollected<BoundingClientRect>(context, x, y, width, height);
 }
 
-BoundingClientRect::BoundingClientRect(ExecutingContext* context, NativeBindingObject* native_binding_object)
-    : BindingObject(context->ctx(), native_binding_object) {}
+// The values are copied from the layout metrics of the element, there is no dart object behind the rect.
+BoundingClientRect::BoundingClientRect(ExecutingContext* context, double x, double y, double width, double height)
+    : BindingObject(context->ctx()),
+      x_(x),
+      y_(y),
+      width_(width),
+      height_(height),
+      top_(y),
+      right_(x + width),
+      bottom_(y + height),
+      left_(x) {}
 
 NativeValue BoundingClientRect::HandleCallFromDartSide(const AtomicString& method,
                                                        int32_t argc,
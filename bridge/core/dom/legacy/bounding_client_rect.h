@@ -20,8 +20,8 @@ class BoundingClientRect : public BindingObject {
  public:
   using ImplType = BoundingClientRect*;
   BoundingClientRect() = delete;
-  static BoundingClientRect* Create(ExecutingContext* context, NativeBindingObject* native_binding_object);
-  explicit BoundingClientRect(ExecutingContext* context, NativeBindingObject* native_binding_object);
+  static BoundingClientRect* Create(ExecutingContext* context, double x, double y, double width, double height);
+  explicit BoundingClientRect(ExecutingContext* context, double x, double y, double width, double height);
 
   NativeValue HandleCallFromDartSide(const AtomicString& method,
                                      int32_t argc,
@@ -38,14 +38,14 @@ class BoundingClientRect : public BindingObject {
   double left() const { return left_; }
 
  private:
-  double x_;
-  double y_;
-  double width_;
-  double height_;
-  double top_;
-  double right_;
-  double bottom_;
-  double left_;
+  double x_{0};
+  double y_{0};
+  double width_{0};
+  double height_{0};
+  double top_{0};
+  double right_{0};
+  double bottom_{0};
+  double left_{0};
 };
 
 }  // namespace webf
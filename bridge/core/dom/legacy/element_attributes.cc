@@ -6,8 +6,10 @@
 #include "element_attributes.h"
 #include "bindings/qjs/exception_state.h"
 #include "built_in_string.h"
+#include "core/dom/document.h"
 #include "core/dom/element.h"
 #include "foundation/native_value_converter.h"
+#include "html_names.h"
 
 namespace webf {
 
@@ -52,13 +54,18 @@ bool ElementAttributes::setAttribute(const AtomicString& name,
     return false;
   }
 
+  if (name == html_names::kIdAttr) {
+    element_->IdAttributeChanged(GetAttributeWithoutFallback(name), value);
+  }
+  if (name == html_names::kClassAttr || name == html_names::kNameAttr) {
+    // getElementsByClassName() and getElementsByName() collections depend on these attributes.
+    element_->GetDocument().IncDOMTreeVersion();
+  }
   attributes_[name] = value;
 
-  std::unique_ptr<SharedNativeString> args_01 = value.ToNativeString(ctx());
-  std::unique_ptr<SharedNativeString> args_02 = name.ToNativeString(ctx());
-
-  GetExecutingContext()->uiCommandBuffer()->addCommand(UICommand::kSetAttribute, std::move(args_01),
-                                                       element_->bindingObject(), args_02.release());
+  auto* buffer = GetExecutingContext()->uiCommandBuffer();
+  buffer->addCommand(UICommand::kSetAttribute, buffer->NewString(value), element_->bindingObject(),
+                     buffer->NewString(name));
 
   return true;
 }
@@ -73,12 +80,25 @@ bool ElementAttributes::hasAttribute(const AtomicString& name, ExceptionState& e
   return attributes_.count(name) > 0;
 }
 
+AtomicString ElementAttributes::GetAttributeWithoutFallback(const AtomicString& name) const {
+  auto it = attributes_.find(name);
+  if (it == attributes_.end()) {
+    return AtomicString::Empty();
+  }
+  return it->second;
+}
+
 void ElementAttributes::removeAttribute(const AtomicString& name, ExceptionState& exception_state) {
+  if (name == html_names::kIdAttr) {
+    element_->IdAttributeChanged(GetAttributeWithoutFallback(name), AtomicString::Empty());
+  }
+  if (name == html_names::kClassAttr || name == html_names::kNameAttr) {
+    element_->GetDocument().IncDOMTreeVersion();
+  }
   attributes_.erase(name);
 
-  std::unique_ptr<SharedNativeString> args_01 = name.ToNativeString(ctx());
-  GetExecutingContext()->uiCommandBuffer()->addCommand(UICommand::kRemoveAttribute, std::move(args_01),
-                                                       element_->bindingObject(), nullptr);
+  GetExecutingContext()->uiCommandBuffer()->addInternedCommand(UICommand::kRemoveAttribute, name,
+                                                               element_->bindingObject(), nullptr);
 }
 
 void ElementAttributes::CopyWith(ElementAttributes* attributes) {
@@ -30,6 +30,8 @@ class ElementAttributes : public ScriptWrappable {
   AtomicString getAttribute(const AtomicString& name, ExceptionState& exception_state);
   bool setAttribute(const AtomicString& name, const AtomicString& value, ExceptionState& exception_state);
   bool hasAttribute(const AtomicString& name, ExceptionState& exception_state);
+  // The value stored at C++ side, empty when absent. Unlike getAttribute(), never reads dart side.
+  AtomicString GetAttributeWithoutFallback(const AtomicString& name) const;
   void removeAttribute(const AtomicString& name, ExceptionState& exception_state);
   void CopyWith(ElementAttributes* attributes);
   std::string ToString();
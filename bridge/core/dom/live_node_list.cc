@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "live_node_list.h"
+#include "core/dom/document.h"
+
+namespace webf {
+
+namespace {
+
+class IsMatch {
+  WEBF_STACK_ALLOCATED();
+
+ public:
+  IsMatch(const LiveNodeList& list) : list_(&list) {}
+
+  bool operator()(const Element& element) const { return list_->ElementMatches(element); }
+
+ private:
+  const LiveNodeList* list_;
+};
+
+}  // namespace
+
+LiveNodeList::LiveNodeList(ContainerNode& owner_node, CollectionType collection_type)
+    : NodeList(owner_node.ctx()),
+      LiveNodeListBase(owner_node, NodeListSearchRoot::kOwnerNode, collection_type),
+      cached_dom_tree_version_(owner_node.GetDocument().DomTreeVersion()) {}
+
+unsigned LiveNodeList::length() const {
+  UpdateCacheIfNeeded();
+  return collection_items_cache_.NodeCount(*this);
+}
+
+Element* LiveNodeList::item(unsigned offset, ExceptionState& exception_state) const {
+  UpdateCacheIfNeeded();
+  return collection_items_cache_.NodeAt(*this, offset);
+}
+
+bool LiveNodeList::NamedPropertyQuery(const AtomicString& key, ExceptionState& exception_state) {
+  // Only the array index keys are items, other names such as `foo` are not.
+  if (!JS_AtomIsTaggedInt(key.Impl()))
+    return false;
+  return JS_AtomToUInt32(key.Impl()) < length();
+}
+
+void LiveNodeList::NamedPropertyEnumerator(std::vector<AtomicString>& names, ExceptionState& exception_state) {
+  unsigned size = length();
+  for (unsigned i = 0; i < size; i++) {
+    names.emplace_back(AtomicString(ctx(), std::to_string(i)));
+  }
+}
+
+void LiveNodeList::InvalidateCache(Document*) const {
+  collection_items_cache_.Invalidate();
+}
+
+void LiveNodeList::UpdateCacheIfNeeded() const {
+  uint64_t dom_tree_version = GetDocument().DomTreeVersion();
+  if (cached_dom_tree_version_ == dom_tree_version)
+    return;
+  InvalidateCache();
+  cached_dom_tree_version_ = dom_tree_version;
+}
+
+Element* LiveNodeList::TraverseToFirst() const {
+  return ElementTraversal::FirstWithin(RootNode(), IsMatch(*this));
+}
+
+Element* LiveNodeList::TraverseToLast() const {
+  return ElementTraversal::LastWithin(RootNode(), IsMatch(*this));
+}
+
+Element* LiveNodeList::TraverseForwardToOffset(unsigned offset,
+                                               Element& current_element,
+                                               unsigned& current_offset) const {
+  return TraverseMatchingElementsForwardToOffset(current_element, &RootNode(), offset, current_offset,
+                                                 IsMatch(*this));
+}
+
+Element* LiveNodeList::TraverseBackwardToOffset(unsigned offset,
+                                                Element& current_element,
+                                                unsigned& current_offset) const {
+  return TraverseMatchingElementsBackwardToOffset(current_element, &RootNode(), offset, current_offset,
+                                                  IsMatch(*this));
+}
+
+Node* LiveNodeList::VirtualOwnerNode() const {
+  return &ownerNode();
+}
+
+void LiveNodeList::Trace(GCVisitor* visitor) const {
+  collection_items_cache_.Trace(visitor);
+  LiveNodeListBase::Trace(visitor);
+  NodeList::Trace(visitor);
+}
+
+}  // namespace webf
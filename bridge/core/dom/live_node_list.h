@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_DOM_LIVE_NODE_LIST_H_
+#define BRIDGE_CORE_DOM_LIVE_NODE_LIST_H_
+
+#include "core/dom/collection_items_cache.h"
+#include "core/dom/element.h"
+#include "core/dom/live_node_list_base.h"
+#include "core/dom/node_list.h"
+
+namespace webf {
+
+// A NodeList of elements which stays in sync with the DOM tree, like the result of getElementsByName().
+class LiveNodeList : public NodeList, public LiveNodeListBase {
+ public:
+  LiveNodeList(ContainerNode& owner_node, CollectionType collection_type);
+
+  // DOM API.
+  unsigned length() const final;
+  Element* item(unsigned offset, ExceptionState& exception_state) const final;
+
+  bool NamedPropertyQuery(const AtomicString& key, ExceptionState& exception_state) final;
+  void NamedPropertyEnumerator(std::vector<AtomicString>& names, ExceptionState& exception_state) final;
+
+  // Non-DOM API.
+  virtual bool ElementMatches(const Element&) const = 0;
+  void InvalidateCache(Document* old_document = nullptr) const final;
+
+  // CollectionIndexCache API.
+  bool CanTraverseBackward() const { return true; }
+  Element* TraverseToFirst() const;
+  Element* TraverseToLast() const;
+  Element* TraverseForwardToOffset(unsigned offset, Element& current_element, unsigned& current_offset) const;
+  Element* TraverseBackwardToOffset(unsigned offset, Element& current_element, unsigned& current_offset) const;
+
+  void Trace(GCVisitor*) const override;
+
+ private:
+  Node* VirtualOwnerNode() const final;
+  // Drops the cached items when the DOM tree changed since they were collected.
+  void UpdateCacheIfNeeded() const;
+
+  mutable CollectionItemsCache<LiveNodeList, Element> collection_items_cache_;
+  mutable uint64_t cached_dom_tree_version_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_DOM_LIVE_NODE_LIST_H_
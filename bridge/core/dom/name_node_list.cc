@@ -0,0 +1,26 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "name_node_list.h"
+#include "bindings/qjs/exception_state.h"
+#include "core/dom/element.h"
+#include "html_names.h"
+
+namespace webf {
+
+NameNodeList::NameNodeList(ContainerNode& root_node, CollectionType type, const AtomicString& name)
+    : LiveNodeList(root_node, kNameNodeListType), name_(name) {
+  assert(type == kNameNodeListType);
+}
+
+NameNodeList::~NameNodeList() = default;
+
+bool NameNodeList::ElementMatches(const Element& element) const {
+  ElementAttributes* attributes = element.attributesIfExists();
+  if (attributes == nullptr || !attributes->hasAttribute(html_names::kNameAttr, ASSERT_NO_EXCEPTION()))
+    return false;
+  return attributes->GetAttributeWithoutFallback(html_names::kNameAttr) == name_;
+}
+
+}  // namespace webf
@@ -0,0 +1,26 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_DOM_NAME_NODE_LIST_H_
+#define BRIDGE_CORE_DOM_NAME_NODE_LIST_H_
+
+#include "core/dom/live_node_list.h"
+
+namespace webf {
+
+// The live NodeList returned by getElementsByName().
+class NameNodeList final : public LiveNodeList {
+ public:
+  NameNodeList(ContainerNode& root_node, CollectionType type, const AtomicString& name);
+  ~NameNodeList() override;
+
+  bool ElementMatches(const Element&) const override;
+
+ private:
+  AtomicString name_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_DOM_NAME_NODE_LIST_H_
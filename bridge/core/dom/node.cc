@@ -40,6 +40,7 @@
 #include "node_data.h"
 #include "node_traversal.h"
 #include "qjs_node.h"
+#include "subtree_command_scope.h"
 #include "text.h"
 
 namespace webf {
@@ -176,6 +177,15 @@ Node* Node::cloneNode(bool deep, ExceptionState&) const {
   // host is an HTML template element.
   auto* fragment = DynamicTo<DocumentFragment>(this);
   bool clone_shadows_flag = fragment && fragment->IsTemplateContent();
+
+  // Deep copies of elements are sent to dart side as a whole subtree.
+  if (deep && IsElementNode()) {
+    SubtreeCommandScope subtree_scope(GetExecutingContext());
+    Node* new_node = Clone(GetDocument(), CloneChildrenFlag::kClone);
+    subtree_scope.Commit(new_node);
+    return new_node;
+  }
+
   Node* new_node = Clone(GetDocument(),
                          deep ? (clone_shadows_flag ? CloneChildrenFlag::kCloneWithShadows : CloneChildrenFlag::kClone)
                               : CloneChildrenFlag::kSkip);
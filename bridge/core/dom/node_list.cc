@@ -4,6 +4,7 @@
  */
 
 #include "node_list.h"
+#include "core/dom/document.h"
 
 namespace webf {
 
@@ -12,10 +13,24 @@ void NodeList::InvalidateCache() {
     cache.second->InvalidateCache();
 }
 
+void NodeList::EvictNamedCollectionsIfStale(ContainerNode& node) {
+  uint64_t dom_tree_version = node.GetDocument().DomTreeVersion();
+  if (named_collection_dom_tree_version_ == dom_tree_version)
+    return;
+  // Collections still referenced by script stay alive and keep working, they just stop being returned again.
+  for (auto& item : named_collection_cache_)
+    item.second.Clear();
+  named_collection_cache_.clear();
+  named_collection_dom_tree_version_ = dom_tree_version;
+}
+
 void NodeList::Trace(webf::GCVisitor* visitor) const {
   for (auto& item : tag_collection_cache_) {
     visitor->TraceMember(item.second);
   }
+  for (auto& item : named_collection_cache_) {
+    visitor->TraceMember(item.second);
+  }
 }
 
 }  // namespace webf
\ No newline at end of file
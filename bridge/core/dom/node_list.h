@@ -35,6 +35,7 @@
 #ifndef BRIDGE_CORE_DOM_NODE_LIST_H_
 #define BRIDGE_CORE_DOM_NODE_LIST_H_
 
+#include "bindings/qjs/atomic_string.h"
 #include "bindings/qjs/script_wrappable.h"
 #include "core/html/collection_type.h"
 #include "core/html/html_collection.h"
@@ -80,10 +81,40 @@ class NodeList : public ScriptWrappable {
     tag_collection_cache_[collection_type] = list;
     return list;
   }
+  // Collections parameterized by a name, like getElementsByClassName().
+  // The names are unbounded, so these collections are only cached until the DOM tree of |node| changes.
+  template <typename T>
+  T* AddCache(ContainerNode& node, CollectionType collection_type, const AtomicString& name) {
+    EvictNamedCollectionsIfStale(node);
+    NamedCollectionKey key{collection_type, name};
+    auto it = named_collection_cache_.find(key);
+    if (it != named_collection_cache_.end()) {
+      return static_cast<T*>(it->second.Get());
+    }
+
+    auto* list = MakeGarbageCollected<T>(node, collection_type, name);
+    named_collection_cache_[key] = list;
+    return list;
+  }
   void Trace(GCVisitor* visitor) const override;
 
  protected:
+  struct NamedCollectionKey {
+    CollectionType type;
+    AtomicString name;
+    bool operator==(const NamedCollectionKey& other) const { return type == other.type && name == other.name; }
+  };
+  struct NamedCollectionKeyHasher {
+    std::size_t operator()(const NamedCollectionKey& key) const {
+      return AtomicString::KeyHasher()(key.name) * 31 + key.type;
+    }
+  };
+
+  void EvictNamedCollectionsIfStale(ContainerNode& node);
+
   std::unordered_map<CollectionType, Member<HTMLCollection>> tag_collection_cache_;
+  std::unordered_map<NamedCollectionKey, Member<ScriptWrappable>, NamedCollectionKeyHasher> named_collection_cache_;
+  uint64_t named_collection_dom_tree_version_{0};
 };
 
 template <typename Collection>
@@ -96,6 +127,17 @@ inline Collection* ContainerNode::EnsureCachedCollection(CollectionType type) {
       ->AddCache<Collection>(*this, type);
 }
 
+template <typename Collection>
+inline Collection* ContainerNode::EnsureCachedCollection(CollectionType type, const AtomicString& name) {
+  auto* this_node = DynamicTo<ContainerNode>(this);
+  if (this_node) {
+    return reinterpret_cast<NodeList*>(EnsureNodeData().EnsureChildNodeList(*this))
+        ->AddCache<Collection>(*this, type, name);
+  }
+  return reinterpret_cast<NodeList*>(EnsureNodeData().EnsureEmptyChildNodeList(*this))
+      ->AddCache<Collection>(*this, type, name);
+}
+
 }  // namespace webf
 
 #endif  // BRIDGE_CORE_DOM_NODE_LIST_H_
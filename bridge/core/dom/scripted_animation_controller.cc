@@ -10,6 +10,11 @@
 namespace webf {
 
 static void handleRAFTransientCallback(void* ptr, int32_t contextId, double highResTimeStamp, const char* errmsg) {
+  if (JSThreadDispatcher* dispatcher = JSThreadDispatcher::FromDartThread()) {
+    dispatcher->PostCallbackToJS(contextId, handleRAFTransientCallback, ptr, contextId, highResTimeStamp, errmsg);
+    return;
+  }
+
   auto* frame_callback = static_cast<FrameCallback*>(ptr);
   auto* context = frame_callback->context();
 
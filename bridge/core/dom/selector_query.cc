@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "selector_query.h"
+#include "core/css/selector_checker.h"
+#include "core/css/selector_filter.h"
+#include "element.h"
+#include "element_traversal.h"
+#include "tree_scope.h"
+
+namespace webf {
+
+SelectorQuery::SelectorQuery(std::unique_ptr<CSSSelectorList> selector_list)
+    : selector_list_(std::move(selector_list)) {
+  for (const CSSComplexSelector& selector : selector_list_->selectors()) {
+    if (!selector.ancestor_identifier_hashes.empty())
+      uses_selector_filter_ = true;
+  }
+
+  const std::vector<CSSComplexSelector>& selectors = selector_list_->selectors();
+  if (selectors.size() == 1 && selectors[0].compounds.size() == 1 && selectors[0].compounds[0].selectors.size() == 1 &&
+      selectors[0].compounds[0].selectors[0].match == CSSSelector::kId) {
+    single_id_ = selectors[0].compounds[0].selectors[0].value;
+  }
+}
+
+bool SelectorQuery::Matches(Element& element) const {
+  return SelectorChecker::Match(*selector_list_, element, &element);
+}
+
+Element* SelectorQuery::Closest(Element& element) const {
+  for (Element* current = &element; current != nullptr; current = current->parentElement()) {
+    if (SelectorChecker::Match(*selector_list_, *current, &element))
+      return current;
+  }
+  return nullptr;
+}
+
+Element* SelectorQuery::QueryFirst(ContainerNode& root) const {
+  if (!single_id_.IsNull() && root.isConnected()) {
+    Element* element = root.GetTreeScope().getElementById(single_id_);
+    if (element == nullptr)
+      return nullptr;
+    if (root.IsDocumentNode() || element->IsDescendantOf(&root))
+      return element;
+    // Another element of the same id may be in |root|.
+  }
+
+  std::vector<Element*> result;
+  Execute<true>(root, result);
+  return result.empty() ? nullptr : result[0];
+}
+
+std::vector<Element*> SelectorQuery::QueryAll(ContainerNode& root) const {
+  std::vector<Element*> result;
+  Execute<false>(root, result);
+  return result;
+}
+
+template <bool kFirstOnly>
+void SelectorQuery::Execute(ContainerNode& root, std::vector<Element*>& result) const {
+  Element* scope = DynamicTo<Element>(root);
+  if (!uses_selector_filter_) {
+    for (Element& element : ElementTraversal::DescendantsOf(root)) {
+      if (SelectorChecker::Match(*selector_list_, element, scope)) {
+        result.emplace_back(&element);
+        if (kFirstOnly)
+          return;
+      }
+    }
+    return;
+  }
+
+  SelectorFilter filter;
+  // Selectors may require ancestors of the root as well.
+  for (Element* ancestor = scope; ancestor != nullptr; ancestor = ancestor->parentElement()) {
+    filter.PushParent(*ancestor);
+  }
+
+  // The elements between the root and the current element, their identifiers are in the filter.
+  std::vector<Element*> parents;
+  for (Element* element = ElementTraversal::FirstWithin(root); element != nullptr;
+       element = ElementTraversal::Next(*element, &root)) {
+    ContainerNode* parent = element->parentNode();
+    while (!parents.empty() && parents.back() != parent) {
+      filter.PopParent(*parents.back());
+      parents.pop_back();
+    }
+
+    for (const CSSComplexSelector& selector : selector_list_->selectors()) {
+      if (filter.FastRejectSelector(selector) || !SelectorChecker::Match(selector, *element, scope))
+        continue;
+      result.emplace_back(element);
+      if (kFirstOnly)
+        return;
+      break;
+    }
+
+    if (element->hasChildren()) {
+      filter.PushParent(*element);
+      parents.emplace_back(element);
+    }
+  }
+}
+
+SelectorQuery* SelectorQueryCache::Add(JSContext* ctx, const AtomicString& selectors) {
+  auto it = entries_.find(selectors);
+  if (it != entries_.end())
+    return it->second.get();
+
+  if (entries_.size() == kMaximumSelectorQueryCacheSize) {
+    entries_.clear();
+  }
+  std::unique_ptr<CSSSelectorList> selector_list = CSSSelectorList::Parse(ctx, selectors);
+  std::unique_ptr<SelectorQuery> query =
+      selector_list != nullptr ? std::make_unique<SelectorQuery>(std::move(selector_list)) : nullptr;
+  SelectorQuery* result = query.get();
+  entries_.emplace(selectors, std::move(query));
+  return result;
+}
+
+}  // namespace webf
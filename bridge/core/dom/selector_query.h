@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_DOM_SELECTOR_QUERY_H_
+#define BRIDGE_CORE_DOM_SELECTOR_QUERY_H_
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "bindings/qjs/atomic_string.h"
+#include "core/css/css_selector.h"
+#include "foundation/macros.h"
+
+namespace webf {
+
+class ContainerNode;
+class Element;
+
+// querySelector(), querySelectorAll(), matches() and closest() answered at C++ side.
+class SelectorQuery {
+  WEBF_DISALLOW_COPY_AND_ASSIGN(SelectorQuery);
+
+ public:
+  explicit SelectorQuery(std::unique_ptr<CSSSelectorList> selector_list);
+
+  bool Matches(Element& element) const;
+  Element* Closest(Element& element) const;
+  Element* QueryFirst(ContainerNode& root) const;
+  std::vector<Element*> QueryAll(ContainerNode& root) const;
+
+ private:
+  template <bool kFirstOnly>
+  void Execute(ContainerNode& root, std::vector<Element*>& result) const;
+
+  std::unique_ptr<CSSSelectorList> selector_list_;
+  // The ancestors are tracked by a SelectorFilter only when a selector can be rejected by it.
+  bool uses_selector_filter_{false};
+  // The id of selectors like `#id`, answered by the id index of the tree scope.
+  AtomicString single_id_ = AtomicString::Null();
+};
+
+// Parsed selectors of a document, keyed by the selector text.
+class SelectorQueryCache {
+ public:
+  // Returns nullptr when |selectors| is invalid or uses syntax not supported at C++ side, the query should be answered
+  // by dart side then.
+  SelectorQuery* Add(JSContext* ctx, const AtomicString& selectors);
+
+ private:
+  static constexpr size_t kMaximumSelectorQueryCacheSize = 256;
+
+  std::unordered_map<AtomicString, std::unique_ptr<SelectorQuery>, AtomicString::KeyHasher> entries_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_DOM_SELECTOR_QUERY_H_
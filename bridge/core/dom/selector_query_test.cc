@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "selector_query.h"
+#include "gtest/gtest.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+TEST(SelectorQuery, parse) {
+  auto env = TEST_init();
+  JSContext* ctx = env->page()->GetExecutingContext()->ctx();
+
+  auto list = CSSSelectorList::Parse(ctx, AtomicString(ctx, "ul > li.item:nth-child(2n+1), a[href^='https' i]"));
+  EXPECT_NE(list, nullptr);
+  EXPECT_EQ(list->selectors().size(), 2);
+  const CSSComplexSelector& first = list->selectors()[0];
+  EXPECT_EQ(first.compounds.size(), 2);
+  EXPECT_EQ(first.compounds[0].relation, CSSSelectorRelation::kChild);
+  EXPECT_EQ(first.compounds[0].selectors[2].nth_a, 2);
+  EXPECT_EQ(first.compounds[0].selectors[2].nth_b, 1);
+  EXPECT_EQ(first.ancestor_identifier_hashes.size(), 1);
+
+  // Answered by dart side.
+  EXPECT_EQ(CSSSelectorList::Parse(ctx, AtomicString(ctx, "div::before")), nullptr);
+  EXPECT_EQ(CSSSelectorList::Parse(ctx, AtomicString(ctx, "a:hover")), nullptr);
+  EXPECT_EQ(CSSSelectorList::Parse(ctx, AtomicString(ctx, "svg|rect")), nullptr);
+  EXPECT_EQ(CSSSelectorList::Parse(ctx, AtomicString(ctx, "div >")), nullptr);
+}
+
+TEST(SelectorQuery, querySelectorAll) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "3 a,c b c 2 true false true");
+  };
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->GetExecutingContext();
+  const char* code =
+      "let list = document.createElement('ul');"
+      "list.id = 'list';"
+      "list.innerHTML = '<li class=\"item\" data-name=\"a\"></li><li data-name=\"b\"><span></span></li>"
+      "<li class=\"item last\" data-name=\"c\"></li>';"
+      "document.body.appendChild(list);"
+      "let names = (elements) => Array.from(elements).map(e => e.getAttribute('data-name')).join(',');"
+      "let span = list.querySelector('span');"
+      "console.log("
+      "  document.querySelectorAll('#list > li').length,"
+      "  names(document.querySelectorAll('body ul li.item')),"
+      "  list.querySelector(':not(.item)').getAttribute('data-name'),"
+      "  list.querySelector('li:last-child').getAttribute('data-name'),"
+      "  list.querySelectorAll('li:nth-child(odd)').length,"
+      "  span.matches('li:nth-of-type(2) > span'),"
+      "  span.matches('.item span'),"
+      "  span.closest('#list') === list"
+      ");";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+TEST(SelectorQuery, link) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "2 a true false false true");
+  };
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->GetExecutingContext();
+  const char* code =
+      "let div = document.createElement('div');"
+      "div.innerHTML = '<a id=\"a\" href=\"#\"></a><a id=\"b\"></a><span id=\"c\" href=\"#\"></span>"
+      "<area id=\"d\" href=\"#\">';"
+      "document.body.appendChild(div);"
+      "console.log("
+      "  div.querySelectorAll(':link').length,"
+      "  div.querySelector(':any-link').id,"
+      "  div.querySelector('#a').matches(':link'),"
+      "  div.querySelector('#b').matches(':link'),"
+      "  div.querySelector('#c').matches(':link'),"
+      "  div.querySelector('#d').matches(':link')"
+      ");";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
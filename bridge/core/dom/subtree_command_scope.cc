@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "subtree_command_scope.h"
+#include <algorithm>
+#include "bindings/qjs/native_string_utils.h"
+#include "core/css/inline_css_style_declaration.h"
+#include "core/dom/comment.h"
+#include "core/dom/element.h"
+#include "core/dom/text.h"
+#include "core/executing_context.h"
+#include "element_namespace_uris.h"
+
+namespace webf {
+
+static void AppendField(std::u16string& packed, const AtomicString& string) {
+  if (!string.IsEmpty()) {
+    if (string.Is8Bit()) {
+      const uint8_t* characters = string.Character8();
+      packed.append(characters, characters + string.length());
+    } else {
+      const uint16_t* characters = string.Character16();
+      packed.append(characters, characters + string.length());
+    }
+  }
+  packed += u'\0';
+}
+
+static void AppendField(std::u16string& packed, const std::string& string) {
+  bool is_ascii = std::all_of(string.begin(), string.end(), [](char c) { return static_cast<unsigned char>(c) < 0x80; });
+  if (LIKELY(is_ascii)) {
+    packed.append(string.begin(), string.end());
+  } else {
+    std::u16string utf16;
+    fromUTF8(string, utf16);
+    packed += utf16;
+  }
+  packed += u'\0';
+}
+
+static void AppendField(std::u16string& packed, int64_t number) {
+  AppendField(packed, std::to_string(number));
+}
+
+SubtreeCommandScope::SubtreeCommandScope(ExecutingContext* context) : context_(context) {
+  context_->uiCommandBuffer()->suspendNodeCommands();
+}
+
+SubtreeCommandScope::~SubtreeCommandScope() {
+  if (suspended_) {
+    context_->uiCommandBuffer()->resumeNodeCommands();
+  }
+}
+
+void SubtreeCommandScope::Commit(ContainerNode* parent, Node* first_child) {
+  Commit(parent, first_child, true);
+}
+
+void SubtreeCommandScope::Commit(Node* root) {
+  Commit(nullptr, root, false);
+}
+
+void SubtreeCommandScope::Commit(ContainerNode* parent, Node* first_root, bool include_siblings) {
+  assert(suspended_);
+  auto* buffer = context_->uiCommandBuffer();
+  buffer->resumeNodeCommands();
+  suspended_ = false;
+
+  // Nested in another scope, the outermost scope describes these nodes.
+  if (buffer->nodeCommandsSuspended() || first_root == nullptr)
+    return;
+
+  for (Node* root = first_root; root != nullptr; root = include_siblings ? root->nextSibling() : nullptr) {
+    SerializeNode(*root, -1);
+  }
+
+  if (nodes_.empty())
+    return;
+
+  auto* node_list =
+      static_cast<NativeBindingObject**>(buffer->AllocatePayload(nodes_.size() * sizeof(NativeBindingObject*)));
+  std::copy(nodes_.begin(), nodes_.end(), node_list);
+
+  buffer->addCommand(UICommand::kCreateSubtree,
+                     buffer->NewString(reinterpret_cast<const uint16_t*>(packed_.data()),
+                                       static_cast<uint32_t>(packed_.size())),
+                     parent != nullptr ? parent->bindingObject() : nullptr, node_list);
+
+  packed_.clear();
+  nodes_.clear();
+}
+
+void SubtreeCommandScope::SerializeNode(const Node& node, int64_t parent_index) {
+  auto index = static_cast<int64_t>(nodes_.size());
+
+  if (auto* element = DynamicTo<Element>(node)) {
+    const AtomicString& namespace_uri = element->namespaceURI();
+    if (namespace_uri == element_namespace_uris::khtml) {
+      AppendField(packed_, static_cast<int64_t>(UICommand::kCreateElement));
+      AppendField(packed_, parent_index);
+      AppendField(packed_, element->localName());
+    } else if (namespace_uri == element_namespace_uris::ksvg) {
+      AppendField(packed_, static_cast<int64_t>(UICommand::kCreateSVGElement));
+      AppendField(packed_, parent_index);
+      AppendField(packed_, element->localName());
+    } else {
+      AppendField(packed_, static_cast<int64_t>(UICommand::kCreateElementNS));
+      AppendField(packed_, parent_index);
+      AppendField(packed_, element->localName());
+      AppendField(packed_, namespace_uri);
+    }
+
+    ElementAttributes* attributes = element->attributesIfExists();
+    if (attributes != nullptr) {
+      AppendField(packed_, static_cast<int64_t>(std::distance(attributes->begin(), attributes->end())));
+      for (auto& attribute : *attributes) {
+        AppendField(packed_, attribute.first);
+        AppendField(packed_, attribute.second);
+      }
+    } else {
+      AppendField(packed_, static_cast<int64_t>(0));
+    }
+
+    InlineCssStyleDeclaration* style = element->inlineStyleIfExists();
+    if (style != nullptr) {
+      AppendField(packed_, static_cast<int64_t>(style->properties().size()));
+      for (auto& property : style->properties()) {
+        AppendField(packed_, property.first);
+        AppendField(packed_, property.second);
+      }
+    } else {
+      AppendField(packed_, static_cast<int64_t>(0));
+    }
+  } else if (auto* text = DynamicTo<Text>(node)) {
+    AppendField(packed_, static_cast<int64_t>(UICommand::kCreateTextNode));
+    AppendField(packed_, parent_index);
+    AppendField(packed_, text->data());
+  } else if (IsA<Comment>(node)) {
+    AppendField(packed_, static_cast<int64_t>(UICommand::kCreateComment));
+    AppendField(packed_, parent_index);
+    AppendField(packed_, AtomicString::Empty());
+  } else {
+    assert_m(false, "Only elements, texts and comments can be sent with kCreateSubtree.");
+    return;
+  }
+
+  nodes_.emplace_back(node.bindingObject());
+
+  for (Node* child = node.firstChild(); child != nullptr; child = child->nextSibling()) {
+    SerializeNode(*child, index);
+  }
+}
+
+}  // namespace webf
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_DOM_SUBTREE_COMMAND_SCOPE_H_
+#define BRIDGE_CORE_DOM_SUBTREE_COMMAND_SCOPE_H_
+
+#include <string>
+#include <vector>
+#include "foundation/macros.h"
+
+namespace webf {
+
+class ExecutingContext;
+class ContainerNode;
+class Node;
+struct NativeBindingObject;
+
+// Builds a detached subtree without sending per node ui commands, and describes the whole subtree to dart side with
+// a single kCreateSubtree command on Commit().
+//
+// args_01 of kCreateSubtree is a list of fields separated by '\0'. Every node in preorder is described by:
+//   type           The UICommand which creates the node (kCreateElement, kCreateSVGElement, kCreateElementNS,
+//                  kCreateTextNode or kCreateComment).
+//   parent index   Index of the parent node in the list, or -1 for the roots of the subtree.
+//   text           Local name for elements, data for text nodes and empty for comments.
+//   namespace uri  Only for kCreateElementNS.
+//   and for elements only:
+//   attribute count, followed by the name and value of each attribute.
+//   style count, followed by the name and value of each inline style property.
+class SubtreeCommandScope {
+  WEBF_DISALLOW_COPY_AND_ASSIGN(SubtreeCommandScope);
+
+ public:
+  explicit SubtreeCommandScope(ExecutingContext* context);
+  ~SubtreeCommandScope();
+
+  // Sends |first_child| and its next siblings, which were appended into |parent| in this scope.
+  void Commit(ContainerNode* parent, Node* first_child);
+  // Sends a detached subtree.
+  void Commit(Node* root);
+
+ private:
+  void Commit(ContainerNode* parent, Node* first_root, bool include_siblings);
+  void SerializeNode(const Node& node, int64_t parent_index);
+
+  ExecutingContext* context_;
+  bool suspended_{true};
+  std::u16string packed_;
+  std::vector<NativeBindingObject*> nodes_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_DOM_SUBTREE_COMMAND_SCOPE_H_
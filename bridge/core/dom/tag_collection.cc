@@ -0,0 +1,19 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "tag_collection.h"
+
+namespace webf {
+
+TagCollection::TagCollection(ContainerNode& root_node, CollectionType type, const AtomicString& qualified_name)
+    : HTMLCollection(root_node, kTagCollectionType),
+      match_all_(qualified_name.ToStdString(root_node.ctx()) == "*"),
+      qualified_name_(qualified_name),
+      lowered_qualified_name_(qualified_name.ToLowerIfNecessary(root_node.ctx())) {
+  assert(type == kTagCollectionType);
+}
+
+TagCollection::~TagCollection() = default;
+
+}  // namespace webf
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_DOM_TAG_COLLECTION_H_
+#define BRIDGE_CORE_DOM_TAG_COLLECTION_H_
+
+#include "core/dom/element.h"
+#include "core/html/html_collection.h"
+
+namespace webf {
+
+// The live collection returned by getElementsByTagName().
+class TagCollection final : public HTMLCollection {
+ public:
+  TagCollection(ContainerNode& root_node, CollectionType type, const AtomicString& qualified_name);
+  ~TagCollection() override;
+
+  bool ElementMatches(const Element& element) const {
+    if (match_all_)
+      return true;
+    // Local names of HTML elements are lowercased when they are created.
+    if (element.IsHTMLElement())
+      return element.localName() == lowered_qualified_name_;
+    return element.localName() == qualified_name_;
+  }
+
+ private:
+  bool match_all_;
+  AtomicString qualified_name_;
+  AtomicString lowered_qualified_name_;
+};
+
+template <>
+struct DowncastTraits<TagCollection> {
+  static bool AllowFrom(const LiveNodeListBase& collection) { return collection.GetType() == kTagCollectionType; }
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_DOM_TAG_COLLECTION_H_
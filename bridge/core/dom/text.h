@@ -21,8 +21,8 @@ class Text : public CharacterData {
   static Text* Create(ExecutingContext* context, const AtomicString& value, ExceptionState& executing_context);
 
   Text(TreeScope& tree_scope, const AtomicString& data, ConstructionType type) : CharacterData(tree_scope, data, type) {
-    GetExecutingContext()->uiCommandBuffer()->addCommand(
-        UICommand::kCreateTextNode, std::move(data.ToNativeString(ctx())), (void*)bindingObject(), nullptr);
+    auto* buffer = GetExecutingContext()->uiCommandBuffer();
+    buffer->addCommand(UICommand::kCreateTextNode, buffer->NewString(data), (void*)bindingObject(), nullptr);
   }
 
   NodeType nodeType() const override;
@@ -5,6 +5,8 @@
 
 #include "tree_scope.h"
 #include "document.h"
+#include "element.h"
+#include "element_traversal.h"
 
 namespace webf {
 
@@ -12,4 +14,48 @@ TreeScope::TreeScope(Document& document) : root_node_(&document), document_(&doc
   root_node_->SetTreeScope(this);
 }
 
+Element* TreeScope::getElementById(const AtomicString& element_id) const {
+  if (element_id.IsEmpty())
+    return nullptr;
+  auto it = elements_by_id_.find(element_id);
+  if (it == elements_by_id_.end())
+    return nullptr;
+  IdMapEntry& entry = it->second;
+  if (entry.element != nullptr)
+    return entry.element;
+
+  for (Element& element : ElementTraversal::DescendantsOf(*root_node_)) {
+    if (element.IdForTreeScope() == element_id) {
+      entry.element = &element;
+      return &element;
+    }
+  }
+  return nullptr;
+}
+
+void TreeScope::AddElementById(const AtomicString& element_id, Element& element) {
+  if (element_id.IsEmpty())
+    return;
+  auto it = elements_by_id_.find(element_id);
+  if (it == elements_by_id_.end()) {
+    elements_by_id_.emplace(element_id, IdMapEntry{&element, 1});
+    return;
+  }
+  it->second.element = nullptr;
+  it->second.count++;
+}
+
+void TreeScope::RemoveElementById(const AtomicString& element_id, Element& element) {
+  if (element_id.IsEmpty())
+    return;
+  auto it = elements_by_id_.find(element_id);
+  if (it == elements_by_id_.end())
+    return;
+  if (--it->second.count == 0) {
+    elements_by_id_.erase(it);
+    return;
+  }
+  it->second.element = nullptr;
+}
+
 }  // namespace webf
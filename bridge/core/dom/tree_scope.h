@@ -7,11 +7,14 @@
 #define BRIDGE_CORE_DOM_TREE_SCOPE_H_
 
 #include <cassert>
+#include <unordered_map>
+#include "bindings/qjs/atomic_string.h"
 
 namespace webf {
 
 class ContainerNode;
 class Document;
+class Element;
 
 // The root node of a document tree (in which case this is a Document) or of a
 // shadow tree (in which case this is a ShadowRoot). Various things, like
@@ -29,10 +32,24 @@ class TreeScope {
     return *document_;
   }
 
+  // Returns the first element in tree order whose id is |element_id|, without calling into dart side.
+  Element* getElementById(const AtomicString& element_id) const;
+  // Connected elements with an id register themselves, see Element::InsertedInto().
+  void AddElementById(const AtomicString& element_id, Element& element);
+  void RemoveElementById(const AtomicString& element_id, Element& element);
+
  protected:
   explicit TreeScope(Document&);
 
  private:
+  struct IdMapEntry {
+    // The first element in tree order, nullptr when it must be found again after elements sharing the id changed.
+    Element* element;
+    size_t count;
+  };
+
+  // Ids are rarely shared, the elements of shared ids are found by walking the tree when asked for.
+  mutable std::unordered_map<AtomicString, IdMapEntry, AtomicString::KeyHasher> elements_by_id_;
   ContainerNode* root_node_;
   Document* document_;
   TreeScope* parent_tree_scope_;
@@ -14,6 +14,7 @@
 #include "foundation/logging.h"
 #include "polyfill.h"
 #include "qjs_window.h"
+#include "script_compiler.h"
 #include "timing/performance.h"
 
 namespace webf {
@@ -21,7 +22,8 @@ namespace webf {
 static std::atomic<int32_t> context_unique_id{0};
 
 #define MAX_JS_CONTEXT 8192
-bool valid_contexts[MAX_JS_CONTEXT];
+// Contexts are created and destroyed on several JS threads, and checked from any of them.
+std::atomic<bool> valid_contexts[MAX_JS_CONTEXT];
 std::atomic<uint32_t> running_context_list{0};
 
 ExecutingContext::ExecutingContext(DartIsolateContext* dart_isolate_context,
@@ -45,9 +47,11 @@ ExecutingContext::ExecutingContext(DartIsolateContext* dart_isolate_context,
   //  #endif
 
   // @FIXME: maybe contextId will larger than MAX_JS_CONTEXT
-  valid_contexts[contextId] = true;
-  if (contextId > running_context_list)
-    running_context_list = contextId;
+  valid_contexts[contextId].store(true, std::memory_order_release);
+  uint32_t running = running_context_list.load();
+  while (static_cast<uint32_t>(contextId) > running &&
+         !running_context_list.compare_exchange_weak(running, static_cast<uint32_t>(contextId))) {
+  }
 
   time_origin_ = std::chrono::system_clock::now();
 
@@ -91,7 +95,7 @@ ExecutingContext::ExecutingContext(DartIsolateContext* dart_isolate_context,
 
 ExecutingContext::~ExecutingContext() {
   is_context_valid_ = false;
-  valid_contexts[context_id_] = false;
+  valid_contexts[context_id_].store(false, std::memory_order_release);
 
   // Check if current context have unhandled exceptions.
   JSValue exception = JS_GetException(script_state_.ctx());
@@ -172,6 +176,33 @@ bool ExecutingContext::EvaluateByteCode(uint8_t* bytes, size_t byteLength) {
   return true;
 }
 
+bool ExecutingContext::EvaluateCompiledScript(CompiledScript* script,
+                                              uint8_t** parsed_bytecodes,
+                                              uint64_t* bytecode_len) {
+  if (!script->WaitForCompilation()) {
+    return EvaluateJavaScript(script->source().c_str(), script->source().size(), script->url().c_str(), 0);
+  }
+
+  const std::vector<uint8_t>& bytecode = script->bytecode();
+  JSValue result;
+  JSValue function = JS_ReadObject(script_state_.ctx(), bytecode.data(), bytecode.size(), JS_READ_OBJ_BYTECODE);
+  if (JS_IsException(function)) {
+    result = function;
+  } else {
+    result = JS_EvalFunction(script_state_.ctx(), function);
+  }
+  if (parsed_bytecodes != nullptr) {
+    *parsed_bytecodes = static_cast<uint8_t*>(malloc(bytecode.size()));
+    memcpy(*parsed_bytecodes, bytecode.data(), bytecode.size());
+    *bytecode_len = bytecode.size();
+  }
+
+  DrainPendingPromiseJobs();
+  bool success = HandleException(&result);
+  JS_FreeValue(script_state_.ctx(), result);
+  return success;
+}
+
 bool ExecutingContext::IsContextValid() const {
   return is_context_valid_;
 }
@@ -269,8 +300,14 @@ void ExecutingContext::DrainPendingPromiseJobs() {
     }
   }
 
+  // The async binding calls made by the task are sent to dart side at once.
+  async_binding_calls_.Flush();
+
   // Throw error when promise are not handled.
   rejected_promises_.Process(this);
+
+  layout_thrashing_detector_.DidFinishTask();
+  task_sequence_++;
 }
 
 void ExecutingContext::DefineGlobalProperty(const char* prop, JSValue value) {
@@ -324,8 +361,12 @@ static void DispatchPromiseRejectionEvent(const AtomicString& event_type,
   }
 }
 
-void ExecutingContext::FlushUICommand() {
+void ExecutingContext::FlushUICommand(UICommandFlushReason reason) {
   if (!uiCommandBuffer()->empty()) {
+    if (UNLIKELY(layout_thrashing_detector_.enabled())) {
+      layout_thrashing_detector_.RecordForcedFlush(uiCommandBuffer()->size());
+    }
+    uiCommandBuffer()->SetFlushReason(reason);
     dartMethodPtr()->flushUICommand(context_id_);
   }
 }
@@ -445,7 +486,7 @@ void ExecutingContext::InActiveScriptWrappers(ScriptWrappable* script_wrappable)
 bool isContextValid(int32_t contextId) {
   if (contextId > running_context_list)
     return false;
-  return valid_contexts[contextId];
+  return valid_contexts[contextId].load(std::memory_order_acquire);
 }
 
 }  // namespace webf
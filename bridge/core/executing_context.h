@@ -22,6 +22,7 @@
 #include "foundation/macros.h"
 #include "foundation/ui_command_buffer.h"
 
+#include "async_binding_call_queue.h"
 #include "dart_isolate_context.h"
 #include "dart_methods.h"
 #include "executing_context_data.h"
@@ -29,6 +30,7 @@
 #include "frame/module_context_coordinator.h"
 #include "frame/module_listener_container.h"
 #include "script_state.h"
+#include "timing/layout_thrashing_detector.h"
 
 namespace webf {
 
@@ -45,6 +47,7 @@ class MemberMutationScope;
 class ErrorEvent;
 class DartContext;
 class ScriptWrappable;
+class CompiledScript;
 
 using JSExceptionHandler = std::function<void(ExecutingContext* context, const char* message)>;
 
@@ -73,6 +76,9 @@ class ExecutingContext {
   bool EvaluateJavaScript(const char16_t* code, size_t length, const char* sourceURL, int startLine);
   bool EvaluateJavaScript(const char* code, size_t codeLength, const char* sourceURL, int startLine);
   bool EvaluateByteCode(uint8_t* bytes, size_t byteLength);
+  // Runs a script compiled by the ScriptCompiler, waiting for it when it's still compiling. The bytecode is copied to
+  // a malloc'ed |parsed_bytecodes| when given.
+  bool EvaluateCompiledScript(CompiledScript* script, uint8_t** parsed_bytecodes, uint64_t* bytecode_len);
   bool IsContextValid() const;
   bool IsCtxValid() const;
   JSValue Global();
@@ -128,7 +134,11 @@ class ExecutingContext {
   FORCE_INLINE std::chrono::time_point<std::chrono::system_clock> timeOrigin() const { return time_origin_; }
 
   // Force dart side to execute the pending ui commands.
-  void FlushUICommand();
+  void FlushUICommand(UICommandFlushReason reason = UICommandFlushReason::kBindingCall);
+  FORCE_INLINE LayoutThrashingDetector* layoutThrashingDetector() { return &layout_thrashing_detector_; }
+  FORCE_INLINE AsyncBindingCallQueue* asyncBindingCalls() { return &async_binding_calls_; }
+  // Increased every time a task finished running JS and its promise jobs.
+  FORCE_INLINE int64_t taskSequence() const { return task_sequence_; }
 
   void DispatchErrorEvent(ErrorEvent* error_event);
   void DispatchErrorEventInterval(ErrorEvent* error_event);
@@ -188,6 +198,9 @@ class ExecutingContext {
   ExecutionContextData context_data_{this};
   bool in_dispatch_error_event_{false};
   RejectedPromises rejected_promises_;
+  LayoutThrashingDetector layout_thrashing_detector_{this};
+  AsyncBindingCallQueue async_binding_calls_{this};
+  int64_t task_sequence_{0};
   MemberMutationScope* active_mutation_scope{nullptr};
   std::set<ScriptWrappable*> active_wrappers_;
 };
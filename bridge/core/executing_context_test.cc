@@ -6,6 +6,7 @@
 #include "gtest/gtest.h"
 #include "include/webf_bridge.h"
 #include "page.h"
+#include "script_compiler.h"
 #include "webf_test_env.h"
 
 using namespace webf;
@@ -274,9 +275,9 @@ TEST(Context, unrejectPromiseErrorWithMultipleContext) {
 
 TEST(Context, disposeContext) {
   auto mockedDartMethods = TEST_getMockDartMethods(nullptr);
-  void* dart_context = initDartIsolateContext(mockedDartMethods.data(), mockedDartMethods.size());
+  void* dart_context = initDartIsolateContext(mockedDartMethods.data(), mockedDartMethods.size(), 0, 1);
   uint32_t contextId = 0;
-  auto* page = reinterpret_cast<webf::WebFPage*>(allocateNewPage(dart_context, contextId));
+  auto* page = reinterpret_cast<webf::WebFPage*>(allocateNewPage(dart_context, contextId, -1));
   static bool disposed = false;
   page->disposeCallback = [](webf::WebFPage* bridge) { disposed = true; };
   disposePage(dart_context, page);
@@ -342,6 +343,36 @@ TEST(Context, evaluateByteCode) {
   EXPECT_EQ(logCalled, true);
 }
 
+TEST(Context, evaluateCompiledScript) {
+  static bool errorHandlerExecuted = false;
+  static std::vector<std::string> logs;
+  logs.clear();
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logs.emplace_back(message);
+  };
+
+  auto errorHandler = [](int32_t contextId, const char* errmsg) {
+    errorHandlerExecuted = true;
+    EXPECT_STREQ(errmsg, "SyntaxError: unexpected token in expression: ')'\n    at vm://:1:14\n");
+  };
+  auto env = TEST_init(errorHandler);
+  auto script = ScriptCompiler::Shared()->Compile(u"function f(a) { console.log(a * 2); } f(21);", "vm://");
+  auto invalid = ScriptCompiler::Shared()->Compile(u"console.log();)", "vm://");
+  uint8_t* bytes = nullptr;
+  uint64_t byteLen = 0;
+  EXPECT_EQ(env->page()->evaluateCompiledScript(script.get(), &bytes, &byteLen), true);
+  EXPECT_EQ(errorHandlerExecuted, false);
+  EXPECT_EQ(env->page()->evaluateCompiledScript(invalid.get(), nullptr, nullptr), false);
+  EXPECT_EQ(errorHandlerExecuted, true);
+
+  // The bytecode handed out runs like the one from dumpByteCode().
+  env->page()->evaluateByteCode(bytes, byteLen);
+  free(bytes);
+  ASSERT_EQ(logs.size(), 2);
+  EXPECT_EQ(logs[0], "42");
+  EXPECT_EQ(logs[1], "42");
+}
+
 TEST(jsValueToNativeString, utf8String) {
   auto env = TEST_init([](int32_t contextId, const char* errmsg) {});
   JSValue str = JS_NewString(env->page()->GetExecutingContext()->ctx(), "helloworld");
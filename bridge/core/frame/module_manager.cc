@@ -20,6 +20,12 @@ NativeValue* handleInvokeModuleTransientCallback(void* ptr,
                                                  int32_t contextId,
                                                  const char* errmsg,
                                                  NativeValue* extra_data) {
+  // The result is returned to dart side, so the dart thread waits for it.
+  if (JSThreadDispatcher* dispatcher = JSThreadDispatcher::FromDartThread()) {
+    return dispatcher->PostToJSSync<NativeValue*>(
+        contextId, [&]() { return handleInvokeModuleTransientCallback(ptr, contextId, errmsg, extra_data); });
+  }
+
   auto* moduleContext = static_cast<ModuleContext*>(ptr);
   ExecutingContext* context = moduleContext->context;
 
@@ -1,10 +1,10 @@
 import {EventTarget} from "../dom/events/event_target";
 
 export interface Screen extends EventTarget {
-  readonly availWidth: DartImpl<int64>;
-  readonly availHeight: DartImpl<int64>;
-  readonly width: DartImpl<int64>;
-  readonly height: DartImpl<int64>;
+  readonly availWidth: DartImpl<int64, 'size'>;
+  readonly availHeight: DartImpl<int64, 'size'>;
+  readonly width: DartImpl<int64, 'size'>;
+  readonly height: DartImpl<int64, 'size'>;
 
   new(): void;
 }
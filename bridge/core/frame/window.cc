@@ -194,10 +194,25 @@ void Window::postMessage(const ScriptValue& message,
 }
 
 ComputedCssStyleDeclaration* Window::getComputedStyle(Element* element, ExceptionState& exception_state) {
+  if (UNLIKELY(element == nullptr)) {
+    exception_state.ThrowException(ctx(), ErrorType::TypeError,
+                                   "Failed to execute 'getComputedStyle' on 'Window': parameter 1 is not of type "
+                                   "'Element'.");
+    return nullptr;
+  }
+  // The declaration is live, so the one created before for |element| can be returned again.
+  if (ComputedCssStyleDeclaration* computed_style = element->CachedComputedStyle()) {
+    return computed_style;
+  }
   NativeValue arguments[] = {NativeValueConverter<NativeTypePointer<Element>>::ToNativeValue(element)};
   NativeValue result = InvokeBindingMethod(binding_call_methods::kgetComputedStyle, 1, arguments, exception_state);
-  return MakeGarbageCollected<ComputedCssStyleDeclaration>(
+  if (UNLIKELY(exception_state.HasException())) {
+    return nullptr;
+  }
+  auto* computed_style = MakeGarbageCollected<ComputedCssStyleDeclaration>(
       GetExecutingContext(), NativeValueConverter<NativeTypePointer<NativeBindingObject>>::FromNativeValue(result));
+  element->SetCachedComputedStyle(computed_style);
+  return computed_style;
 }
 
 ComputedCssStyleDeclaration* Window::getComputedStyle(Element* element,
@@ -32,14 +32,14 @@ interface Window extends EventTarget, WindowEventHandlers, GlobalEventHandlers {
   readonly self: Window;
   readonly screen: Screen;
 
-  readonly scrollX: DartImpl<double>;
-  readonly scrollY: DartImpl<double>;
-  readonly pageXOffset: DartImpl<double>;
-  readonly pageYOffset: DartImpl<double>;
-  readonly devicePixelRatio: DartImpl<double>;
+  readonly scrollX: DartImpl<double, 'viewport'>;
+  readonly scrollY: DartImpl<double, 'viewport'>;
+  readonly pageXOffset: DartImpl<double, 'viewport'>;
+  readonly pageYOffset: DartImpl<double, 'viewport'>;
+  readonly devicePixelRatio: DartImpl<double, 'viewport'>;
   readonly colorScheme: DartImpl<string>;
-  readonly innerWidth: DartImpl<double>;
-  readonly innerHeight: DartImpl<double>;
+  readonly innerWidth: DartImpl<double, 'viewport'>;
+  readonly innerHeight: DartImpl<double, 'viewport'>;
 
   new(): void;
 }
@@ -25,6 +25,11 @@ static void handleTimerCallback(DOMTimer* timer, const char* errmsg) {
 }
 
 static void handleTransientCallback(void* ptr, int32_t contextId, const char* errmsg) {
+  if (JSThreadDispatcher* dispatcher = JSThreadDispatcher::FromDartThread()) {
+    dispatcher->PostCallbackToJS(contextId, handleTransientCallback, ptr, contextId, errmsg);
+    return;
+  }
+
   if (!isContextValid(contextId))
     return;
 
@@ -46,6 +51,11 @@ static void handleTransientCallback(void* ptr, int32_t contextId, const char* er
 }
 
 static void handlePersistentCallback(void* ptr, int32_t contextId, const char* errmsg) {
+  if (JSThreadDispatcher* dispatcher = JSThreadDispatcher::FromDartThread()) {
+    dispatcher->PostCallbackToJS(contextId, handlePersistentCallback, ptr, contextId, errmsg);
+    return;
+  }
+
   if (!isContextValid(contextId))
     return;
 
@@ -4,6 +4,8 @@
  */
 
 #include "window.h"
+#include "binding_call_methods.h"
+#include "bindings/qjs/native_string_utils.h"
 #include "gtest/gtest.h"
 #include "webf_test_env.h"
 
@@ -165,4 +167,140 @@ TEST(Window, btoaToEmpty) {
   std::string code = std::string("atob(' ')");
   env->page()->evaluateScript(code.c_str(), code.size(), "vm://", 0);
   EXPECT_EQ(errorCalled, false);
-}
\ No newline at end of file
+}
+
+static int32_t get_properties_calls = 0;
+
+// Plays the dart side of reading a group of properties, the value of every property is its position plus one.
+static void ReturnPropertyValues(const NativeBindingObject* binding_object,
+                                 NativeValue* return_value,
+                                 NativeValue* method,
+                                 int32_t argc,
+                                 const NativeValue* argv) {
+  EXPECT_EQ(method->u.int64, BindingMethodCallOperations::kGetProperties);
+  get_properties_calls++;
+  auto* values = static_cast<NativeValue*>(malloc(sizeof(NativeValue) * argc));
+  for (int32_t i = 0; i < argc; i++) {
+    // The names are sent as ids.
+    EXPECT_EQ(argv[i].tag, NativeTag::TAG_INT);
+    values[i] = Native_NewFloat64(i + 1);
+  }
+  *return_value = Native_NewList(argc, values);
+}
+
+TEST(Window, readViewportPropertiesWithOneCall) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "6 7 5");
+  };
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->GetExecutingContext();
+  context->window()->bindingObject()->invoke_bindings_methods_from_native = ReturnPropertyValues;
+  get_properties_calls = 0;
+
+  const char* code = "console.log(window.innerWidth, window.innerHeight, window.devicePixelRatio);";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  EXPECT_EQ(get_properties_calls, 1);
+  EXPECT_EQ(logCalled, true);
+
+  // The values may change once the layout did.
+  context->uiCommandBuffer()->InvalidateLayout();
+  const char* code2 = "window.innerWidth;";
+  env->page()->evaluateScript(code2, strlen(code2), "vm://", 0);
+  EXPECT_EQ(get_properties_calls, 2);
+
+  context->window()->bindingObject()->invoke_bindings_methods_from_native = nullptr;
+  EXPECT_EQ(errorCalled, false);
+}
+
+TEST(Window, bindingCallMethodIds) {
+  auto env = TEST_init();
+  int64_t index = binding_call_methods::IndexOf(binding_call_methods::kinnerWidth);
+  EXPECT_EQ(index >= 0, true);
+  EXPECT_EQ(&binding_call_methods::NameAt(index), &binding_call_methods::kinnerWidth);
+
+  // Equal strings which are not the declared names are sent as strings.
+  AtomicString inner_width(env->page()->GetExecutingContext()->ctx(), "innerWidth");
+  EXPECT_EQ(binding_call_methods::IndexOf(inner_width), -1);
+}
+
+static int32_t get_property_values_calls = 0;
+static int32_t get_property_values_argc = 0;
+
+// Plays the dart side of a computed style declaration, the value of every property is its name with a `v-` prefix.
+static void ReturnComputedValues(const NativeBindingObject* binding_object,
+                                 NativeValue* return_value,
+                                 NativeValue* method,
+                                 int32_t argc,
+                                 const NativeValue* argv) {
+  EXPECT_EQ(method->u.int64,
+            kBindingCallMethodIdOffset + binding_call_methods::IndexOf(binding_call_methods::kgetPropertyValues));
+  get_property_values_calls++;
+  get_property_values_argc = argc;
+  auto* values = static_cast<NativeValue*>(malloc(sizeof(NativeValue) * argc));
+  for (int32_t i = 0; i < argc; i++) {
+    auto* name = static_cast<SharedNativeString*>(argv[i].u.ptr);
+    values[i] = Native_NewCString("v-" + nativeStringToStdString(name));
+  }
+  *return_value = Native_NewList(argc, values);
+}
+
+static NativeBindingObject* computed_style_binding_object = nullptr;
+
+static void ReturnComputedStyle(const NativeBindingObject* binding_object,
+                                NativeValue* return_value,
+                                NativeValue* method,
+                                int32_t argc,
+                                const NativeValue* argv) {
+  EXPECT_EQ(method->u.int64,
+            kBindingCallMethodIdOffset + binding_call_methods::IndexOf(binding_call_methods::kgetComputedStyle));
+  computed_style_binding_object = new NativeBindingObject(nullptr);
+  computed_style_binding_object->invoke_bindings_methods_from_native = ReturnComputedValues;
+  *return_value = Native_NewPtr(JSPointerType::Others, computed_style_binding_object);
+}
+
+TEST(Window, computedStyleSnapshot) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "true v-opacity v-transform v-opacity");
+  };
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->GetExecutingContext();
+  context->window()->bindingObject()->invoke_bindings_methods_from_native = ReturnComputedStyle;
+  get_property_values_calls = 0;
+
+  const char* code =
+      "var div = document.createElement('div');"
+      "document.body.appendChild(div);"
+      "var style = getComputedStyle(div);"
+      "console.log(style === getComputedStyle(div), style.getPropertyValue('opacity'), "
+      "style.getPropertyValue('transform'), style.getPropertyValue('opacity'));";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  // Each property is fetched once, the repeated read is answered from the snapshot.
+  EXPECT_EQ(get_property_values_calls, 2);
+  EXPECT_EQ(logCalled, true);
+
+  // The snapshot outlives the task, until the layout may have changed.
+  const char* code2 = "style.getPropertyValue('transform'); style.getPropertyValue('opacity');";
+  env->page()->evaluateScript(code2, strlen(code2), "vm://", 0);
+  EXPECT_EQ(get_property_values_calls, 2);
+
+  // Then every property read so far is fetched again in one call.
+  context->uiCommandBuffer()->InvalidateLayout();
+  env->page()->evaluateScript(code2, strlen(code2), "vm://", 0);
+  EXPECT_EQ(get_property_values_calls, 3);
+  EXPECT_EQ(get_property_values_argc, 2);
+
+  context->window()->bindingObject()->invoke_bindings_methods_from_native = nullptr;
+  EXPECT_EQ(errorCalled, false);
+}
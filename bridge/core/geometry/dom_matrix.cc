@@ -3,18 +3,81 @@
  */
 
 #include "dom_matrix.h"
+#include <limits>
+#include "core/executing_context.h"
 
 namespace webf {
 
+DOMMatrix* DOMMatrix::Create(ExecutingContext* context, ExceptionState& exception_state) {
+  return MakeGarbageCollected<DOMMatrix>(context);
+}
+
 DOMMatrix* DOMMatrix::Create(ExecutingContext* context,
                              const std::shared_ptr<QJSUnionDomStringSequenceDouble>& init,
                              ExceptionState& exception_state) {
   return MakeGarbageCollected<DOMMatrix>(context, init, exception_state);
 }
 
+DOMMatrix* DOMMatrix::Create(ExecutingContext* context, const TransformationMatrix& matrix, bool is_2d) {
+  return MakeGarbageCollected<DOMMatrix>(context, matrix, is_2d);
+}
+
+DOMMatrix::DOMMatrix(ExecutingContext* context) : DOMMatrixReadonly(context) {}
+
 DOMMatrix::DOMMatrix(ExecutingContext* context,
                      const std::shared_ptr<QJSUnionDomStringSequenceDouble>& init,
                      ExceptionState& exception_state)
     : DOMMatrixReadonly(context, init, exception_state) {}
 
-}  // namespace webf
\ No newline at end of file
+DOMMatrix::DOMMatrix(ExecutingContext* context, const TransformationMatrix& matrix, bool is_2d)
+    : DOMMatrixReadonly(context, matrix, is_2d) {}
+
+DOMMatrix* DOMMatrix::multiplySelf(DOMMatrixReadonly* other, ExceptionState& exception_state) {
+  matrix_.Multiply(other->matrix());
+  is_2d_ = is_2d_ && other->is2D();
+  return this;
+}
+
+DOMMatrix* DOMMatrix::preMultiplySelf(DOMMatrixReadonly* other, ExceptionState& exception_state) {
+  matrix_.PreMultiply(other->matrix());
+  is_2d_ = is_2d_ && other->is2D();
+  return this;
+}
+
+DOMMatrix* DOMMatrix::invertSelf(ExceptionState& exception_state) {
+  TransformationMatrix inverse;
+  if (matrix_.Inverse(inverse)) {
+    matrix_ = inverse;
+    return this;
+  }
+
+  // A matrix which is not invertible becomes a 3D matrix of NaN values.
+  double values[TransformationMatrix::kSize];
+  std::fill(values, values + TransformationMatrix::kSize, std::numeric_limits<double>::quiet_NaN());
+  matrix_ = TransformationMatrix::FromColumnMajor(values);
+  is_2d_ = false;
+  return this;
+}
+
+DOMMatrix* DOMMatrix::translateSelf(double tx, double ty, double tz, ExceptionState& exception_state) {
+  matrix_.Translate(tx, ty, tz);
+  if (tz != 0)
+    is_2d_ = false;
+  return this;
+}
+
+DOMMatrix* DOMMatrix::scaleSelf(double scale_x, double scale_y, double scale_z, ExceptionState& exception_state) {
+  matrix_.Scale(scale_x, scale_y, scale_z);
+  if (scale_z != 1)
+    is_2d_ = false;
+  return this;
+}
+
+DOMMatrix* DOMMatrix::rotateSelf(double rot_x, double rot_y, double rot_z, ExceptionState& exception_state) {
+  matrix_.Rotate(rot_x, rot_y, rot_z);
+  if (rot_x != 0 || rot_y != 0)
+    is_2d_ = false;
+  return this;
+}
+
+}  // namespace webf
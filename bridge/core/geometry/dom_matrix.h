@@ -13,16 +13,83 @@ class DOMMatrix : public DOMMatrixReadonly {
   DEFINE_WRAPPERTYPEINFO();
 
  public:
+  using ImplType = DOMMatrix*;
+  static DOMMatrix* Create(ExecutingContext* context, ExceptionState& exception_state);
   static DOMMatrix* Create(ExecutingContext* context,
                            const std::shared_ptr<QJSUnionDomStringSequenceDouble>& init,
                            ExceptionState& exception_state);
+  static DOMMatrix* Create(ExecutingContext* context, const TransformationMatrix& matrix, bool is_2d);
 
   DOMMatrix() = delete;
+  explicit DOMMatrix(ExecutingContext* context);
   explicit DOMMatrix(ExecutingContext* context,
                      const std::shared_ptr<QJSUnionDomStringSequenceDouble>& init,
                      ExceptionState& exception_state);
+  explicit DOMMatrix(ExecutingContext* context, const TransformationMatrix& matrix, bool is_2d);
+
+  void setA(double value, ExceptionState& exception_state) { matrix_.Set(1, 1, value); }
+  void setB(double value, ExceptionState& exception_state) { matrix_.Set(1, 2, value); }
+  void setC(double value, ExceptionState& exception_state) { matrix_.Set(2, 1, value); }
+  void setD(double value, ExceptionState& exception_state) { matrix_.Set(2, 2, value); }
+  void setE(double value, ExceptionState& exception_state) { matrix_.Set(4, 1, value); }
+  void setF(double value, ExceptionState& exception_state) { matrix_.Set(4, 2, value); }
+
+  void setM11(double value, ExceptionState& exception_state) { matrix_.Set(1, 1, value); }
+  void setM12(double value, ExceptionState& exception_state) { matrix_.Set(1, 2, value); }
+  void setM13(double value, ExceptionState& exception_state) { Set3DComponent(1, 3, value, 0); }
+  void setM14(double value, ExceptionState& exception_state) { Set3DComponent(1, 4, value, 0); }
+  void setM21(double value, ExceptionState& exception_state) { matrix_.Set(2, 1, value); }
+  void setM22(double value, ExceptionState& exception_state) { matrix_.Set(2, 2, value); }
+  void setM23(double value, ExceptionState& exception_state) { Set3DComponent(2, 3, value, 0); }
+  void setM24(double value, ExceptionState& exception_state) { Set3DComponent(2, 4, value, 0); }
+  void setM31(double value, ExceptionState& exception_state) { Set3DComponent(3, 1, value, 0); }
+  void setM32(double value, ExceptionState& exception_state) { Set3DComponent(3, 2, value, 0); }
+  void setM33(double value, ExceptionState& exception_state) { Set3DComponent(3, 3, value, 1); }
+  void setM34(double value, ExceptionState& exception_state) { Set3DComponent(3, 4, value, 0); }
+  void setM41(double value, ExceptionState& exception_state) { matrix_.Set(4, 1, value); }
+  void setM42(double value, ExceptionState& exception_state) { matrix_.Set(4, 2, value); }
+  void setM43(double value, ExceptionState& exception_state) { Set3DComponent(4, 3, value, 0); }
+  void setM44(double value, ExceptionState& exception_state) { Set3DComponent(4, 4, value, 1); }
+
+  DOMMatrix* multiplySelf(DOMMatrixReadonly* other, ExceptionState& exception_state);
+  DOMMatrix* preMultiplySelf(DOMMatrixReadonly* other, ExceptionState& exception_state);
+  DOMMatrix* invertSelf(ExceptionState& exception_state);
+
+  DOMMatrix* translateSelf(ExceptionState& exception_state) { return this; }
+  DOMMatrix* translateSelf(double tx, ExceptionState& exception_state) {
+    return translateSelf(tx, 0, 0, exception_state);
+  }
+  DOMMatrix* translateSelf(double tx, double ty, ExceptionState& exception_state) {
+    return translateSelf(tx, ty, 0, exception_state);
+  }
+  DOMMatrix* translateSelf(double tx, double ty, double tz, ExceptionState& exception_state);
+
+  DOMMatrix* scaleSelf(ExceptionState& exception_state) { return this; }
+  DOMMatrix* scaleSelf(double scale_x, ExceptionState& exception_state) {
+    return scaleSelf(scale_x, scale_x, 1, exception_state);
+  }
+  DOMMatrix* scaleSelf(double scale_x, double scale_y, ExceptionState& exception_state) {
+    return scaleSelf(scale_x, scale_y, 1, exception_state);
+  }
+  DOMMatrix* scaleSelf(double scale_x, double scale_y, double scale_z, ExceptionState& exception_state);
+
+  DOMMatrix* rotateSelf(ExceptionState& exception_state) { return this; }
+  // A single angle rotates around the z axis.
+  DOMMatrix* rotateSelf(double rot_x, ExceptionState& exception_state) {
+    return rotateSelf(0, 0, rot_x, exception_state);
+  }
+  DOMMatrix* rotateSelf(double rot_x, double rot_y, ExceptionState& exception_state) {
+    return rotateSelf(rot_x, rot_y, 0, exception_state);
+  }
+  DOMMatrix* rotateSelf(double rot_x, double rot_y, double rot_z, ExceptionState& exception_state);
 
  private:
+  // The matrix is no longer 2D once a component out of the 2D matrix differs from the identity matrix.
+  void Set3DComponent(size_t column, size_t row, double value, double identity_value) {
+    matrix_.Set(column, row, value);
+    if (value != identity_value)
+      is_2d_ = false;
+  }
 };
 
 }  // namespace webf
@@ -3,37 +3,170 @@
  */
 
 #include "dom_matrix_readonly.h"
-#include "foundation/native_value_converter.h"
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "core/executing_context.h"
+#include "dom_matrix.h"
 
 namespace webf {
 
+static bool IsWhitespace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+static void SkipWhitespace(const std::string& input, size_t& position) {
+  while (position < input.size() && IsWhitespace(input[position]))
+    position++;
+}
+
+// Parses the arguments of a transform function after its "(", e.g. "1, 0, 0, 1, 0, 0)".
+static bool ParseArguments(const std::string& input, size_t& position, std::vector<double>& values) {
+  while (true) {
+    SkipWhitespace(input, position);
+    const char* start = input.c_str() + position;
+    char* end = nullptr;
+    double value = std::strtod(start, &end);
+    if (end == start)
+      return false;
+    values.emplace_back(value);
+    position += end - start;
+    SkipWhitespace(input, position);
+    if (position >= input.size())
+      return false;
+    if (input[position] == ')') {
+      position++;
+      return true;
+    }
+    if (input[position] != ',')
+      return false;
+    position++;
+  }
+}
+
+// Only the matrix() and matrix3d() functions are supported, the functions are multiplied from left to right.
+static bool ParseTransformList(const std::string& input, TransformationMatrix& matrix, bool& is_2d) {
+  size_t position = 0;
+  SkipWhitespace(input, position);
+  if (position == input.size() || input.compare(position, std::string::npos, "none") == 0)
+    return true;
+
+  while (position < input.size()) {
+    static const std::string kMatrix3d = "matrix3d(";
+    static const std::string kMatrix = "matrix(";
+    std::vector<double> values;
+    if (input.compare(position, kMatrix3d.size(), kMatrix3d) == 0) {
+      position += kMatrix3d.size();
+      if (!ParseArguments(input, position, values) || values.size() != TransformationMatrix::kSize)
+        return false;
+      matrix.Multiply(TransformationMatrix::FromColumnMajor(values.data()));
+      is_2d = false;
+    } else if (input.compare(position, kMatrix.size(), kMatrix) == 0) {
+      position += kMatrix.size();
+      if (!ParseArguments(input, position, values) || values.size() != 6)
+        return false;
+      matrix.Multiply(TransformationMatrix::Affine(values[0], values[1], values[2], values[3], values[4], values[5]));
+    } else {
+      return false;
+    }
+    SkipWhitespace(input, position);
+  }
+  return true;
+}
+
+static void AppendNumber(JSContext* ctx, std::string& result, double value) {
+  // Serialize the number the same as JS.
+  JSValue number = JS_NewFloat64(ctx, value);
+  const char* string = JS_ToCString(ctx, number);
+  result += string;
+  JS_FreeCString(ctx, string);
+  JS_FreeValue(ctx, number);
+}
+
+DOMMatrixReadonly* DOMMatrixReadonly::Create(ExecutingContext* context, ExceptionState& exception_state) {
+  return MakeGarbageCollected<DOMMatrixReadonly>(context);
+}
+
 DOMMatrixReadonly* DOMMatrixReadonly::Create(ExecutingContext* context,
                                              const std::shared_ptr<QJSUnionDomStringSequenceDouble>& init,
                                              ExceptionState& exception_state) {
   return MakeGarbageCollected<DOMMatrixReadonly>(context, init, exception_state);
 }
 
+DOMMatrixReadonly::DOMMatrixReadonly(ExecutingContext* context) : ScriptWrappable(context->ctx()) {}
+
 DOMMatrixReadonly::DOMMatrixReadonly(ExecutingContext* context,
                                      const std::shared_ptr<QJSUnionDomStringSequenceDouble>& init,
                                      ExceptionState& exception_state)
-    : BindingObject(context->ctx()) {
-  assert(GetExecutingContext()->dartMethodPtr()->create_binding_object != nullptr);
-
-  NativeValue arguments[1];
+    : ScriptWrappable(context->ctx()) {
   if (init->IsDomString()) {
-    arguments[0] = NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), init->GetAsDomString());
+    std::string string = init->GetAsDomString().ToStdString(ctx());
+    if (!ParseTransformList(string, matrix_, is_2d_)) {
+      exception_state.ThrowException(ctx(), ErrorType::SyntaxError,
+                                     "Failed to parse '" + string + "' as a matrix() or matrix3d() transform list.");
+    }
   } else if (init->IsSequenceDouble()) {
-    arguments[0] = NativeValueConverter<NativeTypeArray<NativeTypeDouble>>::ToNativeValue(init->GetAsSequenceDouble());
+    const std::vector<double>& values = init->GetAsSequenceDouble();
+    if (values.size() == 6) {
+      matrix_ = TransformationMatrix::Affine(values[0], values[1], values[2], values[3], values[4], values[5]);
+    } else if (values.size() == TransformationMatrix::kSize) {
+      matrix_ = TransformationMatrix::FromColumnMajor(values.data());
+      is_2d_ = false;
+    } else {
+      exception_state.ThrowException(ctx(), ErrorType::TypeError,
+                                     "The sequence must contain 6 elements for a 2D matrix or 16 for a 3D matrix.");
+    }
   }
-  GetExecutingContext()->dartMethodPtr()->create_binding_object(
-      GetExecutingContext()->contextId(), bindingObject(), CreateBindingObjectType::kCreateDOMMatrix, arguments, 1);
 }
 
-NativeValue DOMMatrixReadonly::HandleCallFromDartSide(const AtomicString& method,
-                                                      int32_t argc,
-                                                      const NativeValue* argv,
-                                                      Dart_Handle dart_object) {
-  return Native_NewNull();
+DOMMatrixReadonly::DOMMatrixReadonly(ExecutingContext* context, const TransformationMatrix& matrix, bool is_2d)
+    : ScriptWrappable(context->ctx()), matrix_(matrix), is_2d_(is_2d) {}
+
+DOMMatrix* DOMMatrixReadonly::multiply(DOMMatrixReadonly* other, ExceptionState& exception_state) const {
+  return DOMMatrix::Create(GetExecutingContext(), matrix_, is_2d_)->multiplySelf(other, exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::inverse(ExceptionState& exception_state) const {
+  return DOMMatrix::Create(GetExecutingContext(), matrix_, is_2d_)->invertSelf(exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::translate(double tx, double ty, double tz, ExceptionState& exception_state) const {
+  return DOMMatrix::Create(GetExecutingContext(), matrix_, is_2d_)->translateSelf(tx, ty, tz, exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::scale(double scale_x,
+                                    double scale_y,
+                                    double scale_z,
+                                    ExceptionState& exception_state) const {
+  return DOMMatrix::Create(GetExecutingContext(), matrix_, is_2d_)
+      ->scaleSelf(scale_x, scale_y, scale_z, exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::rotate(double rot_x, double rot_y, double rot_z, ExceptionState& exception_state) const {
+  return DOMMatrix::Create(GetExecutingContext(), matrix_, is_2d_)->rotateSelf(rot_x, rot_y, rot_z, exception_state);
+}
+
+AtomicString DOMMatrixReadonly::toString(ExceptionState& exception_state) const {
+  std::string result;
+  if (is_2d_) {
+    const double values[] = {a(), b(), c(), d(), e(), f()};
+    result = "matrix(";
+    for (size_t i = 0; i < 6; i++) {
+      if (i > 0)
+        result += ", ";
+      AppendNumber(ctx(), result, values[i]);
+    }
+  } else {
+    const double* values = matrix_.Data();
+    result = "matrix3d(";
+    for (size_t i = 0; i < TransformationMatrix::kSize; i++) {
+      if (i > 0)
+        result += ", ";
+      AppendNumber(ctx(), result, values[i]);
+    }
+  }
+  result += ")";
+  return AtomicString(ctx(), result);
 }
 
-}  // namespace webf
\ No newline at end of file
+}  // namespace webf
@@ -1,3 +1,33 @@
 interface DOMMatrixReadonly {
-  new(init: string | double[]): DOMMatrix;
-}
\ No newline at end of file
+  readonly a: double;
+  readonly b: double;
+  readonly c: double;
+  readonly d: double;
+  readonly e: double;
+  readonly f: double;
+  readonly m11: double;
+  readonly m12: double;
+  readonly m13: double;
+  readonly m14: double;
+  readonly m21: double;
+  readonly m22: double;
+  readonly m23: double;
+  readonly m24: double;
+  readonly m31: double;
+  readonly m32: double;
+  readonly m33: double;
+  readonly m34: double;
+  readonly m41: double;
+  readonly m42: double;
+  readonly m43: double;
+  readonly m44: double;
+  readonly is2D: boolean;
+  readonly isIdentity: boolean;
+  multiply(other: DOMMatrixReadonly): DOMMatrix;
+  inverse(): DOMMatrix;
+  translate(tx?: double, ty?: double, tz?: double): DOMMatrix;
+  scale(scaleX?: double, scaleY?: double, scaleZ?: double): DOMMatrix;
+  rotate(rotX?: double, rotY?: double, rotZ?: double): DOMMatrix;
+  toString(): string;
+  new(init?: string | double[]): DOMMatrix;
+}
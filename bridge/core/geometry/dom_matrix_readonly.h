@@ -6,29 +6,97 @@
 #define WEBF_CORE_GEOMETRY_DOM_MATRIX_READONLY_H_
 
 #include "bindings/qjs/script_wrappable.h"
-#include "core/binding_object.h"
 #include "qjs_union_dom_string_sequencedouble.h"
+#include "transformation_matrix.h"
 
 namespace webf {
 
-class DOMMatrixReadonly : public BindingObject {
+class DOMMatrix;
+
+// DOMMatrix and DOMMatrixReadonly are implemented at C++ side, the values are sent to dart side only when a matrix is
+// applied, e.g. CanvasPattern.setTransform().
+class DOMMatrixReadonly : public ScriptWrappable {
   DEFINE_WRAPPERTYPEINFO();
 
  public:
   using ImplType = DOMMatrixReadonly*;
+  static DOMMatrixReadonly* Create(ExecutingContext* context, ExceptionState& exception_state);
   static DOMMatrixReadonly* Create(ExecutingContext* context,
                                    const std::shared_ptr<QJSUnionDomStringSequenceDouble>& init,
                                    ExceptionState& exception_state);
 
   DOMMatrixReadonly() = delete;
+  explicit DOMMatrixReadonly(ExecutingContext* context);
   explicit DOMMatrixReadonly(ExecutingContext* context,
                              const std::shared_ptr<QJSUnionDomStringSequenceDouble>& init,
                              ExceptionState& exception_state);
+  explicit DOMMatrixReadonly(ExecutingContext* context, const TransformationMatrix& matrix, bool is_2d);
+
+  double a() const { return matrix_.At(1, 1); }
+  double b() const { return matrix_.At(1, 2); }
+  double c() const { return matrix_.At(2, 1); }
+  double d() const { return matrix_.At(2, 2); }
+  double e() const { return matrix_.At(4, 1); }
+  double f() const { return matrix_.At(4, 2); }
+
+  double m11() const { return matrix_.At(1, 1); }
+  double m12() const { return matrix_.At(1, 2); }
+  double m13() const { return matrix_.At(1, 3); }
+  double m14() const { return matrix_.At(1, 4); }
+  double m21() const { return matrix_.At(2, 1); }
+  double m22() const { return matrix_.At(2, 2); }
+  double m23() const { return matrix_.At(2, 3); }
+  double m24() const { return matrix_.At(2, 4); }
+  double m31() const { return matrix_.At(3, 1); }
+  double m32() const { return matrix_.At(3, 2); }
+  double m33() const { return matrix_.At(3, 3); }
+  double m34() const { return matrix_.At(3, 4); }
+  double m41() const { return matrix_.At(4, 1); }
+  double m42() const { return matrix_.At(4, 2); }
+  double m43() const { return matrix_.At(4, 3); }
+  double m44() const { return matrix_.At(4, 4); }
+
+  bool is2D() const { return is_2d_; }
+  bool isIdentity() const { return matrix_.IsIdentity(); }
+
+  DOMMatrix* multiply(DOMMatrixReadonly* other, ExceptionState& exception_state) const;
+  DOMMatrix* inverse(ExceptionState& exception_state) const;
+
+  DOMMatrix* translate(ExceptionState& exception_state) const { return translate(0, 0, 0, exception_state); }
+  DOMMatrix* translate(double tx, ExceptionState& exception_state) const {
+    return translate(tx, 0, 0, exception_state);
+  }
+  DOMMatrix* translate(double tx, double ty, ExceptionState& exception_state) const {
+    return translate(tx, ty, 0, exception_state);
+  }
+  DOMMatrix* translate(double tx, double ty, double tz, ExceptionState& exception_state) const;
+
+  DOMMatrix* scale(ExceptionState& exception_state) const { return scale(1, 1, 1, exception_state); }
+  DOMMatrix* scale(double scale_x, ExceptionState& exception_state) const {
+    return scale(scale_x, scale_x, 1, exception_state);
+  }
+  DOMMatrix* scale(double scale_x, double scale_y, ExceptionState& exception_state) const {
+    return scale(scale_x, scale_y, 1, exception_state);
+  }
+  DOMMatrix* scale(double scale_x, double scale_y, double scale_z, ExceptionState& exception_state) const;
+
+  DOMMatrix* rotate(ExceptionState& exception_state) const { return rotate(0, 0, 0, exception_state); }
+  // A single angle rotates around the z axis.
+  DOMMatrix* rotate(double rot_x, ExceptionState& exception_state) const {
+    return rotate(0, 0, rot_x, exception_state);
+  }
+  DOMMatrix* rotate(double rot_x, double rot_y, ExceptionState& exception_state) const {
+    return rotate(rot_x, rot_y, 0, exception_state);
+  }
+  DOMMatrix* rotate(double rot_x, double rot_y, double rot_z, ExceptionState& exception_state) const;
+
+  AtomicString toString(ExceptionState& exception_state) const;
+
+  const TransformationMatrix& matrix() const { return matrix_; }
 
-  NativeValue HandleCallFromDartSide(const AtomicString& method,
-                                     int32_t argc,
-                                     const NativeValue* argv,
-                                     Dart_Handle dart_object) override;
+ protected:
+  TransformationMatrix matrix_;
+  bool is_2d_{true};
 };
 
 }  // namespace webf
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "gtest/gtest.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+TEST(DOMMatrix, transformations) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    EXPECT_STREQ(message.c_str(), "matrix(1, 0, 0, 1, 10, 20) matrix(2, 0, 0, 2, 10, 10) matrix(0.5, 0, 0, 0.5, 0, 0)");
+    logCalled = true;
+  };
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  const char* code =
+      "let translated = new DOMMatrix().translate(10, 20);"
+      "let scaled = new DOMMatrix([2, 0, 0, 2, 0, 0]);"
+      "let multiplied = scaled.multiply(new DOMMatrix([1, 0, 0, 1, 5, 5]));"
+      "console.log(translated.toString(), multiplied.toString(), scaled.inverse().toString());";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+TEST(DOMMatrix, is2D) {
+  bool static errorCalled = false;
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  const char* code =
+      "let matrix = new DOMMatrix('matrix(1, 2, 3, 4, 5, 6)');"
+      "console.assert(matrix.is2D && matrix.m21 === 3 && matrix.f === 6);"
+      "matrix.translateSelf(0, 0, 1);"
+      "console.assert(!matrix.is2D && matrix.m43 === 1);"
+      "console.assert(new DOMMatrix([1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1]).isIdentity);"
+      "try { new DOMMatrix('scale(2)'); console.assert(false); }"
+      "catch (e) { console.assert(e instanceof SyntaxError); }";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+
+  EXPECT_EQ(errorCalled, false);
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "transformation_matrix.h"
+#include <cmath>
+#include <cstring>
+
+namespace webf {
+
+static constexpr double kDegreesToRadians = 3.14159265358979323846 / 180.0;
+
+// result = left * right. |result| must not alias the operands.
+static void MultiplyMatrices(const double (&left)[4][4], const double (&right)[4][4], double (&result)[4][4]) {
+  for (size_t column = 0; column < 4; column++) {
+    // Every column of the result is a linear combination of the columns of |left|.
+    for (size_t row = 0; row < 4; row++) {
+      result[column][row] = left[0][row] * right[column][0];
+    }
+    for (size_t k = 1; k < 4; k++) {
+      double factor = right[column][k];
+      for (size_t row = 0; row < 4; row++) {
+        result[column][row] += left[k][row] * factor;
+      }
+    }
+  }
+}
+
+TransformationMatrix::TransformationMatrix() {
+  std::memset(m_, 0, sizeof(m_));
+  m_[0][0] = m_[1][1] = m_[2][2] = m_[3][3] = 1;
+}
+
+TransformationMatrix TransformationMatrix::Affine(double a, double b, double c, double d, double e, double f) {
+  TransformationMatrix matrix;
+  matrix.m_[0][0] = a;
+  matrix.m_[0][1] = b;
+  matrix.m_[1][0] = c;
+  matrix.m_[1][1] = d;
+  matrix.m_[3][0] = e;
+  matrix.m_[3][1] = f;
+  return matrix;
+}
+
+TransformationMatrix TransformationMatrix::FromColumnMajor(const double* values) {
+  TransformationMatrix matrix;
+  std::memcpy(matrix.m_, values, sizeof(matrix.m_));
+  return matrix;
+}
+
+bool TransformationMatrix::IsIdentity() const {
+  static const TransformationMatrix identity;
+  return std::memcmp(m_, identity.m_, sizeof(m_)) == 0;
+}
+
+void TransformationMatrix::Multiply(const TransformationMatrix& other) {
+  alignas(32) double result[4][4];
+  MultiplyMatrices(m_, other.m_, result);
+  std::memcpy(m_, result, sizeof(m_));
+}
+
+void TransformationMatrix::PreMultiply(const TransformationMatrix& other) {
+  alignas(32) double result[4][4];
+  MultiplyMatrices(other.m_, m_, result);
+  std::memcpy(m_, result, sizeof(m_));
+}
+
+bool TransformationMatrix::Inverse(TransformationMatrix& result) const {
+  const double* m = Data();
+  double inv[kSize];
+
+  // The adjugate matrix, expanded by cofactors.
+  inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] +
+           m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+  inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] -
+           m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+  inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] +
+           m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+  inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] -
+            m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+  inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] -
+           m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+  inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] +
+           m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+  inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] -
+           m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+  inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] +
+            m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+  inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] +
+           m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+  inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] -
+           m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+  inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] +
+            m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+  inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] -
+            m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+  inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] -
+           m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+  inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] +
+           m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+  inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] -
+            m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+  inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] +
+            m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+  double determinant = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+  if (determinant == 0 || !std::isfinite(determinant))
+    return false;
+
+  double factor = 1.0 / determinant;
+  for (size_t i = 0; i < kSize; i++) {
+    inv[i] *= factor;
+  }
+  result = FromColumnMajor(inv);
+  return true;
+}
+
+void TransformationMatrix::Translate(double tx, double ty, double tz) {
+  for (size_t row = 0; row < 4; row++) {
+    m_[3][row] += m_[0][row] * tx + m_[1][row] * ty + m_[2][row] * tz;
+  }
+}
+
+void TransformationMatrix::Scale(double sx, double sy, double sz) {
+  for (size_t row = 0; row < 4; row++) {
+    m_[0][row] *= sx;
+    m_[1][row] *= sy;
+    m_[2][row] *= sz;
+  }
+}
+
+void TransformationMatrix::Rotate(double rot_x, double rot_y, double rot_z) {
+  if (rot_z != 0)
+    RotateAroundAxis(0, 1, rot_z);
+  if (rot_y != 0)
+    RotateAroundAxis(2, 0, rot_y);
+  if (rot_x != 0)
+    RotateAroundAxis(1, 2, rot_x);
+}
+
+// Post-multiplies the rotation which turns the |first| axis towards the |second| axis.
+void TransformationMatrix::RotateAroundAxis(size_t first, size_t second, double degrees) {
+  double radians = degrees * kDegreesToRadians;
+  double cos = std::cos(radians);
+  double sin = std::sin(radians);
+  for (size_t row = 0; row < 4; row++) {
+    double a = m_[first][row];
+    double b = m_[second][row];
+    m_[first][row] = a * cos + b * sin;
+    m_[second][row] = b * cos - a * sin;
+  }
+}
+
+}  // namespace webf
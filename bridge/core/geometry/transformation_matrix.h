@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_GEOMETRY_TRANSFORMATION_MATRIX_H_
+#define BRIDGE_CORE_GEOMETRY_TRANSFORMATION_MATRIX_H_
+
+#include <cstddef>
+
+namespace webf {
+
+// A 4x4 matrix of doubles stored in column-major order, the same order as the arguments of matrix3d(): m11, m12,
+// m13 and m14 are the first column. The operations work on whole columns of contiguous memory, which compilers turn
+// into SIMD instructions.
+class TransformationMatrix {
+ public:
+  static constexpr size_t kSize = 16;
+
+  // The identity matrix.
+  TransformationMatrix();
+  // The matrix of matrix(a, b, c, d, e, f).
+  static TransformationMatrix Affine(double a, double b, double c, double d, double e, double f);
+  // |values| are 16 values in the order of matrix3d().
+  static TransformationMatrix FromColumnMajor(const double* values);
+
+  // |column| and |row| start from 1, At(4, 1) is m41.
+  double At(size_t column, size_t row) const { return m_[column - 1][row - 1]; }
+  void Set(size_t column, size_t row, double value) { m_[column - 1][row - 1] = value; }
+  const double* Data() const { return &m_[0][0]; }
+
+  bool IsIdentity() const;
+
+  // this = this * other.
+  void Multiply(const TransformationMatrix& other);
+  // this = other * this.
+  void PreMultiply(const TransformationMatrix& other);
+  // Returns false and leaves |result| untouched when the matrix is not invertible.
+  bool Inverse(TransformationMatrix& result) const;
+
+  // The below operations post-multiply the transformation, the same as the CSS transform functions.
+  void Translate(double tx, double ty, double tz);
+  void Scale(double sx, double sy, double sz);
+  // Rotates around the z axis by |rot_z|, then the y axis by |rot_y| and the x axis by |rot_x|, in degrees.
+  void Rotate(double rot_x, double rot_y, double rot_z);
+
+ private:
+  void RotateAroundAxis(size_t first, size_t second, double degrees);
+
+  alignas(32) double m_[4][4];
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_GEOMETRY_TRANSFORMATION_MATRIX_H_
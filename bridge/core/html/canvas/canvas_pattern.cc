@@ -12,7 +12,10 @@ CanvasPattern::CanvasPattern(ExecutingContext* context, NativeBindingObject* nat
     : BindingObject(context->ctx(), native_binding_object) {}
 
 void CanvasPattern::setTransform(DOMMatrix* dom_matrix, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypePointer<DOMMatrix>>::ToNativeValue(dom_matrix)};
+  // The matrix lives at C++ side, dart side receives its 16 values in column-major order.
+  const double* values = dom_matrix->matrix().Data();
+  NativeValue arguments[] = {NativeValueConverter<NativeTypeArray<NativeTypeDouble>>::ToNativeValue(
+      std::vector<double>(values, values + TransformationMatrix::kSize))};
   InvokeBindingMethod(binding_call_methods::ksetTransform, 1, arguments, exception_state);
 }
 
@@ -1,8 +1,8 @@
 import {HTMLElement} from "../html_element";
 
 interface HTMLCanvasElement extends HTMLElement {
-  width: DartImpl<int64>;
-  height: DartImpl<int64>;
+  width: DartImpl<int64, 'size'>;
+  height: DartImpl<int64, 'size'>;
   getContext(contextType: string): CanvasRenderingContext | null;
   new(): void;
 }
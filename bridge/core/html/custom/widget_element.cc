@@ -61,7 +61,7 @@ ScriptValue WidgetElement::item(const AtomicString& key, ExceptionState& excepti
   }
 
   if (!GetExecutingContext()->dartIsolateContext()->EnsureData()->HasWidgetElementShape(tagName())) {
-    GetExecutingContext()->FlushUICommand();
+    GetExecutingContext()->FlushUICommand(UICommandFlushReason::kWidgetElementShape);
   }
 
   if (key == built_in_string::kSymbol_toStringTag) {
@@ -71,7 +71,7 @@ ScriptValue WidgetElement::item(const AtomicString& key, ExceptionState& excepti
   auto shape = GetExecutingContext()->dartIsolateContext()->EnsureData()->GetWidgetElementShape(tagName());
   if (shape != nullptr) {
     if (shape->built_in_properties_.find(key) != shape->built_in_properties_.end()) {
-      return ScriptValue(ctx(), GetBindingProperty(key, exception_state));
+      return GetBuiltInProperty(*shape, key, exception_state);
     }
 
     if (shape->built_in_methods_.find(key) != shape->built_in_methods_.end()) {
@@ -100,11 +100,13 @@ ScriptValue WidgetElement::item(const AtomicString& key, ExceptionState& excepti
 
 bool WidgetElement::SetItem(const AtomicString& key, const ScriptValue& value, ExceptionState& exception_state) {
   if (!GetExecutingContext()->dartIsolateContext()->EnsureData()->HasWidgetElementShape(tagName())) {
-    GetExecutingContext()->FlushUICommand();
+    GetExecutingContext()->FlushUICommand(UICommandFlushReason::kWidgetElementShape);
   }
 
   auto shape = GetExecutingContext()->dartIsolateContext()->EnsureData()->GetWidgetElementShape(tagName());
   if (shape != nullptr && shape->built_in_properties_.count(key) > 0) {
+    // Dart side may normalize the value, read it again next time.
+    cached_properties_.erase(key);
     NativeValue result = SetBindingProperty(key, value.ToNative(exception_state), exception_state);
     return NativeValueConverter<NativeTypeBool>::FromNativeValue(result);
   }
@@ -113,6 +115,29 @@ bool WidgetElement::SetItem(const AtomicString& key, const ScriptValue& value, E
   return true;
 }
 
+ScriptValue WidgetElement::GetBuiltInProperty(const WidgetElementShape& shape,
+                                              const AtomicString& key,
+                                              ExceptionState& exception_state) {
+  auto policy = shape.property_cache_policies_.find(key);
+  if (policy == shape.property_cache_policies_.end() || policy->second == WidgetPropertyCachePolicy::kNone) {
+    return ScriptValue(ctx(), GetBindingProperty(key, exception_state));
+  }
+
+  UICommandBuffer* buffer = GetExecutingContext()->uiCommandBuffer();
+  auto it = cached_properties_.find(key);
+  if (it != cached_properties_.end() && (policy->second == WidgetPropertyCachePolicy::kImmutable ||
+                                         it->second.layout_generation == buffer->layoutGeneration())) {
+    return it->second.value;
+  }
+
+  ScriptValue value = ScriptValue(ctx(), GetBindingProperty(key, exception_state));
+  if (UNLIKELY(exception_state.HasException())) {
+    return value;
+  }
+  cached_properties_[key] = CachedProperty{value, buffer->layoutGeneration()};
+  return value;
+}
+
 bool WidgetElement::DeleteItem(const webf::AtomicString& key, webf::ExceptionState& exception_state) {
   return true;
 }
@@ -134,6 +159,10 @@ void WidgetElement::Trace(GCVisitor* visitor) const {
   for (auto& entry : async_cached_methods_) {
     entry.second.Trace(visitor);
   }
+
+  for (auto& entry : cached_properties_) {
+    entry.second.value.Trace(visitor);
+  }
 }
 
 void WidgetElement::CloneNonAttributePropertiesFrom(const Element& other, CloneChildrenFlag flag) {
@@ -144,15 +173,25 @@ void WidgetElement::CloneNonAttributePropertiesFrom(const Element& other, CloneC
 }
 
 NativeValue WidgetElement::HandleSyncPropertiesAndMethodsFromDart(int32_t argc, const NativeValue* argv) {
-  assert(argc == 3);
   AtomicString key = tagName();
-  assert(!GetExecutingContext()->dartIsolateContext()->EnsureData()->HasWidgetElementShape(key));
+  auto& data = GetExecutingContext()->dartIsolateContext()->EnsureData();
+  // The shape may be registered ahead by dart side already.
+  if (!data->HasWidgetElementShape(key)) {
+    data->SetWidgetElementShape(key, CreateShapeFromDart(ctx(), argc, argv));
+  }
 
+  return Native_NewBool(true);
+}
+
+std::shared_ptr<WidgetElementShape> WidgetElement::CreateShapeFromDart(JSContext* ctx,
+                                                                       int32_t argc,
+                                                                       const NativeValue* argv) {
+  assert(argc == 3 || argc == 4);
   auto shape = std::make_shared<WidgetElementShape>();
 
-  auto&& properties = NativeValueConverter<NativeTypeArray<NativeTypeString>>::FromNativeValue(ctx(), argv[0]);
-  auto&& sync_methods = NativeValueConverter<NativeTypeArray<NativeTypeString>>::FromNativeValue(ctx(), argv[1]);
-  auto&& async_methods = NativeValueConverter<NativeTypeArray<NativeTypeString>>::FromNativeValue(ctx(), argv[2]);
+  auto&& properties = NativeValueConverter<NativeTypeArray<NativeTypeString>>::FromNativeValue(ctx, argv[0]);
+  auto&& sync_methods = NativeValueConverter<NativeTypeArray<NativeTypeString>>::FromNativeValue(ctx, argv[1]);
+  auto&& async_methods = NativeValueConverter<NativeTypeArray<NativeTypeString>>::FromNativeValue(ctx, argv[2]);
 
   for (auto& property : properties) {
     shape->built_in_properties_.emplace(property);
@@ -166,9 +205,32 @@ NativeValue WidgetElement::HandleSyncPropertiesAndMethodsFromDart(int32_t argc,
     shape->built_in_async_methods_.emplace(method);
   }
 
-  GetExecutingContext()->dartIsolateContext()->EnsureData()->SetWidgetElementShape(key, shape);
+  if (argc > 3) {
+    // The policies are in the same order as the properties.
+    assert(argv[3].tag == NativeTag::TAG_LIST);
+    auto* policies = static_cast<NativeValue*>(argv[3].u.ptr);
+    for (size_t i = 0; i < argv[3].uint32 && i < properties.size(); i++) {
+      auto policy =
+          static_cast<WidgetPropertyCachePolicy>(NativeValueConverter<NativeTypeInt64>::FromNativeValue(policies[i]));
+      if (policy != WidgetPropertyCachePolicy::kNone) {
+        shape->property_cache_policies_[properties[i]] = policy;
+      }
+    }
+  }
 
-  return Native_NewBool(true);
+  return shape;
+}
+
+void RegisterWidgetElementShapeFromDart(ExecutingContext* context,
+                                        SharedNativeString* tag_name,
+                                        int32_t argc,
+                                        const NativeValue* argv) {
+  JSContext* ctx = context->ctx();
+  MemberMutationScope mutation_scope{context};
+  // The tag name is owned by native side from now on.
+  AtomicString key(ctx, std::unique_ptr<AutoFreeNativeString>(reinterpret_cast<AutoFreeNativeString*>(tag_name)));
+  context->dartIsolateContext()->EnsureData()->SetWidgetElementShape(
+      key, WidgetElement::CreateShapeFromDart(ctx, argc, argv));
 }
 
 ScriptValue WidgetElement::CreateSyncMethodFunc(const AtomicString& method_name) {
@@ -7,6 +7,7 @@
 
 #include <set>
 #include <unordered_map>
+#include "core/dart_context_data.h"
 #include "core/html/html_element.h"
 
 namespace webf {
@@ -42,15 +43,35 @@ class WidgetElement : public HTMLElement {
 
   void Trace(GCVisitor* visitor) const override;
 
+  // Build the shape from the names of properties, sync methods and async methods, and optionally the cache policies of
+  // the properties, all of them are lists sent by dart side.
+  static std::shared_ptr<WidgetElementShape> CreateShapeFromDart(JSContext* ctx, int32_t argc, const NativeValue* argv);
+
  private:
+  struct CachedProperty {
+    ScriptValue value;
+    int64_t layout_generation;
+  };
+
+  ScriptValue GetBuiltInProperty(const WidgetElementShape& shape,
+                                 const AtomicString& key,
+                                 ExceptionState& exception_state);
   ScriptValue CreateSyncMethodFunc(const AtomicString& method_name);
   ScriptValue CreateAsyncMethodFunc(const AtomicString& method_name);
   NativeValue HandleSyncPropertiesAndMethodsFromDart(int32_t argc, const NativeValue* argv);
   std::unordered_map<AtomicString, ScriptValue, AtomicString::KeyHasher> cached_methods_;
   std::unordered_map<AtomicString, ScriptValue, AtomicString::KeyHasher> async_cached_methods_;
   std::unordered_map<AtomicString, ScriptValue, AtomicString::KeyHasher> unimplemented_properties_;
+  // Values of the properties whose shape declares a cache policy.
+  std::unordered_map<AtomicString, CachedProperty, AtomicString::KeyHasher> cached_properties_;
 };
 
+// Dart side describes the shape of a kind of WidgetElement before any of them was created, |tag_name| is uppercased.
+void RegisterWidgetElementShapeFromDart(ExecutingContext* context,
+                                        SharedNativeString* tag_name,
+                                        int32_t argc,
+                                        const NativeValue* argv);
+
 template <>
 struct DowncastTraits<WidgetElement> {
   static bool AllowFrom(const Element& element) { return element.IsWidgetElement(); }
@@ -3,6 +3,8 @@
  */
 
 #include "widget_element.h"
+#include "core/dom/document.h"
+#include "core/html/html_body_element.h"
 #include "gtest/gtest.h"
 #include "webf_test_env.h"
 
@@ -49,3 +51,162 @@ TEST(WidgetElement, getPropertyWithSymbolToStringTag) {
 
   EXPECT_EQ(errorCalled, false);
 }
+
+TEST(WidgetElement, registerShapeFromDart) {
+  auto env = TEST_init();
+  auto context = env->page()->GetExecutingContext();
+  JSContext* ctx = context->ctx();
+
+  NativeValue properties[] = {Native_NewCString("checked"), Native_NewCString("value")};
+  NativeValue sync_methods[] = {Native_NewCString("focus")};
+  NativeValue policies[] = {Native_NewInt64(static_cast<int64_t>(WidgetPropertyCachePolicy::kNone)),
+                            Native_NewInt64(static_cast<int64_t>(WidgetPropertyCachePolicy::kImmutable))};
+  NativeValue argv[] = {Native_NewList(2, properties), Native_NewList(1, sync_methods), Native_NewList(0, nullptr),
+                        Native_NewList(2, policies)};
+  RegisterWidgetElementShapeFromDart(context, AtomicString(ctx, "FLUTTER-SHAPE").ToNativeString(ctx).release(), 4,
+                                     argv);
+
+  auto shape = context->dartIsolateContext()->EnsureData()->GetWidgetElementShape(AtomicString(ctx, "FLUTTER-SHAPE"));
+  EXPECT_NE(shape, nullptr);
+  EXPECT_EQ(shape->built_in_properties_.size(), 2);
+  EXPECT_EQ(shape->built_in_methods_.count(AtomicString(ctx, "focus")), 1);
+  EXPECT_EQ(shape->property_cache_policies_.count(AtomicString(ctx, "checked")), 0);
+  EXPECT_EQ(shape->property_cache_policies_.at(AtomicString(ctx, "value")), WidgetPropertyCachePolicy::kImmutable);
+  EXPECT_EQ(context->dartIsolateContext()->EnsureData()->GetWidgetElementShape(AtomicString(ctx, "FLUTTER-NONE")),
+            nullptr);
+}
+
+static int32_t async_batch_calls = 0;
+static uint32_t async_batch_size = 0;
+static void* async_batch = nullptr;
+static AsyncBindingCallBatchCallback async_batch_callback = nullptr;
+
+static void RecordAsyncBatch(const NativeBindingObject* binding_object,
+                             NativeValue* return_value,
+                             NativeValue* method,
+                             int32_t argc,
+                             const NativeValue* argv) {
+  if (method->u.int64 != BindingMethodCallOperations::kAsyncAnonymousFunctionBatch)
+    return;
+  async_batch_calls++;
+  async_batch = argv[1].u.ptr;
+  async_batch_callback = reinterpret_cast<AsyncBindingCallBatchCallback>(argv[2].u.ptr);
+  async_batch_size = argv[3].uint32;
+}
+
+static NativeValue NewDartList(std::initializer_list<NativeValue> values) {
+  auto* list = static_cast<NativeValue*>(malloc(sizeof(NativeValue) * values.size()));
+  std::copy(values.begin(), values.end(), list);
+  return Native_NewList(values.size(), list);
+}
+
+TEST(WidgetElement, asyncMethodsCalledInBatch) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "10,20");
+  };
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->GetExecutingContext();
+  JSContext* ctx = context->ctx();
+
+  NativeValue async_methods[] = {Native_NewCString("load")};
+  NativeValue argv[] = {Native_NewList(0, nullptr), Native_NewList(0, nullptr), Native_NewList(1, async_methods)};
+  RegisterWidgetElementShapeFromDart(context, AtomicString(ctx, "FLUTTER-ASYNC").ToNativeString(ctx).release(), 3,
+                                     argv);
+
+  const char* code = "document.body.appendChild(document.createElement('flutter-async'));";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  auto* element = DynamicTo<Element>(context->document()->body()->lastChild());
+  element->bindingObject()->invoke_bindings_methods_from_native = RecordAsyncBatch;
+
+  // Calls made in one task are sent to dart side at once.
+  const char* code2 =
+      "let el = document.body.lastChild;"
+      "Promise.all([el.load(1), el.load(2)]).then(values => console.log(values.join(',')));";
+  env->page()->evaluateScript(code2, strlen(code2), "vm://", 0);
+  EXPECT_EQ(async_batch_calls, 1);
+  EXPECT_EQ(async_batch_size, 2);
+  EXPECT_EQ(logCalled, false);
+
+  // All the results are returned with one callback.
+  auto* results = static_cast<NativeValue*>(malloc(sizeof(NativeValue)));
+  *results = NewDartList({NewDartList({Native_NewInt64(10), Native_NewNull()}),
+                          NewDartList({Native_NewInt64(20), Native_NewNull()})});
+  async_batch_callback(async_batch, results, context->contextId(), nullptr);
+  EXPECT_EQ(logCalled, true);
+
+  element->bindingObject()->invoke_bindings_methods_from_native = nullptr;
+  EXPECT_EQ(errorCalled, false);
+}
+
+static int32_t get_property_calls = 0;
+
+static void CountGetProperty(const NativeBindingObject* binding_object,
+                             NativeValue* return_value,
+                             NativeValue* method,
+                             int32_t argc,
+                             const NativeValue* argv) {
+  if (method->u.int64 != BindingMethodCallOperations::kGetProperty)
+    return;
+  get_property_calls++;
+  *return_value = Native_NewInt64(get_property_calls);
+}
+
+TEST(WidgetElement, builtInPropertyCachePolicies) {
+  bool static errorCalled = false;
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->GetExecutingContext();
+  JSContext* ctx = context->ctx();
+
+  NativeValue properties[] = {Native_NewCString("volatile"), Native_NewCString("immutable"),
+                              Native_NewCString("layout")};
+  NativeValue policies[] = {Native_NewInt64(static_cast<int64_t>(WidgetPropertyCachePolicy::kNone)),
+                            Native_NewInt64(static_cast<int64_t>(WidgetPropertyCachePolicy::kImmutable)),
+                            Native_NewInt64(static_cast<int64_t>(WidgetPropertyCachePolicy::kInvalidateOnCommand))};
+  NativeValue argv[] = {Native_NewList(3, properties), Native_NewList(0, nullptr), Native_NewList(0, nullptr),
+                        Native_NewList(3, policies)};
+  RegisterWidgetElementShapeFromDart(context, AtomicString(ctx, "FLUTTER-CACHE").ToNativeString(ctx).release(), 4,
+                                     argv);
+
+  const char* code = "document.body.appendChild(document.createElement('flutter-cache'));";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  auto* element = DynamicTo<Element>(context->document()->body()->lastChild());
+  element->bindingObject()->invoke_bindings_methods_from_native = CountGetProperty;
+  get_property_calls = 0;
+
+  auto read = [&](const char* property) {
+    std::string source = std::string("document.body.lastChild.") + property + ";";
+    env->page()->evaluateScript(source.c_str(), source.size(), "vm://", 0);
+  };
+
+  // A volatile value is read from dart side every time.
+  read("volatile");
+  read("volatile");
+  EXPECT_EQ(get_property_calls, 2);
+
+  // Cached values are returned without calling dart side.
+  read("immutable");
+  read("immutable");
+  EXPECT_EQ(get_property_calls, 3);
+  read("layout");
+  read("layout");
+  EXPECT_EQ(get_property_calls, 4);
+
+  // Only the values depending on the layout are read again once it may have changed.
+  context->uiCommandBuffer()->InvalidateLayout();
+  read("immutable");
+  EXPECT_EQ(get_property_calls, 4);
+  read("layout");
+  EXPECT_EQ(get_property_calls, 5);
+
+  element->bindingObject()->invoke_bindings_methods_from_native = nullptr;
+  EXPECT_EQ(errorCalled, false);
+}
@@ -22,6 +22,10 @@
  */
 
 #include "html_collection.h"
+#include "core/dom/class_collection.h"
+#include "core/dom/document.h"
+#include "core/dom/tag_collection.h"
+#include "core/html/html_element.h"
 
 namespace webf {
 
@@ -108,6 +112,7 @@ HTMLCollection::HTMLCollection(ContainerNode& owner_node,
     : LiveNodeListBase(owner_node, SearchRootFromCollectionType(owner_node, type), type),
       overrides_item_after_(item_after_override_type == kOverridesItemAfter),
       should_only_include_direct_children_(ShouldTypeOnlyIncludeDirectChildren(type)),
+      cached_dom_tree_version_(owner_node.GetDocument().DomTreeVersion()),
       ScriptWrappable(owner_node.ctx()) {
   // Keep this in the child class because |registerNodeList| requires wrapper
   // tracing and potentially calls virtual methods which is not allowed in a
@@ -121,11 +126,21 @@ void HTMLCollection::InvalidateCache(Document* old_document) const {
   collection_items_cache_.Invalidate();
 }
 
+void HTMLCollection::UpdateCacheIfNeeded() const {
+  uint64_t dom_tree_version = GetDocument().DomTreeVersion();
+  if (cached_dom_tree_version_ == dom_tree_version)
+    return;
+  InvalidateCache();
+  cached_dom_tree_version_ = dom_tree_version;
+}
+
 unsigned HTMLCollection::length() const {
+  UpdateCacheIfNeeded();
   return collection_items_cache_.NodeCount(*this);
 }
 
 Element* HTMLCollection::item(unsigned offset, ExceptionState& exceptionState) const {
+  UpdateCacheIfNeeded();
   return collection_items_cache_.NodeAt(*this, offset);
 }
 
@@ -135,6 +150,10 @@ inline bool HTMLCollection::ElementMatches(const Element& element) const {
     case kDocAll:
     case kNodeChildren:
       return true;
+    case kClassCollectionType:
+      return static_cast<const ClassCollection&>(*this).ElementMatches(element);
+    case kTagCollectionType:
+      return static_cast<const TagCollection&>(*this).ElementMatches(element);
     default:
       break;
   }
@@ -230,6 +249,7 @@ Element* HTMLCollection::TraverseBackwardToOffset(unsigned offset,
 
 Element* HTMLCollection::namedItem(const AtomicString& name) const {
   int32_t index = std::stoi(name.ToStdString(ctx()));
+  UpdateCacheIfNeeded();
   return collection_items_cache_.NodeAt(*this, index);
 }
 
@@ -238,6 +258,7 @@ bool HTMLCollection::NamedPropertyQuery(const AtomicString& name, ExceptionState
 }
 
 void HTMLCollection::NamedPropertyEnumerator(std::vector<AtomicString>& names, ExceptionState&) {
+  UpdateCacheIfNeeded();
   uint32_t size = collection_items_cache_.NodeCount(*this);
   for (int i = 0; i < size; i++) {
     names.emplace_back(AtomicString(ctx(), std::to_string(i)));
@@ -85,8 +85,14 @@ class HTMLCollection : public ScriptWrappable, public LiveNodeListBase {
   void NamedPropertyEnumerator(std::vector<AtomicString>& names, ExceptionState&);
 
   // Non-DOM API
-  bool IsEmpty() const { return collection_items_cache_.IsEmpty(*this); }
-  bool HasExactlyOneItem() const { return collection_items_cache_.HasExactlyOneNode(*this); }
+  bool IsEmpty() const {
+    UpdateCacheIfNeeded();
+    return collection_items_cache_.IsEmpty(*this);
+  }
+  bool HasExactlyOneItem() const {
+    UpdateCacheIfNeeded();
+    return collection_items_cache_.HasExactlyOneNode(*this);
+  }
   bool ElementMatches(const Element&) const;
 
   // CollectionIndexCache API.
@@ -106,11 +112,14 @@ class HTMLCollection : public ScriptWrappable, public LiveNodeListBase {
   bool OverridesItemAfter() const { return overrides_item_after_; }
   virtual Element* VirtualItemAfter(Element*) const;
   bool ShouldOnlyIncludeDirectChildren() const { return should_only_include_direct_children_; }
+  // Drops the cached items when the DOM tree changed since they were collected.
+  void UpdateCacheIfNeeded() const;
 
  private:
   const unsigned overrides_item_after_ : 1;
   const unsigned should_only_include_direct_children_ : 1;
   mutable CollectionItemsCache<HTMLCollection, Element> collection_items_cache_;
+  mutable uint64_t cached_dom_tree_version_;
 };
 
 template <>
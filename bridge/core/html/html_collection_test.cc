@@ -59,3 +59,92 @@ TEST(HTMLCollection, childrenWillNotChangeWithNoElementsNodes) {
 
   EXPECT_EQ(errorCalled, false);
 }
+
+TEST(HTMLCollection, getElementsByClassNameIsLive) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    EXPECT_STREQ(message.c_str(), "true 0 1 2 1 0 1");
+    logCalled = true;
+  };
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->GetExecutingContext();
+  const char* code =
+      "let items = document.getElementsByClassName('item');"
+      "let same = items === document.getElementsByClassName('item');"
+      "let empty = items.length;"
+      "let div = document.createElement('div');"
+      "div.className = 'item';"
+      "document.body.appendChild(div);"
+      "let appended = items.length;"
+      "let p = document.createElement('p');"
+      "p.setAttribute('class', 'big item');"
+      "div.appendChild(p);"
+      "let nested = items.length;"
+      "div.className = 'other';"
+      "let renamed = items.length;"
+      "document.body.removeChild(div);"
+      "let removed = items.length;"
+      "p.setAttribute('name', 'field');"
+      "document.body.appendChild(p);"
+      "console.log(same, empty, appended, nested, renamed, removed, document.getElementsByName('field').length);";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+TEST(HTMLCollection, getElementsByNameIgnoresNonIndexKeys) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    EXPECT_STREQ(message.c_str(), "undefined false true false true");
+    logCalled = true;
+  };
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->GetExecutingContext();
+  const char* code =
+      "let p = document.createElement('p');"
+      "p.setAttribute('name', 'field');"
+      "document.body.appendChild(p);"
+      "let items = document.getElementsByName('field');"
+      "console.log(items.foo, 'foo' in items, 0 in items, 1 in items, items[0] === p);";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+TEST(HTMLCollection, getElementsByTagNameIsLive) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    EXPECT_STREQ(message.c_str(), "0 2 1 true");
+    logCalled = true;
+  };
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->GetExecutingContext();
+  const char* code =
+      "let container = document.createElement('div');"
+      "document.body.appendChild(container);"
+      "let spans = container.getElementsByTagName('SPAN');"
+      "let before = spans.length;"
+      "container.appendChild(document.createElement('span'));"
+      "container.appendChild(document.createElement('span'));"
+      "let after = spans.length;"
+      "container.removeChild(spans[0]);"
+      "console.log(before, after, spans.length, container.getElementsByTagName('*')[0] === spans[0]);";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
@@ -6,11 +6,11 @@ interface HTMLImageElement extends HTMLElement {
     src: string;
     // srcset: DartImpl<string>;
     sizes: DartImpl<string>;
-    width: DartImpl<int64>;
-    height: DartImpl<int64>;
-    readonly naturalWidth: DartImpl<int64>;
-    readonly naturalHeight: DartImpl<int64>;
-    readonly complete: DartImpl<boolean>;
+    width: DartImpl<int64, 'size'>;
+    height: DartImpl<int64, 'size'>;
+    readonly naturalWidth: DartImpl<int64, 'size'>;
+    readonly naturalHeight: DartImpl<int64, 'size'>;
+    readonly complete: DartImpl<boolean, 'size'>;
     readonly currentSrc: DartImpl<string>;
     decoding: DartImpl<string>;
     fetchPriority: DartImpl<string>;
@@ -7,6 +7,7 @@
 
 #include "core/dom/document.h"
 #include "core/dom/element.h"
+#include "core/dom/subtree_command_scope.h"
 #include "core/dom/text.h"
 #include "element_namespace_uris.h"
 #include "foundation/logging.h"
@@ -104,7 +105,10 @@ bool HTMLParser::parseHTML(const std::string& html, Node* root_node, bool isHTML
 
       if (!trim(html).empty()) {
         GumboOutput* htmlTree = parse(html, isHTMLFragment);
+        // The parsed nodes are sent to dart side at once, instead of a group of commands per node.
+        SubtreeCommandScope subtree_scope(root_container_node->GetExecutingContext());
         traverseHTML(root_container_node, htmlTree->root);
+        subtree_scope.Commit(root_container_node, root_container_node->firstChild());
         // Free gumbo parse nodes.
         gumbo_destroy_output(&kGumboDefaultOptions, htmlTree);
       }
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "js_thread_dispatcher.h"
+#include <algorithm>
+
+namespace webf {
+
+static thread_local JSThreadDispatcher* dart_thread_dispatcher_{nullptr};
+// Set on the JS threads only.
+static thread_local JSThreadDispatcher* js_thread_dispatcher_{nullptr};
+static thread_local Looper* current_js_thread_{nullptr};
+
+void DartThreadTaskRunner::OnTaskPosted() {
+  if (dart_port_ == ILLEGAL_PORT)
+    return;
+  Dart_CObject message;
+  message.type = Dart_CObject_kNull;
+  Dart_PostCObject_DL(dart_port_, &message);
+}
+
+JSThreadDispatcher::JSThreadDispatcher(Dart_Port dart_port, size_t js_thread_count) : dart_thread_(dart_port) {
+  dart_thread_dispatcher_ = this;
+  js_thread_count = std::max<size_t>(js_thread_count, 1);
+  for (size_t i = 0; i < js_thread_count; i++) {
+    auto js_thread = std::make_unique<Looper>("webf_js_" + std::to_string(i));
+    js_thread->Start();
+    js_thread->PostTask([this, looper = js_thread.get()]() {
+      js_thread_dispatcher_ = this;
+      current_js_thread_ = looper;
+    });
+    thread_loads_[js_thread.get()] = 0;
+    js_threads_.emplace_back(std::move(js_thread));
+  }
+}
+
+JSThreadDispatcher::~JSThreadDispatcher() {
+  if (dart_thread_dispatcher_ == this) {
+    dart_thread_dispatcher_ = nullptr;
+  }
+  for (auto& js_thread : js_threads_) {
+    js_thread->Stop();
+  }
+}
+
+JSThreadDispatcher* JSThreadDispatcher::FromDartThread() {
+  return dart_thread_dispatcher_;
+}
+
+bool JSThreadDispatcher::IsJSThread() const {
+  return js_thread_dispatcher_ == this;
+}
+
+void JSThreadDispatcher::AssignJSThread(int64_t context_id, int32_t group) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (context_threads_.count(context_id) > 0)
+    return;
+
+  Looper* js_thread = nullptr;
+  if (group >= 0) {
+    auto it = group_threads_.find(group);
+    if (it != group_threads_.end()) {
+      js_thread = it->second;
+    }
+  }
+  if (js_thread == nullptr) {
+    js_thread = std::min_element(thread_loads_.begin(), thread_loads_.end(), [](const auto& a, const auto& b) {
+                  return a.second < b.second;
+                })->first;
+    if (group >= 0) {
+      group_threads_[group] = js_thread;
+    }
+  }
+
+  context_threads_[context_id] = js_thread;
+  thread_loads_[js_thread]++;
+}
+
+void JSThreadDispatcher::ReleaseJSThread(int64_t context_id) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = context_threads_.find(context_id);
+  if (it == context_threads_.end())
+    return;
+  Looper* js_thread = it->second;
+  context_threads_.erase(it);
+
+  // A group whose last page went away may be placed again.
+  if (--thread_loads_[js_thread] == 0) {
+    for (auto group = group_threads_.begin(); group != group_threads_.end();) {
+      group = group->second == js_thread ? group_threads_.erase(group) : std::next(group);
+    }
+  }
+}
+
+Looper* JSThreadDispatcher::JSThreadOf(int64_t context_id) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = context_threads_.find(context_id);
+  return it != context_threads_.end() ? it->second : nullptr;
+}
+
+Looper* JSThreadDispatcher::CurrentJSThread() {
+  return current_js_thread_;
+}
+
+void JSThreadDispatcher::PostToJS(int64_t context_id, TaskRunner::Callback&& task) {
+  if (Looper* js_thread = JSThreadOf(context_id)) {
+    js_thread->PostTask(std::move(task));
+  }
+}
+
+void JSThreadDispatcher::PostToAllJSThreadsSync(const std::function<void()>& task) {
+  for (auto& js_thread : js_threads_) {
+    PostTaskSync<void>(js_thread.get(), &dart_thread_, [&task]() { task(); });
+  }
+}
+
+void JSThreadDispatcher::PostToDart(TaskRunner::Callback&& task) {
+  if (!dart_thread_alive_)
+    return;
+  dart_thread_.PostTask(std::move(task));
+}
+
+void JSThreadDispatcher::Dispose(const std::function<void()>& teardown) {
+  dart_thread_alive_ = false;
+  PostToAllJSThreadsSync(teardown);
+  for (auto& js_thread : js_threads_) {
+    js_thread->Stop();
+  }
+}
+
+}  // namespace webf
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_JS_THREAD_DISPATCHER_H_
+#define WEBF_CORE_JS_THREAD_DISPATCHER_H_
+
+#include <include/dart_api_dl.h>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "foundation/looper.h"
+
+namespace webf {
+
+// The tasks posted to the dart thread. Dart side is notified through its port and runs them with
+// flushDartThreadTasks(), unless the dart thread is already waiting for the JS thread.
+class DartThreadTaskRunner : public TaskRunner {
+ public:
+  explicit DartThreadTaskRunner(Dart_Port dart_port) : dart_port_(dart_port) {}
+
+ protected:
+  void OnTaskPosted() override;
+
+ private:
+  Dart_Port dart_port_;
+};
+
+// Runs the ExecutingContexts of a DartIsolateContext on a pool of dedicated JS threads instead of the dart thread.
+// Every JS thread has its own JSRuntime, a page stays on the thread it was allocated on, pages of the same group share
+// one thread.
+//
+// Calls from dart side are forwarded to the JS thread of their page, the ones returning a value block the dart thread
+// until they finish. Calls from JS to dart side are forwarded to the dart thread the same way. A thread blocked on
+// another one keeps serving the synchronous calls made back to it, so the nested calls between JS and dart work as they
+// did when both ran on one thread.
+class JSThreadDispatcher {
+ public:
+  explicit JSThreadDispatcher(Dart_Port dart_port, size_t js_thread_count);
+  ~JSThreadDispatcher();
+
+  // The dispatcher of the DartIsolateContext created on the current thread. nullptr on the JS threads, and when JS
+  // runs on the dart thread.
+  static JSThreadDispatcher* FromDartThread();
+
+  // Whether the current thread is one of the JS threads.
+  bool IsJSThread() const;
+  size_t JSThreadCount() const { return js_threads_.size(); }
+
+  // Pins the context to a JS thread. Contexts of the same group share the thread picked for the first of them, a
+  // negative group gives the context the least loaded thread.
+  void AssignJSThread(int64_t context_id, int32_t group);
+  void ReleaseJSThread(int64_t context_id);
+
+  // Calls to an unknown context are dropped, the sync ones return a default constructed T.
+  void PostToJS(int64_t context_id, TaskRunner::Callback&& task);
+  template <typename T>
+  T PostToJSSync(int64_t context_id, std::function<T()>&& task) {
+    Looper* js_thread = JSThreadOf(context_id);
+    if (js_thread == nullptr)
+      return T();
+    if (js_thread->IsCurrentThread())
+      return task();
+    TaskRunner* waiting = CurrentJSThread();
+    return PostTaskSync<T>(js_thread, waiting != nullptr ? waiting : &dart_thread_, std::move(task));
+  }
+  // Runs |task| on every JS thread and waits for them.
+  void PostToAllJSThreadsSync(const std::function<void()>& task);
+
+  // Posts a native callback invoked by dart side to the JS thread. The strings passed as const char* are copied, other
+  // arguments must stay valid until the callback runs.
+  template <typename... Params, typename... Args>
+  void PostCallbackToJS(int64_t context_id, void (*callback)(Params...), Args... args) {
+    PostToJS(context_id, [callback, arguments = std::make_tuple(RetainArgument(args)...)]() mutable {
+      std::apply([callback](auto&... values) { callback(ReleaseArgument(values)...); }, arguments);
+    });
+  }
+
+  void PostToDart(TaskRunner::Callback&& task);
+  // Must be called on a JS thread. Returns a default constructed T without calling dart side once the dart thread
+  // stopped serving JS.
+  template <typename T>
+  T PostToDartSync(std::function<T()>&& task) {
+    if (!dart_thread_alive_)
+      return T();
+    return PostTaskSync<T>(&dart_thread_, CurrentJSThread(), std::move(task));
+  }
+
+  // Runs the tasks posted to the dart thread, called by dart side after it was notified.
+  void FlushDartTasks() { dart_thread_.RunPendingTasks(); }
+
+  // Runs |teardown| on every JS thread and stops them. Calls from JS to dart side made from now on are dropped.
+  void Dispose(const std::function<void()>& teardown);
+
+ private:
+  template <typename T>
+  static T RetainArgument(T value) {
+    return value;
+  }
+  static std::optional<std::string> RetainArgument(const char* value) {
+    return value != nullptr ? std::optional<std::string>(value) : std::nullopt;
+  }
+  template <typename T>
+  static T ReleaseArgument(T& value) {
+    return value;
+  }
+  static const char* ReleaseArgument(std::optional<std::string>& value) {
+    return value.has_value() ? value->c_str() : nullptr;
+  }
+
+  Looper* JSThreadOf(int64_t context_id);
+  static Looper* CurrentJSThread();
+
+  std::vector<std::unique_ptr<Looper>> js_threads_;
+  DartThreadTaskRunner dart_thread_;
+  std::atomic<bool> dart_thread_alive_{true};
+
+  std::mutex mutex_;
+  std::unordered_map<int64_t, Looper*> context_threads_;
+  std::unordered_map<int32_t, Looper*> group_threads_;
+  std::unordered_map<Looper*, size_t> thread_loads_;
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_JS_THREAD_DISPATCHER_H_
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "core/js_thread_dispatcher.h"
+#include "gtest/gtest.h"
+
+using namespace webf;
+
+static std::thread::id ThreadOfContext(JSThreadDispatcher& dispatcher, int64_t context_id) {
+  return dispatcher.PostToJSSync<std::thread::id>(context_id, []() { return std::this_thread::get_id(); });
+}
+
+TEST(JSThreadDispatcher, contextsAreSpreadOverThreads) {
+  JSThreadDispatcher dispatcher(ILLEGAL_PORT, 2);
+  dispatcher.AssignJSThread(1, -1);
+  dispatcher.AssignJSThread(2, -1);
+
+  EXPECT_NE(ThreadOfContext(dispatcher, 1), ThreadOfContext(dispatcher, 2));
+  EXPECT_EQ(dispatcher.PostToJSSync<bool>(1, [&dispatcher]() { return dispatcher.IsJSThread(); }), true);
+  EXPECT_EQ(dispatcher.IsJSThread(), false);
+  dispatcher.Dispose([]() {});
+}
+
+TEST(JSThreadDispatcher, contextsOfAGroupShareThread) {
+  JSThreadDispatcher dispatcher(ILLEGAL_PORT, 2);
+  dispatcher.AssignJSThread(1, 7);
+  dispatcher.AssignJSThread(2, -1);
+  dispatcher.AssignJSThread(3, 7);
+
+  EXPECT_EQ(ThreadOfContext(dispatcher, 1), ThreadOfContext(dispatcher, 3));
+  EXPECT_NE(ThreadOfContext(dispatcher, 1), ThreadOfContext(dispatcher, 2));
+  dispatcher.Dispose([]() {});
+}
+
+TEST(JSThreadDispatcher, releasedContextIsDropped) {
+  JSThreadDispatcher dispatcher(ILLEGAL_PORT, 1);
+  dispatcher.AssignJSThread(1, -1);
+  dispatcher.ReleaseJSThread(1);
+
+  EXPECT_EQ(dispatcher.PostToJSSync<int>(1, []() { return 42; }), 0);
+  dispatcher.Dispose([]() {});
+}
@@ -137,6 +137,12 @@ bool WebFPage::evaluateByteCode(uint8_t* bytes, size_t byteLength) {
   return context_->EvaluateByteCode(bytes, byteLength);
 }
 
+bool WebFPage::evaluateCompiledScript(CompiledScript* script, uint8_t** parsed_bytecodes, uint64_t* bytecode_len) {
+  if (!context_->IsContextValid())
+    return false;
+  return context_->EvaluateCompiledScript(script, parsed_bytecodes, bytecode_len);
+}
+
 std::thread::id WebFPage::currentThread() const {
   return ownerThreadId;
 }
@@ -54,6 +54,7 @@ class WebFPage final {
   void evaluateScript(const char* script, size_t length, const char* url, int startLine);
   uint8_t* dumpByteCode(const char* script, size_t length, const char* url, size_t* byteLength);
   bool evaluateByteCode(uint8_t* bytes, size_t byteLength);
+  bool evaluateCompiledScript(CompiledScript* script, uint8_t** parsed_bytecodes, uint64_t* bytecode_len);
 
   std::thread::id currentThread() const;
 
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "script_compiler.h"
+#include "bindings/qjs/native_string_utils.h"
+
+namespace webf {
+
+CompiledScript::CompiledScript(std::u16string source, std::string url)
+    : utf16_source_(std::move(source)), url_(std::move(url)) {}
+
+bool CompiledScript::WaitForCompilation() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  condition_.wait(lock, [this]() { return finished_; });
+  return compiled_;
+}
+
+void CompiledScript::Compile(JSContext* ctx) {
+  std::string source = toUTF8(utf16_source_);
+  std::vector<uint8_t> bytecode;
+  JSValue function =
+      JS_Eval(ctx, source.c_str(), source.size(), url_.c_str(), JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_COMPILE_ONLY);
+  if (LIKELY(!JS_IsException(function))) {
+    size_t length;
+    uint8_t* bytes = JS_WriteObject(ctx, &length, function, JS_WRITE_OBJ_BYTECODE);
+    if (bytes != nullptr) {
+      bytecode.assign(bytes, bytes + length);
+      js_free(ctx, bytes);
+    }
+    JS_FreeValue(ctx, function);
+  } else {
+    // The syntax error is thrown again when the page evaluates the source.
+    JS_FreeValue(ctx, JS_GetException(ctx));
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  utf16_source_.clear();
+  utf16_source_.shrink_to_fit();
+  bytecode_ = std::move(bytecode);
+  compiled_ = !bytecode_.empty();
+  if (!compiled_) {
+    source_ = std::move(source);
+  }
+  finished_ = true;
+  condition_.notify_all();
+}
+
+ScriptCompiler* ScriptCompiler::Shared() {
+  // Never destroyed, a script may still be compiling when the process exits.
+  static auto* compiler = new ScriptCompiler();
+  return compiler;
+}
+
+ScriptCompiler::ScriptCompiler() : thread_("webf_script_compiler") {
+  thread_.Start();
+  thread_.PostTask([this]() {
+    runtime_ = JS_NewRuntime();
+    ctx_ = JS_NewContext(runtime_);
+  });
+}
+
+std::shared_ptr<CompiledScript> ScriptCompiler::Compile(std::u16string source, std::string url) {
+  auto script = std::make_shared<CompiledScript>(std::move(source), std::move(url));
+  thread_.PostTask([this, script]() { script->Compile(ctx_); });
+  return script;
+}
+
+}  // namespace webf
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_SCRIPT_COMPILER_H_
+#define WEBF_CORE_SCRIPT_COMPILER_H_
+
+#include <quickjs/quickjs.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "foundation/looper.h"
+#include "foundation/macros.h"
+
+namespace webf {
+
+// A script being compiled to bytecode by the ScriptCompiler.
+class CompiledScript {
+ public:
+  CompiledScript(std::u16string source, std::string url);
+
+  const std::string& url() const { return url_; }
+
+  // Blocks until the script is compiled. Returns false when it failed to compile, the UTF-8 source is then kept to be
+  // evaluated instead, which reports the error to the page.
+  bool WaitForCompilation();
+  // Valid once WaitForCompilation() returned true.
+  const std::vector<uint8_t>& bytecode() const { return bytecode_; }
+  // Valid once WaitForCompilation() returned false.
+  const std::string& source() const { return source_; }
+
+ private:
+  friend class ScriptCompiler;
+
+  // Called on the compiler thread.
+  void Compile(JSContext* ctx);
+
+  std::u16string utf16_source_;
+  std::string source_;
+  const std::string url_;
+  std::vector<uint8_t> bytecode_;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool finished_{false};
+  bool compiled_{false};
+
+  WEBF_DISALLOW_COPY_AND_ASSIGN(CompiledScript);
+};
+
+// Compiles scripts to bytecode with JS_WriteObject() in a scratch JSRuntime on a background thread, so that parsing a
+// large bundle overlaps with the download of the next scripts and with running the ones before it. The bytecode is
+// then run by ExecutingContext::EvaluateCompiledScript() on the JS thread of the page.
+class ScriptCompiler {
+ public:
+  // The compiler shared by all the pages, never destroyed.
+  static ScriptCompiler* Shared();
+
+  // Starts compiling |source| and returns at once. Scripts are compiled in the order they were given.
+  std::shared_ptr<CompiledScript> Compile(std::u16string source, std::string url);
+
+ private:
+  ScriptCompiler();
+
+  Looper thread_;
+  // Only touched on |thread_|.
+  JSRuntime* runtime_{nullptr};
+  JSContext* ctx_{nullptr};
+
+  WEBF_DISALLOW_COPY_AND_ASSIGN(ScriptCompiler);
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_SCRIPT_COMPILER_H_
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "layout_thrashing_detector.h"
+#include <algorithm>
+#include <sstream>
+#include "bindings/qjs/source_location.h"
+#include "core/executing_context.h"
+#include "foundation/logging.h"
+
+namespace webf {
+
+void LayoutThrashingDetector::SetThreshold(int32_t threshold) {
+  threshold_ = std::max(threshold, 0);
+  forced_flushes_ = 0;
+  flushed_commands_ = 0;
+  report_count_ = 0;
+}
+
+void LayoutThrashingDetector::RecordForcedFlush(int64_t pending_commands) {
+  if (!enabled())
+    return;
+
+  forced_flushes_++;
+  flushed_commands_ += pending_commands;
+
+  // Report once per task, at the read which crosses the threshold.
+  if (forced_flushes_ == threshold_) {
+    Report();
+  }
+}
+
+void LayoutThrashingDetector::DidFinishTask() {
+  forced_flushes_ = 0;
+  flushed_commands_ = 0;
+}
+
+void LayoutThrashingDetector::Report() {
+  report_count_++;
+
+  std::unique_ptr<SourceLocation> location = SourceLocation::Capture(context_->ctx());
+  std::stringstream stream;
+  stream << "[Layout thrashing] " << forced_flushes_
+         << " synchronous reads in one task flushed pending DOM changes and forced layout, " << flushed_commands_
+         << " ui commands were flushed. Batch the reads before the writes to avoid it.";
+  if (!location->StackTrace().empty()) {
+    stream << "\n" << location->StackTrace();
+  } else if (!location->Url().empty()) {
+    stream << "\n    at " << location->Url();
+  }
+  printLog(context_, stream, "warn", nullptr);
+}
+
+}  // namespace webf
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_TIMING_LAYOUT_THRASHING_DETECTOR_H_
+#define BRIDGE_CORE_TIMING_LAYOUT_THRASHING_DETECTOR_H_
+
+#include <cinttypes>
+#include "foundation/macros.h"
+
+namespace webf {
+
+class ExecutingContext;
+
+// Detects scripts which interleave DOM writes with synchronous reads, e.g. setting a style and reading offsetWidth in
+// a loop. Every read which reaches dart side with ui commands pending forces dart side to apply the commands and to
+// layout again. When the forced flushes in one task reach the threshold, a warning with the JS stack is reported to
+// the console.
+//
+// A task ends when the pending promise jobs are drained, see ExecutingContext::DrainPendingPromiseJobs.
+class LayoutThrashingDetector {
+  WEBF_DISALLOW_COPY_AND_ASSIGN(LayoutThrashingDetector);
+
+ public:
+  explicit LayoutThrashingDetector(ExecutingContext* context) : context_(context){};
+
+  // 0 disables the detector.
+  void SetThreshold(int32_t threshold);
+  int32_t threshold() const { return threshold_; }
+  bool enabled() const { return threshold_ > 0; }
+
+  // A synchronous read is going to flush |pending_commands| ui commands to dart side.
+  void RecordForcedFlush(int64_t pending_commands);
+  void DidFinishTask();
+
+  int64_t forcedFlushes() const { return forced_flushes_; }
+  int64_t reportCount() const { return report_count_; }
+
+ private:
+  void Report();
+
+  ExecutingContext* context_;
+  int32_t threshold_{0};
+  // Counters of the running task.
+  int64_t forced_flushes_{0};
+  int64_t flushed_commands_{0};
+  // Tasks reported since enabled.
+  int64_t report_count_{0};
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_TIMING_LAYOUT_THRASHING_DETECTOR_H_
@@ -47,6 +47,47 @@ AtomicString Performance::___webf_navigation_summary__(ExceptionState& exception
   return AtomicString::Empty();
 }
 
+ScriptValue Performance::___webf_ui_command_stats__(ExceptionState& exception_state) const {
+  const UICommandBuffer* buffer = GetExecutingContext()->uiCommandBuffer();
+  if (!buffer->statsEnabled()) {
+    return ScriptValue::Empty(ctx());
+  }
+
+  const UICommandStats& stats = buffer->stats();
+  JSValue command_count = JS_NewObject(ctx());
+  JSValue command_bytes = JS_NewObject(ctx());
+  for (int32_t i = 0; i < kUICommandTypeCount; i++) {
+    const char* name = GetUICommandName(static_cast<UICommand>(i));
+    JS_SetPropertyStr(ctx(), command_count, name, Converter<IDLInt64>::ToValue(ctx(), stats.command_count[i]));
+    JS_SetPropertyStr(ctx(), command_bytes, name, Converter<IDLInt64>::ToValue(ctx(), stats.command_bytes[i]));
+  }
+  JSValue flush_count = JS_NewObject(ctx());
+  for (int32_t i = 0; i < kUICommandFlushReasonCount; i++) {
+    JS_SetPropertyStr(ctx(), flush_count, GetUICommandFlushReasonName(static_cast<UICommandFlushReason>(i)),
+                      Converter<IDLInt64>::ToValue(ctx(), stats.flush_count[i]));
+  }
+
+  JSValue object = JS_NewObject(ctx());
+  JS_SetPropertyStr(ctx(), object, "commandCount", command_count);
+  JS_SetPropertyStr(ctx(), object, "commandBytes", command_bytes);
+  JS_SetPropertyStr(ctx(), object, "flushCount", flush_count);
+  JS_SetPropertyStr(ctx(), object, "frames", Converter<IDLInt64>::ToValue(ctx(), stats.frames));
+  JS_SetPropertyStr(ctx(), object, "lastFrameFlushes", Converter<IDLInt64>::ToValue(ctx(), stats.last_frame_flushes));
+  JS_SetPropertyStr(ctx(), object, "maxFrameFlushes", Converter<IDLInt64>::ToValue(ctx(), stats.max_frame_flushes));
+  ScriptValue result = ScriptValue(ctx(), object);
+  JS_FreeValue(ctx(), object);
+  return result;
+}
+
+void Performance::___webf_set_ui_command_stats_enabled__(bool enabled, ExceptionState& exception_state) {
+  GetExecutingContext()->uiCommandBuffer()->SetStatsEnabled(enabled);
+}
+
+void Performance::___webf_set_layout_thrashing_threshold__(int64_t threshold, ExceptionState& exception_state) {
+  GetExecutingContext()->layoutThrashingDetector()->SetThreshold(
+      static_cast<int32_t>(std::min<int64_t>(threshold, INT32_MAX)));
+}
+
 std::vector<Member<PerformanceEntry>> Performance::getEntries(ExceptionState& exception_state) {
   return entries_;
 }
@@ -4,6 +4,9 @@ import {PerformanceMeasureOptions} from "./performance_measure_options";
 interface Performance {
   now(): int64;
   __webf_navigation_summary__(): string;
+  __webf_ui_command_stats__(): any;
+  __webf_set_ui_command_stats_enabled__(enabled: boolean): void;
+  __webf_set_layout_thrashing_threshold__(threshold: int64): void;
   toJSON(): any;
 
   getEntries(): PerformanceEntry[];
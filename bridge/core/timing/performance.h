@@ -34,6 +34,9 @@ class Performance : public ScriptWrappable {
   int64_t timeOrigin() const;
   ScriptValue toJSON(ExceptionState& exception_state) const;
   AtomicString ___webf_navigation_summary__(ExceptionState& exception_state) const;
+  ScriptValue ___webf_ui_command_stats__(ExceptionState& exception_state) const;
+  void ___webf_set_ui_command_stats_enabled__(bool enabled, ExceptionState& exception_state);
+  void ___webf_set_layout_thrashing_threshold__(int64_t threshold, ExceptionState& exception_state);
   std::vector<Member<PerformanceEntry>> getEntries(ExceptionState& exception_state);
   std::vector<Member<PerformanceEntry>> getEntriesByType(const AtomicString& entry_type,
                                                          ExceptionState& exception_state);
@@ -209,3 +209,38 @@ setTimeout(() => {
   EXPECT_EQ(errorCalled, false);
   EXPECT_EQ(logCalled, true);
 }
+
+TEST(Performance, layoutThrashing) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_EQ(message.find("[Layout thrashing] 5 synchronous reads") == 0, true);
+    EXPECT_EQ(message.find("thrash") != std::string::npos, true);
+  };
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->GetExecutingContext();
+  const char* code = R"(
+performance.__webf_set_layout_thrashing_threshold__(5);
+let div = document.createElement('div');
+document.body.appendChild(div);
+function thrash() {
+  for (let i = 0; i < 10; i ++) {
+    div.style.width = i + 'px';
+    // Reading layout in tests gets nothing without dart side, the ui commands are flushed anyway.
+    try { div.offsetWidth; } catch(e) {}
+  }
+}
+thrash();
+)";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+  EXPECT_EQ(context->layoutThrashingDetector()->reportCount(), 1);
+  // The counters of the task were reset after the task finished.
+  EXPECT_EQ(context->layoutThrashingDetector()->forcedFlushes(), 0);
+}
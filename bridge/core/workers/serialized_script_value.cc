@@ -0,0 +1,748 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "serialized_script_value.h"
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include "bindings/qjs/qjs_engine_patch.h"
+
+namespace webf {
+
+namespace {
+
+// The deepest nesting of objects which can be cloned. Each level takes a few native frames on both sides, and the
+// worker threads may run on stacks as small as 512KB, the default for secondary threads on iOS.
+constexpr int kMaxDepth = 256;
+
+enum class SerializationTag : uint8_t {
+  kUndefined,
+  kNull,
+  kTrue,
+  kFalse,
+  kInt32,
+  kDouble,
+  kBigInt,
+  kString,
+  // Index in the order the objects were first written.
+  kObjectReference,
+  kObject,
+  kArray,
+  kDate,
+  kRegExp,
+  kBooleanObject,
+  kNumberObject,
+  kStringObject,
+  kMap,
+  kSet,
+  kError,
+  kArrayBuffer,
+  // Index in the transfer list.
+  kTransferredArrayBuffer,
+  kArrayBufferView,
+};
+
+// The classes of the ArrayBuffer views, indexed by the view tag written after kArrayBufferView. The BigInt arrays
+// are left out when BigInt is not supported.
+const JSClassID kArrayBufferViewClassIds[] = {
+    JS_CLASS_UINT8C_ARRAY,    JS_CLASS_INT8_ARRAY,       JS_CLASS_UINT8_ARRAY,   JS_CLASS_INT16_ARRAY,
+    JS_CLASS_UINT16_ARRAY,    JS_CLASS_INT32_ARRAY,      JS_CLASS_UINT32_ARRAY,
+#ifdef CONFIG_BIGNUM
+    JS_CLASS_BIG_INT64_ARRAY, JS_CLASS_BIG_UINT64_ARRAY,
+#else
+    0,                        0,
+#endif
+    JS_CLASS_FLOAT32_ARRAY,   JS_CLASS_FLOAT64_ARRAY,    JS_CLASS_DATAVIEW,
+};
+const size_t kArrayBufferViewElementSizes[] = {1, 1, 1, 2, 2, 4, 4, 8, 8, 4, 8, 1};
+
+int ArrayBufferViewTag(JSClassID class_id) {
+  switch (class_id) {
+    case JS_CLASS_UINT8C_ARRAY:
+      return 0;
+    case JS_CLASS_INT8_ARRAY:
+      return 1;
+    case JS_CLASS_UINT8_ARRAY:
+      return 2;
+    case JS_CLASS_INT16_ARRAY:
+      return 3;
+    case JS_CLASS_UINT16_ARRAY:
+      return 4;
+    case JS_CLASS_INT32_ARRAY:
+      return 5;
+    case JS_CLASS_UINT32_ARRAY:
+      return 6;
+#ifdef CONFIG_BIGNUM
+    case JS_CLASS_BIG_INT64_ARRAY:
+      return 7;
+    case JS_CLASS_BIG_UINT64_ARRAY:
+      return 8;
+#endif
+    case JS_CLASS_FLOAT32_ARRAY:
+      return 9;
+    case JS_CLASS_FLOAT64_ARRAY:
+      return 10;
+    case JS_CLASS_DATAVIEW:
+      return 11;
+    default:
+      return -1;
+  }
+}
+
+}  // namespace
+
+class ValueSerializer {
+ public:
+  ValueSerializer(JSContext* ctx, SerializedScriptValue* value, ExceptionState& exception_state)
+      : ctx_(ctx), value_(value), exception_state_(exception_state) {}
+
+  ~ValueSerializer() {
+    for (JSValue object : objects_) {
+      JS_FreeValue(ctx_, object);
+    }
+    for (JSValue array_buffer : transfer_list_) {
+      JS_FreeValue(ctx_, array_buffer);
+    }
+  }
+
+  bool PrepareTransfer(JSValueConst transfer) {
+    if (JS_IsUndefined(transfer))
+      return true;
+    if (!JS_IsArray(ctx_, transfer)) {
+      exception_state_.ThrowException(ctx_, ErrorType::TypeError, "The transfer list must be an array.");
+      return false;
+    }
+
+    uint32_t length;
+    JSValue length_value = JS_GetPropertyStr(ctx_, transfer, "length");
+    int status = JS_ToUint32(ctx_, &length, length_value);
+    JS_FreeValue(ctx_, length_value);
+    if (status < 0)
+      return Rethrow();
+
+    for (uint32_t i = 0; i < length; i++) {
+      JSValue item = JS_GetPropertyUint32(ctx_, transfer, i);
+      if (JS_IsException(item))
+        return Rethrow();
+      transfer_list_.emplace_back(item);
+      if (!JS_IsArrayBuffer(item)) {
+        return ThrowDataCloneError("Value at index " + std::to_string(i) +
+                                   " of the transfer list is not an ArrayBuffer.");
+      }
+      if (!transfer_indexes_.emplace(JS_VALUE_GET_PTR(item), i).second) {
+        return ThrowDataCloneError("ArrayBuffer at index " + std::to_string(i) + " is a duplicate.");
+      }
+    }
+    return true;
+  }
+
+  bool WriteValue(JSValueConst value, int depth) {
+    if (UNLIKELY(depth > kMaxDepth)) {
+      exception_state_.ThrowException(ctx_, ErrorType::RangeError, "Maximum call stack size exceeded.");
+      return false;
+    }
+
+    switch (JS_VALUE_GET_NORM_TAG(value)) {
+      case JS_TAG_UNDEFINED:
+        WriteTag(SerializationTag::kUndefined);
+        return true;
+      case JS_TAG_NULL:
+        WriteTag(SerializationTag::kNull);
+        return true;
+      case JS_TAG_BOOL:
+        WriteTag(JS_VALUE_GET_BOOL(value) ? SerializationTag::kTrue : SerializationTag::kFalse);
+        return true;
+      case JS_TAG_INT:
+        WriteTag(SerializationTag::kInt32);
+        WriteRaw(JS_VALUE_GET_INT(value));
+        return true;
+      case JS_TAG_FLOAT64:
+        WriteTag(SerializationTag::kDouble);
+        WriteRaw(JS_VALUE_GET_FLOAT64(value));
+        return true;
+      case JS_TAG_STRING:
+        WriteTag(SerializationTag::kString);
+        return WriteString(value);
+      case JS_TAG_BIG_INT:
+        WriteTag(SerializationTag::kBigInt);
+        return WriteString(value);
+      case JS_TAG_OBJECT:
+        return WriteObject(value, depth);
+      default:
+        return ThrowDataCloneError("The value could not be cloned.");
+    }
+  }
+
+  // Detaches the ArrayBuffers of the transfer list once the whole value is written.
+  bool TransferArrayBuffers() {
+    for (JSValue array_buffer : transfer_list_) {
+      size_t length;
+      uint8_t* data = JS_TransferArrayBuffer(ctx_, &length, array_buffer);
+      if (data == nullptr)
+        return Rethrow();
+      value_->array_buffers_.emplace_back(SerializedScriptValue::TransferredArrayBuffer{data, length});
+    }
+    return true;
+  }
+
+ private:
+  void WriteTag(SerializationTag tag) { value_->data_.emplace_back(static_cast<uint8_t>(tag)); }
+
+  void WriteVarint(uint64_t value) {
+    do {
+      uint8_t byte = value & 0x7f;
+      value >>= 7;
+      value_->data_.emplace_back(value != 0 ? (byte | 0x80) : byte);
+    } while (value != 0);
+  }
+
+  template <typename T>
+  void WriteRaw(T value) {
+    auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    value_->data_.insert(value_->data_.end(), bytes, bytes + sizeof(T));
+  }
+
+  void WriteBytes(const uint8_t* bytes, size_t length) {
+    WriteVarint(length);
+    value_->data_.insert(value_->data_.end(), bytes, bytes + length);
+  }
+
+  // Strings are written in CESU-8, which keeps the unpaired surrogates.
+  bool WriteString(JSValueConst value) {
+    size_t length;
+    const char* string = JS_ToCStringLen2(ctx_, &length, value, true);
+    if (string == nullptr)
+      return Rethrow();
+    WriteBytes(reinterpret_cast<const uint8_t*>(string), length);
+    JS_FreeCString(ctx_, string);
+    return true;
+  }
+
+  bool WriteStringProperty(JSValueConst object, const char* name) {
+    JSValue property = JS_GetPropertyStr(ctx_, object, name);
+    if (JS_IsException(property))
+      return Rethrow();
+    bool success = WriteString(property);
+    JS_FreeValue(ctx_, property);
+    return success;
+  }
+
+  bool WriteObject(JSValueConst value, int depth) {
+    void* pointer = JS_VALUE_GET_PTR(value);
+    auto written = object_indexes_.find(pointer);
+    if (written != object_indexes_.end()) {
+      WriteTag(SerializationTag::kObjectReference);
+      WriteVarint(written->second);
+      return true;
+    }
+    // The objects are kept alive until the end, so the address of a getter's temporary result can't be reused.
+    object_indexes_.emplace(pointer, objects_.size());
+    objects_.emplace_back(JS_DupValue(ctx_, value));
+
+    auto transferred = transfer_indexes_.find(pointer);
+    if (transferred != transfer_indexes_.end()) {
+      WriteTag(SerializationTag::kTransferredArrayBuffer);
+      WriteVarint(transferred->second);
+      return true;
+    }
+
+    JSClassID class_id = JSValueGetClassId(value);
+    switch (class_id) {
+      case JS_CLASS_OBJECT:
+        WriteTag(SerializationTag::kObject);
+        return WriteProperties(value, depth);
+      case JS_CLASS_ARRAY: {
+        uint32_t length;
+        JSValue length_value = JS_GetPropertyStr(ctx_, value, "length");
+        int status = JS_ToUint32(ctx_, &length, length_value);
+        JS_FreeValue(ctx_, length_value);
+        if (status < 0)
+          return Rethrow();
+        WriteTag(SerializationTag::kArray);
+        WriteVarint(length);
+        return WriteProperties(value, depth);
+      }
+      case JS_CLASS_DATE:
+      case JS_CLASS_NUMBER: {
+        double number;
+        if (JS_ToFloat64(ctx_, &number, value) < 0)
+          return Rethrow();
+        WriteTag(class_id == JS_CLASS_DATE ? SerializationTag::kDate : SerializationTag::kNumberObject);
+        WriteRaw(number);
+        return true;
+      }
+      case JS_CLASS_BOOLEAN: {
+        int boolean = JS_ToBool(ctx_, value);
+        if (boolean < 0)
+          return Rethrow();
+        WriteTag(SerializationTag::kBooleanObject);
+        WriteTag(boolean ? SerializationTag::kTrue : SerializationTag::kFalse);
+        return true;
+      }
+      case JS_CLASS_STRING:
+        WriteTag(SerializationTag::kStringObject);
+        return WriteString(value);
+      case JS_CLASS_REGEXP:
+        WriteTag(SerializationTag::kRegExp);
+        return WriteStringProperty(value, "source") && WriteStringProperty(value, "flags");
+      case JS_CLASS_ERROR:
+        WriteTag(SerializationTag::kError);
+        return WriteStringProperty(value, "name") && WriteStringProperty(value, "message") &&
+               WriteStringProperty(value, "stack");
+      case JS_CLASS_MAP:
+        WriteTag(SerializationTag::kMap);
+        return WriteEntries(value, true, depth);
+      case JS_CLASS_SET:
+        WriteTag(SerializationTag::kSet);
+        return WriteEntries(value, false, depth);
+      case JS_CLASS_ARRAY_BUFFER: {
+        size_t length;
+        uint8_t* data = JS_GetArrayBuffer(ctx_, &length, value);
+        if (data == nullptr) {
+          JS_FreeValue(ctx_, JS_GetException(ctx_));
+          return ThrowDataCloneError("An ArrayBuffer is detached and could not be cloned.");
+        }
+        WriteTag(SerializationTag::kArrayBuffer);
+        WriteBytes(data, length);
+        return true;
+      }
+      default: {
+        int view_tag = ArrayBufferViewTag(class_id);
+        if (view_tag < 0)
+          return ThrowDataCloneError("The object could not be cloned.");
+        return WriteArrayBufferView(value, view_tag, depth);
+      }
+    }
+  }
+
+  bool WriteProperties(JSValueConst object, int depth) {
+    JSPropertyEnum* properties;
+    uint32_t count;
+    if (JS_GetOwnPropertyNames(ctx_, &properties, &count, object, JS_GPN_STRING_MASK | JS_GPN_ENUM_ONLY) < 0)
+      return Rethrow();
+
+    WriteVarint(count);
+    bool success = true;
+    for (uint32_t i = 0; i < count; i++) {
+      JSAtom atom = properties[i].atom;
+      if (success) {
+        success = WriteKey(atom);
+      }
+      if (success) {
+        JSValue property = JS_GetProperty(ctx_, object, atom);
+        success = JS_IsException(property) ? Rethrow() : WriteValue(property, depth + 1);
+        JS_FreeValue(ctx_, property);
+      }
+      JS_FreeAtom(ctx_, atom);
+    }
+    js_free(ctx_, properties);
+    return success;
+  }
+
+  bool WriteKey(JSAtom atom) {
+    if (JS_AtomIsTaggedInt(atom)) {
+      WriteTag(SerializationTag::kInt32);
+      WriteRaw(JS_AtomToUInt32(atom));
+      return true;
+    }
+    JSValue key = JS_AtomToString(ctx_, atom);
+    WriteTag(SerializationTag::kString);
+    bool success = WriteString(key);
+    JS_FreeValue(ctx_, key);
+    return success;
+  }
+
+  // The keys and values of a Map or the values of a Set, taken before any getter of an entry can change them.
+  bool WriteEntries(JSValueConst collection, bool is_map, int depth) {
+    JSValue entries = JS_GetMapEntries(ctx_, collection);
+    if (JS_IsException(entries))
+      return Rethrow();
+
+    uint32_t length = 0;
+    JSValue length_value = JS_GetPropertyStr(ctx_, entries, "length");
+    bool success = JS_ToUint32(ctx_, &length, length_value) == 0 || Rethrow();
+    JS_FreeValue(ctx_, length_value);
+    if (success) {
+      WriteVarint(is_map ? length / 2 : length);
+    }
+    for (uint32_t i = 0; success && i < length; i++) {
+      JSValue entry = JS_GetPropertyUint32(ctx_, entries, i);
+      success = WriteValue(entry, depth + 1);
+      JS_FreeValue(ctx_, entry);
+    }
+    JS_FreeValue(ctx_, entries);
+    return success;
+  }
+
+  // The view is written before its buffer, which may be transferred or shared with other views.
+  bool WriteArrayBufferView(JSValueConst view, int view_tag, int depth) {
+    size_t byte_offset, byte_length;
+    JSValue buffer = JS_GetArrayBufferViewBuffer(ctx_, view, &byte_offset, &byte_length);
+    if (JS_IsException(buffer)) {
+      JS_FreeValue(ctx_, JS_GetException(ctx_));
+      return ThrowDataCloneError("An ArrayBuffer is detached and could not be cloned.");
+    }
+    WriteTag(SerializationTag::kArrayBufferView);
+    value_->data_.emplace_back(static_cast<uint8_t>(view_tag));
+    WriteVarint(byte_offset);
+    WriteVarint(byte_length);
+    bool success = WriteValue(buffer, depth + 1);
+    JS_FreeValue(ctx_, buffer);
+    return success;
+  }
+
+  bool ThrowDataCloneError(const std::string& message) {
+    exception_state_.ThrowException(ctx_, ErrorType::TypeError, "DataCloneError: " + message);
+    return false;
+  }
+
+  // Hands the exception pending in the context to |exception_state_|.
+  bool Rethrow() {
+    exception_state_.ThrowException(ctx_, JS_EXCEPTION);
+    return false;
+  }
+
+  JSContext* ctx_;
+  SerializedScriptValue* value_;
+  ExceptionState& exception_state_;
+  std::vector<JSValue> objects_;
+  std::unordered_map<void*, uint32_t> object_indexes_;
+  std::vector<JSValue> transfer_list_;
+  std::unordered_map<void*, uint32_t> transfer_indexes_;
+};
+
+class ValueDeserializer {
+ public:
+  ValueDeserializer(JSContext* ctx, SerializedScriptValue* value) : ctx_(ctx), value_(value) {}
+
+  ~ValueDeserializer() {
+    for (JSValue object : objects_) {
+      JS_FreeValue(ctx_, object);
+    }
+  }
+
+  JSValue ReadValue() {
+    SerializationTag tag;
+    if (!ReadTag(&tag))
+      return ThrowDataCorrupted();
+
+    switch (tag) {
+      case SerializationTag::kUndefined:
+        return JS_UNDEFINED;
+      case SerializationTag::kNull:
+        return JS_NULL;
+      case SerializationTag::kTrue:
+        return JS_TRUE;
+      case SerializationTag::kFalse:
+        return JS_FALSE;
+      case SerializationTag::kInt32: {
+        int32_t value;
+        return ReadRaw(&value) ? JS_NewInt32(ctx_, value) : ThrowDataCorrupted();
+      }
+      case SerializationTag::kDouble: {
+        double value;
+        return ReadRaw(&value) ? JS_NewFloat64(ctx_, value) : ThrowDataCorrupted();
+      }
+      case SerializationTag::kString:
+        return ReadString();
+      case SerializationTag::kBigInt: {
+        JSValue digits = ReadString();
+        if (JS_IsException(digits))
+          return digits;
+        JSValue result = JS_NewBigIntFromString(ctx_, digits);
+        JS_FreeValue(ctx_, digits);
+        return result;
+      }
+      case SerializationTag::kObjectReference: {
+        uint64_t index;
+        if (!ReadVarint(&index) || index >= objects_.size())
+          return ThrowDataCorrupted();
+        return JS_DupValue(ctx_, objects_[index]);
+      }
+      case SerializationTag::kObject:
+        return ReadProperties(AddObject(JS_NewObject(ctx_)));
+      case SerializationTag::kArray: {
+        uint64_t length;
+        if (!ReadVarint(&length))
+          return ThrowDataCorrupted();
+        JSValue array = AddObject(JS_NewArray(ctx_));
+        if (JS_IsException(array) || JS_SetPropertyStr(ctx_, array, "length", JS_NewInt64(ctx_, length)) < 0) {
+          JS_FreeValue(ctx_, array);
+          return JS_EXCEPTION;
+        }
+        return ReadProperties(array);
+      }
+      case SerializationTag::kDate:
+      case SerializationTag::kNumberObject: {
+        double number;
+        if (!ReadRaw(&number))
+          return ThrowDataCorrupted();
+        return AddObject(tag == SerializationTag::kDate ? JS_NewDate(ctx_, number)
+                                                        : JS_ToObject(ctx_, JS_NewFloat64(ctx_, number)));
+      }
+      case SerializationTag::kBooleanObject:
+      case SerializationTag::kStringObject: {
+        bool is_boolean = tag == SerializationTag::kBooleanObject;
+        JSValue primitive = is_boolean ? ReadValue() : ReadString();
+        if (JS_IsException(primitive))
+          return primitive;
+        JSValue object = JS_ToObject(ctx_, primitive);
+        JS_FreeValue(ctx_, primitive);
+        return AddObject(object);
+      }
+      case SerializationTag::kRegExp:
+        return ReadRegExp();
+      case SerializationTag::kError:
+        return ReadError();
+      case SerializationTag::kMap:
+      case SerializationTag::kSet:
+        return ReadEntries(tag == SerializationTag::kMap);
+      case SerializationTag::kArrayBuffer: {
+        uint64_t length;
+        if (!ReadVarint(&length) || length > Remaining())
+          return ThrowDataCorrupted();
+        JSValue array_buffer = JS_NewArrayBufferCopy(ctx_, value_->data_.data() + position_, length);
+        position_ += length;
+        return AddObject(array_buffer);
+      }
+      case SerializationTag::kTransferredArrayBuffer: {
+        uint64_t index;
+        if (!ReadVarint(&index) || index >= value_->array_buffers_.size() ||
+            value_->array_buffers_[index].data == nullptr)
+          return ThrowDataCorrupted();
+        auto& transferred = value_->array_buffers_[index];
+        JSValue array_buffer = JS_NewArrayBuffer(ctx_, transferred.data, transferred.length,
+                                                 JS_FreeTransferredArrayBuffer, nullptr, false);
+        if (!JS_IsException(array_buffer)) {
+          transferred.data = nullptr;
+        }
+        return AddObject(array_buffer);
+      }
+      case SerializationTag::kArrayBufferView:
+        return ReadArrayBufferView();
+    }
+    return ThrowDataCorrupted();
+  }
+
+ private:
+  size_t Remaining() const { return value_->data_.size() - position_; }
+
+  bool ReadTag(SerializationTag* tag) {
+    if (Remaining() < 1)
+      return false;
+    *tag = static_cast<SerializationTag>(value_->data_[position_++]);
+    return true;
+  }
+
+  bool ReadVarint(uint64_t* value) {
+    *value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (Remaining() < 1)
+        return false;
+      uint8_t byte = value_->data_[position_++];
+      *value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0)
+        return true;
+    }
+    return false;
+  }
+
+  template <typename T>
+  bool ReadRaw(T* value) {
+    if (Remaining() < sizeof(T))
+      return false;
+    memcpy(value, value_->data_.data() + position_, sizeof(T));
+    position_ += sizeof(T);
+    return true;
+  }
+
+  JSValue ReadString() {
+    uint64_t length;
+    if (!ReadVarint(&length) || length > Remaining())
+      return ThrowDataCorrupted();
+    JSValue string = JS_NewStringLen(ctx_, reinterpret_cast<const char*>(value_->data_.data() + position_), length);
+    position_ += length;
+    return string;
+  }
+
+  // Keeps a reference for kObjectReference, the objects are numbered in the order they were written.
+  JSValue AddObject(JSValue object) {
+    if (!JS_IsException(object)) {
+      objects_.emplace_back(JS_DupValue(ctx_, object));
+    }
+    return object;
+  }
+
+  JSValue ReadProperties(JSValue object) {
+    uint64_t count;
+    if (JS_IsException(object))
+      return object;
+    if (!ReadVarint(&count)) {
+      JS_FreeValue(ctx_, object);
+      return ThrowDataCorrupted();
+    }
+
+    for (uint64_t i = 0; i < count; i++) {
+      JSAtom atom = ReadKey();
+      if (atom == JS_ATOM_NULL) {
+        JS_FreeValue(ctx_, object);
+        return JS_EXCEPTION;
+      }
+      JSValue property = ReadValue();
+      int status = JS_IsException(property) ? -1 : JS_DefinePropertyValue(ctx_, object, atom, property, JS_PROP_C_W_E);
+      JS_FreeAtom(ctx_, atom);
+      if (status < 0) {
+        JS_FreeValue(ctx_, object);
+        return JS_EXCEPTION;
+      }
+    }
+    return object;
+  }
+
+  JSAtom ReadKey() {
+    SerializationTag tag;
+    if (!ReadTag(&tag)) {
+      ThrowDataCorrupted();
+      return JS_ATOM_NULL;
+    }
+    if (tag == SerializationTag::kInt32) {
+      uint32_t index;
+      if (!ReadRaw(&index)) {
+        ThrowDataCorrupted();
+        return JS_ATOM_NULL;
+      }
+      return JS_NewAtomUInt32(ctx_, index);
+    }
+    if (tag != SerializationTag::kString) {
+      ThrowDataCorrupted();
+      return JS_ATOM_NULL;
+    }
+    JSValue key = ReadString();
+    if (JS_IsException(key))
+      return JS_ATOM_NULL;
+    JSAtom atom = JS_ValueToAtom(ctx_, key);
+    JS_FreeValue(ctx_, key);
+    return atom;
+  }
+
+  JSValue ReadRegExp() {
+    JSValue pattern = ReadString();
+    if (JS_IsException(pattern))
+      return pattern;
+    JSValue flags = ReadString();
+    JSValue regexp = JS_IsException(flags) ? flags : JS_NewRegExp(ctx_, pattern, flags);
+    JS_FreeValue(ctx_, pattern);
+    JS_FreeValue(ctx_, flags);
+    return AddObject(regexp);
+  }
+
+  // The error gets the prototype of the native error named |name|, or of Error for any other name.
+  JSValue ReadError() {
+    JSValue name = ReadString();
+    if (JS_IsException(name))
+      return name;
+    JSValue message = ReadString();
+    const char* name_string = JS_IsException(message) ? nullptr : JS_ToCString(ctx_, name);
+    JSValue error = name_string != nullptr ? JS_NewNativeError(ctx_, name_string, message) : JS_EXCEPTION;
+    JS_FreeCString(ctx_, name_string);
+    JS_FreeValue(ctx_, name);
+    JS_FreeValue(ctx_, message);
+    AddObject(error);
+    if (JS_IsException(error))
+      return error;
+    JSValue stack = ReadString();
+    if (JS_IsException(stack)) {
+      JS_FreeValue(ctx_, error);
+      return stack;
+    }
+    JS_DefinePropertyValueStr(ctx_, error, "stack", stack, JS_PROP_WRITABLE | JS_PROP_CONFIGURABLE);
+    return error;
+  }
+
+  JSValue ReadEntries(bool is_map) {
+    uint64_t length;
+    if (!ReadVarint(&length))
+      return ThrowDataCorrupted();
+    JSValue collection = AddObject(is_map ? JS_NewMap(ctx_) : JS_NewSet(ctx_));
+    if (JS_IsException(collection))
+      return collection;
+
+    bool success = true;
+    for (uint64_t i = 0; success && i < length; i++) {
+      JSValue arguments[2] = {ReadValue(), JS_UNDEFINED};
+      success = !JS_IsException(arguments[0]);
+      if (success && is_map) {
+        arguments[1] = ReadValue();
+        success = !JS_IsException(arguments[1]);
+      }
+      if (success) {
+        success = JS_MapSetEntry(ctx_, collection, arguments[0], arguments[1]) == 0;
+      }
+      JS_FreeValue(ctx_, arguments[0]);
+      JS_FreeValue(ctx_, arguments[1]);
+    }
+    if (!success) {
+      JS_FreeValue(ctx_, collection);
+      return JS_EXCEPTION;
+    }
+    return collection;
+  }
+
+  JSValue ReadArrayBufferView() {
+    uint8_t view_tag;
+    uint64_t byte_offset, byte_length;
+    if (!ReadRaw(&view_tag) || view_tag >= std::size(kArrayBufferViewClassIds) || !ReadVarint(&byte_offset) ||
+        !ReadVarint(&byte_length))
+      return ThrowDataCorrupted();
+
+    // The view was numbered before its buffer.
+    size_t index = objects_.size();
+    objects_.emplace_back(JS_UNDEFINED);
+    JSValue buffer = ReadValue();
+    if (JS_IsException(buffer))
+      return buffer;
+
+    JSValue view = JS_NewArrayBufferView(ctx_, kArrayBufferViewClassIds[view_tag], buffer, byte_offset,
+                                         byte_length / kArrayBufferViewElementSizes[view_tag]);
+    JS_FreeValue(ctx_, buffer);
+    if (!JS_IsException(view)) {
+      objects_[index] = JS_DupValue(ctx_, view);
+    }
+    return view;
+  }
+
+  JSValue ThrowDataCorrupted() { return JS_ThrowTypeError(ctx_, "Unable to deserialize cloned data."); }
+
+  JSContext* ctx_;
+  SerializedScriptValue* value_;
+  size_t position_{0};
+  std::vector<JSValue> objects_;
+};
+
+std::unique_ptr<SerializedScriptValue> SerializedScriptValue::Serialize(JSContext* ctx,
+                                                                        JSValueConst value,
+                                                                        JSValueConst transfer,
+                                                                        ExceptionState& exception_state) {
+  std::unique_ptr<SerializedScriptValue> serialized(new SerializedScriptValue());
+  ValueSerializer serializer(ctx, serialized.get(), exception_state);
+  if (!serializer.PrepareTransfer(transfer) || !serializer.WriteValue(value, 0) || !serializer.TransferArrayBuffers())
+    return nullptr;
+  return serialized;
+}
+
+SerializedScriptValue::~SerializedScriptValue() {
+  for (auto& array_buffer : array_buffers_) {
+    if (array_buffer.data != nullptr) {
+      JS_FreeTransferredArrayBuffer(nullptr, nullptr, array_buffer.data);
+    }
+  }
+}
+
+JSValue SerializedScriptValue::Deserialize(JSContext* ctx) {
+  ValueDeserializer deserializer(ctx, this);
+  return deserializer.ReadValue();
+}
+
+}  // namespace webf
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_WORKERS_SERIALIZED_SCRIPT_VALUE_H_
+#define WEBF_CORE_WORKERS_SERIALIZED_SCRIPT_VALUE_H_
+
+#include <quickjs/quickjs.h>
+#include <memory>
+#include <vector>
+#include "bindings/qjs/exception_state.h"
+#include "foundation/macros.h"
+
+namespace webf {
+
+// A JavaScript value serialized by the structured clone algorithm, which can be deserialized in another JSRuntime on
+// another thread.
+// https://html.spec.whatwg.org/multipage/structured-data.html#safe-passing-of-structured-data
+//
+// Primitives, plain objects, arrays, Date, RegExp, Map, Set, errors, ArrayBuffers and their views are supported,
+// object identities and cycles are kept. The ArrayBuffers in the transfer list are detached and their contents are
+// moved along with the value instead of being copied.
+class SerializedScriptValue {
+ public:
+  // |transfer| is undefined or an array of ArrayBuffers. Returns nullptr with an exception in |exception_state| when
+  // the value can't be cloned.
+  static std::unique_ptr<SerializedScriptValue> Serialize(JSContext* ctx,
+                                                          JSValueConst value,
+                                                          JSValueConst transfer,
+                                                          ExceptionState& exception_state);
+
+  ~SerializedScriptValue();
+
+  // Creates the value in |ctx|, the transferred ArrayBuffers are handed to it, so a value is deserialized only once.
+  JSValue Deserialize(JSContext* ctx);
+
+ private:
+  friend class ValueSerializer;
+  friend class ValueDeserializer;
+
+  struct TransferredArrayBuffer {
+    uint8_t* data;
+    size_t length;
+  };
+
+  SerializedScriptValue() = default;
+
+  std::vector<uint8_t> data_;
+  // Owned until the value is deserialized.
+  std::vector<TransferredArrayBuffer> array_buffers_;
+
+  WEBF_DISALLOW_COPY_AND_ASSIGN(SerializedScriptValue);
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_WORKERS_SERIALIZED_SCRIPT_VALUE_H_
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "serialized_script_value.h"
+#include <string>
+#include "gtest/gtest.h"
+
+using namespace webf;
+
+namespace {
+
+// Clones the value of |source| evaluated in one runtime to a global named `cloned` of another runtime.
+class SerializedScriptValueTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    from_runtime_ = JS_NewRuntime();
+    from_ = JS_NewContext(from_runtime_);
+    to_runtime_ = JS_NewRuntime();
+    to_ = JS_NewContext(to_runtime_);
+  }
+
+  void TearDown() override {
+    JS_FreeContext(from_);
+    JS_FreeRuntime(from_runtime_);
+    JS_FreeContext(to_);
+    JS_FreeRuntime(to_runtime_);
+  }
+
+  std::unique_ptr<SerializedScriptValue> Serialize(const std::string& source, const std::string& transfer = "") {
+    JSValue value = Evaluate(from_, source);
+    JSValue transfer_list = transfer.empty() ? JS_UNDEFINED : Evaluate(from_, transfer);
+    ExceptionState exception_state;
+    auto serialized = SerializedScriptValue::Serialize(from_, value, transfer_list, exception_state);
+    if (exception_state.HasException()) {
+      JS_FreeValue(from_, JS_GetException(from_));
+    }
+    JS_FreeValue(from_, transfer_list);
+    JS_FreeValue(from_, value);
+    return serialized;
+  }
+
+  void Clone(const std::string& source, const std::string& transfer = "") {
+    auto serialized = Serialize(source, transfer);
+    ASSERT_NE(serialized, nullptr);
+    JSValue cloned = serialized->Deserialize(to_);
+    ASSERT_FALSE(JS_IsException(cloned));
+    JSValue global = JS_GetGlobalObject(to_);
+    JS_SetPropertyStr(to_, global, "cloned", cloned);
+    JS_FreeValue(to_, global);
+  }
+
+  static JSValue Evaluate(JSContext* ctx, const std::string& source) {
+    return JS_Eval(ctx, source.c_str(), source.size(), "test.js", JS_EVAL_TYPE_GLOBAL);
+  }
+
+  static std::string EvaluateToString(JSContext* ctx, const std::string& source) {
+    JSValue result = Evaluate(ctx, source);
+    const char* string = JS_ToCString(ctx, result);
+    std::string copy = string != nullptr ? string : "";
+    JS_FreeCString(ctx, string);
+    JS_FreeValue(ctx, result);
+    return copy;
+  }
+
+  JSRuntime* from_runtime_;
+  JSContext* from_;
+  JSRuntime* to_runtime_;
+  JSContext* to_;
+};
+
+}  // namespace
+
+TEST_F(SerializedScriptValueTest, clonesPrimitivesAndObjects) {
+  Clone("({a: 1, b: 1.5, c: 'text\\ud800', d: [1, , 'x'], e: null, f: undefined, g: true, 3: 'index'})");
+  EXPECT_EQ(EvaluateToString(to_, "JSON.stringify(cloned)"),
+            "{\"3\":\"index\",\"a\":1,\"b\":1.5,\"c\":\"text\\ud800\",\"d\":[1,null,\"x\"],\"e\":null,\"g\":true}");
+  EXPECT_EQ(EvaluateToString(to_, "[1 in cloned.d, cloned.d.length, 'f' in cloned].join()"), "false,3,true");
+}
+
+TEST_F(SerializedScriptValueTest, clonesBuiltInObjects) {
+  Clone(
+      "({date: new Date(1000), regexp: /a+b/gi, map: new Map([[1, {x: 1}]]), set: new Set(['s']),"
+      " error: new RangeError('bad'), bytes: new Uint16Array([1, 2, 3]).subarray(1)})");
+  EXPECT_EQ(EvaluateToString(to_, "cloned.date.getTime()"), "1000");
+  EXPECT_EQ(EvaluateToString(to_, "cloned.regexp.toString()"), "/a+b/gi");
+  EXPECT_EQ(EvaluateToString(to_, "cloned.map.get(1).x"), "1");
+  EXPECT_EQ(EvaluateToString(to_, "cloned.set.has('s')"), "true");
+  EXPECT_EQ(EvaluateToString(to_, "cloned.error instanceof RangeError && cloned.error.message"), "bad");
+  EXPECT_EQ(EvaluateToString(to_, "cloned.bytes instanceof Uint16Array && Array.from(cloned.bytes).join()"), "2,3");
+  EXPECT_EQ(EvaluateToString(to_, "cloned.bytes.buffer.byteLength"), "6");
+}
+
+TEST_F(SerializedScriptValueTest, keepsObjectIdentities) {
+  Clone("var shared = {}; var cyclic = {shared, again: shared}; cyclic.self = cyclic; cyclic");
+  EXPECT_EQ(EvaluateToString(to_, "cloned.self === cloned && cloned.shared === cloned.again"), "true");
+}
+
+TEST_F(SerializedScriptValueTest, transfersArrayBuffersWithoutCopying) {
+  JSValue buffer = Evaluate(from_, "var buffer = new Uint8Array([7, 8, 9]).buffer; buffer");
+  size_t length;
+  const uint8_t* data = JS_GetArrayBuffer(from_, &length, buffer);
+  JS_FreeValue(from_, buffer);
+
+  Clone("({buffer, view: new Uint8Array(buffer, 1)})", "[buffer]");
+  EXPECT_EQ(EvaluateToString(from_, "buffer.byteLength"), "0");
+  EXPECT_EQ(EvaluateToString(to_, "cloned.view.buffer === cloned.buffer && Array.from(cloned.view).join()"), "8,9");
+
+  JSValue cloned_buffer = Evaluate(to_, "cloned.buffer");
+  EXPECT_EQ(JS_GetArrayBuffer(to_, &length, cloned_buffer), data);
+  JS_FreeValue(to_, cloned_buffer);
+}
+
+TEST_F(SerializedScriptValueTest, rejectsValuesWhichCanNotBeCloned) {
+  EXPECT_EQ(Serialize("({f() {}})"), nullptr);
+  EXPECT_EQ(Serialize("Symbol('s')"), nullptr);
+  EXPECT_EQ(Serialize("new WeakMap()"), nullptr);
+  EXPECT_EQ(Serialize("var b = new ArrayBuffer(1); b", "[b, b]"), nullptr);
+  EXPECT_EQ(EvaluateToString(from_, "b.byteLength"), "1");
+}
+
+TEST_F(SerializedScriptValueTest, ignoresOverriddenGlobals) {
+  EvaluateToString(from_, "Array.from = null; Map.prototype[Symbol.iterator] = Set.prototype.values = null");
+  EvaluateToString(to_,
+                   "var original = {Map, Set, RangeError, Uint8Array};"
+                   "Map = Set = Date = RegExp = RangeError = Boolean = Uint8Array = null;"
+                   "original.Map.prototype.set = original.Set.prototype.add = null");
+  Clone(
+      "({date: new Date(1000), regexp: /a/g, map: new Map([[1, 2]]), set: new Set(['s']),"
+      " error: new RangeError('bad'), flag: new Boolean(true), bytes: new Uint8Array([1, 2])})");
+  EXPECT_EQ(EvaluateToString(to_, "cloned.date.getTime()"), "1000");
+  EXPECT_EQ(EvaluateToString(to_, "cloned.regexp.toString()"), "/a/g");
+  EXPECT_EQ(EvaluateToString(to_, "cloned.map instanceof original.Map && cloned.map.get(1)"), "2");
+  EXPECT_EQ(EvaluateToString(to_, "cloned.set instanceof original.Set && cloned.set.has('s')"), "true");
+  EXPECT_EQ(EvaluateToString(to_, "cloned.error instanceof original.RangeError && cloned.error.message"), "bad");
+  EXPECT_EQ(EvaluateToString(to_, "typeof cloned.flag + cloned.flag.valueOf()"), "objecttrue");
+  EXPECT_EQ(EvaluateToString(to_, "cloned.bytes instanceof original.Uint8Array && cloned.bytes[1]"), "2");
+}
+
+TEST_F(SerializedScriptValueTest, rejectsValuesNestedTooDeeply) {
+  EXPECT_NE(Serialize("var shallow = []; for (var i = 0; i < 200; i++) shallow = [shallow]; shallow"), nullptr);
+  EXPECT_EQ(Serialize("var deep = []; for (var i = 0; i < 1000; i++) deep = [deep]; deep"), nullptr);
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "worker.h"
+#include <sstream>
+#include "bindings/qjs/cppgc/garbage_collected.h"
+#include "bindings/qjs/qjs_function.h"
+#include "core/events/error_event.h"
+#include "core/events/message_event.h"
+#include "core/executing_context.h"
+#include "core/frame/window_or_worker_global_scope.h"
+#include "foundation/logging.h"
+
+namespace webf {
+
+// How often the worker is polled when the page runs on the dart thread.
+constexpr int32_t kPollIntervalInMilliseconds = 16;
+
+Worker* Worker::Create(ExecutingContext* context, const AtomicString& script_url, ExceptionState& exception_state) {
+  auto* worker = MakeGarbageCollected<Worker>(context, script_url);
+  if (!worker->Start()) {
+    exception_state.ThrowException(context->ctx(), ErrorType::InternalError,
+                                   "Failed to construct 'Worker': at most " +
+                                       std::to_string(WorkerThreadPool::kMaximumRunningWorkers) +
+                                       " workers can run at once.");
+    return nullptr;
+  }
+  return worker;
+}
+
+Worker::Worker(ExecutingContext* context, const AtomicString& script_url)
+    : EventTargetWithInlineData(context), script_url_(script_url.ToStdString(ctx())) {}
+
+Worker::~Worker() {
+  // The JS thread may be torn down, only the worker thread is stopped.
+  if (thread_ != nullptr) {
+    thread_->Terminate();
+  }
+}
+
+void Worker::postMessage(const ScriptValue& message, ExceptionState& exception_state) {
+  postMessage(message, ScriptValue::Undefined(ctx()), exception_state);
+}
+
+void Worker::postMessage(const ScriptValue& message, const ScriptValue& transfer, ExceptionState& exception_state) {
+  auto serialized = SerializedScriptValue::Serialize(ctx(), message.QJSValue(), transfer.QJSValue(), exception_state);
+  if (UNLIKELY(serialized == nullptr))
+    return;
+  thread_->PostMessageToWorker(std::move(serialized));
+  StartPolling();
+}
+
+void Worker::terminate(ExceptionState& exception_state) {
+  thread_->Terminate();
+  Stop();
+}
+
+bool Worker::Start() {
+  JSThreadDispatcher* dispatcher = GetExecutingContext()->dartIsolateContext()->dispatcher();
+  WorkerThread::OwnerNotifier notify_owner;
+  if (dispatcher != nullptr) {
+    notify_owner = [dispatcher, context_id = contextId(), worker = this](WorkerThread* thread) {
+      dispatcher->PostToJS(context_id, [worker, weak_thread = thread->weak_from_this()]() {
+        // The Worker may be gone once the thread is terminated.
+        auto thread = weak_thread.lock();
+        if (thread != nullptr && !thread->IsTerminated()) {
+          worker->DispatchMessagesFromWorker();
+        }
+      });
+    };
+  }
+
+  auto thread = WorkerThread::Create(script_url_, std::move(notify_owner));
+  if (!thread->Start(WorkerThreadPool::Shared()))
+    return false;
+  thread_ = std::move(thread);
+  running_ = true;
+  KeepAlive();
+  StartPolling();
+  return true;
+}
+
+void Worker::Stop() {
+  if (!running_)
+    return;
+  running_ = false;
+  StopPolling();
+  ReleaseAlive();
+}
+
+void Worker::StartPolling() {
+  if (!running_ || poll_timer_id_ >= 0 || GetExecutingContext()->dartIsolateContext()->dispatcher() != nullptr)
+    return;
+  auto poll = QJSFunction::Create(
+      ctx(),
+      [](JSContext* ctx, const ScriptValue& this_val, uint32_t argc, const ScriptValue* argv,
+         void* private_data) -> ScriptValue {
+        static_cast<Worker*>(private_data)->PollWorker();
+        return ScriptValue::Empty(ctx);
+      },
+      0, this);
+  ExceptionState exception_state;
+  poll_timer_id_ =
+      WindowOrWorkerGlobalScope::setInterval(GetExecutingContext(), poll, kPollIntervalInMilliseconds, exception_state);
+  if (UNLIKELY(exception_state.HasException())) {
+    GetExecutingContext()->HandleException(exception_state);
+  }
+}
+
+void Worker::StopPolling() {
+  if (poll_timer_id_ < 0)
+    return;
+  ExceptionState exception_state;
+  WindowOrWorkerGlobalScope::clearInterval(GetExecutingContext(), poll_timer_id_, exception_state);
+  poll_timer_id_ = -1;
+}
+
+void Worker::PollWorker() {
+  // An idle worker posts nothing until it's sent a message, which starts polling again.
+  bool idle = !thread_->HasPendingWork();
+  DispatchMessagesFromWorker();
+  if (idle)
+    StopPolling();
+}
+
+void Worker::DispatchMessagesFromWorker() {
+  if (!running_)
+    return;
+  for (WorkerMessage& message : thread_->TakeMessagesToOwner()) {
+    // A listener may have terminated the worker.
+    if (thread_->IsTerminated())
+      break;
+    DispatchWorkerMessage(message);
+  }
+  GetExecutingContext()->DrainPendingPromiseJobs();
+}
+
+void Worker::DispatchWorkerMessage(WorkerMessage& message) {
+  ExceptionState exception_state;
+  switch (message.type) {
+    case WorkerMessage::Type::kMessage: {
+      JSValue data = message.data->Deserialize(ctx());
+      if (UNLIKELY(JS_IsException(data))) {
+        JS_FreeValue(ctx(), JS_GetException(ctx()));
+        auto* event = MessageEvent::Create(GetExecutingContext(), event_type_names::kmessageerror, exception_state);
+        dispatchEvent(event, exception_state);
+        break;
+      }
+      auto event_init = MessageEventInit::Create();
+      event_init->setData(ScriptValue(ctx(), data));
+      JS_FreeValue(ctx(), data);
+      auto* event =
+          MessageEvent::Create(GetExecutingContext(), event_type_names::kmessage, event_init, exception_state);
+      dispatchEvent(event, exception_state);
+      break;
+    }
+    case WorkerMessage::Type::kError: {
+      auto* event = ErrorEvent::Create(GetExecutingContext(), message.text);
+      dispatchEvent(event, exception_state);
+      break;
+    }
+    case WorkerMessage::Type::kConsole: {
+      std::stringstream stream;
+      stream << message.text;
+      printLog(GetExecutingContext(), stream, message.level, nullptr);
+      break;
+    }
+    case WorkerMessage::Type::kClosed:
+      Stop();
+      break;
+  }
+  if (UNLIKELY(exception_state.HasException())) {
+    GetExecutingContext()->HandleException(exception_state);
+  }
+}
+
+}  // namespace webf
@@ -0,0 +1,13 @@
+import {EventTarget} from "../dom/events/event_target";
+import {IDLEventHandler} from "../frame/window_event_handlers";
+
+export interface Worker extends EventTarget {
+  onmessage: IDLEventHandler | null;
+  onmessageerror: IDLEventHandler | null;
+  onerror: IDLEventHandler | null;
+
+  postMessage(message: any, transfer?: any): void;
+  terminate(): void;
+
+  new(scriptURL: string): Worker;
+}
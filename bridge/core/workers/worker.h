@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_WORKERS_WORKER_H_
+#define WEBF_CORE_WORKERS_WORKER_H_
+
+#include <memory>
+#include <string>
+#include "bindings/qjs/wrapper_type_info.h"
+#include "core/dom/events/event_target.h"
+#include "event_type_names.h"
+#include "worker_thread.h"
+
+namespace webf {
+
+// https://html.spec.whatwg.org/multipage/workers.html#dedicated-workers-and-the-worker-interface
+//
+// Runs the script registered as |script_url| with registerWorkerCode() or registerWorkerByteCode() on a thread of the
+// shared WorkerThreadPool, see WorkerGlobalScope for what the script can use. The Worker is kept alive until the
+// worker is terminated or closes itself.
+//
+// The worker reports to the page through the JS thread dispatcher when the page runs on a dedicated JS thread. The dart
+// thread can't be woken up from another thread, so a page running there polls the worker with a timer, only while the
+// worker has work left which may post to the page.
+class Worker : public EventTargetWithInlineData {
+  DEFINE_WRAPPERTYPEINFO();
+
+ public:
+  using ImplType = Worker*;
+  static Worker* Create(ExecutingContext* context, const AtomicString& script_url, ExceptionState& exception_state);
+
+  explicit Worker(ExecutingContext* context, const AtomicString& script_url);
+  ~Worker() override;
+
+  void postMessage(const ScriptValue& message, ExceptionState& exception_state);
+  void postMessage(const ScriptValue& message, const ScriptValue& transfer, ExceptionState& exception_state);
+  void terminate(ExceptionState& exception_state);
+
+  DEFINE_ATTRIBUTE_EVENT_LISTENER(message, kmessage);
+  DEFINE_ATTRIBUTE_EVENT_LISTENER(messageerror, kmessageerror);
+  DEFINE_ATTRIBUTE_EVENT_LISTENER(error, kerror);
+
+ private:
+  // Returns false when the worker can't be given a thread.
+  bool Start();
+  // Stops delivering the messages of the worker and lets the Worker be collected.
+  void Stop();
+  void StartPolling();
+  void StopPolling();
+  void PollWorker();
+  void DispatchMessagesFromWorker();
+  void DispatchWorkerMessage(WorkerMessage& message);
+
+  std::string script_url_;
+  std::shared_ptr<WorkerThread> thread_;
+  bool running_{false};
+  // The timer polling the worker when the page runs on the dart thread.
+  int32_t poll_timer_id_{-1};
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_WORKERS_WORKER_H_
@@ -0,0 +1,378 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "worker_global_scope.h"
+#include <algorithm>
+#include <cassert>
+#include <mutex>
+#include "worker_thread.h"
+
+namespace webf {
+
+namespace {
+
+struct WorkerScript {
+  const uint8_t* bytecode{nullptr};
+  size_t bytecode_length{0};
+  std::string code;
+};
+
+std::mutex& ScriptsMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::unordered_map<std::string, WorkerScript>& Scripts() {
+  static std::unordered_map<std::string, WorkerScript> scripts;
+  return scripts;
+}
+
+bool FindScript(const std::string& name, WorkerScript* script) {
+  std::lock_guard<std::mutex> guard(ScriptsMutex());
+  auto it = Scripts().find(name);
+  if (it == Scripts().end())
+    return false;
+  *script = it->second;
+  return true;
+}
+
+std::string ToStdString(JSContext* ctx, JSValueConst value) {
+  const char* string = JS_ToCString(ctx, value);
+  if (string == nullptr) {
+    JS_FreeValue(ctx, JS_GetException(ctx));
+    return "";
+  }
+  std::string result = string;
+  JS_FreeCString(ctx, string);
+  return result;
+}
+
+// The EventTarget methods of the global object, the listeners are called after the on<type> handler.
+const char kEventTargetSource[] = R"(
+(function(self) {
+  var listeners = Object.create(null);
+  self.addEventListener = function(type, listener) {
+    if (listener == null) return;
+    var list = listeners[type] || (listeners[type] = []);
+    if (list.indexOf(listener) < 0) list.push(listener);
+  };
+  self.removeEventListener = function(type, listener) {
+    var list = listeners[type];
+    var index = list ? list.indexOf(listener) : -1;
+    if (index >= 0) list.splice(index, 1);
+  };
+  self.dispatchEvent = function(event) {
+    var handler = self['on' + event.type];
+    var list = (listeners[event.type] || []).slice();
+    if (typeof handler === 'function') list.unshift(handler);
+    list.forEach(function(listener) {
+      try {
+        if (typeof listener === 'function') listener.call(self, event);
+        else listener.handleEvent(event);
+      } catch (e) {
+        self.reportError(e);
+      }
+    });
+    return true;
+  };
+})(globalThis);
+)";
+
+const char* const kConsoleLevels[] = {"log", "info", "warn", "error", "debug"};
+constexpr int kConsoleLevelCount = sizeof(kConsoleLevels) / sizeof(kConsoleLevels[0]);
+
+}  // namespace
+
+WorkerGlobalScope::WorkerGlobalScope(WorkerThread* thread) : thread_(thread) {
+  runtime_ = JS_NewRuntime();
+  JS_SetInterruptHandler(runtime_, HandleInterrupt, this);
+  ctx_ = JS_NewContext(runtime_);
+  JS_SetContextOpaque(ctx_, this);
+
+  JSValue global = JS_GetGlobalObject(ctx_);
+  JS_SetPropertyStr(ctx_, global, "self", JS_DupValue(ctx_, global));
+  JS_SetPropertyStr(ctx_, global, "postMessage", JS_NewCFunction(ctx_, PostMessage, "postMessage", 1));
+  JS_SetPropertyStr(ctx_, global, "close", JS_NewCFunction(ctx_, Close, "close", 0));
+  JS_SetPropertyStr(ctx_, global, "importScripts", JS_NewCFunction(ctx_, ImportScripts, "importScripts", 0));
+  JS_SetPropertyStr(ctx_, global, "reportError", JS_NewCFunction(ctx_, ReportError, "reportError", 1));
+  JS_SetPropertyStr(ctx_, global, "setTimeout",
+                    JS_NewCFunctionMagic(ctx_, SetTimer, "setTimeout", 1, JS_CFUNC_generic_magic, 0));
+  JS_SetPropertyStr(ctx_, global, "setInterval",
+                    JS_NewCFunctionMagic(ctx_, SetTimer, "setInterval", 1, JS_CFUNC_generic_magic, 1));
+  JS_SetPropertyStr(ctx_, global, "clearTimeout", JS_NewCFunction(ctx_, ClearTimer, "clearTimeout", 0));
+  JS_SetPropertyStr(ctx_, global, "clearInterval", JS_NewCFunction(ctx_, ClearTimer, "clearInterval", 0));
+
+  JSValue console = JS_NewObject(ctx_);
+  for (int level = 0; level < kConsoleLevelCount; level++) {
+    JS_SetPropertyStr(ctx_, console, kConsoleLevels[level],
+                      JS_NewCFunctionMagic(ctx_, ConsoleLog, kConsoleLevels[level], 0, JS_CFUNC_generic_magic, level));
+  }
+  JS_SetPropertyStr(ctx_, global, "console", console);
+  JS_FreeValue(ctx_, global);
+
+  JSValue result = JS_Eval(ctx_, kEventTargetSource, sizeof(kEventTargetSource) - 1, "worker://event_target",
+                           JS_EVAL_TYPE_GLOBAL);
+  assert(!JS_IsException(result));
+  JS_FreeValue(ctx_, result);
+}
+
+WorkerGlobalScope::~WorkerGlobalScope() {
+  for (auto& entry : timers_) {
+    FreeTimer(entry.second);
+  }
+  timers_.clear();
+  JS_FreeContext(ctx_);
+  JS_FreeRuntime(runtime_);
+}
+
+WorkerGlobalScope* WorkerGlobalScope::From(JSContext* ctx) {
+  return static_cast<WorkerGlobalScope*>(JS_GetContextOpaque(ctx));
+}
+
+bool WorkerGlobalScope::EvaluateScript(const std::string& script_url) {
+  WorkerScript script;
+  if (!FindScript(script_url, &script)) {
+    thread_->PostMessageToOwner(
+        {WorkerMessage::Type::kError, nullptr, "Failed to load the worker script '" + script_url + "'."});
+    return false;
+  }
+  JSValue result = LoadScript(script_url);
+  if (JS_IsException(result)) {
+    ReportPendingException();
+  }
+  JS_FreeValue(ctx_, result);
+  RunPendingJobs();
+  return true;
+}
+
+void WorkerGlobalScope::DispatchMessage(std::unique_ptr<SerializedScriptValue> message) {
+  if (message == nullptr) {
+    DispatchEvent("messageerror", JS_NULL);
+    return;
+  }
+  JSValue data = message->Deserialize(ctx_);
+  if (JS_IsException(data)) {
+    JS_FreeValue(ctx_, JS_GetException(ctx_));
+    DispatchEvent("messageerror", JS_NULL);
+    return;
+  }
+  DispatchEvent("message", data);
+}
+
+void WorkerGlobalScope::RegisterScript(const std::string& name, const uint8_t* bytes, size_t length) {
+  std::lock_guard<std::mutex> guard(ScriptsMutex());
+  Scripts()[name] = WorkerScript{bytes, length, ""};
+}
+
+void WorkerGlobalScope::RegisterScript(const std::string& name, std::string code) {
+  std::lock_guard<std::mutex> guard(ScriptsMutex());
+  Scripts()[name] = WorkerScript{nullptr, 0, std::move(code)};
+}
+
+JSValue WorkerGlobalScope::PostMessage(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv) {
+  ExceptionState exception_state;
+  auto message = SerializedScriptValue::Serialize(ctx, argc > 0 ? argv[0] : JS_UNDEFINED,
+                                                  argc > 1 ? argv[1] : JS_UNDEFINED, exception_state);
+  if (message == nullptr)
+    return JS_EXCEPTION;
+  From(ctx)->thread_->PostMessageToOwner({WorkerMessage::Type::kMessage, std::move(message)});
+  return JS_UNDEFINED;
+}
+
+JSValue WorkerGlobalScope::Close(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv) {
+  From(ctx)->closing_ = true;
+  return JS_UNDEFINED;
+}
+
+JSValue WorkerGlobalScope::ImportScripts(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv) {
+  WorkerGlobalScope* scope = From(ctx);
+  for (int i = 0; i < argc; i++) {
+    const char* name = JS_ToCString(ctx, argv[i]);
+    if (name == nullptr)
+      return JS_EXCEPTION;
+    JSValue result = scope->LoadScript(name);
+    JS_FreeCString(ctx, name);
+    if (JS_IsException(result))
+      return JS_EXCEPTION;
+    JS_FreeValue(ctx, result);
+  }
+  return JS_UNDEFINED;
+}
+
+JSValue WorkerGlobalScope::ReportError(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv) {
+  From(ctx)->ReportException(JS_DupValue(ctx, argc > 0 ? argv[0] : JS_UNDEFINED));
+  return JS_UNDEFINED;
+}
+
+JSValue WorkerGlobalScope::SetTimer(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int repeat) {
+  if (argc < 1 || !JS_IsFunction(ctx, argv[0])) {
+    return JS_ThrowTypeError(ctx,
+                             "Failed to execute '%s' on 'WorkerGlobalScope': parameter 1 is not of type 'Function'.",
+                             repeat ? "setInterval" : "setTimeout");
+  }
+  int32_t timeout = 0;
+  if (argc > 1 && JS_ToInt32(ctx, &timeout, argv[1]) < 0)
+    return JS_EXCEPTION;
+  timeout = std::max(timeout, 0);
+
+  Timer timer{JS_DupValue(ctx, argv[0]), {}, timeout, repeat != 0};
+  for (int i = 2; i < argc; i++) {
+    timer.arguments.emplace_back(JS_DupValue(ctx, argv[i]));
+  }
+  WorkerGlobalScope* scope = From(ctx);
+  int32_t timer_id = scope->next_timer_id_++;
+  scope->timers_.emplace(timer_id, std::move(timer));
+  scope->ScheduleTimer(timer_id, timeout);
+  return JS_NewInt32(ctx, timer_id);
+}
+
+JSValue WorkerGlobalScope::ClearTimer(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv) {
+  int32_t timer_id = 0;
+  if (argc > 0 && JS_ToInt32(ctx, &timer_id, argv[0]) < 0)
+    return JS_EXCEPTION;
+  WorkerGlobalScope* scope = From(ctx);
+  auto it = scope->timers_.find(timer_id);
+  if (it != scope->timers_.end()) {
+    scope->FreeTimer(it->second);
+    scope->timers_.erase(it);
+  }
+  return JS_UNDEFINED;
+}
+
+JSValue WorkerGlobalScope::ConsoleLog(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int level) {
+  std::string text;
+  for (int i = 0; i < argc; i++) {
+    if (i > 0) {
+      text += ' ';
+    }
+    text += ToStdString(ctx, argv[i]);
+  }
+  From(ctx)->thread_->PostMessageToOwner({WorkerMessage::Type::kConsole, nullptr, text, kConsoleLevels[level]});
+  return JS_UNDEFINED;
+}
+
+int WorkerGlobalScope::HandleInterrupt(JSRuntime* runtime, void* opaque) {
+  return static_cast<WorkerGlobalScope*>(opaque)->thread_->IsTerminated() ? 1 : 0;
+}
+
+JSValue WorkerGlobalScope::LoadScript(const std::string& name) {
+  WorkerScript script;
+  if (!FindScript(name, &script)) {
+    return JS_ThrowTypeError(ctx_,
+                             "Failed to execute 'importScripts' on 'WorkerGlobalScope': The script at '%s' failed to "
+                             "load.",
+                             name.c_str());
+  }
+  if (script.bytecode == nullptr) {
+    return JS_Eval(ctx_, script.code.c_str(), script.code.size(), name.c_str(), JS_EVAL_TYPE_GLOBAL);
+  }
+  JSValue function = JS_ReadObject(ctx_, script.bytecode, script.bytecode_length, JS_READ_OBJ_BYTECODE);
+  if (JS_IsException(function))
+    return function;
+  return JS_EvalFunction(ctx_, function);
+}
+
+void WorkerGlobalScope::DispatchEvent(const char* type, JSValue data) {
+  JSValue global = JS_GetGlobalObject(ctx_);
+  JSValue event = JS_NewObject(ctx_);
+  JS_SetPropertyStr(ctx_, event, "type", JS_NewString(ctx_, type));
+  JS_SetPropertyStr(ctx_, event, "data", data);
+  JS_SetPropertyStr(ctx_, event, "target", JS_DupValue(ctx_, global));
+  JS_SetPropertyStr(ctx_, event, "currentTarget", JS_DupValue(ctx_, global));
+
+  JSValue dispatch = JS_GetPropertyStr(ctx_, global, "dispatchEvent");
+  JSValue result = JS_Call(ctx_, dispatch, global, 1, &event);
+  if (JS_IsException(result)) {
+    ReportPendingException();
+  }
+  JS_FreeValue(ctx_, result);
+  JS_FreeValue(ctx_, dispatch);
+  JS_FreeValue(ctx_, event);
+  JS_FreeValue(ctx_, global);
+  RunPendingJobs();
+}
+
+void WorkerGlobalScope::ScheduleTimer(int32_t timer_id, int32_t timeout) {
+  thread_->PostDelayedTask([timer_id](WorkerGlobalScope* scope) { scope->FireTimer(timer_id); },
+                          std::chrono::milliseconds(timeout));
+}
+
+void WorkerGlobalScope::FireTimer(int32_t timer_id) {
+  auto it = timers_.find(timer_id);
+  if (it == timers_.end())
+    return;
+
+  // The callback may clear its own timer.
+  JSValue callback = JS_DupValue(ctx_, it->second.callback);
+  std::vector<JSValue> arguments = it->second.arguments;
+  for (JSValue& argument : arguments) {
+    JS_DupValue(ctx_, argument);
+  }
+  bool repeat = it->second.repeat;
+  int32_t timeout = it->second.timeout;
+  if (!repeat) {
+    FreeTimer(it->second);
+    timers_.erase(it);
+  }
+
+  JSValue result = JS_Call(ctx_, callback, JS_UNDEFINED, static_cast<int>(arguments.size()), arguments.data());
+  if (JS_IsException(result)) {
+    ReportPendingException();
+  }
+  JS_FreeValue(ctx_, result);
+  JS_FreeValue(ctx_, callback);
+  for (JSValue& argument : arguments) {
+    JS_FreeValue(ctx_, argument);
+  }
+  RunPendingJobs();
+
+  if (repeat && timers_.count(timer_id) > 0) {
+    ScheduleTimer(timer_id, timeout);
+  }
+}
+
+void WorkerGlobalScope::FreeTimer(Timer& timer) {
+  JS_FreeValue(ctx_, timer.callback);
+  for (JSValue& argument : timer.arguments) {
+    JS_FreeValue(ctx_, argument);
+  }
+  timer.arguments.clear();
+}
+
+void WorkerGlobalScope::RunPendingJobs() {
+  JSContext* job_ctx;
+  int status;
+  while ((status = JS_ExecutePendingJob(runtime_, &job_ctx)) != 0) {
+    if (status < 0) {
+      ReportPendingException();
+    }
+    if (thread_->IsTerminated())
+      break;
+  }
+}
+
+void WorkerGlobalScope::ReportException(JSValue exception) {
+  std::string message = ToStdString(ctx_, exception);
+  if (JS_IsError(ctx_, exception)) {
+    JSValue stack = JS_GetPropertyStr(ctx_, exception, "stack");
+    if (JS_IsString(stack)) {
+      message += '\n' + ToStdString(ctx_, stack);
+    }
+    JS_FreeValue(ctx_, stack);
+  }
+  JS_FreeValue(ctx_, exception);
+  thread_->PostMessageToOwner({WorkerMessage::Type::kError, nullptr, message});
+}
+
+void WorkerGlobalScope::ReportPendingException() {
+  JSValue exception = JS_GetException(ctx_);
+  // A terminated worker is interrupted with an uncatchable error, which isn't reported.
+  if (thread_->IsTerminated()) {
+    JS_FreeValue(ctx_, exception);
+    return;
+  }
+  ReportException(exception);
+}
+
+}  // namespace webf
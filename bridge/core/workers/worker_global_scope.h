@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_WORKERS_WORKER_GLOBAL_SCOPE_H_
+#define WEBF_CORE_WORKERS_WORKER_GLOBAL_SCOPE_H_
+
+#include <quickjs/quickjs.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "foundation/macros.h"
+#include "serialized_script_value.h"
+
+namespace webf {
+
+class WorkerThread;
+
+// The global scope of a worker, a JSRuntime of its own living on the worker thread.
+//
+// Workers have no DOM. The scope only provides self, postMessage(), close(), importScripts(), the timers,
+// reportError(), a console forwarded to the owner page and the EventTarget methods of the global object, which
+// dispatch the message events to onmessage and the listeners.
+class WorkerGlobalScope {
+ public:
+  explicit WorkerGlobalScope(WorkerThread* thread);
+  ~WorkerGlobalScope();
+
+  static WorkerGlobalScope* From(JSContext* ctx);
+
+  // Runs the worker script. Returns false when no script is registered for |script_url|, the exceptions it throws are
+  // reported to the owner.
+  bool EvaluateScript(const std::string& script_url);
+  void DispatchMessage(std::unique_ptr<SerializedScriptValue> message);
+  // Whether close() was called, the worker finishes after the current task.
+  bool IsClosing() const { return closing_; }
+
+  // The scripts loaded by `new Worker(name)` and importScripts(name). The bytecode isn't copied, it must stay valid as
+  // long as workers may load it.
+  static void RegisterScript(const std::string& name, const uint8_t* bytes, size_t length);
+  static void RegisterScript(const std::string& name, std::string code);
+
+ private:
+  struct Timer {
+    JSValue callback;
+    std::vector<JSValue> arguments;
+    int32_t timeout;
+    bool repeat;
+  };
+
+  static JSValue PostMessage(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv);
+  static JSValue Close(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv);
+  static JSValue ImportScripts(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv);
+  static JSValue ReportError(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv);
+  static JSValue SetTimer(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int repeat);
+  static JSValue ClearTimer(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv);
+  static JSValue ConsoleLog(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv, int level);
+  static int HandleInterrupt(JSRuntime* runtime, void* opaque);
+
+  // Runs a registered script, returns JS_EXCEPTION when it isn't registered or throws.
+  JSValue LoadScript(const std::string& name);
+  void DispatchEvent(const char* type, JSValue data);
+  void ScheduleTimer(int32_t timer_id, int32_t timeout);
+  void FireTimer(int32_t timer_id);
+  void FreeTimer(Timer& timer);
+  // Runs the promise jobs queued by the last task.
+  void RunPendingJobs();
+  void ReportException(JSValue exception);
+  void ReportPendingException();
+
+  WorkerThread* thread_;
+  JSRuntime* runtime_;
+  JSContext* ctx_;
+  bool closing_{false};
+  int32_t next_timer_id_{1};
+  std::unordered_map<int32_t, Timer> timers_;
+
+  WEBF_DISALLOW_COPY_AND_ASSIGN(WorkerGlobalScope);
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_WORKERS_WORKER_GLOBAL_SCOPE_H_
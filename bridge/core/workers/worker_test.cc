@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "gtest/gtest.h"
+#include "webf_test_env.h"
+#include "worker_global_scope.h"
+
+using namespace webf;
+
+TEST(Worker, exchangesMessages) {
+  bool static errorCalled = false;
+  static std::vector<std::string> logs;
+  logs.clear();
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logs.emplace_back(message);
+  };
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  WorkerGlobalScope::RegisterScript("double.js",
+                                    "self.addEventListener('message', function(e) {"
+                                    "  var bytes = new Uint8Array(e.data.buffer);"
+                                    "  postMessage({value: e.data.value * 2, first: bytes[0]});"
+                                    "  close();"
+                                    "});");
+  std::string code = R"(
+    let worker = new Worker('double.js');
+    let buffer = new Uint8Array([7]).buffer;
+    worker.onmessage = (e) => console.log(e.data.value, e.data.first, buffer.byteLength);
+    worker.postMessage({value: 21, buffer}, [buffer]);
+  )";
+  env->page()->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+  TEST_runLoop(env->page()->GetExecutingContext());
+
+  EXPECT_EQ(errorCalled, false);
+  ASSERT_EQ(logs.size(), 1);
+  EXPECT_EQ(logs[0], "42 7 0");
+}
+
+TEST(Worker, reportsErrorsAndTerminates) {
+  bool static errorCalled = false;
+  static std::vector<std::string> logs;
+  logs.clear();
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logs.emplace_back(message);
+  };
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  WorkerGlobalScope::RegisterScript("throw.js", "console.warn('starting'); throw new RangeError('bad input');");
+  WorkerGlobalScope::RegisterScript("spin.js", "for (;;) {}");
+  std::string code = R"(
+    new Worker('spin.js').terminate();
+    let worker = new Worker('throw.js');
+    worker.onerror = (e) => {
+      console.log(e.message.split('\n')[0]);
+      worker.terminate();
+    };
+    worker.postMessage(new Map());
+  )";
+  env->page()->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+  TEST_runLoop(env->page()->GetExecutingContext());
+
+  EXPECT_EQ(errorCalled, false);
+  ASSERT_EQ(logs.size(), 2);
+  EXPECT_EQ(logs[0], "starting");
+  EXPECT_EQ(logs[1], "RangeError: bad input");
+}
+
+TEST(Worker, startsWhileOtherWorkersAreBusy) {
+  bool static errorCalled = false;
+  static std::vector<std::string> logs;
+  logs.clear();
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logs.emplace_back(message);
+  };
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  WorkerGlobalScope::RegisterScript("busy.js", "for (;;) {}");
+  WorkerGlobalScope::RegisterScript("ready.js", "postMessage('ready'); close();");
+  std::string code = R"(
+    let busy = [];
+    for (let i = 0; i < 8; i++) busy.push(new Worker('busy.js'));
+    let worker = new Worker('ready.js');
+    worker.onmessage = (e) => {
+      console.log(e.data);
+      busy.forEach(w => w.terminate());
+    };
+  )";
+  env->page()->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+  TEST_runLoop(env->page()->GetExecutingContext());
+
+  EXPECT_EQ(errorCalled, false);
+  ASSERT_EQ(logs.size(), 1);
+  EXPECT_EQ(logs[0], "ready");
+}
+
+TEST(Worker, failsToStartOverTheRunningLimit) {
+  bool static errorCalled = false;
+  static std::vector<std::string> logs;
+  logs.clear();
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logs.emplace_back(message);
+  };
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  WorkerGlobalScope::RegisterScript("busy.js", "for (;;) {}");
+  std::string code = R"(
+    let busy = [];
+    try {
+      for (;;) busy.push(new Worker('busy.js'));
+    } catch (e) {
+      console.log(e.message, busy.length <= 16);
+    }
+    busy.forEach(w => w.terminate());
+  )";
+  env->page()->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+  TEST_runLoop(env->page()->GetExecutingContext());
+
+  EXPECT_EQ(errorCalled, false);
+  ASSERT_EQ(logs.size(), 1);
+  EXPECT_EQ(logs[0], "Failed to construct 'Worker': at most 16 workers can run at once. true");
+}
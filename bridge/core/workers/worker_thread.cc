@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "worker_thread.h"
+#include <algorithm>
+#include <cassert>
+#include "worker_global_scope.h"
+
+namespace webf {
+
+std::shared_ptr<WorkerThread> WorkerThread::Create(std::string script_url, OwnerNotifier notify_owner) {
+  return std::shared_ptr<WorkerThread>(new WorkerThread(std::move(script_url), std::move(notify_owner)));
+}
+
+WorkerThread::WorkerThread(std::string script_url, OwnerNotifier notify_owner)
+    : script_url_(std::move(script_url)), notify_owner_(std::move(notify_owner)) {}
+
+WorkerThread::~WorkerThread() = default;
+
+bool WorkerThread::Start(WorkerThreadPool* pool) {
+  pool_ = pool;
+  // Done once the script has run.
+  pending_work_.fetch_add(1, std::memory_order_relaxed);
+  if (!pool->Schedule(shared_from_this())) {
+    pending_work_.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+void WorkerThread::PostMessageToWorker(std::unique_ptr<SerializedScriptValue> message) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (IsTerminated())
+    return;
+  messages_to_worker_.emplace_back(std::move(message));
+  pending_work_.fetch_add(1, std::memory_order_relaxed);
+  // Messages posted before the worker got a thread are dispatched once its script has run.
+  if (looper_ != nullptr) {
+    looper_->PostTask([self = shared_from_this()]() { self->DispatchMessagesToWorker(); });
+  }
+}
+
+void WorkerThread::Terminate() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (IsTerminated())
+    return;
+  terminated_.store(true, std::memory_order_release);
+  notify_owner_ = nullptr;
+  messages_to_worker_.clear();
+  messages_to_owner_.clear();
+  if (looper_ != nullptr) {
+    looper_->PostTask([self = shared_from_this()]() { self->Finish(); });
+  }
+}
+
+std::vector<WorkerMessage> WorkerThread::TakeMessagesToOwner() {
+  std::vector<WorkerMessage> messages;
+  std::lock_guard<std::mutex> guard(mutex_);
+  messages.swap(messages_to_owner_);
+  return messages;
+}
+
+void WorkerThread::PostMessageToOwner(WorkerMessage&& message) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (IsTerminated())
+    return;
+  messages_to_owner_.emplace_back(std::move(message));
+  if (notify_owner_ != nullptr) {
+    notify_owner_(this);
+  }
+}
+
+void WorkerThread::PostDelayedTask(WorkerTask&& task, std::chrono::milliseconds delay) {
+  // |looper_| only changes on this thread.
+  assert(looper_ != nullptr && looper_->IsCurrentThread());
+  pending_work_.fetch_add(1, std::memory_order_relaxed);
+  looper_->PostDelayedTask(
+      [weak_self = weak_from_this(), task = std::move(task)]() {
+        if (auto self = weak_self.lock()) {
+          self->RunTask(task);
+          self->pending_work_.fetch_sub(1, std::memory_order_release);
+        }
+      },
+      delay);
+}
+
+void WorkerThread::Run(Looper* looper) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (!IsTerminated()) {
+      looper_ = looper;
+    }
+  }
+  if (looper_ == nullptr) {
+    finished_ = true;
+    pool_->Recycle(looper);
+    return;
+  }
+
+  global_scope_ = std::make_unique<WorkerGlobalScope>(this);
+  if (global_scope_->EvaluateScript(script_url_)) {
+    DispatchMessagesToWorker();
+  } else {
+    Finish();
+  }
+  pending_work_.fetch_sub(1, std::memory_order_release);
+}
+
+void WorkerThread::RunTask(const WorkerTask& task) {
+  if (global_scope_ == nullptr || IsTerminated())
+    return;
+  task(global_scope_.get());
+  if (global_scope_->IsClosing()) {
+    Finish();
+  }
+}
+
+void WorkerThread::DispatchMessagesToWorker() {
+  if (global_scope_ == nullptr)
+    return;
+
+  std::deque<std::unique_ptr<SerializedScriptValue>> messages;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    messages.swap(messages_to_worker_);
+  }
+  for (auto& message : messages) {
+    // Messages left when the worker closes itself are discarded.
+    if (IsTerminated() || global_scope_->IsClosing())
+      break;
+    global_scope_->DispatchMessage(std::move(message));
+  }
+  if (global_scope_->IsClosing()) {
+    Finish();
+  }
+  pending_work_.fetch_sub(static_cast<int32_t>(messages.size()), std::memory_order_release);
+}
+
+void WorkerThread::Finish() {
+  if (finished_)
+    return;
+  finished_ = true;
+  global_scope_.reset();
+
+  Looper* looper;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    looper = looper_;
+    looper_ = nullptr;
+  }
+  PostMessageToOwner({WorkerMessage::Type::kClosed});
+  pool_->Recycle(looper);
+}
+
+WorkerThreadPool::WorkerThreadPool() = default;
+
+WorkerThreadPool::~WorkerThreadPool() {
+  // Runs the tasks finishing the terminated workers before joining.
+  threads_.clear();
+}
+
+WorkerThreadPool* WorkerThreadPool::Shared() {
+  // Never destroyed, a worker may still be running its script when the process exits.
+  static auto* pool = new WorkerThreadPool();
+  return pool;
+}
+
+bool WorkerThreadPool::Schedule(std::shared_ptr<WorkerThread> worker) {
+  Looper* looper = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (!idle_threads_.empty()) {
+      looper = idle_threads_.back();
+      idle_threads_.pop_back();
+    } else if (threads_.size() >= kMaximumRunningWorkers) {
+      return false;
+    } else {
+      threads_.emplace_back(std::make_unique<Looper>("webf_worker_" + std::to_string(threads_.size())));
+      looper = threads_.back().get();
+      looper->Start();
+    }
+  }
+  looper->PostTask([worker, looper]() { worker->Run(looper); });
+  return true;
+}
+
+void WorkerThreadPool::Recycle(Looper* looper) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (idle_threads_.size() < kKeepAliveThreads) {
+    idle_threads_.emplace_back(looper);
+    return;
+  }
+
+  // A thread can't join itself, one of the idle threads stops it once this task has returned. The idle thread does so
+  // before running any worker it's given later.
+  auto it = std::find_if(threads_.begin(), threads_.end(),
+                         [looper](const std::unique_ptr<Looper>& thread) { return thread.get() == looper; });
+  assert(it != threads_.end());
+  std::shared_ptr<Looper> stopped_thread = std::move(*it);
+  threads_.erase(it);
+  idle_threads_.back()->PostTask([stopped_thread]() { stopped_thread->Stop(); });
+}
+
+}  // namespace webf
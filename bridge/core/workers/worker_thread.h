@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_WORKERS_WORKER_THREAD_H_
+#define WEBF_CORE_WORKERS_WORKER_THREAD_H_
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "foundation/looper.h"
+#include "foundation/macros.h"
+#include "serialized_script_value.h"
+
+namespace webf {
+
+class WorkerGlobalScope;
+class WorkerThreadPool;
+
+// What a worker reports to its owner.
+struct WorkerMessage {
+  enum class Type { kMessage, kError, kConsole, kClosed };
+
+  Type type;
+  // The message of kMessage, nullptr when it failed to be serialized.
+  std::unique_ptr<SerializedScriptValue> data;
+  // The error message of kError, the logged text of kConsole.
+  std::string text;
+  // The console method of kConsole, e.g. "warn".
+  std::string level;
+};
+
+// The state of a worker shared by the thread owning the Worker object and the thread running its WorkerGlobalScope.
+//
+// A worker is given a thread of a WorkerThreadPool when it's started and keeps it until it's closed or terminated, the
+// messages posted to it before its script has run are queued. Messages to the owner are queued until the owner takes
+// them, |notify_owner| is called on the worker thread after each of them, until the worker is terminated.
+class WorkerThread : public std::enable_shared_from_this<WorkerThread> {
+ public:
+  using OwnerNotifier = std::function<void(WorkerThread* thread)>;
+  using WorkerTask = std::function<void(WorkerGlobalScope*)>;
+
+  static std::shared_ptr<WorkerThread> Create(std::string script_url, OwnerNotifier notify_owner);
+  ~WorkerThread();
+
+  const std::string& script_url() const { return script_url_; }
+
+  // Called on the owner thread. Returns false when the pool has no thread left for the worker.
+  bool Start(WorkerThreadPool* pool);
+  void PostMessageToWorker(std::unique_ptr<SerializedScriptValue> message);
+  // Stops the worker, even in the middle of a script, and drops the messages queued both ways. Returns at once, the
+  // global scope is disposed on the worker thread.
+  void Terminate();
+  bool IsTerminated() const { return terminated_.load(std::memory_order_acquire); }
+  // Whether the worker still has its script, a message or a timer to run, any of which may post to the owner. Read it
+  // before taking the messages, those posted by the work done by then are taken too.
+  bool HasPendingWork() const { return pending_work_.load(std::memory_order_acquire) > 0; }
+  std::vector<WorkerMessage> TakeMessagesToOwner();
+
+  // Called on the worker thread.
+  void PostMessageToOwner(WorkerMessage&& message);
+  // Runs |task| on the global scope after |delay|, unless the worker has finished by then.
+  void PostDelayedTask(WorkerTask&& task, std::chrono::milliseconds delay);
+
+ private:
+  friend class WorkerThreadPool;
+
+  WorkerThread(std::string script_url, OwnerNotifier notify_owner);
+
+  // Runs the worker script on |looper|, given by the pool.
+  void Run(Looper* looper);
+  void RunTask(const WorkerTask& task);
+  void DispatchMessagesToWorker();
+  // Disposes the global scope and gives the thread back to the pool.
+  void Finish();
+
+  const std::string script_url_;
+  WorkerThreadPool* pool_{nullptr};
+  std::atomic<bool> terminated_{false};
+  std::atomic<int32_t> pending_work_{0};
+
+  std::mutex mutex_;
+  OwnerNotifier notify_owner_;
+  // Set while the worker holds a thread.
+  Looper* looper_{nullptr};
+  std::deque<std::unique_ptr<SerializedScriptValue>> messages_to_worker_;
+  std::vector<WorkerMessage> messages_to_owner_;
+
+  // Only touched on the worker thread.
+  std::unique_ptr<WorkerGlobalScope> global_scope_;
+  bool finished_{false};
+
+  WEBF_DISALLOW_COPY_AND_ASSIGN(WorkerThread);
+};
+
+// Runs each worker on its own native thread. The threads of finished workers are kept and given to the workers started
+// later, a new thread is only spawned when all of them are taken. A worker never waits for another one to finish, which
+// may never happen, so no more than kMaximumRunningWorkers are started at once. Only kKeepAliveThreads of the idle
+// threads are kept, the others are stopped.
+class WorkerThreadPool {
+ public:
+  static constexpr size_t kMaximumRunningWorkers = 16;
+  static constexpr size_t kKeepAliveThreads = 2;
+
+  WorkerThreadPool();
+  // Stops the threads, the workers started on the pool must have been terminated.
+  ~WorkerThreadPool();
+
+  // The pool shared by the workers of all the pages.
+  static WorkerThreadPool* Shared();
+
+ private:
+  friend class WorkerThread;
+
+  // Returns false when kMaximumRunningWorkers are running.
+  bool Schedule(std::shared_ptr<WorkerThread> worker);
+  // Called on the thread of |looper| once its worker has finished.
+  void Recycle(Looper* looper);
+
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<Looper>> threads_;
+  std::vector<Looper*> idle_threads_;
+
+  WEBF_DISALLOW_COPY_AND_ASSIGN(WorkerThreadPool);
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_WORKERS_WORKER_THREAD_H_
@@ -7,7 +7,10 @@
 
 namespace webf {
 
-std::mutex InspectorTaskQueue::inspector_task_creation_mutex_{};
-fml::RefPtr<InspectorTaskQueue> InspectorTaskQueue::instance_{};
+fml::RefPtr<InspectorTaskQueue> InspectorTaskQueue::Create(int32_t contextId) {
+  auto queue = fml::MakeRefCounted<InspectorTaskQueue>();
+  queue->m_contextId = contextId;
+  return queue;
+}
 
 }  // namespace webf
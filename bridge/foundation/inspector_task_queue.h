@@ -16,12 +16,9 @@ using Task = void (*)(void*);
 class InspectorTaskQueue : public TaskQueue {
  public:
   static fml::RefPtr<InspectorTaskQueue> instance(int32_t contextId) {
-    std::lock_guard<std::mutex> guard(inspector_task_creation_mutex_);
-    if (!instance_) {
-      instance_ = fml::MakeRefCounted<InspectorTaskQueue>();
-      instance_->m_contextId = contextId;
-    }
-    return instance_;
+    // Created once by the first caller, later calls don't take a lock.
+    static const fml::RefPtr<InspectorTaskQueue> instance = Create(contextId);
+    return instance;
   };
   int32_t registerTask(const Task& task, void* data) override {
     int32_t taskId = TaskQueue::registerTask(task, data);
@@ -29,9 +26,9 @@ class InspectorTaskQueue : public TaskQueue {
   }
 
  private:
+  static fml::RefPtr<InspectorTaskQueue> Create(int32_t contextId);
+
   int32_t m_contextId{-1};
-  static std::mutex inspector_task_creation_mutex_;
-  static fml::RefPtr<InspectorTaskQueue> instance_;
 };
 
 }  // namespace webf
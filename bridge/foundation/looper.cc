@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "looper.h"
+#include <algorithm>
+#include <cassert>
+
+#if defined(__APPLE__)
+#include <pthread.h>
+#elif defined(__linux__) || defined(__ANDROID__)
+#include <sys/prctl.h>
+#endif
+
+namespace webf {
+
+void TaskRunner::PostTask(Callback&& task) {
+  Enqueue(std::move(task), false);
+}
+
+void TaskRunner::PostNestableTask(Callback&& task) {
+  Enqueue(std::move(task), true);
+}
+
+void TaskRunner::Enqueue(Callback&& task, bool nestable) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    tasks_.push_back(QueuedTask{std::move(task), nestable});
+  }
+  condition_.notify_all();
+  OnTaskPosted();
+}
+
+void TaskRunner::RunPendingTasks() {
+  // Tasks are taken one by one, the queued ones stay visible to a WaitUntil() nested in the running task.
+  while (true) {
+    Callback task;
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      if (tasks_.empty())
+        return;
+      task = std::move(tasks_.front().callback);
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+void TaskRunner::WaitUntil(const std::function<bool()>& condition) {
+  auto is_nestable = [](const QueuedTask& task) { return task.nestable; };
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    condition_.wait(lock, [&]() {
+      return condition() || std::find_if(tasks_.begin(), tasks_.end(), is_nestable) != tasks_.end();
+    });
+    if (condition())
+      return;
+
+    auto it = std::find_if(tasks_.begin(), tasks_.end(), is_nestable);
+    Callback task = std::move(it->callback);
+    tasks_.erase(it);
+    lock.unlock();
+    task();
+    lock.lock();
+  }
+}
+
+void TaskRunner::Wakeup() {
+  // Taking the lock orders the notification after a waiter checked its condition.
+  std::lock_guard<std::mutex> guard(mutex_);
+  condition_.notify_all();
+}
+
+Looper::Looper(std::string name) : name_(std::move(name)) {}
+
+Looper::~Looper() {
+  Stop();
+}
+
+void Looper::Start() {
+  assert(!thread_.joinable());
+  thread_ = std::thread([this]() {
+#if defined(__APPLE__)
+    pthread_setname_np(name_.c_str());
+#elif defined(__linux__) || defined(__ANDROID__)
+    prctl(PR_SET_NAME, name_.c_str());
+#endif
+    Run();
+  });
+}
+
+void Looper::Stop() {
+  if (!thread_.joinable())
+    return;
+  assert(!IsCurrentThread());
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stopped_ = true;
+  }
+  condition_.notify_all();
+  thread_.join();
+}
+
+void Looper::PostDelayedTask(Callback&& task, std::chrono::milliseconds delay) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    TimePoint due = std::chrono::steady_clock::now() + std::max(delay, std::chrono::milliseconds(0));
+    delayed_tasks_.emplace(std::make_pair(due, delayed_task_sequence_++), std::move(task));
+  }
+  condition_.notify_all();
+}
+
+void Looper::EnqueueDueTasks(TimePoint now) {
+  while (!delayed_tasks_.empty() && delayed_tasks_.begin()->first.first <= now) {
+    tasks_.push_back(QueuedTask{std::move(delayed_tasks_.begin()->second), false});
+    delayed_tasks_.erase(delayed_tasks_.begin());
+  }
+}
+
+void Looper::Run() {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (true) {
+        EnqueueDueTasks(std::chrono::steady_clock::now());
+        if (stopped_ || !tasks_.empty())
+          break;
+        if (delayed_tasks_.empty()) {
+          condition_.wait(lock);
+        } else {
+          condition_.wait_until(lock, delayed_tasks_.begin()->first.first);
+        }
+      }
+      if (stopped_ && tasks_.empty())
+        return;
+    }
+    RunPendingTasks();
+  }
+}
+
+}  // namespace webf
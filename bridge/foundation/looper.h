@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_FOUNDATION_LOOPER_H_
+#define BRIDGE_FOUNDATION_LOOPER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "foundation/macros.h"
+
+namespace webf {
+
+// The tasks posted to one thread. Tasks run in the order they were posted. A nestable task may also run while the
+// thread is blocked in WaitUntil(), it serves the synchronous calls made back to this thread by the thread being
+// waited for.
+class TaskRunner {
+ public:
+  using Callback = std::function<void()>;
+
+  TaskRunner() = default;
+  virtual ~TaskRunner() = default;
+
+  void PostTask(Callback&& task);
+  void PostNestableTask(Callback&& task);
+
+  // Runs the tasks queued so far, must be called on the thread owning the runner.
+  void RunPendingTasks();
+  // Blocks until |condition| returns true, the nestable tasks posted in the meantime are run while waiting.
+  void WaitUntil(const std::function<bool()>& condition);
+  // Makes WaitUntil() check its condition again.
+  void Wakeup();
+
+ protected:
+  struct QueuedTask {
+    Callback callback;
+    bool nestable;
+  };
+
+  // Called after a task was queued, the mutex is not held.
+  virtual void OnTaskPosted() {}
+
+  void Enqueue(Callback&& task, bool nestable);
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<QueuedTask> tasks_;
+
+  WEBF_DISALLOW_COPY_AND_ASSIGN(TaskRunner);
+};
+
+// A native thread running the tasks posted to it until it's stopped.
+class Looper : public TaskRunner {
+ public:
+  explicit Looper(std::string name);
+  ~Looper() override;
+
+  void Start();
+  // Runs the tasks already posted, then joins the thread. The delayed tasks not due yet are dropped.
+  void Stop();
+
+  // Posts |task| once |delay| has passed.
+  void PostDelayedTask(Callback&& task, std::chrono::milliseconds delay);
+
+  bool IsCurrentThread() const { return std::this_thread::get_id() == thread_.get_id(); }
+  std::thread::id ThreadId() const { return thread_.get_id(); }
+  const std::string& name() const { return name_; }
+
+ private:
+  using TimePoint = std::chrono::steady_clock::time_point;
+
+  void Run();
+  // Moves the due delayed tasks to the queue, the mutex must be held.
+  void EnqueueDueTasks(TimePoint now);
+
+  std::string name_;
+  std::thread thread_;
+  bool stopped_{false};
+  // Ordered by due time, then by posting order.
+  std::map<std::pair<TimePoint, uint64_t>, Callback> delayed_tasks_;
+  uint64_t delayed_task_sequence_{0};
+};
+
+// Runs |task| on the thread of |target| and returns its result. The calling thread owns |waiting| and keeps running the
+// nestable tasks posted to it until |task| has finished.
+template <typename T>
+T PostTaskSync(TaskRunner* target, TaskRunner* waiting, std::function<T()>&& task) {
+  std::packaged_task<T()> packaged_task(std::move(task));
+  std::future<T> future = packaged_task.get_future();
+  target->PostNestableTask([&packaged_task, waiting]() {
+    packaged_task();
+    waiting->Wakeup();
+  });
+  waiting->WaitUntil([&future]() { return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; });
+  return future.get();
+}
+
+}  // namespace webf
+
+#endif  // BRIDGE_FOUNDATION_LOOPER_H_
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "foundation/looper.h"
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace webf;
+
+TEST(Looper, tasksRunInOrder) {
+  Looper looper("test");
+  looper.Start();
+  std::vector<int> order;
+  for (int i = 0; i < 100; i++) {
+    looper.PostTask([&order, i]() { order.emplace_back(i); });
+  }
+  looper.Stop();
+
+  ASSERT_EQ(order.size(), 100);
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(order[i], i);
+  }
+}
+
+TEST(Looper, postTaskSyncReturnsResult) {
+  Looper looper("test");
+  TaskRunner current;
+  looper.Start();
+  std::thread::id task_thread;
+  int result = PostTaskSync<int>(&looper, &current, [&task_thread]() {
+    task_thread = std::this_thread::get_id();
+    return 42;
+  });
+
+  EXPECT_EQ(result, 42);
+  EXPECT_EQ(task_thread, looper.ThreadId());
+}
+
+TEST(Looper, nestedSyncCallsDoNotDeadlock) {
+  Looper looper("test");
+  TaskRunner current;
+  looper.Start();
+  std::thread::id current_thread = std::this_thread::get_id();
+  std::thread::id nested_thread;
+  int result = PostTaskSync<int>(&looper, &current, [&]() {
+    // Calls back to the waiting thread, which runs the nested task while waiting.
+    return PostTaskSync<int>(&current, &looper, [&]() {
+             nested_thread = std::this_thread::get_id();
+             return 1;
+           }) +
+           1;
+  });
+
+  EXPECT_EQ(result, 2);
+  EXPECT_EQ(nested_thread, current_thread);
+}
+
+TEST(Looper, waitingRunsOnlyNestableTasks) {
+  Looper looper("test");
+  TaskRunner current;
+  looper.Start();
+  bool async_task_called = false;
+  current.PostTask([&async_task_called]() { async_task_called = true; });
+  PostTaskSync<void>(&looper, &current, [&]() { PostTaskSync<void>(&current, &looper, []() {}); });
+
+  EXPECT_EQ(async_task_called, false);
+  current.RunPendingTasks();
+  EXPECT_EQ(async_task_called, true);
+}
+
+TEST(Looper, delayedTasksRunWhenDue) {
+  Looper looper("test");
+  looper.Start();
+  std::vector<int> order;
+  std::promise<void> finished;
+  auto start = std::chrono::steady_clock::now();
+  looper.PostDelayedTask(
+      [&order, &finished]() {
+        order.emplace_back(2);
+        finished.set_value();
+      },
+      std::chrono::milliseconds(30));
+  looper.PostDelayedTask([&order]() { order.emplace_back(1); }, std::chrono::milliseconds(10));
+  looper.PostTask([&order]() { order.emplace_back(0); });
+  finished.get_future().wait();
+
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(30));
+  EXPECT_EQ(order, std::vector<int>({0, 1, 2}));
+}
@@ -7,6 +7,10 @@
 #include "bindings/qjs/script_value.h"
 #include "core/executing_context.h"
 
+#if WIN32
+#include <Windows.h>
+#endif
+
 namespace webf {
 
 NativeValue Native_NewNull() {
@@ -142,4 +146,12 @@ NativeValue Native_NewJSON(const ScriptValue& value, ExceptionState& exception_s
 #endif
 }
 
+void FreeDartAllocated(void* ptr) {
+#if WIN32
+  CoTaskMemFree(ptr);
+#else
+  free(ptr);
+#endif
+}
+
 }  // namespace webf
@@ -77,6 +77,9 @@ NativeValue Native_NewList(uint32_t argc, NativeValue* argv);
 NativeValue Native_NewPtr(JSPointerType pointerType, void* ptr);
 NativeValue Native_NewJSON(const ScriptValue& value, ExceptionState& exception_state);
 
+// Frees the memory dart side allocated with malloc of package:ffi, e.g. the lists returned by binding calls.
+void FreeDartAllocated(void* ptr);
+
 }  // namespace webf
 
 #endif  // BRIDGE_NATIVE_VALUE_H
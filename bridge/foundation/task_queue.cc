@@ -7,29 +7,121 @@
 
 namespace webf {
 
+// Nodes are only pushed onto the shared pool and taken from it as a whole, which are both free from ABA. Every thread
+// pops from its own cache.
+struct TaskQueue::NodeCache {
+  ~NodeCache() {
+    while (head != nullptr) {
+      TaskNode* next = head->next;
+      delete head;
+      head = next;
+    }
+  }
+
+  TaskNode* head{nullptr};
+};
+
+std::atomic<TaskQueue::TaskNode*> TaskQueue::recycled_nodes_{nullptr};
+
+TaskQueue::TaskNode* TaskQueue::AcquireNode() {
+  thread_local NodeCache cache;
+  if (cache.head == nullptr) {
+    cache.head = recycled_nodes_.exchange(nullptr, std::memory_order_acquire);
+  }
+  if (cache.head == nullptr)
+    return new TaskNode();
+
+  TaskNode* node = cache.head;
+  cache.head = node->next;
+  return node;
+}
+
+void TaskQueue::RecycleNodes(TaskNode* first, TaskNode* last) {
+  TaskNode* head = recycled_nodes_.load(std::memory_order_relaxed);
+  do {
+    last->next = head;
+  } while (!recycled_nodes_.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+}
+
+TaskQueue::~TaskQueue() {
+  TakeRegisteredTasks();
+  if (pending_head_ != nullptr) {
+    RecycleNodes(pending_head_, pending_tail_);
+  }
+}
+
 int32_t TaskQueue::registerTask(const Task& task, void* data) {
-  std::lock_guard<std::mutex> guard(queue_mutex_);
-  auto taskData = new TaskData(task, data);
-  m_map[id++] = taskData;
-  return id - 1;
+  TaskNode* node = AcquireNode();
+  node->task = task;
+  node->data = data;
+  int32_t id = id_.fetch_add(1, std::memory_order_relaxed);
+  node->id = id;
+
+  // The node may be run and recycled by the consumer as soon as it's pushed.
+  TaskNode* head = registered_.load(std::memory_order_relaxed);
+  do {
+    node->next = head;
+  } while (!registered_.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+  return id;
+}
+
+void TaskQueue::TakeRegisteredTasks() {
+  TaskNode* stack = registered_.exchange(nullptr, std::memory_order_acquire);
+  if (stack == nullptr)
+    return;
+
+  // The stack holds the newest task first.
+  TaskNode* first = nullptr;
+  TaskNode* last = stack;
+  while (stack != nullptr) {
+    TaskNode* next = stack->next;
+    stack->next = first;
+    first = stack;
+    stack = next;
+  }
+
+  if (pending_tail_ != nullptr) {
+    pending_tail_->next = first;
+  } else {
+    pending_head_ = first;
+  }
+  pending_tail_ = last;
 }
 
 void TaskQueue::dispatchTask(int32_t taskId) {
-  std::lock_guard<std::mutex> guard(queue_mutex_);
-  if (m_map.count(taskId) > 0) {
-    m_map[taskId]->task(m_map[taskId]->data);
-    delete m_map[taskId];
-    m_map.erase(taskId);
+  TakeRegisteredTasks();
+  TaskNode* previous = nullptr;
+  for (TaskNode* node = pending_head_; node != nullptr; previous = node, node = node->next) {
+    if (node->id != taskId)
+      continue;
+
+    if (previous != nullptr) {
+      previous->next = node->next;
+    } else {
+      pending_head_ = node->next;
+    }
+    if (pending_tail_ == node) {
+      pending_tail_ = previous;
+    }
+    // The node is unlinked before running, the task may register or dispatch other tasks.
+    node->task(node->data);
+    RecycleNodes(node, node);
+    return;
   }
 }
 
 void TaskQueue::flushTask() {
-  std::lock_guard<std::mutex> guard(queue_mutex_);
-  for (auto& m : m_map) {
-    m.second->task(m.second->data);
-    delete m.second;
+  TakeRegisteredTasks();
+  TaskNode* first = pending_head_;
+  TaskNode* last = pending_tail_;
+  pending_head_ = pending_tail_ = nullptr;
+
+  for (TaskNode* node = first; node != nullptr; node = node->next) {
+    node->task(node->data);
+  }
+  if (first != nullptr) {
+    RecycleNodes(first, last);
   }
-  m_map.clear();
 }
 
 }  // namespace webf
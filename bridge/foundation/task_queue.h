@@ -6,8 +6,8 @@
 #ifndef BRIDGE_TASK_QUEUE_H
 #define BRIDGE_TASK_QUEUE_H
 
-#include <mutex>
-#include <unordered_map>
+#include <atomic>
+#include <cstdint>
 #include "ref_counter.h"
 #include "ref_ptr.h"
 
@@ -15,22 +15,46 @@ namespace webf {
 
 using Task = void (*)(void*);
 
+// A multi-producer single-consumer queue of tasks. registerTask() is lock free and callable on any thread, the tasks
+// are run by dispatchTask() and flushTask() on the thread consuming the queue.
+//
+// Producers push onto an atomic stack, the consumer takes the whole stack at once and keeps the tasks in registration
+// order. Task nodes are recycled through a shared pool with a per-thread cache, so registering a task doesn't allocate
+// once the pool is warm.
 class TaskQueue : public fml::RefCountedThreadSafe<TaskQueue> {
  public:
   virtual int32_t registerTask(const Task& task, void* data);
+  // Runs the pending task with |taskId|, if any.
   void dispatchTask(int32_t taskId);
+  // Runs the tasks registered so far in registration order. Tasks registered by them run at the next flush.
   void flushTask();
 
+ protected:
+  virtual ~TaskQueue();
+
  private:
-  struct TaskData {
-    TaskData(const Task& task, void* data) : task(task), data(data){};
+  struct TaskNode {
     Task task;
     void* data;
+    int32_t id;
+    TaskNode* next;
   };
+  struct NodeCache;
+
+  static TaskNode* AcquireNode();
+  static void RecycleNodes(TaskNode* first, TaskNode* last);
+
+  // The nodes released by all the queues.
+  static std::atomic<TaskNode*> recycled_nodes_;
+
+  // Moves the registered tasks to the consumer side list.
+  void TakeRegisteredTasks();
 
-  mutable std::mutex queue_mutex_;
-  std::unordered_map<int, TaskData*> m_map;
-  int64_t id{0};
+  std::atomic<TaskNode*> registered_{nullptr};
+  std::atomic<int32_t> id_{0};
+  // Only touched by the consumer.
+  TaskNode* pending_head_{nullptr};
+  TaskNode* pending_tail_{nullptr};
 
   FML_FRIEND_MAKE_REF_COUNTED(TaskQueue);
   FML_FRIEND_REF_COUNTED_THREAD_SAFE(TaskQueue);
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "foundation/task_queue.h"
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace webf;
+
+namespace {
+
+struct Recorder {
+  std::vector<int> values;
+};
+
+struct RecordedValue {
+  Recorder* recorder;
+  int value;
+};
+
+void RecordValue(void* data) {
+  auto* recorded = static_cast<RecordedValue*>(data);
+  recorded->recorder->values.emplace_back(recorded->value);
+}
+
+}  // namespace
+
+TEST(TaskQueue, flushRunsTasksInOrder) {
+  auto queue = fml::MakeRefCounted<TaskQueue>();
+  Recorder recorder;
+  std::vector<RecordedValue> values;
+  values.reserve(10);
+  for (int i = 0; i < 10; i++) {
+    values.emplace_back(RecordedValue{&recorder, i});
+    queue->registerTask(RecordValue, &values.back());
+  }
+  queue->flushTask();
+
+  ASSERT_EQ(recorder.values.size(), 10);
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(recorder.values[i], i);
+  }
+  queue->flushTask();
+  EXPECT_EQ(recorder.values.size(), 10);
+}
+
+TEST(TaskQueue, dispatchRunsOnlyTheTask) {
+  auto queue = fml::MakeRefCounted<TaskQueue>();
+  Recorder recorder;
+  RecordedValue first{&recorder, 1};
+  RecordedValue second{&recorder, 2};
+  queue->registerTask(RecordValue, &first);
+  int32_t second_id = queue->registerTask(RecordValue, &second);
+
+  queue->dispatchTask(second_id);
+  EXPECT_EQ(recorder.values, std::vector<int>({2}));
+  queue->dispatchTask(second_id);
+  EXPECT_EQ(recorder.values, std::vector<int>({2}));
+  queue->flushTask();
+  EXPECT_EQ(recorder.values, std::vector<int>({2, 1}));
+}
+
+TEST(TaskQueue, tasksFromManyProducersAllRun) {
+  auto queue = fml::MakeRefCounted<TaskQueue>();
+  std::atomic<int> count{0};
+  std::vector<std::thread> producers;
+  for (int i = 0; i < 4; i++) {
+    producers.emplace_back([&queue, &count]() {
+      for (int j = 0; j < 10000; j++) {
+        queue->registerTask([](void* data) { (*static_cast<std::atomic<int>*>(data))++; }, &count);
+      }
+    });
+  }
+  // Flushing while the producers are running.
+  while (count < 40000) {
+    queue->flushTask();
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  queue->flushTask();
+
+  EXPECT_EQ(count, 40000);
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "ui_command_arena.h"
+#include <algorithm>
+#include <cstring>
+
+namespace webf {
+
+static size_t AlignSize(size_t size) {
+  return (size + 7) & ~static_cast<size_t>(7);
+}
+
+UICommandArena::~UICommandArena() {
+  for (auto& block : blocks_) {
+    delete[] block.data;
+  }
+}
+
+void* UICommandArena::Allocate(size_t size) {
+  size = AlignSize(size);
+  allocated_bytes_ += size;
+
+  if (LIKELY(current_ < blocks_.size() && offset_ + size <= blocks_[current_].size)) {
+    void* memory = blocks_[current_].data + offset_;
+    offset_ += size;
+    return memory;
+  }
+
+  // Move on to the next retained block, or insert a new one which is large enough.
+  size_t next = blocks_.empty() ? 0 : current_ + 1;
+  if (next >= blocks_.size() || blocks_[next].size < size) {
+    size_t block_size = std::max(static_cast<size_t>(UI_COMMAND_ARENA_BLOCK_SIZE), size);
+    blocks_.insert(blocks_.begin() + static_cast<ptrdiff_t>(std::min(next, blocks_.size())),
+                   Block{new uint8_t[block_size], block_size});
+  }
+  current_ = next;
+  offset_ = size;
+  return blocks_[current_].data;
+}
+
+SharedNativeString* UICommandArena::NewString(const uint16_t* string, uint32_t length) {
+  auto* characters = static_cast<uint16_t*>(Allocate(length * sizeof(uint16_t)));
+  if (length > 0) {
+    memcpy(characters, string, length * sizeof(uint16_t));
+  }
+  return ::new (Allocate(sizeof(SharedNativeString))) SharedNativeString(characters, length);
+}
+
+SharedNativeString* UICommandArena::NewString(const uint8_t* string, uint32_t length) {
+  auto* characters = static_cast<uint16_t*>(Allocate(length * sizeof(uint16_t)));
+  std::copy(string, string + length, characters);
+  return ::new (Allocate(sizeof(SharedNativeString))) SharedNativeString(characters, length);
+}
+
+void UICommandArena::Reset() {
+  // Oversized blocks are dropped to bound the memory kept by idle pages.
+  size_t kept = 0;
+  for (size_t i = 0; i < blocks_.size(); i++) {
+    if (kept < MAXIMUM_RETAINED_UI_COMMAND_ARENA_BLOCKS && blocks_[i].size == UI_COMMAND_ARENA_BLOCK_SIZE) {
+      blocks_[kept++] = blocks_[i];
+    } else {
+      delete[] blocks_[i].data;
+    }
+  }
+  blocks_.resize(kept);
+  current_ = 0;
+  offset_ = 0;
+  allocated_bytes_ = 0;
+}
+
+}  // namespace webf
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_FOUNDATION_UI_COMMAND_ARENA_H_
+#define BRIDGE_FOUNDATION_UI_COMMAND_ARENA_H_
+
+#include <cinttypes>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include "foundation/macros.h"
+#include "foundation/native_string.h"
+
+namespace webf {
+
+#define UI_COMMAND_ARENA_BLOCK_SIZE (16 * 1024)
+// Blocks kept after Reset() to be reused by the next batch, the rest are released.
+#define MAXIMUM_RETAINED_UI_COMMAND_ARENA_BLOCKS 4
+
+// Bump pointer allocator of the payloads carried by the ui commands of one batch: string payloads, event listener
+// options and node lists. Dart side reads the payloads before the batch is released, and all of them are released at
+// once when the batch is cleared, so nothing needs to be freed one by one.
+class UICommandArena {
+ public:
+  UICommandArena() = default;
+  ~UICommandArena();
+  WEBF_DISALLOW_COPY_AND_ASSIGN(UICommandArena);
+
+  // Returns 8 bytes aligned memory which lives until Reset().
+  void* Allocate(size_t size);
+  // Only trivially destructible types, their destructors are never called.
+  template <typename T>
+  T* New() {
+    static_assert(std::is_trivially_destructible<T>::value, "Arena payloads are never destructed.");
+    return ::new (Allocate(sizeof(T))) T();
+  }
+  SharedNativeString* NewString(const uint16_t* string, uint32_t length);
+  // Widens latin1 characters to UTF-16.
+  SharedNativeString* NewString(const uint8_t* string, uint32_t length);
+
+  void Reset();
+  size_t allocatedBytes() const { return allocated_bytes_; }
+
+ private:
+  struct Block {
+    uint8_t* data;
+    size_t size;
+  };
+
+  std::vector<Block> blocks_;
+  // The block being allocated from, and the offset of its free space.
+  size_t current_{0};
+  size_t offset_{0};
+  size_t allocated_bytes_{0};
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_FOUNDATION_UI_COMMAND_ARENA_H_
@@ -4,6 +4,8 @@
  */
 
 #include "ui_command_buffer.h"
+#include <algorithm>
+#include "core/css/inline_css_style_declaration.h"
 #include "core/dart_methods.h"
 #include "core/executing_context.h"
 #include "foundation/logging.h"
@@ -11,68 +13,449 @@
 
 namespace webf {
 
-UICommandBuffer::UICommandBuffer(ExecutingContext* context) : context_(context) {}
+const char* GetUICommandName(UICommand command) {
+  switch (command) {
+    case UICommand::kCreateElement:
+      return "createElement";
+    case UICommand::kCreateTextNode:
+      return "createTextNode";
+    case UICommand::kCreateComment:
+      return "createComment";
+    case UICommand::kCreateDocument:
+      return "createDocument";
+    case UICommand::kCreateWindow:
+      return "createWindow";
+    case UICommand::kDisposeBindingObject:
+      return "disposeBindingObject";
+    case UICommand::kAddEvent:
+      return "addEvent";
+    case UICommand::kRemoveNode:
+      return "removeNode";
+    case UICommand::kInsertAdjacentNode:
+      return "insertAdjacentNode";
+    case UICommand::kSetStyle:
+      return "setStyle";
+    case UICommand::kClearStyle:
+      return "clearStyle";
+    case UICommand::kSetAttribute:
+      return "setAttribute";
+    case UICommand::kRemoveAttribute:
+      return "removeAttribute";
+    case UICommand::kCloneNode:
+      return "cloneNode";
+    case UICommand::kRemoveEvent:
+      return "removeEvent";
+    case UICommand::kCreateDocumentFragment:
+      return "createDocumentFragment";
+    case UICommand::kCreateSVGElement:
+      return "createSVGElement";
+    case UICommand::kCreateElementNS:
+      return "createElementNS";
+    case UICommand::kInternString:
+      return "internString";
+    case UICommand::kSetStyleBatch:
+      return "setStyleBatch";
+    case UICommand::kCreateSubtree:
+      return "createSubtree";
+  }
+  return "";
+}
 
-UICommandBuffer::~UICommandBuffer() {
-  if (UNLIKELY(!context_->dartIsolateContext()->valid())) {
-    return;
+const char* GetUICommandFlushReasonName(UICommandFlushReason reason) {
+  switch (reason) {
+    case UICommandFlushReason::kEndOfFrame:
+      return "endOfFrame";
+    case UICommandFlushReason::kBindingCall:
+      return "bindingCall";
+    case UICommandFlushReason::kLayoutMetrics:
+      return "layoutMetrics";
+    case UICommandFlushReason::kWidgetElementShape:
+      return "widgetElementShape";
+  }
+  return "";
+}
+
+// Commands describing a node which is sent with kCreateSubtree when node commands are suspended.
+static bool IsSubtreeNodeCommand(UICommand command) {
+  switch (command) {
+    case UICommand::kCreateElement:
+    case UICommand::kCreateSVGElement:
+    case UICommand::kCreateElementNS:
+    case UICommand::kCreateTextNode:
+    case UICommand::kCreateComment:
+    case UICommand::kInsertAdjacentNode:
+    case UICommand::kSetAttribute:
+    case UICommand::kRemoveAttribute:
+    case UICommand::kSetStyle:
+    case UICommand::kClearStyle:
+    case UICommand::kCloneNode:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Commands which change the tree or the inline style of their targets, the pending style changes of the targets are
+// sent before them. The pending changes of disposed nodes are dropped instead.
+static bool IsStructuralCommand(UICommand command) {
+  switch (command) {
+    case UICommand::kInsertAdjacentNode:
+    case UICommand::kRemoveNode:
+    case UICommand::kCloneNode:
+    case UICommand::kCreateSubtree:
+    case UICommand::kClearStyle:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Commands which never change the layout of the nodes already attached.
+static bool MayAffectLayout(UICommand command) {
+  switch (command) {
+    case UICommand::kCreateElement:
+    case UICommand::kCreateSVGElement:
+    case UICommand::kCreateElementNS:
+    case UICommand::kCreateTextNode:
+    case UICommand::kCreateComment:
+    case UICommand::kCreateDocumentFragment:
+    case UICommand::kCloneNode:
+    case UICommand::kDisposeBindingObject:
+    case UICommand::kAddEvent:
+    case UICommand::kRemoveEvent:
+    case UICommand::kInternString:
+      return false;
+    default:
+      return true;
   }
+}
+
+UICommandBatch::~UICommandBatch() {
+  for (auto* chunk : chunks_) {
+    delete[] chunk;
+  }
+}
+
+void UICommandBatch::push(const UICommandItem& item) {
+  int64_t chunk_index = size_ / UI_COMMAND_CHUNK_SIZE;
+  if (UNLIKELY(chunk_index == static_cast<int64_t>(chunks_.size()))) {
+    chunks_.emplace_back(new UICommandItem[UI_COMMAND_CHUNK_SIZE]);
+  }
+
+  chunks_[chunk_index][size_ % UI_COMMAND_CHUNK_SIZE] = item;
+  size_++;
+}
+
+UICommandItem** UICommandBatch::data() {
+  return chunks_.data();
+}
+
+int64_t UICommandBatch::chunkCount() const {
+  return (size_ + UI_COMMAND_CHUNK_SIZE - 1) / UI_COMMAND_CHUNK_SIZE;
+}
+
+UICommandItem* UICommandBatch::at(int64_t index) {
+  assert(index >= 0 && index < size_);
+  return &chunks_[index / UI_COMMAND_CHUNK_SIZE][index % UI_COMMAND_CHUNK_SIZE];
+}
 
+int64_t UICommandBatch::size() const {
+  return size_;
+}
+
+bool UICommandBatch::empty() const {
+  return size_ == 0;
+}
+
+void UICommandBatch::clear() {
+  size_ = 0;
+  arena_.Reset();
+  // Consumed items will be overwritten by the next batch, there is no need to reset them.
+  while (chunks_.size() > MAXIMUM_RETAINED_UI_COMMAND_CHUNKS) {
+    delete[] chunks_.back();
+    chunks_.pop_back();
+  }
+}
+
+void UICommandBatch::truncate(int64_t size) {
+  assert(size >= 0 && size <= size_);
+  size_ = size;
+}
+
+UICommandBuffer::UICommandBuffer(ExecutingContext* context) : context_(context) {}
+
+UICommandBuffer::~UICommandBuffer() {
 #if FLUTTER_BACKEND
   // Flush and execute all disposeEventTarget commands when context released.
-  if (context_->dartMethodPtr()->flushUICommand != nullptr) {
+  if (LIKELY(context_->dartIsolateContext()->valid()) && context_->dartMethodPtr()->flushUICommand != nullptr) {
     context_->dartMethodPtr()->flushUICommand(context_->contextId());
   }
 #endif
 }
 
 void UICommandBuffer::addCommand(UICommand type,
-                                 std::unique_ptr<SharedNativeString>&& args_01,
+                                 const SharedNativeString* args_01,
                                  void* nativePtr,
                                  void* nativePtr2,
                                  bool request_ui_update) {
-  UICommandItem item{static_cast<int32_t>(type), args_01.get(), nativePtr, nativePtr2};
+  UICommandItem item{static_cast<int32_t>(type), args_01, nativePtr, nativePtr2};
   addCommand(item, request_ui_update);
 }
 
+SharedNativeString* UICommandBuffer::NewString(const AtomicString& string) {
+  if (string.IsEmpty())
+    return recording_->arena()->NewString(static_cast<const uint16_t*>(nullptr), 0);
+  if (string.Is8Bit())
+    return recording_->arena()->NewString(string.Character8(), string.length());
+  return recording_->arena()->NewString(string.Character16(), string.length());
+}
+
+SharedNativeString* UICommandBuffer::NewString(const std::string& string) {
+  bool is_ascii = std::all_of(string.begin(), string.end(), [](char c) { return static_cast<unsigned char>(c) < 0x80; });
+  if (LIKELY(is_ascii)) {
+    return recording_->arena()->NewString(reinterpret_cast<const uint8_t*>(string.data()),
+                                          static_cast<uint32_t>(string.size()));
+  }
+  std::u16string utf16;
+  fromUTF8(string, utf16);
+  return NewString(reinterpret_cast<const uint16_t*>(utf16.data()), static_cast<uint32_t>(utf16.size()));
+}
+
+SharedNativeString* UICommandBuffer::NewString(const uint16_t* string, uint32_t length) {
+  return recording_->arena()->NewString(string, length);
+}
+
+void UICommandBuffer::addInternedCommand(UICommand type,
+                                         const AtomicString& args_01,
+                                         void* nativePtr,
+                                         void* nativePtr2,
+                                         bool request_ui_update) {
+  // Dropped commands must not define strings, or dart side would miss the definition.
+  if (UNLIKELY(node_commands_suspended_ > 0 && IsSubtreeNodeCommand(type))) {
+    return;
+  }
+  UICommandStringTable::InternResult interned = string_table_.Intern(args_01);
+  if (UNLIKELY(interned.id == UICommandStringTable::kNotInterned)) {
+    // The table is full, fallback to send the string with the command.
+    addCommand(type, NewString(args_01), nativePtr, nativePtr2, request_ui_update);
+    return;
+  }
+  addInternedCommand(type, interned, nativePtr, nativePtr2, request_ui_update);
+}
+
+void UICommandBuffer::addInternedCommand(UICommand type,
+                                         const std::string& args_01,
+                                         void* nativePtr,
+                                         void* nativePtr2,
+                                         bool request_ui_update) {
+  if (UNLIKELY(node_commands_suspended_ > 0 && IsSubtreeNodeCommand(type))) {
+    return;
+  }
+  UICommandStringTable::InternResult interned = string_table_.Intern(args_01);
+  if (UNLIKELY(interned.id == UICommandStringTable::kNotInterned)) {
+    addCommand(type, NewString(args_01), nativePtr, nativePtr2, request_ui_update);
+    return;
+  }
+  addInternedCommand(type, interned, nativePtr, nativePtr2, request_ui_update);
+}
+
+void UICommandBuffer::addInternedCommand(UICommand type,
+                                         const UICommandStringTable::InternResult& interned,
+                                         void* nativePtr,
+                                         void* nativePtr2,
+                                         bool request_ui_update) {
+  if (interned.is_new) {
+    const std::u16string& string = string_table_.Lookup(interned.id);
+    addCommand(UICommand::kInternString,
+               NewString(reinterpret_cast<const uint16_t*>(string.data()), static_cast<uint32_t>(string.size())),
+               nullptr, reinterpret_cast<void*>(static_cast<intptr_t>(interned.id)), request_ui_update);
+  }
+
+  addCommand(UICommandItem::Interned(static_cast<int32_t>(type), interned.id, nativePtr, nativePtr2),
+             request_ui_update);
+}
+
 void UICommandBuffer::addCommand(const UICommandItem& item, bool request_ui_update) {
+  if (UNLIKELY(item.type == static_cast<int32_t>(UICommand::kDisposeBindingObject))) {
+    // Dart side drops the node, its pending style changes are useless.
+    auto it = pending_style_indices_.find(item.nativePtr);
+    if (it != pending_style_indices_.end()) {
+      pending_styles_[it->second]->ClearPendingProperties();
+      pending_styles_[it->second] = nullptr;
+      pending_style_indices_.erase(it);
+    }
+  }
+
   if (UNLIKELY(!context_->dartIsolateContext()->valid())) {
     return;
   }
 
-  if (size_ >= MAXIMUM_UI_COMMAND_SIZE) {
-    context_->FlushUICommand();
-    assert(size_ == 0);
+  // The payloads of dropped commands are released with the batch.
+  if (UNLIKELY(node_commands_suspended_ > 0 && IsSubtreeNodeCommand(static_cast<UICommand>(item.type)))) {
+    return;
+  }
+
+  if (UNLIKELY(!pending_style_indices_.empty()) && IsStructuralCommand(static_cast<UICommand>(item.type))) {
+    flushPendingStyle(item.nativePtr);
+    // The inserted node of kInsertAdjacentNode and the copy of kCloneNode. The node list of kCreateSubtree has no
+    // pending styles since its nodes were built with node commands suspended.
+    if (item.type != static_cast<int32_t>(UICommand::kCreateSubtree)) {
+      flushPendingStyle(item.nativePtr2);
+    }
+  }
+
+  if (request_ui_update) {
+    requestBatchUpdate();
+  }
+
+  if (MayAffectLayout(static_cast<UICommand>(item.type))) {
+    layout_generation_++;
+    pending_layout_commands_ = true;
+  }
+
+  if (UNLIKELY(stats_enabled_)) {
+    stats_.command_count[item.type]++;
+    if (item.args_01_length > 0) {
+      stats_.command_bytes[item.type] += item.args_01_length * static_cast<int64_t>(sizeof(uint16_t));
+    }
   }
 
+  recording_->push(item);
+}
+
+void UICommandBuffer::requestBatchUpdate() {
 #if FLUTTER_BACKEND
-  if (UNLIKELY(request_ui_update && !update_batched_ && context_->IsContextValid() &&
+  if (UNLIKELY(!update_batched_ && context_->IsContextValid() &&
                context_->dartMethodPtr()->requestBatchUpdate != nullptr)) {
     context_->dartMethodPtr()->requestBatchUpdate(context_->contextId());
     update_batched_ = true;
   }
 #endif
+}
 
-  buffer_[size_] = item;
-  size_++;
+UICommandItem** UICommandBuffer::data() {
+  return recording_->data();
+}
+
+int64_t UICommandBuffer::chunkCount() {
+  return recording_->chunkCount();
 }
 
-UICommandItem* UICommandBuffer::data() {
-  return buffer_;
+UICommandItem* UICommandBuffer::at(int64_t index) {
+  return recording_->at(index);
 }
 
 int64_t UICommandBuffer::size() {
-  return size_;
+  return recording_->size();
 }
 
 bool UICommandBuffer::empty() {
-  return size_ == 0;
+  return recording_->empty() && pending_style_indices_.empty();
 }
 
 void UICommandBuffer::clear() {
-  size_ = 0;
-  memset(buffer_, 0, sizeof(buffer_));
+  for (auto* style : pending_styles_) {
+    if (style != nullptr) {
+      style->ClearPendingProperties();
+    }
+  }
+  pending_styles_.clear();
+  pending_style_indices_.clear();
+  recording_->clear();
+  // String definitions in the dropped commands never reach dart side.
+  string_table_.Reset();
   update_batched_ = false;
 }
 
+UICommandBatch* UICommandBuffer::acquire() {
+  // The previous batch should had been released by the consumer, recycle it anyway to keep the buffers usable.
+  assert_m(consuming_ == nullptr, "The previous ui command batch was not released.");
+  if (UNLIKELY(consuming_ != nullptr)) {
+    release();
+  }
+
+  flushPendingStyles();
+
+  if (UNLIKELY(stats_enabled_)) {
+    stats_.flush_count[static_cast<int32_t>(flush_reason_)]++;
+    stats_.current_frame_flushes++;
+    if (flush_reason_ == UICommandFlushReason::kEndOfFrame) {
+      stats_.frames++;
+      stats_.last_frame_flushes = stats_.current_frame_flushes;
+      stats_.max_frame_flushes = std::max(stats_.max_frame_flushes, stats_.current_frame_flushes);
+      stats_.current_frame_flushes = 0;
+    }
+  }
+  flush_reason_ = UICommandFlushReason::kEndOfFrame;
+
+  if (coalescing_enabled_) {
+    coalescer_.Coalesce(recording_, string_table_);
+  }
+
+  consuming_ = recording_;
+  recording_ = recording_ == &batches_[0] ? &batches_[1] : &batches_[0];
+  pending_layout_commands_ = false;
+  // Commands recorded from now on belongs to a new batch, which needs another batch update from dart side.
+  update_batched_ = false;
+  return consuming_;
+}
+
+void UICommandBuffer::SetStatsEnabled(bool enabled) {
+  stats_enabled_ = enabled;
+  if (enabled) {
+    stats_ = UICommandStats{};
+  }
+}
+
+void UICommandBuffer::addPendingStyle(InlineCssStyleDeclaration* style, NativeBindingObject* target) {
+  auto key = reinterpret_cast<int64_t>(target);
+  assert(pending_style_indices_.count(key) == 0);
+  pending_style_indices_.emplace(key, pending_styles_.size());
+  pending_styles_.emplace_back(style);
+  layout_generation_++;
+  pending_layout_commands_ = true;
+  requestBatchUpdate();
+}
+
+void UICommandBuffer::removePendingStyle(NativeBindingObject* target) {
+  auto it = pending_style_indices_.find(reinterpret_cast<int64_t>(target));
+  if (it != pending_style_indices_.end()) {
+    pending_styles_[it->second] = nullptr;
+    pending_style_indices_.erase(it);
+  }
+}
+
+void UICommandBuffer::flushPendingStyle(int64_t target) {
+  auto it = pending_style_indices_.find(target);
+  if (it == pending_style_indices_.end())
+    return;
+  InlineCssStyleDeclaration* style = pending_styles_[it->second];
+  pending_styles_[it->second] = nullptr;
+  pending_style_indices_.erase(it);
+  style->FlushPendingProperties();
+}
+
+void UICommandBuffer::flushPendingStyles() {
+  if (pending_style_indices_.empty()) {
+    pending_styles_.clear();
+    return;
+  }
+  // Flushing emits commands only, it never registers new pending styles.
+  std::vector<InlineCssStyleDeclaration*> styles;
+  styles.swap(pending_styles_);
+  pending_style_indices_.clear();
+  for (auto* style : styles) {
+    if (style != nullptr) {
+      style->FlushPendingProperties();
+    }
+  }
+}
+
+void UICommandBuffer::release() {
+  if (consuming_ == nullptr)
+    return;
+  consuming_->clear();
+  consuming_ = nullptr;
+}
+
 }  // namespace webf
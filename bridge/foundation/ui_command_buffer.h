@@ -7,12 +7,20 @@
 #define BRIDGE_FOUNDATION_UI_COMMAND_BUFFER_H_
 
 #include <cinttypes>
+#include <unordered_map>
+#include <vector>
 #include "bindings/qjs/native_string_utils.h"
+#include "foundation/macros.h"
+#include "foundation/ui_command_arena.h"
+#include "foundation/ui_command_coalescer.h"
+#include "foundation/ui_command_string_table.h"
 #include "native_value.h"
 
 namespace webf {
 
 class ExecutingContext;
+class InlineCssStyleDeclaration;
+struct NativeBindingObject;
 
 enum class UICommand {
   kCreateElement,
@@ -33,18 +41,71 @@ enum class UICommand {
   kCreateDocumentFragment,
   kCreateSVGElement,
   kCreateElementNS,
+  // Defines an interned string, args_01 is the string and nativePtr2 is its id. See UICommandStringTable.
+  kInternString,
+  // Pending inline style changes of one element, args_01 is a packed list of "name\0value\0" pairs, removed
+  // properties have empty values.
+  kSetStyleBatch,
+  // Creates a whole subtree, see SubtreeCommandScope for the layout. nativePtr is the parent node or null for a
+  // detached subtree, nativePtr2 is the list of NativeBindingObject pointers of the nodes in preorder.
+  kCreateSubtree,
 };
 
-#define MAXIMUM_UI_COMMAND_SIZE 2048
+constexpr int32_t kUICommandTypeCount = static_cast<int32_t>(UICommand::kCreateSubtree) + 1;
+const char* GetUICommandName(UICommand command);
 
+// Why the recorded commands were handed over to dart side.
+enum class UICommandFlushReason : int32_t {
+  // Dart side consumes the commands when drawing a frame.
+  kEndOfFrame,
+  // A synchronous call into dart side, see BindingObject::InvokeBindingMethod.
+  kBindingCall,
+  // Reading the geometry of an element which is not cached, see Element::EnsureLayoutMetrics().
+  kLayoutMetrics,
+  // A WidgetElement property was accessed before dart side reported the shape of its tag.
+  kWidgetElementShape,
+};
+
+constexpr int32_t kUICommandFlushReasonCount = static_cast<int32_t>(UICommandFlushReason::kWidgetElementShape) + 1;
+const char* GetUICommandFlushReasonName(UICommandFlushReason reason);
+
+// Counters of the commands and flushes, shared with dart side through getUICommandStats(). Recorded only when
+// enabled by setUICommandStatsEnabled().
+struct UICommandStats {
+  int64_t command_count[kUICommandTypeCount];
+  // Bytes of the string payload carried by args_01.
+  int64_t command_bytes[kUICommandTypeCount];
+  int64_t flush_count[kUICommandFlushReasonCount];
+  int64_t frames;
+  // Flushes since the end of last frame, including the end of frame flush itself.
+  int64_t current_frame_flushes;
+  int64_t last_frame_flushes;
+  int64_t max_frame_flushes;
+};
+
+// Commands are stored in fixed size chunks. Dart side reads them chunk by chunk, so the value must be kept in sync
+// with `uiCommandChunkSize` in webf/lib/src/bridge/to_native.dart.
+#define UI_COMMAND_CHUNK_SIZE 2048
+// Empty chunks kept after clear() to be reused by the next batch, the rest are released.
+#define MAXIMUM_RETAINED_UI_COMMAND_CHUNKS 8
+
+// When args_01_length is negative, the command carries no string payload and args_01 is the interned string
+// whose id is (-args_01_length - 1).
 struct UICommandItem {
   UICommandItem() = default;
-  explicit UICommandItem(int32_t type, SharedNativeString* args_01, void* nativePtr, void* nativePtr2)
+  explicit UICommandItem(int32_t type, const SharedNativeString* args_01, void* nativePtr, void* nativePtr2)
       : type(type),
         string_01(reinterpret_cast<int64_t>(args_01 != nullptr ? args_01->string() : nullptr)),
         args_01_length(args_01 != nullptr ? args_01->length() : 0),
         nativePtr(reinterpret_cast<int64_t>(nativePtr)),
         nativePtr2(reinterpret_cast<int64_t>(nativePtr2)){};
+  static UICommandItem Interned(int32_t type, int32_t string_id, void* nativePtr, void* nativePtr2) {
+    UICommandItem item{type, nullptr, nativePtr, nativePtr2};
+    item.args_01_length = -string_id - 1;
+    return item;
+  }
+  bool IsArgs01Interned() const { return args_01_length < 0; }
+  int32_t args01StringId() const { return -args_01_length - 1; }
   int32_t type{0};
   int32_t args_01_length{0};
   int64_t string_01{0};
@@ -52,28 +113,148 @@ struct UICommandItem {
   int64_t nativePtr2{0};
 };
 
+// A growable list of commands made of fixed size chunks, with the arena of their payloads.
+// Appending never moves the items already recorded.
+class UICommandBatch {
+ public:
+  UICommandBatch() = default;
+  ~UICommandBatch();
+  WEBF_DISALLOW_COPY_AND_ASSIGN(UICommandBatch);
+
+  void push(const UICommandItem& item);
+  // The list of chunks, every chunk holds UI_COMMAND_CHUNK_SIZE items except the last one, which holds the
+  // remaining (size() % UI_COMMAND_CHUNK_SIZE) items.
+  UICommandItem** data();
+  int64_t chunkCount() const;
+  UICommandItem* at(int64_t index);
+  int64_t size() const;
+  bool empty() const;
+  void clear();
+  // Drop the items from the given index.
+  void truncate(int64_t size);
+  UICommandArena* arena() { return &arena_; }
+
+ private:
+  std::vector<UICommandItem*> chunks_;
+  UICommandArena arena_;
+  int64_t size_{0};
+};
+
+// Double buffered ui command store.
+// JS side always records into the recording batch, which never forces a flush to dart side. Dart side takes a
+// completed batch by calling acquire(), which swaps in an empty batch so the context can keep producing commands
+// while dart side is consuming, and gives it back with release() once it has been read.
 class UICommandBuffer {
  public:
   UICommandBuffer() = delete;
   explicit UICommandBuffer(ExecutingContext* context);
   ~UICommandBuffer();
+  // The string payloads must be allocated by NewString() and other payloads by NewPayload(), right before adding the
+  // command, so they are owned by the batch the command is recorded into.
   void addCommand(UICommand type,
-                  std::unique_ptr<SharedNativeString>&& args_01,
+                  const SharedNativeString* args_01,
                   void* nativePtr,
                   void* nativePtr2,
                   bool request_ui_update = true);
-  UICommandItem* data();
+  // Same as addCommand, but args_01 is sent through the string table.
+  void addInternedCommand(UICommand type,
+                          const AtomicString& args_01,
+                          void* nativePtr,
+                          void* nativePtr2,
+                          bool request_ui_update = true);
+  void addInternedCommand(UICommand type,
+                          const std::string& args_01,
+                          void* nativePtr,
+                          void* nativePtr2,
+                          bool request_ui_update = true);
+  // Payloads allocated from the arena of the recording batch. Dart side reads them before releasing the batch and
+  // never frees them.
+  SharedNativeString* NewString(const AtomicString& string);
+  SharedNativeString* NewString(const std::string& string);
+  SharedNativeString* NewString(const uint16_t* string, uint32_t length);
+  template <typename T>
+  T* NewPayload() {
+    return recording_->arena()->New<T>();
+  }
+  void* AllocatePayload(size_t size) { return recording_->arena()->Allocate(size); }
+
+  // Accessors of the recording batch.
+  UICommandItem** data();
+  int64_t chunkCount();
+  UICommandItem* at(int64_t index);
   int64_t size();
   bool empty();
   void clear();
 
+  // Hand the recording batch to the consumer and start recording into a fresh one.
+  UICommandBatch* acquire();
+  // Recycle the batch returned by acquire().
+  void release();
+
+  // Run UICommandCoalescer over every batch before handing it to the consumer.
+  void SetCoalescingEnabled(bool enabled) { coalescing_enabled_ = enabled; }
+  const UICommandCoalescingStats& coalescingStats() const { return coalescer_.stats(); }
+
+  const UICommandStringTable& stringTable() const { return string_table_; }
+
+  // Enabling the stats resets all the counters.
+  void SetStatsEnabled(bool enabled);
+  bool statsEnabled() const { return stats_enabled_; }
+  const UICommandStats& stats() const { return stats_; }
+  // The reason of the next acquire(), which is reset to kEndOfFrame after acquired.
+  void SetFlushReason(UICommandFlushReason reason) { flush_reason_ = reason; }
+
+  // Inline styles with pending property changes, keyed by the binding object of their element. Their changes are
+  // packed into one kSetStyleBatch command per element when the recording batch is acquired, or right before a
+  // command which changes the tree or the inline style of the element, so the batch keeps the order of the writes.
+  void addPendingStyle(InlineCssStyleDeclaration* style, NativeBindingObject* target);
+  void removePendingStyle(NativeBindingObject* target);
+  void flushPendingStyles();
+
+  // While suspended, the commands which create or update a node are dropped, the nodes are sent with a
+  // kCreateSubtree command instead. Suspensions can be nested.
+  void suspendNodeCommands() { node_commands_suspended_++; }
+  void resumeNodeCommands() {
+    assert(node_commands_suspended_ > 0);
+    node_commands_suspended_--;
+  }
+  bool nodeCommandsSuspended() const { return node_commands_suspended_ > 0; }
+
+  // Bumped by every command and dart call which may change the layout. Layout metrics cached by elements are valid
+  // while the generation stays the same, see Element::EnsureLayoutMetrics().
+  int64_t layoutGeneration() const { return layout_generation_; }
+  void InvalidateLayout() { layout_generation_++; }
+  // Whether commands which may change the layout are recorded but not acquired by dart side yet.
+  bool hasPendingLayoutCommands() const { return pending_layout_commands_; }
+
  private:
   void addCommand(const UICommandItem& item, bool request_ui_update = true);
+  void requestBatchUpdate();
+  // Sends the pending style changes of |target| before a command touching it.
+  void flushPendingStyle(int64_t target);
+  void addInternedCommand(UICommand type,
+                          const UICommandStringTable::InternResult& interned,
+                          void* nativePtr,
+                          void* nativePtr2,
+                          bool request_ui_update);
 
   ExecutingContext* context_{nullptr};
-  UICommandItem buffer_[MAXIMUM_UI_COMMAND_SIZE];
+  UICommandBatch batches_[2];
+  UICommandBatch* recording_{&batches_[0]};
+  UICommandBatch* consuming_{nullptr};
+  UICommandCoalescer coalescer_;
+  UICommandStringTable string_table_;
+  // In the order they were changed first, removed entries are left as nullptr until the next flush.
+  std::vector<InlineCssStyleDeclaration*> pending_styles_;
+  std::unordered_map<int64_t, size_t> pending_style_indices_;
+  int32_t node_commands_suspended_{0};
+  UICommandStats stats_{};
+  UICommandFlushReason flush_reason_{UICommandFlushReason::kEndOfFrame};
+  bool stats_enabled_{false};
+  bool coalescing_enabled_{false};
   bool update_batched_{false};
-  int64_t size_{0};
+  int64_t layout_generation_{0};
+  bool pending_layout_commands_{false};
 };
 
 }  // namespace webf
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "gtest/gtest.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+TEST(UICommandBuffer, growWithoutFlush) {
+  bool static errorCalled = false;
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) { errorCalled = true; });
+  auto context = env->page()->GetExecutingContext();
+  context->uiCommandBuffer()->clear();
+  const char* code =
+      "for (let i = 0; i < 5000; i ++) {"
+      "  document.body.appendChild(document.createElement('div'));"
+      "}";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+
+  // Each div produces a kCreateElement and a kInsertAdjacentNode command.
+  auto* buffer = context->uiCommandBuffer();
+  EXPECT_EQ(buffer->size() >= 10000, true);
+  EXPECT_EQ(buffer->chunkCount(), (buffer->size() + UI_COMMAND_CHUNK_SIZE - 1) / UI_COMMAND_CHUNK_SIZE);
+  EXPECT_EQ(buffer->at(buffer->size() - 1)->type, (int32_t)UICommand::kInsertAdjacentNode);
+  EXPECT_EQ(buffer->data()[buffer->chunkCount() - 1] + (buffer->size() - 1) % UI_COMMAND_CHUNK_SIZE,
+            buffer->at(buffer->size() - 1));
+
+  context->FlushUICommand();
+  EXPECT_EQ(buffer->empty(), true);
+  EXPECT_EQ(errorCalled, false);
+}
+
+TEST(UICommandBuffer, swapBatch) {
+  bool static errorCalled = false;
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) { errorCalled = true; });
+  auto context = env->page()->GetExecutingContext();
+  auto* buffer = context->uiCommandBuffer();
+  buffer->clear();
+  const char* code = "document.body.appendChild(document.createElement('div'));";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  int64_t recorded = buffer->size();
+  EXPECT_EQ(recorded > 0, true);
+
+  UICommandBatch* batch = buffer->acquire();
+  EXPECT_EQ(batch->size(), recorded);
+  EXPECT_EQ(buffer->empty(), true);
+
+  // The context keeps recording into another batch while the acquired one is being consumed. The tag name and
+  // the insert position were defined by the first batch, so only kCreateElement and kInsertAdjacentNode are recorded.
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  EXPECT_EQ(buffer->size(), 2);
+  EXPECT_EQ(batch->size(), recorded);
+  EXPECT_EQ(batch->at(recorded - 1)->type, (int32_t)UICommand::kInsertAdjacentNode);
+
+  buffer->release();
+  EXPECT_EQ(batch->empty(), true);
+  EXPECT_EQ(buffer->size(), 2);
+  EXPECT_EQ(errorCalled, false);
+}
+
+TEST(UICommandBuffer, internStrings) {
+  bool static errorCalled = false;
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) { errorCalled = true; });
+  auto context = env->page()->GetExecutingContext();
+  auto* buffer = context->uiCommandBuffer();
+  buffer->clear();
+  const char* code =
+      "for (let i = 0; i < 3; i ++) {"
+      "  document.body.appendChild(document.createElement('span'));"
+      "}";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+
+  // 'span' and 'beforeend' are defined once and referenced by id afterwards.
+  int64_t definitions = 0;
+  for (int64_t i = 0; i < buffer->size(); i++) {
+    UICommandItem* item = buffer->at(i);
+    if (item->type == (int32_t)UICommand::kInternString) {
+      definitions++;
+      continue;
+    }
+    EXPECT_EQ(item->IsArgs01Interned(), true);
+    EXPECT_EQ(item->string_01, 0);
+  }
+  EXPECT_EQ(definitions, 2);
+  EXPECT_EQ(buffer->size(), 8);
+  EXPECT_EQ(buffer->stringTable().Lookup(buffer->at(1)->args01StringId()), u"span");
+  EXPECT_EQ(errorCalled, false);
+}
+
+TEST(UICommandBuffer, stats) {
+  bool static errorCalled = false;
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->GetExecutingContext();
+  auto* buffer = context->uiCommandBuffer();
+  context->FlushUICommand();
+  buffer->acquire();
+  buffer->release();
+
+  const char* code =
+      "performance.__webf_set_ui_command_stats_enabled__(true);"
+      "let div = document.createElement('div');"
+      "div.setAttribute('id', 'abc');"
+      "document.body.appendChild(div);";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  EXPECT_EQ(buffer->statsEnabled(), true);
+
+  const UICommandStats& stats = buffer->stats();
+  EXPECT_EQ(stats.command_count[static_cast<int32_t>(UICommand::kCreateElement)], 1);
+  EXPECT_EQ(stats.command_count[static_cast<int32_t>(UICommand::kSetAttribute)], 1);
+  EXPECT_EQ(stats.command_count[static_cast<int32_t>(UICommand::kInsertAdjacentNode)], 1);
+  // The value "abc" is carried by args_01 as UTF-16.
+  EXPECT_EQ(stats.command_bytes[static_cast<int32_t>(UICommand::kSetAttribute)], 6);
+
+  context->FlushUICommand();
+  buffer->acquire();
+  buffer->release();
+  EXPECT_EQ(stats.flush_count[static_cast<int32_t>(UICommandFlushReason::kBindingCall)], 1);
+  EXPECT_EQ(stats.flush_count[static_cast<int32_t>(UICommandFlushReason::kEndOfFrame)], 1);
+  EXPECT_EQ(stats.frames, 1);
+  EXPECT_EQ(stats.last_frame_flushes, 2);
+
+  const char* check =
+      "let stats = performance.__webf_ui_command_stats__();"
+      "if (stats.commandCount.createElement !== 1 || stats.flushCount.bindingCall !== 1 || stats.frames !== 1) {"
+      "  throw new Error('unexpected ui command stats');"
+      "}";
+  env->page()->evaluateScript(check, strlen(check), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+}
+
+TEST(UICommandBuffer, pendingStylesKeepOrder) {
+  bool static errorCalled = false;
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) { errorCalled = true; });
+  auto context = env->page()->GetExecutingContext();
+  auto* buffer = context->uiCommandBuffer();
+  buffer->clear();
+  const char* code =
+      "let div = document.createElement('div');"
+      "document.body.appendChild(div);"
+      "div.style.width = '100px';"
+      "div.style.width = '200px';"
+      "document.body.removeChild(div);"
+      "div.style.height = '100px';";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+
+  // The changes before kRemoveNode are sent right before it, the later ones when the batch is acquired.
+  UICommandBatch* batch = buffer->acquire();
+  std::vector<int32_t> types;
+  for (int64_t i = 0; i < batch->size(); i++) {
+    int32_t type = batch->at(i)->type;
+    if (type == (int32_t)UICommand::kSetStyleBatch || type == (int32_t)UICommand::kRemoveNode) {
+      types.emplace_back(type);
+    }
+  }
+  std::vector<int32_t> expected = {(int32_t)UICommand::kSetStyleBatch, (int32_t)UICommand::kRemoveNode,
+                                   (int32_t)UICommand::kSetStyleBatch};
+  EXPECT_EQ(types, expected);
+  buffer->release();
+  EXPECT_EQ(errorCalled, false);
+}
+
+TEST(UICommandBuffer, arenaPayloads) {
+  UICommandArena arena;
+  const uint16_t value[] = {'1', '0', 'p', 'x'};
+  SharedNativeString* string = arena.NewString(value, 4);
+  EXPECT_EQ(string->length(), 4);
+  EXPECT_EQ(memcmp(string->string(), value, sizeof(value)), 0);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(string) % 8, 0);
+
+  // Payloads larger than a block get a block of their own.
+  void* large = arena.Allocate(UI_COMMAND_ARENA_BLOCK_SIZE * 2);
+  memset(large, 0, UI_COMMAND_ARENA_BLOCK_SIZE * 2);
+  struct Options {
+    bool capture;
+    bool passive;
+  };
+  auto* options = arena.New<Options>();
+  EXPECT_EQ(options->capture, false);
+  EXPECT_EQ(arena.allocatedBytes() > UI_COMMAND_ARENA_BLOCK_SIZE * 2, true);
+
+  arena.Reset();
+  EXPECT_EQ(arena.allocatedBytes(), 0);
+  EXPECT_EQ(arena.NewString(value, 0)->length(), 0);
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "ui_command_coalescer.h"
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "core/binding_object.h"
+#include "core/dom/events/event_target.h"
+#include "foundation/ui_command_buffer.h"
+#include "foundation/ui_command_string_table.h"
+
+namespace webf {
+
+namespace {
+
+struct CoalescingState {
+  bool cleared_later{false};
+  std::unordered_set<std::u16string> styles_written_later;
+  std::unordered_set<std::u16string> attributes_written_later;
+  // Event type -> index of a kRemoveEvent which has not been paired with a kAddEvent yet, indexed by the capture
+  // flag of the listener.
+  std::unordered_map<std::u16string, int64_t> pending_removed_events[2];
+};
+
+std::u16string CommandString(const UICommandItem& item, const UICommandStringTable& strings) {
+  if (item.IsArgs01Interned())
+    return strings.Lookup(item.args01StringId());
+  if (item.string_01 == 0)
+    return std::u16string();
+  return std::u16string(reinterpret_cast<const char16_t*>(item.string_01), item.args_01_length);
+}
+
+std::u16string NativeStringPayload(int64_t ptr) {
+  if (ptr == 0)
+    return std::u16string();
+  auto* native_string = reinterpret_cast<SharedNativeString*>(ptr);
+  return std::u16string(reinterpret_cast<const char16_t*>(native_string->string()), native_string->length());
+}
+
+bool IsNodeCreation(UICommand command) {
+  switch (command) {
+    case UICommand::kCreateElement:
+    case UICommand::kCreateTextNode:
+    case UICommand::kCreateComment:
+    case UICommand::kCreateDocumentFragment:
+    case UICommand::kCreateSVGElement:
+    case UICommand::kCreateElementNS:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Commands which make a node reachable from the tree at dart side.
+bool IsTreeMutation(UICommand command) {
+  return command == UICommand::kInsertAdjacentNode || command == UICommand::kRemoveNode ||
+         command == UICommand::kCloneNode || command == UICommand::kCreateSubtree;
+}
+
+}  // namespace
+
+void UICommandCoalescer::Coalesce(UICommandBatch* batch, const UICommandStringTable& strings) {
+  int64_t size = batch->size();
+  stats_.batches++;
+  stats_.input_commands += size;
+  if (size < 2)
+    return;
+
+  // Find out the nodes which live and die inside this batch without being attached to the tree.
+  std::unordered_set<int64_t> created;
+  std::unordered_set<int64_t> disposed;
+  std::unordered_set<int64_t> attached;
+  for (int64_t i = 0; i < size; i++) {
+    UICommandItem* item = batch->at(i);
+    auto command = static_cast<UICommand>(item->type);
+    if (IsNodeCreation(command)) {
+      created.emplace(item->nativePtr);
+    } else if (command == UICommand::kDisposeBindingObject) {
+      disposed.emplace(item->nativePtr);
+    } else if (IsTreeMutation(command)) {
+      attached.emplace(item->nativePtr);
+      attached.emplace(item->nativePtr2);
+    }
+  }
+  std::unordered_set<int64_t> dead_nodes;
+  for (int64_t ptr : created) {
+    if (disposed.count(ptr) > 0 && attached.count(ptr) == 0) {
+      dead_nodes.emplace(ptr);
+    }
+  }
+
+  // Walk backward so that every command knows whether it is overridden by a later one.
+  std::vector<bool> dropped(size, false);
+  std::unordered_map<int64_t, CoalescingState> states;
+  for (int64_t i = size - 1; i >= 0; i--) {
+    UICommandItem* item = batch->at(i);
+    auto command = static_cast<UICommand>(item->type);
+
+    if (dead_nodes.count(item->nativePtr) > 0) {
+      dropped[i] = true;
+      stats_.dead_node_commands++;
+      continue;
+    }
+
+    switch (command) {
+      case UICommand::kSetStyle: {
+        CoalescingState& state = states[item->nativePtr];
+        if (state.cleared_later || !state.styles_written_later.emplace(CommandString(*item, strings)).second) {
+          dropped[i] = true;
+          stats_.style_commands++;
+        }
+        break;
+      }
+      case UICommand::kSetStyleBatch: {
+        CoalescingState& state = states[item->nativePtr];
+        if (state.cleared_later) {
+          dropped[i] = true;
+          stats_.style_commands++;
+        }
+        break;
+      }
+      case UICommand::kClearStyle: {
+        CoalescingState& state = states[item->nativePtr];
+        if (state.cleared_later) {
+          dropped[i] = true;
+          stats_.style_commands++;
+        }
+        state.cleared_later = true;
+        break;
+      }
+      case UICommand::kSetAttribute:
+      case UICommand::kRemoveAttribute: {
+        CoalescingState& state = states[item->nativePtr];
+        std::u16string key =
+            command == UICommand::kSetAttribute ? NativeStringPayload(item->nativePtr2) : CommandString(*item, strings);
+        if (!state.attributes_written_later.emplace(key).second) {
+          dropped[i] = true;
+          stats_.attribute_commands++;
+        }
+        break;
+      }
+      case UICommand::kRemoveEvent: {
+        bool capture = item->nativePtr2 != 0;
+        states[item->nativePtr].pending_removed_events[capture][CommandString(*item, strings)] = i;
+        break;
+      }
+      case UICommand::kAddEvent: {
+        CoalescingState& state = states[item->nativePtr];
+        auto* options = reinterpret_cast<DartAddEventListenerOptions*>(item->nativePtr2);
+        auto& pending_removed_events = state.pending_removed_events[options != nullptr && options->capture];
+        auto pending = pending_removed_events.find(CommandString(*item, strings));
+        if (pending != pending_removed_events.end()) {
+          // Dart side was not listening before this kAddEvent, and will not be listening after the paired
+          // kRemoveEvent.
+          dropped[i] = true;
+          dropped[pending->second] = true;
+          stats_.event_commands += 2;
+          pending_removed_events.erase(pending);
+        }
+        break;
+      }
+      case UICommand::kCloneNode:
+        // Dart side copies attributes and inline styles when cloning, updates before the clone must be kept.
+        states.erase(item->nativePtr);
+        states.erase(item->nativePtr2);
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Compact the batch in place, the payloads of dropped commands are released with the batch.
+  int64_t kept = 0;
+  for (int64_t i = 0; i < size; i++) {
+    UICommandItem* item = batch->at(i);
+    if (dropped[i])
+      continue;
+    if (kept != i) {
+      *batch->at(kept) = *item;
+    }
+    kept++;
+  }
+  batch->truncate(kept);
+  stats_.eliminated_commands += size - kept;
+
+  // Dart side never knew these nodes, free the native binding objects which dart side would free on dispose.
+  for (int64_t ptr : dead_nodes) {
+    delete reinterpret_cast<NativeBindingObject*>(ptr);
+  }
+}
+
+}  // namespace webf
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_FOUNDATION_UI_COMMAND_COALESCER_H_
+#define BRIDGE_FOUNDATION_UI_COMMAND_COALESCER_H_
+
+#include <cinttypes>
+
+namespace webf {
+
+class UICommandBatch;
+class UICommandStringTable;
+struct UICommandItem;
+
+// Counters of the coalescing pass, shared with dart side through getUICommandCoalescingStats().
+struct UICommandCoalescingStats {
+  int64_t batches{0};
+  int64_t input_commands{0};
+  int64_t eliminated_commands{0};
+  // Commands removed because their target node was created and disposed in the same batch without being attached.
+  int64_t dead_node_commands{0};
+  // kSetStyle/kClearStyle overridden by a later style update of the same element.
+  int64_t style_commands{0};
+  // kSetAttribute/kRemoveAttribute overridden by a later update of the same attribute.
+  int64_t attribute_commands{0};
+  // kAddEvent/kRemoveEvent pairs cancelled out.
+  int64_t event_commands{0};
+};
+
+// An optimization pass over a completed batch of ui commands, which drops the commands cancelled out by later ones
+// before the batch is handed to dart side:
+//   - kCreate* ... kDisposeBindingObject of a node that never got attached, and every update in between.
+//   - kSetStyle of a property which is set again or cleared by kClearStyle later.
+//   - kSetAttribute/kRemoveAttribute of an attribute which is written again later.
+//   - kAddEvent immediately cancelled by a kRemoveEvent of the same event type and capture flag.
+// The payloads of dropped commands are released at native side since dart side will never see them.
+class UICommandCoalescer {
+ public:
+  void Coalesce(UICommandBatch* batch, const UICommandStringTable& strings);
+  const UICommandCoalescingStats& stats() const { return stats_; }
+
+ private:
+  UICommandCoalescingStats stats_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_FOUNDATION_UI_COMMAND_COALESCER_H_
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "gtest/gtest.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+static int64_t CountCommands(UICommandBatch* batch, UICommand type) {
+  int64_t count = 0;
+  for (int64_t i = 0; i < batch->size(); i++) {
+    if (batch->at(i)->type == static_cast<int32_t>(type))
+      count++;
+  }
+  return count;
+}
+
+TEST(UICommandCoalescer, lastWriterWins) {
+  bool static errorCalled = false;
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) { errorCalled = true; });
+  auto context = env->page()->GetExecutingContext();
+  auto* buffer = context->uiCommandBuffer();
+  buffer->clear();
+  buffer->SetCoalescingEnabled(true);
+  const char* code =
+      "let div = document.createElement('div');"
+      "document.body.appendChild(div);"
+      "div.style.width = '100px';"
+      "div.style.width = '200px';"
+      "div.style.height = '100px';"
+      "div.setAttribute('title', 'a');"
+      "div.removeAttribute('title');"
+      "div.setAttribute('id', 'a');"
+      "div.setAttribute('id', 'b');"
+      "function f() {};"
+      "div.addEventListener('click', f);"
+      "div.removeEventListener('click', f);";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+
+  UICommandBatch* batch = buffer->acquire();
+  // Style changes are already merged into one kSetStyleBatch by the inline style declaration.
+  EXPECT_EQ(CountCommands(batch, UICommand::kSetStyleBatch), 1);
+  EXPECT_EQ(CountCommands(batch, UICommand::kSetAttribute), 1);
+  EXPECT_EQ(CountCommands(batch, UICommand::kRemoveAttribute), 1);
+  EXPECT_EQ(CountCommands(batch, UICommand::kAddEvent), 0);
+  EXPECT_EQ(CountCommands(batch, UICommand::kRemoveEvent), 0);
+  buffer->release();
+
+  auto& stats = buffer->coalescingStats();
+  EXPECT_EQ(stats.attribute_commands, 2);
+  EXPECT_EQ(stats.event_commands, 2);
+  EXPECT_EQ(stats.eliminated_commands, 4);
+  EXPECT_EQ(errorCalled, false);
+}
+
+TEST(UICommandCoalescer, eventPairsMatchCaptureFlag) {
+  bool static errorCalled = false;
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) { errorCalled = true; });
+  auto context = env->page()->GetExecutingContext();
+  auto* buffer = context->uiCommandBuffer();
+  buffer->clear();
+  buffer->SetCoalescingEnabled(true);
+  const char* code =
+      "let div = document.createElement('div');"
+      "document.body.appendChild(div);"
+      "function f() {};"
+      "function g() {};"
+      "div.addEventListener('click', f, true);"
+      "div.addEventListener('click', g, false);"
+      "div.removeEventListener('click', f, true);"
+      "div.removeEventListener('click', g, false);";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+
+  UICommandBatch* batch = buffer->acquire();
+  EXPECT_EQ(CountCommands(batch, UICommand::kAddEvent), 1);
+  EXPECT_EQ(CountCommands(batch, UICommand::kRemoveEvent), 1);
+  buffer->release();
+
+  EXPECT_EQ(buffer->coalescingStats().event_commands, 0);
+  EXPECT_EQ(errorCalled, false);
+}
+
+TEST(UICommandCoalescer, deadNodes) {
+  bool static errorCalled = false;
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) { errorCalled = true; });
+  auto context = env->page()->GetExecutingContext();
+  auto* buffer = context->uiCommandBuffer();
+  buffer->clear();
+  buffer->SetCoalescingEnabled(true);
+  const char* code =
+      "(function() {"
+      "  let div = document.createElement('div');"
+      "  div.style.color = 'red';"
+      "  div.setAttribute('id', 'a');"
+      "})();"
+      "document.body.appendChild(document.createElement('span'));";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  JS_RunGC(context->dartIsolateContext()->runtime());
+
+  UICommandBatch* batch = buffer->acquire();
+  EXPECT_EQ(CountCommands(batch, UICommand::kCreateElement), 1);
+  EXPECT_EQ(CountCommands(batch, UICommand::kSetStyleBatch), 0);
+  EXPECT_EQ(CountCommands(batch, UICommand::kSetAttribute), 0);
+  EXPECT_EQ(CountCommands(batch, UICommand::kInsertAdjacentNode), 1);
+  buffer->release();
+
+  EXPECT_EQ(buffer->coalescingStats().dead_node_commands >= 3, true);
+  EXPECT_EQ(errorCalled, false);
+}
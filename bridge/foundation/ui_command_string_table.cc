@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "ui_command_string_table.h"
+#include "bindings/qjs/native_string_utils.h"
+
+namespace webf {
+
+UICommandStringTable::InternResult UICommandStringTable::Intern(const AtomicString& string) {
+  auto it = atomic_ids_.find(string);
+  if (it != atomic_ids_.end()) {
+    return {it->second, false};
+  }
+
+  if (UNLIKELY(strings_.size() >= MAXIMUM_UI_COMMAND_INTERNED_STRINGS)) {
+    return {kNotInterned, false};
+  }
+
+  std::u16string characters;
+  if (!string.IsEmpty()) {
+    if (string.Is8Bit()) {
+      characters.assign(string.Character8(), string.Character8() + string.length());
+    } else {
+      characters.assign(string.Character16(), string.Character16() + string.length());
+    }
+  }
+  InternResult result = Add(std::move(characters));
+  atomic_ids_[string] = result.id;
+  return result;
+}
+
+UICommandStringTable::InternResult UICommandStringTable::Intern(const std::string& string) {
+  auto it = std_string_ids_.find(string);
+  if (it != std_string_ids_.end()) {
+    return {it->second, false};
+  }
+
+  if (UNLIKELY(strings_.size() >= MAXIMUM_UI_COMMAND_INTERNED_STRINGS)) {
+    return {kNotInterned, false};
+  }
+
+  std::u16string characters;
+  fromUTF8(string, characters);
+  InternResult result = Add(std::move(characters));
+  std_string_ids_[string] = result.id;
+  return result;
+}
+
+const std::u16string& UICommandStringTable::Lookup(int32_t id) const {
+  assert(id >= 0 && id < static_cast<int32_t>(strings_.size()));
+  return strings_[id];
+}
+
+void UICommandStringTable::Reset() {
+  atomic_ids_.clear();
+  std_string_ids_.clear();
+  strings_.clear();
+}
+
+UICommandStringTable::InternResult UICommandStringTable::Add(std::u16string&& string) {
+  auto id = static_cast<int32_t>(strings_.size());
+  strings_.emplace_back(std::move(string));
+  return {id, true};
+}
+
+}  // namespace webf
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_FOUNDATION_UI_COMMAND_STRING_TABLE_H_
+#define BRIDGE_FOUNDATION_UI_COMMAND_STRING_TABLE_H_
+
+#include <cinttypes>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "bindings/qjs/atomic_string.h"
+
+namespace webf {
+
+// Stop interning new strings once the table holds this many entries, to keep the table bounded on pages which
+// generate names dynamically.
+#define MAXIMUM_UI_COMMAND_INTERNED_STRINGS 4096
+
+// Per context table of the strings commonly carried by ui commands: tag names, insert positions, css property names
+// and event types. Every distinct string is sent to dart side once through a kInternString command, later commands
+// reference it by id instead of carrying a fresh UTF-16 copy.
+class UICommandStringTable {
+ public:
+  static constexpr int32_t kNotInterned = -1;
+
+  struct InternResult {
+    // kNotInterned when the table is full, the string should be sent with the command itself.
+    int32_t id{kNotInterned};
+    // Newly interned strings should be sent with kInternString before the command.
+    bool is_new{false};
+  };
+
+  InternResult Intern(const AtomicString& string);
+  InternResult Intern(const std::string& string);
+  const std::u16string& Lookup(int32_t id) const;
+  size_t size() const { return strings_.size(); }
+  // Forget all the strings, used when pending definitions are dropped before dart side read them.
+  void Reset();
+
+ private:
+  InternResult Add(std::u16string&& string);
+
+  std::unordered_map<AtomicString, int32_t, AtomicString::KeyHasher> atomic_ids_;
+  std::unordered_map<std::string, int32_t> std_string_ids_;
+  std::vector<std::u16string> strings_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_FOUNDATION_UI_COMMAND_STRING_TABLE_H_
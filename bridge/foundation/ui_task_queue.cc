@@ -6,8 +6,12 @@
 #include "ui_task_queue.h"
 
 namespace webf {
-std::mutex UITaskQueue::ui_task_creation_mutex_{};
-fml::RefPtr<UITaskQueue> UITaskQueue::instance_{};
+
+fml::RefPtr<UITaskQueue> UITaskQueue::Create(int32_t contextId) {
+  auto queue = fml::MakeRefCounted<UITaskQueue>();
+  queue->m_contextId = contextId;
+  return queue;
+}
 
 int32_t UITaskQueue::registerTask(const Task& task, void* data) {
   int32_t taskId = TaskQueue::registerTask(task, data);
@@ -13,18 +13,15 @@ namespace webf {
 class UITaskQueue : public TaskQueue {
  public:
   static fml::RefPtr<UITaskQueue> instance(int32_t contextId) {
-    std::lock_guard<std::mutex> guard(ui_task_creation_mutex_);
-    if (!instance_) {
-      instance_ = fml::MakeRefCounted<UITaskQueue>();
-      instance_->m_contextId = contextId;
-    }
-    return instance_;
+    // Created once by the first caller, later calls don't take a lock.
+    static const fml::RefPtr<UITaskQueue> instance = Create(contextId);
+    return instance;
   };
   int32_t registerTask(const Task& task, void* data);
 
  private:
-  static std::mutex ui_task_creation_mutex_;
-  static fml::RefPtr<UITaskQueue> instance_;
+  static fml::RefPtr<UITaskQueue> Create(int32_t contextId);
+
   int m_contextId;
 };
 
@@ -32,10 +32,19 @@ struct WebFInfo {
 };
 
 typedef void (*Task)(void*);
+// js_thread_port is the native port of a dart ReceivePort, JS runs on js_thread_count dedicated threads and notifies
+// dart side through the port when a call to dart side is waiting. JS runs on the dart thread when it's 0.
 WEBF_EXPORT_C
-void* initDartIsolateContext(uint64_t* dart_methods, int32_t dart_methods_len);
+void* initDartIsolateContext(uint64_t* dart_methods,
+                             int32_t dart_methods_len,
+                             int64_t js_thread_port,
+                             int32_t js_thread_count);
+// Run the calls from JS to dart side which are waiting on the dart thread.
 WEBF_EXPORT_C
-void* allocateNewPage(void* dart_isolate_context, int32_t targetContextId);
+void flushDartThreadTasks(void* dart_isolate_context);
+// Pages of the same js_thread_group share a JS thread, a negative group puts the page on the least loaded one.
+WEBF_EXPORT_C
+void* allocateNewPage(void* dart_isolate_context, int32_t targetContextId, int32_t js_thread_group);
 WEBF_EXPORT_C
 void disposePage(void* dart_isolate_context, void* page);
 WEBF_EXPORT_C
@@ -47,6 +56,16 @@ int8_t evaluateScripts(void* page,
                        int32_t startLine);
 WEBF_EXPORT_C
 int8_t evaluateQuickjsByteCode(void* page, uint8_t* bytes, int32_t byteLen);
+// Starts compiling |code| to bytecode on a background thread, the code is copied. The returned script is run and freed
+// by evaluateCompiledScript(), or only freed by disposeCompiledScript().
+WEBF_EXPORT_C
+void* compileScript(SharedNativeString* code, const char* bundleFilename);
+// Waits for |script| to be compiled and runs it. The bytecode is handed out in a malloc'ed |parsed_bytecodes| when
+// given, to be cached by dart side.
+WEBF_EXPORT_C
+int8_t evaluateCompiledScript(void* page, void* script, uint8_t** parsed_bytecodes, uint64_t* bytecode_len);
+WEBF_EXPORT_C
+void disposeCompiledScript(void* script);
 WEBF_EXPORT_C
 void parseHTML(void* page, const char* code, int32_t length);
 WEBF_EXPORT_C
@@ -59,18 +78,54 @@ WEBF_EXPORT_C
 WebFInfo* getWebFInfo();
 WEBF_EXPORT_C
 void dispatchUITask(void* page, void* context, void* callback);
+// Take the pending ui commands as a whole batch, the executing context continues recording into another buffer.
+// Returns the chunk list of the batch and writes the count of commands into length. The batch stays valid until
+// releaseUICommandItems is called.
 WEBF_EXPORT_C
-void* getUICommandItems(void* page);
+void* acquireUICommandItems(void* page, int64_t* length);
 WEBF_EXPORT_C
-int64_t getUICommandItemSize(void* page);
+void releaseUICommandItems(void* page);
+// Drop the ui commands cancelled out by later ones in the same batch before handing them to dart side.
 WEBF_EXPORT_C
-void clearUICommandItems(void* page);
+void setUICommandCoalescingEnabled(void* page, int8_t enabled);
+WEBF_EXPORT_C
+void* getUICommandCoalescingStats(void* page);
 WEBF_EXPORT_C
 void registerPluginByteCode(uint8_t* bytes, int32_t length, const char* pluginName);
 WEBF_EXPORT_C
 void registerPluginCode(const char* code, int32_t length, const char* pluginName);
+// The scripts run by `new Worker(scriptURL)` and importScripts(scriptURL) in workers. Bytecode isn't copied.
+WEBF_EXPORT_C
+void registerWorkerByteCode(uint8_t* bytes, int32_t length, const char* scriptURL);
+WEBF_EXPORT_C
+void registerWorkerCode(const char* code, int32_t length, const char* scriptURL);
 WEBF_EXPORT_C
 int32_t profileModeEnabled();
+// Count the ui commands and the flushes of the page, see UICommandStats. Enabling resets the counters.
+WEBF_EXPORT_C
+void setUICommandStatsEnabled(void* page, int8_t enabled);
+WEBF_EXPORT_C
+void* getUICommandStats(void* page);
+// The lengths of the arrays in UICommandStats, for dart side to check its enums are in sync.
+WEBF_EXPORT_C
+int32_t getUICommandTypeCount();
+WEBF_EXPORT_C
+int32_t getUICommandFlushReasonCount();
+// Warn with the JS stack when the synchronous reads flushing pending ui commands in one task reach the threshold.
+// 0 disables the detection.
+WEBF_EXPORT_C
+void setLayoutThrashingThreshold(void* page, int32_t threshold);
+// Refresh the geometry cached by the elements after a frame was laid out, metrics is a list of NativeLayoutMetrics.
+WEBF_EXPORT_C
+void updateLayoutMetrics(void* page, void* metrics, int32_t length);
+// Drop the cached geometry when the layout changed without ui commands, e.g. the viewport was resized.
+WEBF_EXPORT_C
+void invalidateLayoutMetrics(void* page);
+// Describe a kind of WidgetElement before any of them was created, so JS can use its properties and methods without
+// flushing the ui commands first. argv holds the lists of properties, sync methods, async methods and the cache
+// policies of the properties.
+WEBF_EXPORT_C
+void registerWidgetElementShape(void* page, SharedNativeString* tag_name, int32_t argc, NativeValue* argv);
 
 WEBF_EXPORT_C
 void init_dart_dynamic_linking(void* data);
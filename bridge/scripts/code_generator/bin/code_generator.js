@@ -144,6 +144,14 @@ function genCodeFromJSONData() {
       let genFilePath = path.join(dist, targetTemplate.filename);
       wirteFileIfChanged(genFilePath + '.h', result.header);
       result.source && wirteFileIfChanged(genFilePath + '.cc', result.source);
+
+      // The names shared with dart side, the dart file lives in the webf package and is checked in.
+      if (targetTemplate.dart) {
+        let targetTemplateDartData = templates.find(t => t.filename === targetTemplate.template + '.dart');
+        let dartResult = generateJSONTemplate(blobs[i], targetTemplateDartData, undefined, depsBlob, targetTemplate.options);
+        let cwdDir = blob.source.split(path.sep).slice(0, -1).join(path.sep);
+        wirteFileIfChanged(path.join(cwdDir, targetTemplate.dart), dartResult.header + '\n');
+      }
     });
   }
 
@@ -12,5 +12,6 @@ declare type JSEventListener = void;
 declare type LegacyNullToEmptyString = string | null;
 
 // This property is implemented by Dart side
-type DartImpl<T> = T;
+// Properties of the same Group are read from dart side with one call, see BindingObject::GetBindingPropertyInGroup.
+type DartImpl<T, Group extends string = never> = T;
 type StaticMember<T> = T;
@@ -127,6 +127,10 @@ function getParameterBaseType(type: ts.TypeNode, mode?: ParameterMode): Paramete
       return argument.typeName.text;
     } else if (identifier === 'DartImpl') {
       if (mode) mode.dartImpl = true;
+      let group = typeReference.typeArguments![1];
+      if (mode && group && group.kind === ts.SyntaxKind.LiteralType) {
+        mode.dartImplGroup = ((group as unknown as ts.LiteralTypeNode).literal as ts.StringLiteral).text;
+      }
       let argument = typeReference.typeArguments![0];
       // @ts-ignore
       return getParameterBaseType(argument);
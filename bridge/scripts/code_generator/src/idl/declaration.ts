@@ -32,6 +32,8 @@ export class FunctionArguments {
 export class ParameterMode {
   newObject?: boolean;
   dartImpl?: boolean;
+  // Properties implemented at dart side with the same group are read together, e.g. DartImpl<double, 'viewport'>.
+  dartImplGroup?: string;
   static?: boolean;
 }
 
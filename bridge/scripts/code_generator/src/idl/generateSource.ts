@@ -548,6 +548,20 @@ function readTemplate(name: string) {
   return fs.readFileSync(path.join(__dirname, '../../templates/idl_templates/' + name + '.cc.tpl'), {encoding: 'utf-8'});
 }
 
+// The members of the group of a DartImpl property, which are read from dart side with one call.
+export function getDartImplPropertyGroup(object: ClassObject, prop: PropsDeclaration) {
+  let group = object.props.filter(p => p.typeMode && p.typeMode.dartImplGroup === prop.typeMode.dartImplGroup);
+  group.forEach(p => {
+    if (isTypeNeedAllocate(p.type)) {
+      throw new Error(`${object.name}.${p.name}: only properties of numbers and booleans can be grouped.`);
+    }
+  });
+  return {
+    index: group.indexOf(prop),
+    props: group.map(p => `&binding_call_methods::k${p.name}`)
+  };
+}
+
 export function generateCppSource(blob: IDLBlob, options: GenerateOptions) {
   const baseTemplate = fs.readFileSync(path.join(__dirname, '../../templates/idl_templates/base.cc.tpl'), {encoding: 'utf-8'});
   const className = getClassName(blob)
@@ -650,6 +664,7 @@ const WrapperTypeInfo& ${className}::wrapper_type_info_ = QJS${className}::wrapp
           generateRawTypeValue,
           generateOverLoadSwitchBody,
           isTypeNeedAllocate,
+          getDartImplPropertyGroup,
           overloadMethods,
           isJSArrayBuiltInProps,
           filtedMethods,
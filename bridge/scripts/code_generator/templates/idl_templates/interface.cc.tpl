@@ -154,7 +154,11 @@ static JSValue <%= prop.name %>AttributeGetCallback(JSContext* ctx, JSValueConst
 
   <% if (prop.typeMode && prop.typeMode.dartImpl) { %>
   ExceptionState exception_state;
-  <% if (isTypeNeedAllocate(prop.type)) { %>
+  <% if (prop.typeMode.dartImplGroup) { %>
+  <% let group = getDartImplPropertyGroup(object, prop); %>
+  const AtomicString* const group_props[] = {<%= group.props.join(', ') %>};
+  typename <%= generateNativeValueTypeConverter(prop.type) %>::ImplType v = NativeValueConverter<<%= generateNativeValueTypeConverter(prop.type) %>>::FromNativeValue(<%= blob.filename %>->GetBindingPropertyInGroup(<%= group.index %>, BindingPropertyGroup{group_props, <%= group.props.length %>}, exception_state));
+  <% } else if (isTypeNeedAllocate(prop.type)) { %>
   typename <%= generateNativeValueTypeConverter(prop.type) %>::ImplType v = NativeValueConverter<<%= generateNativeValueTypeConverter(prop.type) %>>::FromNativeValue(ctx, <%= blob.filename %>->GetBindingProperty(binding_call_methods::k<%= prop.name %>, exception_state));
   <% } else { %>
   typename <%= generateNativeValueTypeConverter(prop.type) %>::ImplType v = NativeValueConverter<<%= generateNativeValueTypeConverter(prop.type) %>>::FromNativeValue(<%= blob.filename %>->GetBindingProperty(binding_call_methods::k<%= prop.name %>, exception_state));
@@ -1,7 +1,7 @@
 <%
 const lprefix = options.prefix.toLowerCase()
 const uprefix = options.prefix.toUpperCase()
-const items = data.map((item, index) => {
+const items = data.filter(item => !item.namesOnly).map((item, index) => {
   let name
   let headerPath
   let interfaceName
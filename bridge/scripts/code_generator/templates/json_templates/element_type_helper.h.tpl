@@ -13,7 +13,7 @@
 <% _.forEach(data, (item, index) => { %>
   <% if (_.isString(item)) { %>
 #include "core/html/html_<%= item %>_element.h"
-  <% } else if (_.isObject(item)) { %>
+  <% } else if (_.isObject(item) && !item.namesOnly) { %>
     <% if (item.interfaceHeaderDir) { %>
 #include "<%= item.interfaceHeaderDir %>/html_<%= item.filename ? item.filename : item.name  %>_element.h"
     <% } else if (item.interfaceName != 'HTMLElement'){ %>
@@ -51,7 +51,7 @@ struct DowncastTraits<HTML${_.upperFirst(name)}Element> {
 <% _.forEach(data, (item, index) => { %>
   <% if (_.isString(item)) { %>
     <%= generateTypeHelperTemplate(item) %>
-  <% } else if (_.isObject(item)) { %>
+  <% } else if (_.isObject(item) && !item.namesOnly) { %>
     <%= generateTypeHelperTemplate(item.name) %>
   <% } %>
 <% }) %>
@@ -4,6 +4,7 @@
 //   <%= template_path %>
 
 #include "<%= name %>.h"
+#include <cassert>
 
 namespace webf {
 namespace <%= name %> {
@@ -30,6 +31,20 @@ thread_local const AtomicString& k<%= name %> = reinterpret_cast<AtomicString*>(
   <% }) %>
 <% } %>
 
+int64_t IndexOf(const AtomicString& name) {
+  auto begin = reinterpret_cast<uintptr_t>(&names_storage);
+  auto address = reinterpret_cast<uintptr_t>(&name);
+  if (address < begin || address >= begin + sizeof(AtomicString) * kNamesCount) {
+    return -1;
+  }
+  return static_cast<int64_t>((address - begin) / sizeof(AtomicString));
+}
+
+const AtomicString& NameAt(int64_t index) {
+  assert(index >= 0 && index < kNamesCount);
+  return reinterpret_cast<AtomicString*>(&names_storage)[index];
+}
+
 void Init(JSContext* ctx) {
   struct NameEntry {
     <% if (options.add_atom_prefix) { %>
@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+// Generated from template:
+//   code_generator/templates/json_templates/make_names.dart.tpl
+// and input files:
+//   bridge/core/<%= name %>.json5
+// Do not edit, run the code generator after changing the input file.
+
+// The ids of the names, which are their positions in the input file and are shared with C++ side.
+abstract class <%= upperCamelCase(name) %> {
+<% _.forEach(data, function(name, index) { %>
+  <% if (_.isArray(name)) { %>
+  static const int k<%= name[0] %> = <%= index %>;
+  <% } else if (_.isObject(name)) { %>
+  static const int k<%= name.name %> = <%= index %>;
+  <% } else { %>
+  static const int k<%= name %> = <%= index %>;
+  <% } %>
+<% }) %>
+}
+
+const List<String> <%= _.camelCase(name) %>Names = [
+<% _.forEach(data, function(name) { %>
+  <% if (_.isArray(name)) { %>
+  '<%= name[1] %>',
+  <% } else if (_.isObject(name)) { %>
+  '<%= name.name %>',
+  <% } else { %>
+  '<%= name %>',
+  <% } %>
+<% }) %>
+];
@@ -31,6 +31,10 @@ namespace <%= name %> {
 
 constexpr unsigned kNamesCount = <%= data.length %>;
 
+// The position of |name| in the names, -1 when |name| is not one of the names declared above.
+int64_t IndexOf(const AtomicString& name);
+const AtomicString& NameAt(int64_t index);
+
 void Init(JSContext* ctx);
 void Dispose();
 
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include <mutex>
+#include <unordered_map>
+#include "foundation/task_queue.h"
+
+using namespace webf;
+
+namespace {
+
+// The TaskQueue before it became lock free, kept as the baseline.
+class MutexTaskQueue {
+ public:
+  int32_t registerTask(const Task& task, void* data) {
+    std::lock_guard<std::mutex> guard(queue_mutex_);
+    auto taskData = new TaskData(task, data);
+    m_map[id++] = taskData;
+    return id - 1;
+  }
+
+  void flushTask() {
+    std::lock_guard<std::mutex> guard(queue_mutex_);
+    for (auto& m : m_map) {
+      m.second->task(m.second->data);
+      delete m.second;
+    }
+    m_map.clear();
+  }
+
+ private:
+  struct TaskData {
+    TaskData(const Task& task, void* data) : task(task), data(data){};
+    Task task;
+    void* data;
+  };
+
+  std::mutex queue_mutex_;
+  std::unordered_map<int, TaskData*> m_map;
+  int64_t id{0};
+};
+
+void EmptyTask(void* data) {
+  benchmark::DoNotOptimize(data);
+}
+
+// Tasks are flushed by the first thread every kFlushInterval registrations, the other threads only register.
+constexpr int64_t kFlushInterval = 64;
+
+fml::RefPtr<TaskQueue> lock_free_queue;
+MutexTaskQueue* mutex_queue = nullptr;
+
+}  // namespace
+
+static void LockFreeTaskQueueRegister(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    lock_free_queue = fml::MakeRefCounted<TaskQueue>();
+  }
+  int64_t registered = 0;
+  for (auto _ : state) {
+    lock_free_queue->registerTask(EmptyTask, nullptr);
+    if (state.thread_index() == 0 && ++registered % kFlushInterval == 0) {
+      lock_free_queue->flushTask();
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    lock_free_queue->flushTask();
+    lock_free_queue = nullptr;
+  }
+}
+
+static void MutexTaskQueueRegister(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    mutex_queue = new MutexTaskQueue();
+  }
+  int64_t registered = 0;
+  for (auto _ : state) {
+    mutex_queue->registerTask(EmptyTask, nullptr);
+    if (state.thread_index() == 0 && ++registered % kFlushInterval == 0) {
+      mutex_queue->flushTask();
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    mutex_queue->flushTask();
+    delete mutex_queue;
+    mutex_queue = nullptr;
+  }
+}
+
+BENCHMARK(LockFreeTaskQueueRegister)->Threads(1)->Threads(4)->Threads(8)->UseRealTime();
+BENCHMARK(MutexTaskQueueRegister)->Threads(1)->Threads(4)->Threads(8)->UseRealTime();
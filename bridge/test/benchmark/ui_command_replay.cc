@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include "ui_command_stream.h"
+#include "webf_test_env.h"
+
+// Benchmarks producing, coalescing and consuming ui commands without dart side.
+//
+// WEBF_UI_COMMAND_STREAM  Replays the stream in the file instead of the stream captured from the built-in workload.
+// WEBF_UI_COMMAND_CAPTURE Writes the stream captured from the built-in workload into the file, and a text dump of it
+//                         into the file with ".txt" appended, to be diffed between releases.
+
+using namespace webf;
+
+auto env = TEST_init();
+
+static const std::string workload = R"(
+(() => {
+let list = document.createElement('div');
+list.setAttribute('class', 'list');
+document.body.appendChild(list);
+for(let i = 0; i < 200; i ++) {
+  let item = document.createElement('div');
+  item.setAttribute('class', 'item');
+  item.style.width = '100px';
+  item.style.height = '20px';
+  item.addEventListener('click', () => {});
+  let text = document.createTextNode('item ' + i);
+  item.appendChild(text);
+  list.appendChild(item);
+}
+for(let i = 0; i < 200; i += 2) {
+  let item = list.childNodes[i];
+  item.style.width = '200px';
+  item.style.color = 'red';
+  item.setAttribute('class', 'item selected');
+}
+let template = document.createElement('div');
+template.innerHTML = '<p class="title">Title</p><ul><li>1</li><li>2</li><li>3</li></ul>';
+for(let i = 0; i < 50; i ++) {
+  list.appendChild(template.cloneNode(true));
+}
+document.body.removeChild(list);
+})();
+)";
+
+static std::vector<RecordedUICommandBatch> CaptureWorkload() {
+  auto context = env->page()->GetExecutingContext();
+  context->FlushUICommand();
+
+  std::stringstream stream;
+  UICommandRecorder recorder(stream);
+  TEST_registerUICommandFlushedCallback(
+      context->uniqueId(),
+      [](void* data, UICommandItem** chunks, int64_t length) {
+        static_cast<UICommandRecorder*>(data)->RecordBatch(chunks, length);
+      },
+      &recorder);
+  context->EvaluateJavaScript(workload.c_str(), workload.size(), "internal://", 0);
+  context->FlushUICommand();
+  TEST_registerUICommandFlushedCallback(context->uniqueId(), nullptr, nullptr);
+
+  std::vector<RecordedUICommandBatch> batches;
+  ReadUICommandStream(stream, batches);
+
+  if (const char* path = getenv("WEBF_UI_COMMAND_CAPTURE")) {
+    std::ofstream capture(path, std::ios::binary);
+    capture << stream.str();
+    std::ofstream dump(std::string(path) + ".txt");
+    dump << DumpUICommandStream(batches);
+  }
+  return batches;
+}
+
+static const std::vector<RecordedUICommandBatch>& ReplayBatches() {
+  static std::vector<RecordedUICommandBatch> batches = []() {
+    if (const char* path = getenv("WEBF_UI_COMMAND_STREAM")) {
+      std::vector<RecordedUICommandBatch> result;
+      std::ifstream input(path, std::ios::binary);
+      if (!ReadUICommandStream(input, result)) {
+        WEBF_LOG(ERROR) << "Failed to read ui command stream from " << path;
+      }
+      return result;
+    }
+    return CaptureWorkload();
+  }();
+  return batches;
+}
+
+// Producing the commands in JS and handing them over to the mocked dart side, with and without coalescing.
+static void ProduceUICommands(benchmark::State& state) {
+  auto context = env->page()->GetExecutingContext();
+  context->uiCommandBuffer()->SetCoalescingEnabled(state.range(0) == 1);
+  context->uiCommandBuffer()->SetStatsEnabled(true);
+  for (auto _ : state) {
+    context->EvaluateJavaScript(workload.c_str(), workload.size(), "internal://", 0);
+    context->FlushUICommand();
+  }
+
+  int64_t commands = 0;
+  for (int64_t count : context->uiCommandBuffer()->stats().command_count) {
+    commands += count;
+  }
+  state.counters["commands"] = benchmark::Counter(commands, benchmark::Counter::kAvgIterations);
+  context->uiCommandBuffer()->SetStatsEnabled(false);
+  context->uiCommandBuffer()->SetCoalescingEnabled(false);
+}
+
+// Applying a recorded stream to the reference consumer.
+static void ConsumeUICommands(benchmark::State& state) {
+  const std::vector<RecordedUICommandBatch>& batches = ReplayBatches();
+  int64_t commands = 0;
+  for (auto _ : state) {
+    MockUICommandConsumer consumer;
+    for (const RecordedUICommandBatch& batch : batches) {
+      consumer.Consume(batch);
+    }
+    commands = consumer.consumedCommands();
+    benchmark::DoNotOptimize(consumer.nodeCount());
+  }
+  state.counters["commands"] = static_cast<double>(commands);
+  state.counters["batches"] = static_cast<double>(batches.size());
+}
+
+BENCHMARK(ProduceUICommands)->Arg(0)->Arg(1)->Threads(1);
+BENCHMARK(ConsumeUICommands)->Threads(1);
+
+// Run the benchmark
+BENCHMARK_MAIN();
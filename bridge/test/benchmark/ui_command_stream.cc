@@ -0,0 +1,520 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "ui_command_stream.h"
+#include <algorithm>
+#include <sstream>
+#include "bindings/qjs/native_string_utils.h"
+#include "foundation/native_string.h"
+
+namespace webf {
+
+static const char kStreamMagic[4] = {'W', 'U', 'I', 'C'};
+static const int32_t kStreamVersion = 1;
+
+template <typename T>
+static void Write(std::ostream& output, T value) {
+  output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static void WriteString(std::ostream& output, const uint16_t* string, int32_t length) {
+  Write(output, length);
+  output.write(reinterpret_cast<const char*>(string), length * sizeof(uint16_t));
+}
+
+template <typename T>
+static bool Read(std::istream& input, T& value) {
+  return static_cast<bool>(input.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+static bool ReadString(std::istream& input, int32_t length, std::u16string& string) {
+  if (length < 0)
+    return false;
+  string.resize(length);
+  return static_cast<bool>(input.read(reinterpret_cast<char*>(&string[0]), length * sizeof(char16_t)));
+}
+
+static int64_t ToNumber(const std::u16string& field) {
+  return std::stoll(toUTF8(field));
+}
+
+UICommandRecorder::UICommandRecorder(std::ostream& output) : output_(output) {
+  output_.write(kStreamMagic, sizeof(kStreamMagic));
+  Write(output_, kStreamVersion);
+}
+
+void UICommandRecorder::RecordBatch(UICommandItem** chunks, int64_t length) {
+  Write(output_, length);
+  for (int64_t i = 0; i < length; i++) {
+    RecordCommand(chunks[i / UI_COMMAND_CHUNK_SIZE][i % UI_COMMAND_CHUNK_SIZE]);
+  }
+  batch_count_++;
+}
+
+void UICommandRecorder::RecordCommand(const UICommandItem& item) {
+  auto type = static_cast<UICommand>(item.type);
+  Write(output_, item.type);
+  if (item.args_01_length > 0) {
+    WriteString(output_, reinterpret_cast<const uint16_t*>(item.string_01), item.args_01_length);
+  } else {
+    Write(output_, item.args_01_length);
+  }
+  Write(output_, IdOf(item.nativePtr));
+
+  switch (type) {
+    case UICommand::kInsertAdjacentNode:
+    case UICommand::kCloneNode:
+      Write(output_, UICommandPayloadKind::kNode);
+      Write(output_, IdOf(item.nativePtr2));
+      break;
+    case UICommand::kSetStyle:
+    case UICommand::kSetAttribute:
+    case UICommand::kCreateElementNS: {
+      auto* string = reinterpret_cast<SharedNativeString*>(item.nativePtr2);
+      if (string == nullptr) {
+        Write(output_, UICommandPayloadKind::kNone);
+        break;
+      }
+      Write(output_, UICommandPayloadKind::kString);
+      WriteString(output_, string->string(), static_cast<int32_t>(string->length()));
+      break;
+    }
+    case UICommand::kAddEvent: {
+      // Same layout as AddEventListenerOptions at dart side.
+      auto* options = reinterpret_cast<const bool*>(item.nativePtr2);
+      if (options == nullptr) {
+        Write(output_, UICommandPayloadKind::kNone);
+        break;
+      }
+      Write(output_, UICommandPayloadKind::kInteger);
+      Write(output_, static_cast<int64_t>(options[0] | options[1] << 1 | options[2] << 2));
+      break;
+    }
+    case UICommand::kRemoveEvent:
+    case UICommand::kInternString:
+      Write(output_, UICommandPayloadKind::kInteger);
+      Write(output_, item.nativePtr2);
+      break;
+    case UICommand::kCreateSubtree: {
+      std::u16string packed(reinterpret_cast<const char16_t*>(item.string_01), item.args_01_length);
+      int64_t count = CountSubtreeNodes(packed);
+      auto* nodes = reinterpret_cast<int64_t*>(item.nativePtr2);
+      Write(output_, UICommandPayloadKind::kNodeList);
+      Write(output_, count);
+      for (int64_t i = 0; i < count; i++) {
+        Write(output_, IdOf(nodes[i]));
+      }
+      break;
+    }
+    default:
+      Write(output_, UICommandPayloadKind::kNone);
+      break;
+  }
+
+  // The address can be reused by a new binding object, which should get a new id.
+  if (type == UICommand::kDisposeBindingObject) {
+    ids_.erase(item.nativePtr);
+  }
+}
+
+int64_t UICommandRecorder::IdOf(int64_t pointer) {
+  if (pointer == 0)
+    return 0;
+  auto it = ids_.find(pointer);
+  if (it != ids_.end())
+    return it->second;
+  ids_[pointer] = next_id_;
+  return next_id_++;
+}
+
+bool ReadUICommandStream(std::istream& input, std::vector<RecordedUICommandBatch>& batches) {
+  char magic[sizeof(kStreamMagic)];
+  int32_t version;
+  if (!input.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), kStreamMagic) ||
+      !Read(input, version) || version != kStreamVersion) {
+    return false;
+  }
+
+  int64_t length;
+  while (Read(input, length)) {
+    RecordedUICommandBatch batch;
+    batch.reserve(length);
+    for (int64_t i = 0; i < length; i++) {
+      RecordedUICommand command;
+      int32_t type;
+      if (!Read(input, type) || !Read(input, command.args_length))
+        return false;
+      command.type = static_cast<UICommand>(type);
+      if (command.args_length > 0 && !ReadString(input, command.args_length, command.args))
+        return false;
+      if (!Read(input, command.target) || !Read(input, command.payload_kind))
+        return false;
+
+      switch (command.payload_kind) {
+        case UICommandPayloadKind::kNone:
+          break;
+        case UICommandPayloadKind::kNode:
+        case UICommandPayloadKind::kInteger:
+          if (!Read(input, command.payload))
+            return false;
+          break;
+        case UICommandPayloadKind::kString: {
+          int32_t string_length;
+          if (!Read(input, string_length) || !ReadString(input, string_length, command.payload_string))
+            return false;
+          break;
+        }
+        case UICommandPayloadKind::kNodeList: {
+          int64_t count;
+          if (!Read(input, count) || count < 0)
+            return false;
+          command.payload_nodes.resize(count);
+          for (int64_t& id : command.payload_nodes) {
+            if (!Read(input, id))
+              return false;
+          }
+          break;
+        }
+        default:
+          return false;
+      }
+      batch.emplace_back(std::move(command));
+    }
+    batches.emplace_back(std::move(batch));
+  }
+
+  return input.eof();
+}
+
+std::string DumpUICommandStream(const std::vector<RecordedUICommandBatch>& batches) {
+  std::unordered_map<int32_t, std::u16string> interned_strings;
+  std::stringstream stream;
+  for (size_t i = 0; i < batches.size(); i++) {
+    stream << "batch " << i << "\n";
+    for (const RecordedUICommand& command : batches[i]) {
+      stream << "  " << GetUICommandName(command.type) << " #" << command.target;
+      if (command.type == UICommand::kInternString) {
+        interned_strings[static_cast<int32_t>(command.payload)] = command.args;
+      }
+      const std::u16string& args =
+          command.args_length < 0 ? interned_strings[-command.args_length - 1] : command.args;
+      if (!args.empty()) {
+        std::u16string printable = args;
+        std::replace(printable.begin(), printable.end(), u'\0', u'|');
+        stream << " \"" << toUTF8(printable) << "\"";
+      }
+      switch (command.payload_kind) {
+        case UICommandPayloadKind::kNode:
+          stream << " #" << command.payload;
+          break;
+        case UICommandPayloadKind::kInteger:
+          stream << " " << command.payload;
+          break;
+        case UICommandPayloadKind::kString:
+          stream << " \"" << toUTF8(command.payload_string) << "\"";
+          break;
+        case UICommandPayloadKind::kNodeList:
+          for (int64_t id : command.payload_nodes) {
+            stream << " #" << id;
+          }
+          break;
+        default:
+          break;
+      }
+      stream << "\n";
+    }
+  }
+  return stream.str();
+}
+
+namespace {
+
+struct SubtreeNode {
+  UICommand type;
+  int64_t parent;
+  std::u16string name;
+  std::vector<std::pair<std::u16string, std::u16string>> attributes;
+  std::vector<std::pair<std::u16string, std::u16string>> style;
+};
+
+bool ParseSubtree(const std::u16string& packed, std::vector<SubtreeNode>& nodes) {
+  std::vector<std::u16string> fields;
+  size_t begin = 0;
+  for (size_t end = packed.find(u'\0'); end != std::u16string::npos; end = packed.find(u'\0', begin)) {
+    fields.emplace_back(packed.substr(begin, end - begin));
+    begin = end + 1;
+  }
+
+  size_t i = 0;
+  auto read_pairs = [&](std::vector<std::pair<std::u16string, std::u16string>>& pairs) {
+    if (i >= fields.size())
+      return false;
+    int64_t count = ToNumber(fields[i++]);
+    if (count < 0 || i + count * 2 > fields.size())
+      return false;
+    for (int64_t j = 0; j < count; j++, i += 2) {
+      pairs.emplace_back(fields[i], fields[i + 1]);
+    }
+    return true;
+  };
+
+  while (i < fields.size()) {
+    if (i + 3 > fields.size())
+      return false;
+    SubtreeNode node;
+    node.type = static_cast<UICommand>(ToNumber(fields[i]));
+    node.parent = ToNumber(fields[i + 1]);
+    node.name = fields[i + 2];
+    i += 3;
+    if (node.type == UICommand::kCreateElementNS) {
+      // The namespace is not kept by the mock nodes.
+      i++;
+    }
+    if (node.type == UICommand::kCreateElement || node.type == UICommand::kCreateSVGElement ||
+        node.type == UICommand::kCreateElementNS) {
+      if (!read_pairs(node.attributes) || !read_pairs(node.style))
+        return false;
+    }
+    nodes.emplace_back(std::move(node));
+  }
+  return true;
+}
+
+}  // namespace
+
+int64_t CountSubtreeNodes(const std::u16string& packed) {
+  std::vector<SubtreeNode> nodes;
+  ParseSubtree(packed, nodes);
+  return static_cast<int64_t>(nodes.size());
+}
+
+void MockUICommandConsumer::Consume(const RecordedUICommandBatch& batch) {
+  for (const RecordedUICommand& command : batch) {
+    Apply(command);
+  }
+  consumed_commands_ += static_cast<int64_t>(batch.size());
+}
+
+MockNode* MockUICommandConsumer::GetNode(int64_t id) {
+  auto it = nodes_.find(id);
+  return it != nodes_.end() ? it->second.get() : nullptr;
+}
+
+void MockUICommandConsumer::Apply(const RecordedUICommand& command) {
+  const std::u16string& args =
+      command.args_length < 0 ? interned_strings_[-command.args_length - 1] : command.args;
+  MockNode* target = GetNode(command.target);
+
+  switch (command.type) {
+    case UICommand::kInternString:
+      interned_strings_[static_cast<int32_t>(command.payload)] = command.args;
+      break;
+    case UICommand::kCreateElement:
+    case UICommand::kCreateTextNode:
+    case UICommand::kCreateComment:
+    case UICommand::kCreateDocument:
+    case UICommand::kCreateWindow:
+    case UICommand::kCreateDocumentFragment:
+    case UICommand::kCreateSVGElement:
+    case UICommand::kCreateElementNS:
+      CreateNode(command.target, command.type, args);
+      break;
+    case UICommand::kCreateSubtree:
+      CreateSubtree(target, args, command.payload_nodes);
+      break;
+    case UICommand::kDisposeBindingObject:
+      if (target != nullptr) {
+        Detach(target);
+        for (MockNode* child : target->children) {
+          child->parent = nullptr;
+        }
+        nodes_.erase(command.target);
+      }
+      break;
+    case UICommand::kInsertAdjacentNode: {
+      MockNode* node = GetNode(command.payload);
+      if (target != nullptr && node != nullptr) {
+        InsertAdjacentNode(target, args, node);
+      }
+      break;
+    }
+    case UICommand::kRemoveNode:
+      if (target != nullptr) {
+        Detach(target);
+      }
+      break;
+    case UICommand::kCloneNode: {
+      MockNode* clone = GetNode(command.payload);
+      if (target != nullptr && clone != nullptr) {
+        clone->attributes = target->attributes;
+        clone->style = target->style;
+      }
+      break;
+    }
+    case UICommand::kSetStyle:
+      if (target == nullptr)
+        break;
+      if (command.payload_string.empty()) {
+        target->style.erase(args);
+      } else {
+        target->style[args] = command.payload_string;
+      }
+      break;
+    case UICommand::kSetStyleBatch:
+      if (target != nullptr) {
+        size_t begin = 0;
+        while (begin < args.size()) {
+          size_t name_end = args.find(u'\0', begin);
+          size_t value_end = name_end != std::u16string::npos ? args.find(u'\0', name_end + 1) : name_end;
+          if (value_end == std::u16string::npos)
+            break;
+          std::u16string value = args.substr(name_end + 1, value_end - name_end - 1);
+          if (value.empty()) {
+            target->style.erase(args.substr(begin, name_end - begin));
+          } else {
+            target->style[args.substr(begin, name_end - begin)] = value;
+          }
+          begin = value_end + 1;
+        }
+      }
+      break;
+    case UICommand::kClearStyle:
+      if (target != nullptr) {
+        target->style.clear();
+      }
+      break;
+    case UICommand::kSetAttribute:
+      if (target != nullptr) {
+        // Text nodes receive their data as the "data" attribute.
+        if (target->type == UICommand::kCreateTextNode && command.payload_string == u"data") {
+          target->name = args;
+        } else {
+          target->attributes[command.payload_string] = args;
+        }
+      }
+      break;
+    case UICommand::kRemoveAttribute:
+      if (target != nullptr) {
+        target->attributes.erase(args);
+      }
+      break;
+    case UICommand::kAddEvent:
+      if (target != nullptr) {
+        target->events.insert(args);
+      }
+      break;
+    case UICommand::kRemoveEvent:
+      if (target != nullptr) {
+        target->events.erase(args);
+      }
+      break;
+  }
+}
+
+MockNode* MockUICommandConsumer::CreateNode(int64_t id, UICommand type, const std::u16string& name) {
+  auto node = std::make_unique<MockNode>();
+  node->id = id;
+  node->type = type;
+  node->name = name;
+  MockNode* result = node.get();
+  nodes_[id] = std::move(node);
+  return result;
+}
+
+void MockUICommandConsumer::CreateSubtree(MockNode* parent,
+                                          const std::u16string& packed,
+                                          const std::vector<int64_t>& ids) {
+  std::vector<SubtreeNode> descriptions;
+  if (!ParseSubtree(packed, descriptions) || descriptions.size() != ids.size())
+    return;
+
+  std::vector<MockNode*> nodes;
+  nodes.reserve(ids.size());
+  for (size_t i = 0; i < descriptions.size(); i++) {
+    SubtreeNode& description = descriptions[i];
+    MockNode* node = CreateNode(ids[i], description.type, description.name);
+    node->attributes.insert(description.attributes.begin(), description.attributes.end());
+    node->style.insert(description.style.begin(), description.style.end());
+    nodes.emplace_back(node);
+
+    MockNode* node_parent = description.parent >= 0 ? nodes[description.parent] : parent;
+    if (node_parent != nullptr) {
+      node->parent = node_parent;
+      node_parent->children.emplace_back(node);
+    }
+  }
+}
+
+void MockUICommandConsumer::InsertAdjacentNode(MockNode* target, const std::u16string& position, MockNode* node) {
+  Detach(node);
+  if (position == u"beforebegin" || position == u"afterend") {
+    MockNode* parent = target->parent;
+    if (parent == nullptr)
+      return;
+    auto it = std::find(parent->children.begin(), parent->children.end(), target);
+    if (position == u"afterend")
+      it++;
+    parent->children.insert(it, node);
+    node->parent = parent;
+  } else if (position == u"afterbegin") {
+    target->children.insert(target->children.begin(), node);
+    node->parent = target;
+  } else {
+    target->children.emplace_back(node);
+    node->parent = target;
+  }
+}
+
+void MockUICommandConsumer::Detach(MockNode* node) {
+  if (node->parent == nullptr)
+    return;
+  auto& siblings = node->parent->children;
+  siblings.erase(std::find(siblings.begin(), siblings.end(), node));
+  node->parent = nullptr;
+}
+
+std::string MockUICommandConsumer::Serialize(int64_t id) {
+  std::string result;
+  MockNode* node = GetNode(id);
+  if (node != nullptr) {
+    Serialize(node, result);
+  }
+  return result;
+}
+
+void MockUICommandConsumer::Serialize(const MockNode* node, std::string& result) {
+  bool is_element = node->type == UICommand::kCreateElement || node->type == UICommand::kCreateSVGElement ||
+                    node->type == UICommand::kCreateElementNS;
+  if (node->type == UICommand::kCreateTextNode) {
+    result += toUTF8(node->name);
+    return;
+  }
+  if (node->type == UICommand::kCreateComment) {
+    result += "<!---->";
+    return;
+  }
+
+  if (is_element) {
+    result += "<" + toUTF8(node->name);
+    for (auto& attribute : node->attributes) {
+      result += " " + toUTF8(attribute.first) + "=\"" + toUTF8(attribute.second) + "\"";
+    }
+    if (!node->style.empty()) {
+      result += " style=\"";
+      for (auto& property : node->style) {
+        result += toUTF8(property.first) + ": " + toUTF8(property.second) + ";";
+      }
+      result += "\"";
+    }
+    result += ">";
+  }
+  for (const MockNode* child : node->children) {
+    Serialize(child, result);
+  }
+  if (is_element) {
+    result += "</" + toUTF8(node->name) + ">";
+  }
+}
+
+}  // namespace webf
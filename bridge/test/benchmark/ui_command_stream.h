@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_TEST_BENCHMARK_UI_COMMAND_STREAM_H_
+#define BRIDGE_TEST_BENCHMARK_UI_COMMAND_STREAM_H_
+
+#include <istream>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "foundation/macros.h"
+#include "foundation/ui_command_buffer.h"
+
+namespace webf {
+
+// The binary stream of the ui command batches flushed to dart side, which can be replayed without dart side.
+//
+// The stream starts with the magic "WUIC" and the version, followed by the batches. Every batch is the count of
+// commands followed by the commands:
+//   int32_t   type
+//   int32_t   args_01_length, negative for interned strings, see UICommandItem.
+//   uint16_t  args_01[args_01_length]
+//   int64_t   id of nativePtr, 0 for nullptr.
+//   uint8_t   UICommandPayloadKind of nativePtr2, followed by the payload.
+// Pointers to binding objects are recorded as ids in the order they first appear, so the streams of the same script
+// are identical between runs and can be diffed.
+enum class UICommandPayloadKind : uint8_t {
+  kNone,
+  // int64_t id of a binding object.
+  kNode,
+  // int32_t length followed by the UTF-16 characters.
+  kString,
+  // int64_t value.
+  kInteger,
+  // int64_t count followed by the ids of binding objects.
+  kNodeList,
+};
+
+struct RecordedUICommand {
+  UICommand type;
+  int32_t args_length{0};
+  std::u16string args;
+  int64_t target{0};
+  UICommandPayloadKind payload_kind{UICommandPayloadKind::kNone};
+  int64_t payload{0};
+  std::u16string payload_string;
+  std::vector<int64_t> payload_nodes;
+};
+
+using RecordedUICommandBatch = std::vector<RecordedUICommand>;
+
+// Writes the batches read by dart side into |output|.
+class UICommandRecorder {
+  WEBF_DISALLOW_COPY_AND_ASSIGN(UICommandRecorder);
+
+ public:
+  explicit UICommandRecorder(std::ostream& output);
+
+  // |chunks| and |length| are the values returned by acquireUICommandItems.
+  void RecordBatch(UICommandItem** chunks, int64_t length);
+  int64_t batchCount() const { return batch_count_; }
+
+ private:
+  void RecordCommand(const UICommandItem& item);
+  int64_t IdOf(int64_t pointer);
+
+  std::ostream& output_;
+  std::unordered_map<int64_t, int64_t> ids_;
+  int64_t next_id_{1};
+  int64_t batch_count_{0};
+};
+
+// Returns false when |input| is not an ui command stream or is truncated.
+bool ReadUICommandStream(std::istream& input, std::vector<RecordedUICommandBatch>& batches);
+
+// One line per command, with the interned strings resolved.
+std::string DumpUICommandStream(const std::vector<RecordedUICommandBatch>& batches);
+
+// Returns the number of nodes described by the args of a kCreateSubtree command, see SubtreeCommandScope.
+int64_t CountSubtreeNodes(const std::u16string& packed);
+
+struct MockNode {
+  int64_t id;
+  UICommand type;
+  // Tag name of elements and data of text nodes.
+  std::u16string name;
+  MockNode* parent{nullptr};
+  std::vector<MockNode*> children;
+  std::map<std::u16string, std::u16string> attributes;
+  std::map<std::u16string, std::u16string> style;
+  std::set<std::u16string> events;
+};
+
+// A reference consumer which applies the commands to a tree of mock nodes like dart side does to the render tree.
+class MockUICommandConsumer {
+ public:
+  void Consume(const RecordedUICommandBatch& batch);
+
+  MockNode* GetNode(int64_t id);
+  size_t nodeCount() const { return nodes_.size(); }
+  int64_t consumedCommands() const { return consumed_commands_; }
+
+  // Serializes the node and its descendants like outerHTML.
+  std::string Serialize(int64_t id);
+
+ private:
+  void Apply(const RecordedUICommand& command);
+  MockNode* CreateNode(int64_t id, UICommand type, const std::u16string& name);
+  void CreateSubtree(MockNode* parent, const std::u16string& packed, const std::vector<int64_t>& ids);
+  void InsertAdjacentNode(MockNode* target, const std::u16string& position, MockNode* node);
+  void Detach(MockNode* node);
+  void Serialize(const MockNode* node, std::string& result);
+
+  std::unordered_map<int64_t, std::unique_ptr<MockNode>> nodes_;
+  std::unordered_map<int32_t, std::u16string> interned_strings_;
+  int64_t consumed_commands_{0};
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_TEST_BENCHMARK_UI_COMMAND_STREAM_H_
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "ui_command_stream.h"
+#include <algorithm>
+#include <sstream>
+#include "gtest/gtest.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+static void RecordBatch(void* data, UICommandItem** chunks, int64_t length) {
+  static_cast<UICommandRecorder*>(data)->RecordBatch(chunks, length);
+}
+
+TEST(UICommandStream, replayToMockTree) {
+  bool static errorCalled = false;
+  auto env = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->GetExecutingContext();
+  context->FlushUICommand();
+
+  std::stringstream stream;
+  UICommandRecorder recorder(stream);
+  TEST_registerUICommandFlushedCallback(context->uniqueId(), RecordBatch, &recorder);
+
+  const char* code =
+      "let div = document.createElement('div');"
+      "div.setAttribute('id', 'box');"
+      "div.style.width = '100px';"
+      "div.appendChild(document.createTextNode('hello'));"
+      "document.body.appendChild(div);";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  context->FlushUICommand();
+  const char* code2 =
+      "div.innerHTML = '<span class=\"a\">world</span>';"
+      "div.style.width = '';"
+      "div.style.height = '20px';";
+  env->page()->evaluateScript(code2, strlen(code2), "vm://", 0);
+  context->FlushUICommand();
+  TEST_registerUICommandFlushedCallback(context->uniqueId(), nullptr, nullptr);
+  EXPECT_EQ(recorder.batchCount(), 2);
+
+  std::vector<RecordedUICommandBatch> batches;
+  EXPECT_EQ(ReadUICommandStream(stream, batches), true);
+  EXPECT_EQ(batches.size(), 2);
+
+  MockUICommandConsumer consumer;
+  for (auto& batch : batches) {
+    consumer.Consume(batch);
+  }
+
+  // The div is the first element created by the stream.
+  auto div = std::find_if(batches[0].begin(), batches[0].end(),
+                          [](const RecordedUICommand& command) { return command.type == UICommand::kCreateElement; });
+  EXPECT_EQ(div != batches[0].end(), true);
+  EXPECT_EQ(consumer.Serialize(div->target),
+            "<div id=\"box\" style=\"height: 20px;\"><span class=\"a\">world</span></div>");
+  EXPECT_EQ(DumpUICommandStream(batches).find("createSubtree") != std::string::npos, true);
+  EXPECT_EQ(errorCalled, false);
+}
@@ -29,12 +29,24 @@ list(APPEND WEBF_UNIT_TEST_SOURCEURCE
   ./core/dom/node_test.cc
   ./core/html/html_collection_test.cc
   ./core/dom/element_test.cc
+  ./core/dom/selector_query_test.cc
   ./core/frame/dom_timer_test.cc
   ./core/frame/window_test.cc
   ./core/css/inline_css_style_declaration_test.cc
   ./core/html/html_element_test.cc
   ./core/html/custom/widget_element_test.cc
+  ./core/geometry/dom_matrix_test.cc
+  ./core/workers/serialized_script_value_test.cc
+  ./core/workers/worker_test.cc
   ./core/timing/performance_test.cc
+  ./foundation/ui_command_buffer_test.cc
+  ./foundation/ui_command_coalescer_test.cc
+  ./foundation/looper_test.cc
+  ./foundation/task_queue_test.cc
+  ./core/js_thread_dispatcher_test.cc
+  ./test/benchmark/ui_command_stream.cc
+  ./test/benchmark/ui_command_stream.h
+  ./test/benchmark/ui_command_stream_test.cc
 )
 
 ### webf_unit_test executable
@@ -83,6 +95,7 @@ add_executable(webf_benchmark
   ./test/webf_test_env.cc
   ./test/webf_test_env.h
   ./test/benchmark/create_element.cc
+  ./test/benchmark/task_queue.cc
 )
 target_include_directories(webf_benchmark PUBLIC
   ./third_party/googletest/googletest/include
@@ -93,6 +106,25 @@ target_link_libraries(webf_benchmark gtest gtest_main benchmark::benchmark  ${BR
 target_compile_definitions(webf_benchmark PUBLIC -DFLUTTER_BACKEND=0)
 target_compile_definitions(webf_benchmark PUBLIC -DUNIT_TEST=1)
 
+# Record and replay ui command streams without flutter.
+add_executable(webf_ui_command_benchmark
+  ${WEBF_TEST_SOURCE}
+  ${BRIDGE_SOURCE}
+  ./test/webf_test_env.cc
+  ./test/webf_test_env.h
+  ./test/benchmark/ui_command_stream.cc
+  ./test/benchmark/ui_command_stream.h
+  ./test/benchmark/ui_command_replay.cc
+)
+target_include_directories(webf_ui_command_benchmark PUBLIC
+  ./third_party/googletest/googletest/include
+  ./third_party/benchmark/include/
+  ${BRIDGE_INCLUDE}
+  ./test)
+target_link_libraries(webf_ui_command_benchmark gtest gtest_main benchmark::benchmark  ${BRIDGE_LINK_LIBS})
+target_compile_definitions(webf_ui_command_benchmark PUBLIC -DFLUTTER_BACKEND=0)
+target_compile_definitions(webf_ui_command_benchmark PUBLIC -DUNIT_TEST=1)
+
 # Built libwebf_test.dylib library for integration test with flutter.
 add_library(webf_test SHARED ${WEBF_TEST_SOURCE})
 target_link_libraries(webf_test PRIVATE ${BRIDGE_LINK_LIBS} webf)
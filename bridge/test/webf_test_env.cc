@@ -174,11 +174,13 @@ void TEST_toBlob(void* ptr,
 
 void TEST_flushUICommand(int32_t contextId) {
   auto* page = test_context_map[contextId]->page();
-  clearUICommandItems(reinterpret_cast<void*>(page));
-}
-
-void TEST_CreateBindingObject(int32_t context_id, void* native_binding_object, int32_t type, void* args, int32_t argc) {
-
+  int64_t length;
+  auto* chunks = static_cast<UICommandItem**>(acquireUICommandItems(reinterpret_cast<void*>(page), &length));
+  auto env = TEST_getEnv(page->GetExecutingContext()->uniqueId());
+  if (env->on_ui_command_flushed != nullptr) {
+    env->on_ui_command_flushed(env->on_ui_command_flushed_data, chunks, length);
+  }
+  releaseUICommandItems(reinterpret_cast<void*>(page));
 }
 
 void TEST_onJsLog(int32_t contextId, int32_t level, const char*) {}
@@ -201,9 +203,9 @@ WebFTestEnv::~WebFTestEnv() {
 
 std::unique_ptr<WebFTestEnv> TEST_init(OnJSError onJsError) {
   auto mockedDartMethods = TEST_getMockDartMethods(onJsError);
-  auto* dart_isolate_context = initDartIsolateContext(mockedDartMethods.data(), mockedDartMethods.size());
+  auto* dart_isolate_context = initDartIsolateContext(mockedDartMethods.data(), mockedDartMethods.size(), 0, 1);
   int pageContextId = contextId++;
-  auto* page = allocateNewPage(dart_isolate_context, pageContextId);
+  auto* page = allocateNewPage(dart_isolate_context, pageContextId, -1);
   void* testContext = initTestFramework(page);
   test_context_map[pageContextId] = reinterpret_cast<WebFTestContext*>(testContext);
   TEST_mockTestEnvDartMethods(testContext, onJsError);
@@ -221,9 +223,9 @@ std::unique_ptr<WebFTestEnv> TEST_init() {
 std::unique_ptr<webf::WebFPage> TEST_allocateNewPage(OnJSError onJsError) {
   auto mockedDartMethods = TEST_getMockDartMethods(onJsError);
   auto dart_isolate_context = std::unique_ptr<DartIsolateContext>(
-      (DartIsolateContext*)initDartIsolateContext(mockedDartMethods.data(), mockedDartMethods.size()));
+      (DartIsolateContext*)initDartIsolateContext(mockedDartMethods.data(), mockedDartMethods.size(), 0, 1));
   int pageContextId = contextId++;
-  auto* page = allocateNewPage(dart_isolate_context.get(), pageContextId);
+  auto* page = allocateNewPage(dart_isolate_context.get(), pageContextId, -1);
   void* testContext = initTestFramework(page);
   test_context_map[pageContextId] = reinterpret_cast<WebFTestContext*>(testContext);
 
@@ -324,8 +326,7 @@ std::vector<uint64_t> TEST_getMockDartMethods(OnJSError onJSError) {
                                     reinterpret_cast<uint64_t>(TEST_requestAnimationFrame),
                                     reinterpret_cast<uint64_t>(TEST_cancelAnimationFrame),
                                     reinterpret_cast<uint64_t>(TEST_toBlob),
-                                    reinterpret_cast<uint64_t>(TEST_flushUICommand),
-                                    reinterpret_cast<uint64_t>(TEST_CreateBindingObject)};
+                                    reinterpret_cast<uint64_t>(TEST_flushUICommand)};
 
 #if ENABLE_PROFILE
   mockMethods.emplace_back(reinterpret_cast<uint64_t>(TEST_getPerformanceEntries));
@@ -368,4 +369,10 @@ void TEST_registerEventTargetDisposedCallback(int32_t context_unique_id, TEST_On
   unitTestEnvMap[context_unique_id]->on_event_target_disposed = callback;
 }
 
+void TEST_registerUICommandFlushedCallback(int32_t context_unique_id, TEST_OnUICommandFlushed callback, void* data) {
+  auto env = TEST_getEnv(context_unique_id);
+  env->on_ui_command_flushed = callback;
+  env->on_ui_command_flushed_data = data;
+}
+
 }  // namespace webf
@@ -17,8 +17,12 @@ using namespace webf;
 
 // Trigger a callbacks before GC free the eventTargets.
 using TEST_OnEventTargetDisposed = void (*)(EventTarget* event_target);
+// Receives the ui command batches read by the mocked dart side, the same as acquireUICommandItems returns.
+using TEST_OnUICommandFlushed = void (*)(void* data, UICommandItem** chunks, int64_t length);
 struct UnitTestEnv {
   TEST_OnEventTargetDisposed on_event_target_disposed{nullptr};
+  TEST_OnUICommandFlushed on_ui_command_flushed{nullptr};
+  void* on_ui_command_flushed_data{nullptr};
 };
 
 // Mock dart methods and add async timer to emulate webf environment in C++ unit test.
@@ -44,6 +48,7 @@ void TEST_runLoop(ExecutingContext* context);
 std::vector<uint64_t> TEST_getMockDartMethods(OnJSError onJSError);
 void TEST_mockTestEnvDartMethods(void* testContext, OnJSError onJSError);
 void TEST_registerEventTargetDisposedCallback(int32_t context_unique_id, TEST_OnEventTargetDisposed callback);
+void TEST_registerUICommandFlushedCallback(int32_t context_unique_id, TEST_OnUICommandFlushed callback, void* data);
 std::shared_ptr<UnitTestEnv> TEST_getEnv(int32_t context_unique_id);
 }  // namespace webf
    // void TEST_dispatchEvent(int32_t contextId, EventTarget* eventTarget, const std::string type);
@@ -569,6 +569,8 @@ static js_force_inline JSValue JS_NewUint32(JSContext *ctx, uint32_t val) {
 
 JSValue JS_NewBigInt64(JSContext *ctx, int64_t v);
 JSValue JS_NewBigUint64(JSContext *ctx, uint64_t v);
+/* Throws a SyntaxError for an invalid literal, or a TypeError when BigInt is not supported. */
+JSValue JS_NewBigIntFromString(JSContext* ctx, JSValueConst digits);
 
 static js_force_inline JSValue JS_NewFloat64(JSContext *ctx, double d) {
   JSValue v;
@@ -655,6 +657,9 @@ JSValue JS_GetException(JSContext *ctx);
 JS_BOOL JS_IsError(JSContext *ctx, JSValueConst val);
 void JS_ResetUncatchableError(JSContext *ctx);
 JSValue JS_NewError(JSContext *ctx);
+/* An error with the prototype of the native error constructor 'name', e.g.
+   "TypeError", or of Error when 'name' is not a native error. */
+JSValue JS_NewNativeError(JSContext* ctx, const char* name, JSValueConst message);
 JSValue __js_printf_like(2, 3) JS_ThrowSyntaxError(JSContext *ctx, const char *fmt, ...);
 JSValue __js_printf_like(2, 3) JS_ThrowTypeError(JSContext *ctx, const char *fmt, ...);
 JSValue __js_printf_like(2, 3) JS_ThrowReferenceError(JSContext *ctx, const char *fmt, ...);
@@ -738,6 +743,16 @@ JS_BOOL JS_SetConstructorBit(JSContext *ctx, JSValueConst func_obj, JS_BOOL val)
 
 JSValue JS_NewArray(JSContext *ctx);
 int JS_IsArray(JSContext *ctx, JSValueConst val);
+JSValue JS_ToObject(JSContext* ctx, JSValueConst val);
+JSValue JS_NewDate(JSContext* ctx, double epoch_ms);
+JSValue JS_NewRegExp(JSContext* ctx, JSValueConst pattern, JSValueConst flags);
+JSValue JS_NewMap(JSContext* ctx);
+JSValue JS_NewSet(JSContext* ctx);
+/* Adds an entry to a Map, or 'key' to a Set and 'value' is ignored. */
+int JS_MapSetEntry(JSContext* ctx, JSValueConst obj, JSValueConst key, JSValueConst value);
+/* A new array of the keys and values of a Map interleaved, or of the values
+   of a Set, in insertion order. No user code is run. */
+JSValue JS_GetMapEntries(JSContext* ctx, JSValueConst obj);
 
 typedef struct InlineCache InlineCache;
 JSValue JS_GetPropertyInternal(JSContext* ctx, JSValueConst obj, JSAtom prop, JSValueConst receiver, InlineCache *ic, JS_BOOL throw_ref_error);
@@ -805,8 +820,15 @@ typedef void JSFreeArrayBufferDataFunc(JSRuntime *rt, void *opaque, void *ptr);
 JSValue JS_NewArrayBuffer(JSContext* ctx, uint8_t* buf, size_t len, JSFreeArrayBufferDataFunc* free_func, void* opaque, JS_BOOL is_shared);
 JSValue JS_NewArrayBufferCopy(JSContext* ctx, const uint8_t* buf, size_t len);
 void JS_DetachArrayBuffer(JSContext *ctx, JSValueConst obj);
+uint8_t* JS_TransferArrayBuffer(JSContext* ctx, size_t* psize, JSValueConst obj);
+void JS_FreeTransferredArrayBuffer(JSRuntime* rt, void* opaque, void* ptr);
 uint8_t* JS_GetArrayBuffer(JSContext* ctx, size_t* psize, JSValueConst obj);
 JSValue JS_GetTypedArrayBuffer(JSContext* ctx, JSValueConst obj, size_t* pbyte_offset, size_t* pbyte_length, size_t* pbytes_per_element);
+/* 'class_id' is a typed array class or JS_CLASS_DATAVIEW. 'length' counts
+   elements of a typed array and bytes of a DataView. */
+JSValue JS_NewArrayBufferView(JSContext* ctx, JSClassID class_id, JSValueConst buffer, uint64_t byte_offset, uint64_t length);
+/* Like JS_GetTypedArrayBuffer() but also accepts a DataView. */
+JSValue JS_GetArrayBufferViewBuffer(JSContext* ctx, JSValueConst obj, size_t* pbyte_offset, size_t* pbyte_length);
 typedef struct {
   void* (*sab_alloc)(void* opaque, size_t size);
   void (*sab_free)(void* opaque, void* ptr);
@@ -4634,4 +4634,16 @@ void JS_EnableBignumExt(JSContext *ctx, BOOL enable)
   ctx->bignum_ext = enable;
 }
 
-#endif /* CONFIG_BIGNUM */
\ No newline at end of file
+#endif /* CONFIG_BIGNUM */
+
+JSValue JS_NewBigIntFromString(JSContext *ctx, JSValueConst digits)
+{
+#ifdef CONFIG_BIGNUM
+  JSValue str = JS_ToString(ctx, digits);
+  if (JS_IsException(str))
+    return str;
+  return JS_StringToBigIntErr(ctx, str);
+#else
+  return JS_ThrowTypeError(ctx, "BigInt is not supported");
+#endif
+}
\ No newline at end of file
@@ -554,6 +554,13 @@ has_val:
   return rv;
 }
 
+JSValue JS_NewDate(JSContext* ctx, double epoch_ms) {
+  JSValue obj = js_create_from_ctor(ctx, JS_UNDEFINED, JS_CLASS_DATE);
+  if (!JS_IsException(obj))
+    JS_SetObjectData(ctx, obj, JS_NewFloat64(ctx, time_clip(epoch_ms)));
+  return obj;
+}
+
 JSValue js_Date_UTC(JSContext* ctx, JSValueConst this_val, int argc, JSValueConst* argv) {
   // UTC(y, mon, d, h, m, s, ms)
   double fields[] = {0, 0, 1, 0, 0, 0, 0};
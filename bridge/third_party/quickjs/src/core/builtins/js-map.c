@@ -779,6 +779,66 @@ const uint8_t js_map_proto_funcs_count[6] = {
     countof(js_set_iterator_proto_funcs),
 };
 
+static BOOL js_map_is_set(JSValueConst obj)
+{
+  return JS_VALUE_GET_TAG(obj) == JS_TAG_OBJECT &&
+         JS_VALUE_GET_OBJ(obj)->class_id == JS_CLASS_SET;
+}
+
+JSValue JS_NewMap(JSContext *ctx)
+{
+  return js_map_constructor(ctx, JS_UNDEFINED, 0, NULL, 0);
+}
+
+JSValue JS_NewSet(JSContext *ctx)
+{
+  return js_map_constructor(ctx, JS_UNDEFINED, 0, NULL, MAGIC_SET);
+}
+
+int JS_MapSetEntry(JSContext *ctx, JSValueConst obj, JSValueConst key,
+                   JSValueConst value)
+{
+  JSValueConst args[2] = { key, value };
+  int magic = js_map_is_set(obj) ? MAGIC_SET : 0;
+  JSValue ret = js_map_set(ctx, obj, 2, args, magic);
+  if (JS_IsException(ret))
+    return -1;
+  JS_FreeValue(ctx, ret);
+  return 0;
+}
+
+JSValue JS_GetMapEntries(JSContext *ctx, JSValueConst obj)
+{
+  JSMapState *s;
+  JSMapRecord *mr;
+  struct list_head *el;
+  JSValue arr;
+  uint32_t i = 0;
+  BOOL is_set;
+
+  is_set = js_map_is_set(obj);
+  s = JS_GetOpaque2(ctx, obj, is_set ? JS_CLASS_SET : JS_CLASS_MAP);
+  if (!s)
+    return JS_EXCEPTION;
+  arr = JS_NewArray(ctx);
+  if (JS_IsException(arr))
+    return arr;
+  list_for_each(el, &s->records) {
+    mr = list_entry(el, JSMapRecord, link);
+    if (mr->empty)
+      continue;
+    if (JS_DefinePropertyValueUint32(ctx, arr, i++, JS_DupValue(ctx, mr->key), JS_PROP_C_W_E) < 0)
+      goto fail;
+    if (!is_set &&
+        JS_DefinePropertyValueUint32(ctx, arr, i++, JS_DupValue(ctx, mr->value), JS_PROP_C_W_E) < 0)
+      goto fail;
+  }
+  return arr;
+ fail:
+  JS_FreeValue(ctx, arr);
+  return JS_EXCEPTION;
+}
+
 void JS_AddIntrinsicMapSet(JSContext *ctx)
 {
   int i;
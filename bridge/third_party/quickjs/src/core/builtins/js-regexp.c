@@ -147,6 +147,14 @@ JSValue js_regexp_constructor_internal(JSContext *ctx, JSValueConst ctor,
   return obj;
 }
 
+JSValue JS_NewRegExp(JSContext *ctx, JSValueConst pattern, JSValueConst flags)
+{
+  JSValue bc = js_compile_regexp(ctx, pattern, flags);
+  if (JS_IsException(bc))
+    return bc;
+  return js_regexp_constructor_internal(ctx, JS_UNDEFINED, JS_ToString(ctx, pattern), bc);
+}
+
 JSRegExp *js_get_regexp(JSContext *ctx, JSValueConst obj, BOOL throw_error)
 {
   if (JS_VALUE_GET_TAG(obj) == JS_TAG_OBJECT) {
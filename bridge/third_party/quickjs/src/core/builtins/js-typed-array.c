@@ -27,6 +27,7 @@
 #include "../convertion.h"
 #include "../exception.h"
 #include "../function.h"
+#include "../malloc.h"
 #include "../object.h"
 #include "../runtime.h"
 #include "../string.h"
@@ -179,14 +180,9 @@ JSValue js_array_buffer_get_byteLength(JSContext* ctx, JSValueConst this_val, in
   return JS_NewUint32(ctx, abuf->byte_length);
 }
 
-void JS_DetachArrayBuffer(JSContext* ctx, JSValueConst obj) {
-  JSArrayBuffer* abuf = JS_GetOpaque(obj, JS_CLASS_ARRAY_BUFFER);
+static void js_array_buffer_detach(JSArrayBuffer* abuf) {
   struct list_head* el;
 
-  if (!abuf || abuf->detached)
-    return;
-  if (abuf->free_func)
-    abuf->free_func(ctx->rt, abuf->opaque, abuf->data);
   abuf->data = NULL;
   abuf->byte_length = 0;
   abuf->detached = TRUE;
@@ -205,6 +201,58 @@ void JS_DetachArrayBuffer(JSContext* ctx, JSValueConst obj) {
   }
 }
 
+void JS_DetachArrayBuffer(JSContext* ctx, JSValueConst obj) {
+  JSArrayBuffer* abuf = JS_GetOpaque(obj, JS_CLASS_ARRAY_BUFFER);
+
+  if (!abuf || abuf->detached)
+    return;
+  if (abuf->free_func)
+    abuf->free_func(ctx->rt, abuf->opaque, abuf->data);
+  js_array_buffer_detach(abuf);
+}
+
+void JS_FreeTransferredArrayBuffer(JSRuntime* rt, void* opaque, void* ptr) {
+  js_def_free_untracked(ptr);
+}
+
+/* Detach the ArrayBuffer and return its data, which no longer belongs to
+   the runtime. Pass it to JS_NewArrayBuffer() with
+   JS_FreeTransferredArrayBuffer() in this or another runtime. The data is
+   moved without copying when it was allocated by the default allocator. */
+uint8_t* JS_TransferArrayBuffer(JSContext* ctx, size_t* psize, JSValueConst obj) {
+  JSArrayBuffer* abuf = js_get_array_buffer(ctx, obj);
+  uint8_t* data;
+
+  if (!abuf)
+    return NULL;
+  if (abuf->detached) {
+    JS_ThrowTypeErrorDetachedArrayBuffer(ctx);
+    return NULL;
+  }
+  if (abuf->shared) {
+    JS_ThrowTypeError(ctx, "SharedArrayBuffer cannot be transferred");
+    return NULL;
+  }
+  if (abuf->free_func == js_array_buffer_free && ctx->rt->mf.js_free == js_def_free) {
+    js_def_untrack(&ctx->rt->malloc_state, abuf->data);
+    data = abuf->data;
+  } else if (abuf->free_func == JS_FreeTransferredArrayBuffer) {
+    data = abuf->data;
+  } else {
+    data = js_def_malloc_untracked(max_int(abuf->byte_length, 1));
+    if (!data) {
+      JS_ThrowOutOfMemory(ctx);
+      return NULL;
+    }
+    memcpy(data, abuf->data, abuf->byte_length);
+    if (abuf->free_func)
+      abuf->free_func(ctx->rt, abuf->opaque, abuf->data);
+  }
+  *psize = abuf->byte_length;
+  js_array_buffer_detach(abuf);
+  return data;
+}
+
 /* get an ArrayBuffer or SharedArrayBuffer */
 JSArrayBuffer* js_get_array_buffer(JSContext* ctx, JSValueConst obj) {
   JSObject* p;
@@ -1997,6 +2045,41 @@ JSValue js_dataview_constructor(JSContext* ctx, JSValueConst new_target, int arg
   return obj;
 }
 
+JSValue JS_NewArrayBufferView(JSContext* ctx, JSClassID class_id, JSValueConst buffer, uint64_t byte_offset, uint64_t length) {
+  JSValue args[3];
+  JSValue obj;
+
+  if (class_id != JS_CLASS_DATAVIEW && !(class_id >= JS_CLASS_UINT8C_ARRAY && class_id <= JS_CLASS_FLOAT64_ARRAY))
+    return JS_ThrowTypeError(ctx, "not an ArrayBuffer view class");
+  args[0] = buffer;
+  args[1] = JS_NewInt64(ctx, byte_offset);
+  args[2] = JS_NewInt64(ctx, length);
+  if (class_id == JS_CLASS_DATAVIEW)
+    obj = js_dataview_constructor(ctx, JS_UNDEFINED, 3, args);
+  else
+    obj = js_typed_array_constructor(ctx, JS_UNDEFINED, 3, args, class_id);
+  JS_FreeValue(ctx, args[1]);
+  JS_FreeValue(ctx, args[2]);
+  return obj;
+}
+
+JSValue JS_GetArrayBufferViewBuffer(JSContext* ctx, JSValueConst obj, size_t* pbyte_offset, size_t* pbyte_length) {
+  JSObject* p;
+  JSTypedArray* ta;
+
+  if (JS_VALUE_GET_TAG(obj) != JS_TAG_OBJECT || JS_VALUE_GET_OBJ(obj)->class_id != JS_CLASS_DATAVIEW)
+    return JS_GetTypedArrayBuffer(ctx, obj, pbyte_offset, pbyte_length, NULL);
+  p = JS_VALUE_GET_OBJ(obj);
+  if (typed_array_is_detached(ctx, p))
+    return JS_ThrowTypeErrorDetachedArrayBuffer(ctx);
+  ta = p->u.typed_array;
+  if (pbyte_offset)
+    *pbyte_offset = ta->offset;
+  if (pbyte_length)
+    *pbyte_length = ta->length;
+  return JS_DupValue(ctx, JS_MKPTR(JS_TAG_OBJECT, ta->buffer));
+}
+
 JSValue js_dataview_getValue(JSContext* ctx, JSValueConst this_obj, int argc, JSValueConst* argv, int class_id) {
   JSTypedArray* ta;
   JSArrayBuffer* abuf;
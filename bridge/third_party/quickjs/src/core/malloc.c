@@ -222,6 +222,31 @@ void js_def_free(JSMallocState* s, void* ptr) {
 #endif
 }
 
+/* memory which doesn't belong to any runtime, released with
+   js_def_free_untracked() */
+void* js_def_malloc_untracked(size_t size) {
+#if ENABLE_MI_MALLOC
+  return mi_malloc(size);
+#else
+  return malloc(size);
+#endif
+}
+
+/* stop counting 'ptr' allocated by js_def_malloc(), it must be released
+   with js_def_free_untracked() */
+void js_def_untrack(JSMallocState* s, void* ptr) {
+  s->malloc_count--;
+  s->malloc_size -= js_def_malloc_usable_size(ptr) + MALLOC_OVERHEAD;
+}
+
+void js_def_free_untracked(void* ptr) {
+#if ENABLE_MI_MALLOC
+  mi_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+
 void* js_def_realloc(JSMallocState* s, void* ptr, size_t size) {
   size_t old_size;
 
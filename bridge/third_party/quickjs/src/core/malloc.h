@@ -52,6 +52,9 @@ static inline void js_dbuf_init(JSContext* ctx, DynBuf* s) {
 void* js_def_malloc(JSMallocState* s, size_t size);
 void js_def_free(JSMallocState* s, void* ptr);
 void* js_def_realloc(JSMallocState* s, void* ptr, size_t size);
+void* js_def_malloc_untracked(size_t size);
+void js_def_untrack(JSMallocState* s, void* ptr);
+void js_def_free_untracked(void* ptr);
 size_t js_malloc_usable_size_unknown(const void* ptr);
 
 
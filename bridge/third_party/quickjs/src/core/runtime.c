@@ -1769,6 +1769,29 @@ static const char* const native_error_name[JS_NATIVE_ERROR_COUNT] = {
     "EvalError", "RangeError", "ReferenceError", "SyntaxError", "TypeError", "URIError", "InternalError", "AggregateError",
 };
 
+JSValue JS_NewNativeError(JSContext* ctx, const char* name, JSValueConst message) {
+  JSValueConst proto = ctx->class_proto[JS_CLASS_ERROR];
+  JSValue obj, msg;
+  int i;
+
+  for (i = 0; i < JS_NATIVE_ERROR_COUNT; i++) {
+    if (strcmp(name, native_error_name[i]) == 0) {
+      proto = ctx->native_error_proto[i];
+      break;
+    }
+  }
+  msg = JS_ToString(ctx, message);
+  if (JS_IsException(msg))
+    return msg;
+  obj = JS_NewObjectProtoClass(ctx, proto, JS_CLASS_ERROR);
+  if (JS_IsException(obj)) {
+    JS_FreeValue(ctx, msg);
+    return obj;
+  }
+  JS_DefinePropertyValue(ctx, obj, JS_ATOM_message, msg, JS_PROP_WRITABLE | JS_PROP_CONFIGURABLE);
+  return obj;
+}
+
 /* URI handling */
 
 int string_get_hex(JSString* p, int k, int n) {
@@ -9,7 +9,11 @@
 
 #include "bindings/qjs/native_string_utils.h"
 #include "core/dart_isolate_context.h"
+#include "core/dom/element_layout_metrics.h"
+#include "core/html/custom/widget_element.h"
 #include "core/page.h"
+#include "core/script_compiler.h"
+#include "core/workers/worker_global_scope.h"
 #include "foundation/logging.h"
 #include "foundation/ui_command_buffer.h"
 #include "include/webf_bridge.h"
@@ -37,12 +41,34 @@
 #define SYSTEM_NAME "unknown"
 #endif
 
-void* initDartIsolateContext(uint64_t* dart_methods, int32_t dart_methods_len) {
-  void* ptr = new webf::DartIsolateContext(dart_methods, dart_methods_len);
+void* initDartIsolateContext(uint64_t* dart_methods,
+                             int32_t dart_methods_len,
+                             int64_t js_thread_port,
+                             int32_t js_thread_count) {
+  void* ptr = new webf::DartIsolateContext(dart_methods, dart_methods_len, js_thread_port, js_thread_count);
   return ptr;
 }
 
-void* allocateNewPage(void* dart_isolate_context, int32_t targetContextId) {
+void flushDartThreadTasks(void* dart_isolate_context) {
+  webf::JSThreadDispatcher* dispatcher = ((webf::DartIsolateContext*)dart_isolate_context)->dispatcher();
+  if (dispatcher != nullptr) {
+    dispatcher->FlushDartTasks();
+  }
+}
+
+// When JS runs on dedicated threads, the functions below are called on the dart thread and forwarded to the JS thread
+// of the page. The ones returning a value to dart side wait for the JS thread, the others are posted in order.
+
+static int64_t PageContextId(void* page) {
+  return reinterpret_cast<webf::WebFPage*>(page)->contextId;
+}
+
+void* allocateNewPage(void* dart_isolate_context, int32_t targetContextId, int32_t js_thread_group) {
+  if (auto* dispatcher = webf::JSThreadDispatcher::FromDartThread()) {
+    dispatcher->AssignJSThread(targetContextId, js_thread_group);
+    return dispatcher->PostToJSSync<void*>(
+        targetContextId, [=]() { return allocateNewPage(dart_isolate_context, targetContextId, js_thread_group); });
+  }
   assert(dart_isolate_context != nullptr);
   auto page =
       std::make_unique<webf::WebFPage>((webf::DartIsolateContext*)dart_isolate_context, targetContextId, nullptr);
@@ -52,6 +78,16 @@ void* allocateNewPage(void* dart_isolate_context, int32_t targetContextId) {
 }
 
 void disposePage(void* dart_isolate_context, void* page_) {
+  if (auto* dispatcher = webf::JSThreadDispatcher::FromDartThread()) {
+    int64_t context_id = PageContextId(page_);
+    // The thread is released once the page is gone, a page reusing the id until then is placed on the same thread,
+    // after the teardown.
+    dispatcher->PostToJS(context_id, [=]() {
+      disposePage(dart_isolate_context, page_);
+      dispatcher->ReleaseJSThread(context_id);
+    });
+    return;
+  }
   auto* page = reinterpret_cast<webf::WebFPage*>(page_);
   assert(std::this_thread::get_id() == page->currentThread());
   ((webf::DartIsolateContext*)dart_isolate_context)->RemovePage(page);
@@ -63,6 +99,11 @@ int8_t evaluateScripts(void* page_,
                        uint64_t* bytecode_len,
                        const char* bundleFilename,
                        int32_t startLine) {
+  if (auto* dispatcher = webf::JSThreadDispatcher::FromDartThread()) {
+    return dispatcher->PostToJSSync<int8_t>(PageContextId(page_), [=]() {
+      return evaluateScripts(page_, code, parsed_bytecodes, bytecode_len, bundleFilename, startLine);
+    });
+  }
   auto page = reinterpret_cast<webf::WebFPage*>(page_);
   assert(std::this_thread::get_id() == page->currentThread());
   return page->evaluateScript(reinterpret_cast<webf::SharedNativeString*>(code), parsed_bytecodes, bytecode_len,
@@ -72,12 +113,48 @@ int8_t evaluateScripts(void* page_,
 }
 
 int8_t evaluateQuickjsByteCode(void* page_, uint8_t* bytes, int32_t byteLen) {
+  if (auto* dispatcher = webf::JSThreadDispatcher::FromDartThread()) {
+    return dispatcher->PostToJSSync<int8_t>(PageContextId(page_),
+                                            [=]() { return evaluateQuickjsByteCode(page_, bytes, byteLen); });
+  }
   auto page = reinterpret_cast<webf::WebFPage*>(page_);
   assert(std::this_thread::get_id() == page->currentThread());
   return page->evaluateByteCode(bytes, byteLen) ? 1 : 0;
 }
 
+void* compileScript(SharedNativeString* code, const char* bundleFilename) {
+  auto* native_code = reinterpret_cast<webf::SharedNativeString*>(code);
+  std::u16string source(reinterpret_cast<const char16_t*>(native_code->string()), native_code->length());
+  return new std::shared_ptr<webf::CompiledScript>(
+      webf::ScriptCompiler::Shared()->Compile(std::move(source), bundleFilename));
+}
+
+int8_t evaluateCompiledScript(void* page_, void* script, uint8_t** parsed_bytecodes, uint64_t* bytecode_len) {
+  // Freed on the calling thread once the page is done with it.
+  std::unique_ptr<std::shared_ptr<webf::CompiledScript>> compiled_script(
+      reinterpret_cast<std::shared_ptr<webf::CompiledScript>*>(script));
+  webf::CompiledScript* compiled = compiled_script->get();
+  auto evaluate = [=]() -> int8_t {
+    auto page = reinterpret_cast<webf::WebFPage*>(page_);
+    assert(std::this_thread::get_id() == page->currentThread());
+    return page->evaluateCompiledScript(compiled, parsed_bytecodes, bytecode_len) ? 1 : 0;
+  };
+  if (auto* dispatcher = webf::JSThreadDispatcher::FromDartThread()) {
+    return dispatcher->PostToJSSync<int8_t>(PageContextId(page_), evaluate);
+  }
+  return evaluate();
+}
+
+void disposeCompiledScript(void* script) {
+  delete reinterpret_cast<std::shared_ptr<webf::CompiledScript>*>(script);
+}
+
 void parseHTML(void* page_, const char* code, int32_t length) {
+  // The code is freed by dart side after the call.
+  if (auto* dispatcher = webf::JSThreadDispatcher::FromDartThread()) {
+    dispatcher->PostToJSSync<void>(PageContextId(page_), [=]() { parseHTML(page_, code, length); });
+    return;
+  }
   auto page = reinterpret_cast<webf::WebFPage*>(page_);
   assert(std::this_thread::get_id() == page->currentThread());
   page->parseHTML(code, length);
@@ -88,6 +165,10 @@ NativeValue* invokeModuleEvent(void* page_,
                                const char* eventType,
                                void* event,
                                NativeValue* extra) {
+  if (auto* dispatcher = webf::JSThreadDispatcher::FromDartThread()) {
+    return dispatcher->PostToJSSync<NativeValue*>(
+        PageContextId(page_), [=]() { return invokeModuleEvent(page_, module_name, eventType, event, extra); });
+  }
   auto page = reinterpret_cast<webf::WebFPage*>(page_);
   assert(std::this_thread::get_id() == page->currentThread());
   auto* result = page->invokeModuleEvent(reinterpret_cast<webf::SharedNativeString*>(module_name), eventType, event,
@@ -110,27 +191,55 @@ WebFInfo* getWebFInfo() {
 }
 
 void dispatchUITask(void* page_, void* context, void* callback) {
+  if (auto* dispatcher = webf::JSThreadDispatcher::FromDartThread()) {
+    dispatcher->PostToJS(PageContextId(page_), [=]() { dispatchUITask(page_, context, callback); });
+    return;
+  }
   auto page = reinterpret_cast<webf::WebFPage*>(page_);
   assert(std::this_thread::get_id() == page->currentThread());
   reinterpret_cast<void (*)(void*)>(callback)(context);
 }
 
-void* getUICommandItems(void* page_) {
+void* acquireUICommandItems(void* page_, int64_t* length) {
+  if (auto* dispatcher = webf::JSThreadDispatcher::FromDartThread()) {
+    return dispatcher->PostToJSSync<void*>(PageContextId(page_),
+                                           [=]() { return acquireUICommandItems(page_, length); });
+  }
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  assert(std::this_thread::get_id() == page->currentThread());
+  webf::UICommandBatch* batch = page->GetExecutingContext()->uiCommandBuffer()->acquire();
+  *length = batch->size();
+  return batch->data();
+}
+
+void releaseUICommandItems(void* page_) {
+  if (auto* dispatcher = webf::JSThreadDispatcher::FromDartThread()) {
+    // Nestable like acquireUICommandItems, so a release never falls behind the next acquire.
+    dispatcher->PostToJSSync<void>(PageContextId(page_), [=]() { releaseUICommandItems(page_); });
+    return;
+  }
   auto page = reinterpret_cast<webf::WebFPage*>(page_);
   assert(std::this_thread::get_id() == page->currentThread());
-  return page->GetExecutingContext()->uiCommandBuffer()->data();
+  page->GetExecutingContext()->uiCommandBuffer()->release();
 }
 
-int64_t getUICommandItemSize(void* page_) {
+void setUICommandCoalescingEnabled(void* page_, int8_t enabled) {
+  if (auto* dispatcher = webf::JSThreadDispatcher::FromDartThread()) {
+    dispatcher->PostToJS(PageContextId(page_), [=]() { setUICommandCoalescingEnabled(page_, enabled); });
+    return;
+  }
   auto page = reinterpret_cast<webf::WebFPage*>(page_);
   assert(std::this_thread::get_id() == page->currentThread());
-  return page->GetExecutingContext()->uiCommandBuffer()->size();
+  page->GetExecutingContext()->uiCommandBuffer()->SetCoalescingEnabled(enabled == 1);
 }
 
-void clearUICommandItems(void* page_) {
+void* getUICommandCoalescingStats(void* page_) {
+  if (auto* dispatcher = webf::JSThreadDispatcher::FromDartThread()) {
+    return dispatcher->PostToJSSync<void*>(PageContextId(page_), [=]() { return getUICommandCoalescingStats(page_); });
+  }
   auto page = reinterpret_cast<webf::WebFPage*>(page_);
   assert(std::this_thread::get_id() == page->currentThread());
-  page->GetExecutingContext()->uiCommandBuffer()->clear();
+  return (void*)&page->GetExecutingContext()->uiCommandBuffer()->coalescingStats();
 }
 
 void registerPluginByteCode(uint8_t* bytes, int32_t length, const char* pluginName) {
@@ -141,6 +250,14 @@ void registerPluginCode(const char* code, int32_t length, const char* pluginName
   webf::ExecutingContext::plugin_string_code[pluginName] = std::string(code, length);
 }
 
+void registerWorkerByteCode(uint8_t* bytes, int32_t length, const char* scriptURL) {
+  webf::WorkerGlobalScope::RegisterScript(scriptURL, bytes, length);
+}
+
+void registerWorkerCode(const char* code, int32_t length, const char* scriptURL) {
+  webf::WorkerGlobalScope::RegisterScript(scriptURL, std::string(code, length));
+}
+
 int32_t profileModeEnabled() {
 #if ENABLE_PROFILE
   return 1;
@@ -149,6 +266,78 @@ int32_t profileModeEnabled() {
 #endif
 }
 
+void setUICommandStatsEnabled(void* page_, int8_t enabled) {
+  if (auto* dispatcher = webf::JSThreadDispatcher::FromDartThread()) {
+    dispatcher->PostToJS(PageContextId(page_), [=]() { setUICommandStatsEnabled(page_, enabled); });
+    return;
+  }
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  assert(std::this_thread::get_id() == page->currentThread());
+  page->GetExecutingContext()->uiCommandBuffer()->SetStatsEnabled(enabled == 1);
+}
+
+void* getUICommandStats(void* page_) {
+  if (auto* dispatcher = webf::JSThreadDispatcher::FromDartThread()) {
+    return dispatcher->PostToJSSync<void*>(PageContextId(page_), [=]() { return getUICommandStats(page_); });
+  }
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  assert(std::this_thread::get_id() == page->currentThread());
+  return (void*)&page->GetExecutingContext()->uiCommandBuffer()->stats();
+}
+
+int32_t getUICommandTypeCount() {
+  return webf::kUICommandTypeCount;
+}
+
+int32_t getUICommandFlushReasonCount() {
+  return webf::kUICommandFlushReasonCount;
+}
+
+void setLayoutThrashingThreshold(void* page_, int32_t threshold) {
+  if (auto* dispatcher = webf::JSThreadDispatcher::FromDartThread()) {
+    dispatcher->PostToJS(PageContextId(page_), [=]() { setLayoutThrashingThreshold(page_, threshold); });
+    return;
+  }
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  assert(std::this_thread::get_id() == page->currentThread());
+  page->GetExecutingContext()->layoutThrashingDetector()->SetThreshold(threshold);
+}
+
+void updateLayoutMetrics(void* page_, void* metrics, int32_t length) {
+  // The metrics are freed by dart side after the call.
+  if (auto* dispatcher = webf::JSThreadDispatcher::FromDartThread()) {
+    dispatcher->PostToJSSync<void>(PageContextId(page_), [=]() { updateLayoutMetrics(page_, metrics, length); });
+    return;
+  }
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  assert(std::this_thread::get_id() == page->currentThread());
+  webf::UpdateLayoutMetricsFromDart(page->GetExecutingContext(),
+                                    reinterpret_cast<const webf::NativeLayoutMetrics*>(metrics), length);
+}
+
+void invalidateLayoutMetrics(void* page_) {
+  if (auto* dispatcher = webf::JSThreadDispatcher::FromDartThread()) {
+    dispatcher->PostToJS(PageContextId(page_), [=]() { invalidateLayoutMetrics(page_); });
+    return;
+  }
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  assert(std::this_thread::get_id() == page->currentThread());
+  page->GetExecutingContext()->uiCommandBuffer()->InvalidateLayout();
+}
+
+void registerWidgetElementShape(void* page_, SharedNativeString* tag_name, int32_t argc, NativeValue* argv) {
+  if (auto* dispatcher = webf::JSThreadDispatcher::FromDartThread()) {
+    dispatcher->PostToJSSync<void>(PageContextId(page_),
+                                   [=]() { registerWidgetElementShape(page_, tag_name, argc, argv); });
+    return;
+  }
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  assert(std::this_thread::get_id() == page->currentThread());
+  webf::RegisterWidgetElementShapeFromDart(page->GetExecutingContext(),
+                                           reinterpret_cast<webf::SharedNativeString*>(tag_name), argc,
+                                           reinterpret_cast<webf::NativeValue*>(argv));
+}
+
 // Callbacks when dart context object was finalized by Dart GC.
 static void finalize_dart_context(void* isolate_callback_data, void* peer) {
   auto* dart_isolate_context = (webf::DartIsolateContext*)peer;
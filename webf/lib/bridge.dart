@@ -5,6 +5,7 @@
 
 export 'src/bridge/bridge.dart';
 export 'src/bridge/binding.dart';
+export 'src/bridge/binding_call_methods.dart';
 export 'src/bridge/dynamic_library.dart';
 export 'src/bridge/to_native.dart';
 export 'src/bridge/from_native.dart';
@@ -1,7 +0,0 @@
-/*
- * Copyright (C) 2019-2022 The Kraken authors. All rights reserved.
- * Copyright (C) 2022-present The WebF authors. All rights reserved.
- */
-
-export 'src/geometry/dom_matrix.dart';
-export 'src/geometry/dom_matrix_readonly.dart';
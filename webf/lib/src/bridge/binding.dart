@@ -11,7 +11,6 @@ import 'dart:ffi';
 import 'package:ffi/ffi.dart';
 import 'package:webf/bridge.dart';
 import 'package:webf/dom.dart';
-import 'package:webf/geometry.dart';
 import 'package:webf/foundation.dart';
 
 // We have some integrated built-in behavior starting with string prefix reuse the callNativeMethod implements.
@@ -21,6 +20,22 @@ enum BindingMethodCallOperations {
   GetAllPropertyNames,
   AnonymousFunctionCall,
   AsyncAnonymousFunction,
+  GetProperties,
+  AsyncAnonymousFunctionBatch,
+}
+
+// The names in binding_call_methods.json5 are exchanged with C++ side as their positions plus the offset, which
+// keeps them apart from BindingMethodCallOperations. Must be the same as kBindingCallMethodIdOffset at C++ side.
+const int bindingCallMethodIdOffset = 1 << 16;
+
+int bindingCallMethodId(int name) => bindingCallMethodIdOffset + name;
+
+// Returns the name of a method or property sent by C++ side, names not in binding_call_methods.json5 are sent as strings.
+dynamic bindingCallMethodName(dynamic value) {
+  if (value is int && value >= bindingCallMethodIdOffset) {
+    return bindingCallMethodsNames[value - bindingCallMethodIdOffset];
+  }
+  return value;
 }
 
 typedef NativeAsyncAnonymousFunctionCallback = Void Function(
@@ -35,7 +50,9 @@ List<BindingCallFunc> bindingCallMethodDispatchTable = [
   setterBindingCall,
   getPropertyNamesBindingCall,
   invokeBindingMethodSync,
-  invokeBindingMethodAsync
+  invokeBindingMethodAsync,
+  gettersBindingCall,
+  invokeBindingMethodsAsyncBatch,
 ];
 
 // Dispatch the event to the binding side.
@@ -62,7 +79,7 @@ void _dispatchEventToNative(Event event, bool isCapture) {
     }
 
     Pointer<NativeValue> method = malloc.allocate(sizeOf<NativeValue>());
-    toNativeValue(method, 'dispatchEvent');
+    toNativeValue(method, bindingCallMethodId(BindingCallMethods.kdispatchEvent));
     Pointer<NativeValue> allocatedNativeArguments = makeNativeValueArguments(bindingObject, dispatchEventArguments);
 
     Pointer<NativeValue> returnValue = malloc.allocate(sizeOf<NativeValue>());
@@ -88,10 +105,6 @@ void _dispatchEventToNative(Event event, bool isCapture) {
   }
 }
 
-enum CreateBindingObjectType {
-  createDOMMatrix
-}
-
 abstract class BindingBridge {
   static final Pointer<NativeFunction<InvokeBindingsMethodsFromNative>> _invokeBindingMethodFromNative =
       Pointer.fromFunction(invokeBindingMethodFromNativeImpl);
@@ -108,19 +121,6 @@ abstract class BindingBridge {
     return _nativeObjects.containsKey(pointer.address);
   }
 
-  static void createBindingObject(int contextId, Pointer<NativeBindingObject> pointer, CreateBindingObjectType type, Pointer<NativeValue> args, int argc) {
-    List<dynamic> arguments = List.generate(argc, (index) {
-      return fromNativeValue(args.elementAt(index));
-    });
-    switch(type) {
-      case CreateBindingObjectType.createDOMMatrix: {
-        DOMMatrix domMatrix = DOMMatrix(BindingContext(contextId, pointer), arguments);
-        _nativeObjects[pointer.address] = domMatrix;
-        return;
-      }
-    }
-  }
-
   static void _bindObject(BindingObject object) {
     Pointer<NativeBindingObject>? nativeBindingObject = object.pointer;
     if (nativeBindingObject != null) {
@@ -149,15 +149,13 @@ abstract class BindingBridge {
     BindingObject.unbind = null;
   }
 
-  static void listenEvent(EventTarget target, String type, {Pointer<AddEventListenerOptions>? addEventListenerOptions}) {
-    bool isCapture = addEventListenerOptions != null ? addEventListenerOptions.ref.capture : false;
+  static void listenEvent(EventTarget target, String type, {EventListenerOptions? eventListenerOptions}) {
+    bool isCapture = eventListenerOptions != null ? eventListenerOptions.capture : false;
     if (!hasListener(target, type, isCapture: isCapture)) {
-      EventListenerOptions? eventListenerOptions;
-      if (addEventListenerOptions != null && addEventListenerOptions.ref.capture) {
-        eventListenerOptions = EventListenerOptions(addEventListenerOptions.ref.capture, addEventListenerOptions.ref.passive, addEventListenerOptions.ref.once);
+      if (isCapture) {
         target.addEventListener(type, _dispatchCaptureEventToNative, addEventListenerOptions: eventListenerOptions);
       } else
-        target.addEventListener(type, _dispatchNomalEventToNative, addEventListenerOptions: eventListenerOptions);
+        target.addEventListener(type, _dispatchNomalEventToNative);
     }
   }
 
@@ -0,0 +1,357 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+// Generated from template:
+//   code_generator/templates/json_templates/make_names.dart.tpl
+// and input files:
+//   bridge/core/binding_call_methods.json5
+// Do not edit, run the code generator after changing the input file.
+// The ids of the names, which are their positions in the input file and are shared with C++ side.
+abstract class BindingCallMethods {
+  static const int kclick = 0;
+  static const int kscroll = 1;
+  static const int kscrollBy = 2;
+  static const int kclientTop = 3;
+  static const int kclientLeft = 4;
+  static const int kclientWidth = 5;
+  static const int kclientHeight = 6;
+  static const int kscrollLeft = 7;
+  static const int kscrollTop = 8;
+  static const int koffsetTop = 9;
+  static const int koffsetLeft = 10;
+  static const int koffsetWidth = 11;
+  static const int koffsetHeight = 12;
+  static const int kscrollWidth = 13;
+  static const int kscrollHeight = 14;
+  static const int kgetBoundingClientRect = 15;
+  static const int kgetLayoutMetrics = 16;
+  static const int kgetPropertyMagic = 17;
+  static const int ksetPropertyMagic = 18;
+  static const int kopen = 19;
+  static const int kdevicePixelRatio = 20;
+  static const int kcolorScheme = 21;
+  static const int kscrollX = 22;
+  static const int kscrollY = 23;
+  static const int kinnerWidth = 24;
+  static const int kinnerHeight = 25;
+  static const int kavailWidth = 26;
+  static const int kavailHeight = 27;
+  static const int kwidth = 28;
+  static const int kheight = 29;
+  static const int ktop = 30;
+  static const int kbottom = 31;
+  static const int kleft = 32;
+  static const int kright = 33;
+  static const int kx = 34;
+  static const int ky = 35;
+  static const int kz = 36;
+  static const int kscreen = 37;
+  static const int ktarget = 38;
+  static const int kaccessKey = 39;
+  static const int kdownload = 40;
+  static const int kping = 41;
+  static const int krel = 42;
+  static const int ktype = 43;
+  static const int ktext = 44;
+  static const int khref = 45;
+  static const int korigin = 46;
+  static const int kprotocol = 47;
+  static const int kusername = 48;
+  static const int kpassword = 49;
+  static const int khost = 50;
+  static const int khostname = 51;
+  static const int kport = 52;
+  static const int kpathname = 53;
+  static const int ksearch = 54;
+  static const int khash = 55;
+  static const int kalt = 56;
+  static const int ksrc = 57;
+  static const int ksrcset = 58;
+  static const int ksizes = 59;
+  static const int knaturalWidth = 60;
+  static const int knaturalHeight = 61;
+  static const int kcomplete = 62;
+  static const int kcurrentSrc = 63;
+  static const int kdecoding = 64;
+  static const int kfetchPriority = 65;
+  static const int kloading = 66;
+  static const int knoModule = 67;
+  static const int kasync = 68;
+  static const int kgetContext = 69;
+  static const int kfillStyle = 70;
+  static const int kdirection = 71;
+  static const int kfont = 72;
+  static const int kstrokeStyle = 73;
+  static const int klineCap = 74;
+  static const int klineDashOffset = 75;
+  static const int klineJoin = 76;
+  static const int klineWidth = 77;
+  static const int kmiterLimit = 78;
+  static const int ktextAlign = 79;
+  static const int ktextBaseline = 80;
+  static const int karc = 81;
+  static const int karcTo = 82;
+  static const int kbeginPath = 83;
+  static const int kbezierCurveTo = 84;
+  static const int kclearRect = 85;
+  static const int kclosePath = 86;
+  static const int kclip = 87;
+  static const int kdrawImage = 88;
+  static const int kellipse = 89;
+  static const int kfill = 90;
+  static const int kfillRect = 91;
+  static const int kfillText = 92;
+  static const int klineTo = 93;
+  static const int kmoveTo = 94;
+  static const int krect = 95;
+  static const int krestore = 96;
+  static const int kresetTransform = 97;
+  static const int krotate = 98;
+  static const int kquadraticCurveTo = 99;
+  static const int kstroke = 100;
+  static const int kstrokeRect = 101;
+  static const int ksave = 102;
+  static const int kscale = 103;
+  static const int kstrokeText = 104;
+  static const int ksetTransform = 105;
+  static const int ktransform = 106;
+  static const int ktranslate = 107;
+  static const int kreset = 108;
+  static const int kfocus = 109;
+  static const int kblur = 110;
+  static const int kdefaultValue = 111;
+  static const int kvalue = 112;
+  static const int kaccept = 113;
+  static const int kautocomplete = 114;
+  static const int kautofocus = 115;
+  static const int kchecked = 116;
+  static const int kdisabled = 117;
+  static const int kmin = 118;
+  static const int kmax = 119;
+  static const int kminLength = 120;
+  static const int kmaxLength = 121;
+  static const int ksize = 122;
+  static const int kmultiple = 123;
+  static const int kname = 124;
+  static const int kstep = 125;
+  static const int kpattern = 126;
+  static const int krequired = 127;
+  static const int kreadonly = 128;
+  static const int kplaceholder = 129;
+  static const int kinputMode = 130;
+  static const int kcols = 131;
+  static const int krows = 132;
+  static const int kwrap = 133;
+  static const int kdispatchEvent = 134;
+  static const int kgetModifierState = 135;
+  static const int kquerySelector = 136;
+  static const int kquerySelectorAll = 137;
+  static const int kgetElementById = 138;
+  static const int kgetElementsByClassName = 139;
+  static const int kgetElementsByName = 140;
+  static const int kgetElementsByTagName = 141;
+  static const int kid = 142;
+  static const int kclassName = 143;
+  static const int kcookie = 144;
+  static const int kclass = 145;
+  static const int ksyncPropertiesAndMethods = 146;
+  static const int k___clear_cookies__ = 147;
+  static const int kgetComputedStyle = 148;
+  static const int kgetPropertyValue = 149;
+  static const int ksetProperty = 150;
+  static const int kcheckCSSProperty = 151;
+  static const int kgetFullCSSPropertyList = 152;
+  static const int kremoveProperty = 153;
+  static const int kcssText = 154;
+  static const int klength = 155;
+  static const int kaddColorStop = 156;
+  static const int kcreateLinearGradient = 157;
+  static const int kcreateRadialGradient = 158;
+  static const int kcreatePattern = 159;
+  static const int kdomain = 160;
+  static const int kcompatMode = 161;
+  static const int kreadyState = 162;
+  static const int kvisibilityState = 163;
+  static const int khidden = 164;
+  static const int kmatches = 165;
+  static const int kclosest = 166;
+  static const int kelementFromPoint = 167;
+  static const int kdir = 168;
+  static const int kpageXOffset = 169;
+  static const int kpageYOffset = 170;
+  static const int kgetPropertyValues = 171;
+}
+const List<String> bindingCallMethodsNames = [
+  'click',
+  'scroll',
+  'scrollBy',
+  'clientTop',
+  'clientLeft',
+  'clientWidth',
+  'clientHeight',
+  'scrollLeft',
+  'scrollTop',
+  'offsetTop',
+  'offsetLeft',
+  'offsetWidth',
+  'offsetHeight',
+  'scrollWidth',
+  'scrollHeight',
+  'getBoundingClientRect',
+  'getLayoutMetrics',
+  '%g',
+  '%s',
+  'open',
+  'devicePixelRatio',
+  'colorScheme',
+  'scrollX',
+  'scrollY',
+  'innerWidth',
+  'innerHeight',
+  'availWidth',
+  'availHeight',
+  'width',
+  'height',
+  'top',
+  'bottom',
+  'left',
+  'right',
+  'x',
+  'y',
+  'z',
+  'screen',
+  'target',
+  'accessKey',
+  'download',
+  'ping',
+  'rel',
+  'type',
+  'text',
+  'href',
+  'origin',
+  'protocol',
+  'username',
+  'password',
+  'host',
+  'hostname',
+  'port',
+  'pathname',
+  'search',
+  'hash',
+  'alt',
+  'src',
+  'srcset',
+  'sizes',
+  'naturalWidth',
+  'naturalHeight',
+  'complete',
+  'currentSrc',
+  'decoding',
+  'fetchPriority',
+  'loading',
+  'noModule',
+  'async',
+  'getContext',
+  'fillStyle',
+  'direction',
+  'font',
+  'strokeStyle',
+  'lineCap',
+  'lineDashOffset',
+  'lineJoin',
+  'lineWidth',
+  'miterLimit',
+  'textAlign',
+  'textBaseline',
+  'arc',
+  'arcTo',
+  'beginPath',
+  'bezierCurveTo',
+  'clearRect',
+  'closePath',
+  'clip',
+  'drawImage',
+  'ellipse',
+  'fill',
+  'fillRect',
+  'fillText',
+  'lineTo',
+  'moveTo',
+  'rect',
+  'restore',
+  'resetTransform',
+  'rotate',
+  'quadraticCurveTo',
+  'stroke',
+  'strokeRect',
+  'save',
+  'scale',
+  'strokeText',
+  'setTransform',
+  'transform',
+  'translate',
+  'reset',
+  'focus',
+  'blur',
+  'defaultValue',
+  'value',
+  'accept',
+  'autocomplete',
+  'autofocus',
+  'checked',
+  'disabled',
+  'min',
+  'max',
+  'minLength',
+  'maxLength',
+  'size',
+  'multiple',
+  'name',
+  'step',
+  'pattern',
+  'required',
+  'readonly',
+  'placeholder',
+  'inputMode',
+  'cols',
+  'rows',
+  'wrap',
+  'dispatchEvent',
+  'getModifierState',
+  'querySelector',
+  'querySelectorAll',
+  'getElementById',
+  'getElementsByClassName',
+  'getElementsByName',
+  'getElementsByTagName',
+  'id',
+  'className',
+  'cookie',
+  'class',
+  'syncPropertiesAndMethods',
+  '___clear_cookies__',
+  'getComputedStyle',
+  'getPropertyValue',
+  'setProperty',
+  'checkCSSProperty',
+  'getFullCSSPropertyList',
+  'removeProperty',
+  'cssText',
+  'length',
+  'addColorStop',
+  'createLinearGradient',
+  'createRadialGradient',
+  'createPattern',
+  'domain',
+  'compatMode',
+  'readyState',
+  'visibilityState',
+  'hidden',
+  'matches',
+  'closest',
+  'elementFromPoint',
+  'dir',
+  'pageXOffset',
+  'pageYOffset',
+  'getPropertyValues',
+];
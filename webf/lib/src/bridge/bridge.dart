@@ -4,6 +4,8 @@
  */
 
 import 'dart:ffi';
+import 'dart:isolate';
+import 'dart:math' as math;
 import 'package:webf/launcher.dart';
 
 import 'binding.dart';
@@ -16,12 +18,28 @@ int newContextId() {
   return ++_contextId;
 }
 
+/// Run JavaScript on a dedicated native thread instead of the flutter ui thread, so script evaluation and GC pauses
+/// of JavaScript don't block frames. Must be set before the first WebF widget is created.
+bool runJavaScriptOnDedicatedThread = false;
+
+/// The number of native threads running JavaScript when [runJavaScriptOnDedicatedThread] is set. Each thread has its
+/// own JavaScript runtime, pages are spread over the threads unless [WebFController.jsThreadGroup] puts them together.
+/// Must be set before the first WebF widget is created.
+int javaScriptThreadCount = 1;
+
 class DartContext {
-  DartContext() : pointer = initDartIsolateContext(makeDartMethodsData()) {
+  DartContext() {
     initDartDynamicLinking();
+    if (runJavaScriptOnDedicatedThread) {
+      // The JS thread notifies this port when its calls to dart side are waiting.
+      _jsThreadPort = RawReceivePort((_) => flushDartThreadTasks(pointer));
+    }
+    pointer = initDartIsolateContext(
+        makeDartMethodsData(), _jsThreadPort?.sendPort.nativePort ?? 0, math.max(javaScriptThreadCount, 1));
     registerDartContextFinalizer(this);
   }
-  final Pointer<Void> pointer;
+  late final Pointer<Void> pointer;
+  RawReceivePort? _jsThreadPort;
 }
 
 DartContext dartContext = DartContext();
@@ -32,7 +50,7 @@ int initBridge(WebFViewController view) {
   BindingBridge.setup();
 
   int pageId = newContextId();
-  allocateNewPage(pageId);
+  allocateNewPage(pageId, view.rootController.jsThreadGroup);
 
   return pageId;
 }
@@ -60,6 +60,39 @@ class AddEventListenerOptions extends Struct {
   external bool once;
 }
 
+// Must be in sync with LayoutMetric at native side.
+const int layoutMetricsCount = 16;
+
+class NativeLayoutMetrics extends Struct {
+  external Pointer<NativeBindingObject> bindingObject;
+
+  @Array(layoutMetricsCount)
+  external Array<Double> values;
+}
+
+class NativeUICommandCoalescingStats extends Struct {
+  @Int64()
+  external int batches;
+
+  @Int64()
+  external int inputCommands;
+
+  @Int64()
+  external int eliminatedCommands;
+
+  @Int64()
+  external int deadNodeCommands;
+
+  @Int64()
+  external int styleCommands;
+
+  @Int64()
+  external int attributeCommands;
+
+  @Int64()
+  external int eventCommands;
+}
+
 class NativeTouchList extends Struct {
   @Int64()
   external int length;
@@ -124,6 +157,9 @@ class NativeBindingObject extends Struct {
   external Pointer<NativeFunction<InvokeBindingMethodsFromDart>> invokeBindingMethodFromDart;
   // Shared method called by JS side.
   external Pointer<NativeFunction<InvokeBindingsMethodsFromNative>> invokeBindingMethodFromNative;
+  // Written by native side, the JS thread of the context runs the calls from dart side.
+  @Int64()
+  external int contextId;
 }
 
 Pointer<NativeBindingObject> allocateNewBindingObject() {
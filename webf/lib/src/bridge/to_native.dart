@@ -6,11 +6,13 @@
 import 'dart:collection';
 import 'dart:ffi';
 import 'dart:io';
+import 'dart:math' as math;
 import 'dart:typed_data';
 
 import 'package:ffi/ffi.dart';
 import 'package:flutter/foundation.dart';
 import 'package:flutter/scheduler.dart';
+import 'package:webf/dom.dart';
 import 'package:webf/webf.dart';
 
 // Steps for using dart:ffi to call a C function from Dart:
@@ -132,8 +134,73 @@ class ScriptByteCode {
   late Uint8List bytes;
 }
 
-Future<bool> evaluateScripts(int contextId, String code, {String? url, int line = 0}) async {
+// Register compileScript
+typedef NativeCompileScript = Pointer<Void> Function(Pointer<NativeString> code, Pointer<Utf8> url);
+typedef DartCompileScript = Pointer<Void> Function(Pointer<NativeString> code, Pointer<Utf8> url);
+
+final DartCompileScript _compileScript =
+    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeCompileScript>>('compileScript').asFunction();
+
+// Register evaluateCompiledScript
+typedef NativeEvaluateCompiledScript = Int8 Function(
+    Pointer<Void>, Pointer<Void> script, Pointer<Pointer<Uint8>> parsedBytecodes, Pointer<Uint64> bytecodeLen);
+typedef DartEvaluateCompiledScript = int Function(
+    Pointer<Void>, Pointer<Void> script, Pointer<Pointer<Uint8>> parsedBytecodes, Pointer<Uint64> bytecodeLen);
+
+final DartEvaluateCompiledScript _evaluateCompiledScript = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeEvaluateCompiledScript>>('evaluateCompiledScript')
+    .asFunction();
+
+// Register disposeCompiledScript
+typedef NativeDisposeCompiledScript = Void Function(Pointer<Void> script);
+typedef DartDisposeCompiledScript = void Function(Pointer<Void> script);
+
+final DartDisposeCompiledScript _disposeCompiledScript =
+    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeDisposeCompiledScript>>('disposeCompiledScript').asFunction();
+
+// A script being compiled to bytecode on a background thread, see compileScript().
+class CompiledScript {
+  CompiledScript._(this._pointer);
+  Pointer<Void>? _pointer;
+
+  // Hands the native script over, it is freed by the page once evaluated.
+  Pointer<Void> _take() {
+    Pointer<Void> pointer = _pointer!;
+    _pointer = null;
+    return pointer;
+  }
+
+  void dispose() {
+    if (_pointer != null) {
+      _disposeCompiledScript(_take());
+    }
+  }
+}
+
+// Starts compiling the code to bytecode on a background thread, so the parsing overlaps with loading the other
+// scripts. Pass the result to evaluateScripts() with the same code.
+CompiledScript compileScript(String code, {String? url}) {
+  Pointer<NativeString> nativeString = stringToNativeString(code);
+  Pointer<Utf8> _url = (url ?? '').toNativeUtf8();
+  Pointer<Void> script = _compileScript(nativeString, _url);
+  freeNativeString(nativeString);
+  malloc.free(_url);
+  return CompiledScript._(script);
+}
+
+// Like compileScript(), but skips the compiling when evaluateScripts() will run the cached bytecode of the code.
+Future<CompiledScript?> compileScriptUnlessCached(String code, {String? url}) async {
+  if (QuickJSByteCodeCacheObject.cacheMode == ByteCodeCacheMode.DEFAULT) {
+    QuickJSByteCodeCacheObject cacheObject = await QuickJSByteCodeCache.getCacheObject(code);
+    if (cacheObject.valid) return null;
+  }
+  return compileScript(code, url: url);
+}
+
+Future<bool> evaluateScripts(int contextId, String code,
+    {String? url, int line = 0, CompiledScript? compiledScript}) async {
   if (WebFController.getControllerOfJSContextId(contextId) == null) {
+    compiledScript?.dispose();
     return false;
   }
   // Assign `vm://$id` for no url (anonymous scripts).
@@ -144,6 +211,7 @@ Future<bool> evaluateScripts(int contextId, String code, {String? url, int line
 
   QuickJSByteCodeCacheObject cacheObject = await QuickJSByteCodeCache.getCacheObject(code);
   if (QuickJSByteCodeCacheObject.cacheMode == ByteCodeCacheMode.DEFAULT && cacheObject.valid && cacheObject.bytes != null) {
+    compiledScript?.dispose();
     bool result = evaluateQuickjsByteCode(contextId, cacheObject.bytes!);
     // If the bytecode evaluate failed, remove the cached file and fallback to raw javascript mode.
     if (!result) {
@@ -151,6 +219,28 @@ Future<bool> evaluateScripts(int contextId, String code, {String? url, int line
     }
 
     return result;
+  } else if (compiledScript != null) {
+    assert(_allocatedPages.containsKey(contextId));
+    int result;
+    if (QuickJSByteCodeCache.isCodeNeedCache(code)) {
+      Pointer<Pointer<Uint8>> bytecodes = malloc.allocate(sizeOf<Pointer<Uint8>>());
+      Pointer<Uint64> bytecodeLen = malloc.allocate(sizeOf<Uint64>());
+      bytecodes.value = nullptr;
+      bytecodeLen.value = 0;
+      result = _evaluateCompiledScript(_allocatedPages[contextId]!, compiledScript._take(), bytecodes, bytecodeLen);
+      if (bytecodes.value != nullptr) {
+        // Copied out of the native buffer, which is freed right away.
+        Uint8List bytes = Uint8List.fromList(bytecodes.value.asTypedList(bytecodeLen.value));
+        malloc.free(bytecodes.value);
+        // Save to disk cache
+        QuickJSByteCodeCache.putObject(code, bytes);
+      }
+      malloc.free(bytecodes);
+      malloc.free(bytecodeLen);
+    } else {
+      result = _evaluateCompiledScript(_allocatedPages[contextId]!, compiledScript._take(), nullptr, nullptr);
+    }
+    return result == 1;
   } else {
     Pointer<NativeString> nativeString = stringToNativeString(code);
     Pointer<Utf8> _url = url.toNativeUtf8();
@@ -212,17 +302,30 @@ void parseHTML(int contextId, String code) {
 }
 
 // Register initJsEngine
-typedef NativeInitDartIsolateContext = Pointer<Void> Function(Pointer<Uint64> dartMethods, Int32 methodsLength);
-typedef DartInitDartIsolateContext = Pointer<Void> Function(Pointer<Uint64> dartMethods, int methodsLength);
+typedef NativeInitDartIsolateContext = Pointer<Void> Function(
+    Pointer<Uint64> dartMethods, Int32 methodsLength, Int64 jsThreadPort, Int32 jsThreadCount);
+typedef DartInitDartIsolateContext = Pointer<Void> Function(
+    Pointer<Uint64> dartMethods, int methodsLength, int jsThreadPort, int jsThreadCount);
 
 final DartInitDartIsolateContext _initDartIsolateContext =
     WebFDynamicLibrary.ref.lookup<NativeFunction<NativeInitDartIsolateContext>>('initDartIsolateContext').asFunction();
 
-Pointer<Void> initDartIsolateContext(List<int> dartMethods) {
+Pointer<Void> initDartIsolateContext(List<int> dartMethods, int jsThreadPort, int jsThreadCount) {
   Pointer<Uint64> bytes = malloc.allocate<Uint64>(sizeOf<Uint64>() * dartMethods.length);
   Uint64List nativeMethodList = bytes.asTypedList(dartMethods.length);
   nativeMethodList.setAll(0, dartMethods);
-  return _initDartIsolateContext(bytes, dartMethods.length);
+  return _initDartIsolateContext(bytes, dartMethods.length, jsThreadPort, jsThreadCount);
+}
+
+typedef NativeFlushDartThreadTasks = Void Function(Pointer<Void> dartContext);
+typedef DartFlushDartThreadTasks = void Function(Pointer<Void> dartContext);
+
+final DartFlushDartThreadTasks _flushDartThreadTasks =
+    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeFlushDartThreadTasks>>('flushDartThreadTasks').asFunction();
+
+// Run the calls from the JS thread waiting for the dart thread.
+void flushDartThreadTasks(Pointer<Void> dartContext) {
+  _flushDartThreadTasks(dartContext);
 }
 
 typedef NativeDisposePage = Void Function(Pointer<Void>, Pointer<Void> page);
@@ -235,18 +338,71 @@ void disposePage(int contextId) {
   Pointer<Void> page = _allocatedPages[contextId]!;
   _disposePage(dartContext.pointer, page);
   _allocatedPages.remove(contextId);
+  _internedUICommandStrings.remove(contextId);
 }
 
-typedef NativeAllocateNewPage = Pointer<Void> Function(Pointer<Void>, Int32);
-typedef DartAllocateNewPage = Pointer<Void> Function(Pointer<Void>, int);
+typedef NativeAllocateNewPage = Pointer<Void> Function(Pointer<Void>, Int32, Int32);
+typedef DartAllocateNewPage = Pointer<Void> Function(Pointer<Void>, int, int);
 
 final DartAllocateNewPage _allocateNewPage =
     WebFDynamicLibrary.ref.lookup<NativeFunction<NativeAllocateNewPage>>('allocateNewPage').asFunction();
 
-void allocateNewPage(int targetContextId) {
-  Pointer<Void> page = _allocateNewPage(dartContext.pointer, targetContextId);
+// Pages with the same jsThreadGroup share a JS thread, see [javaScriptThreadCount].
+void allocateNewPage(int targetContextId, [int? jsThreadGroup]) {
+  Pointer<Void> page = _allocateNewPage(dartContext.pointer, targetContextId, jsThreadGroup ?? -1);
   assert(!_allocatedPages.containsKey(targetContextId));
   _allocatedPages[targetContextId] = page;
+  _definedWidgetElements.forEach((tagName, creator) {
+    _registerWidgetElementShapeToPage(page, tagName, creator);
+  });
+}
+
+typedef NativeRegisterWidgetElementShape = Void Function(
+    Pointer<Void> page, Pointer<NativeString> tagName, Int32 argc, Pointer<NativeValue> argv);
+typedef DartRegisterWidgetElementShape = void Function(
+    Pointer<Void> page, Pointer<NativeString> tagName, int argc, Pointer<NativeValue> argv);
+
+final DartRegisterWidgetElementShape _registerWidgetElementShape = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeRegisterWidgetElementShape>>('registerWidgetElementShape')
+    .asFunction();
+
+// The custom elements defined by WebF.defineCustomElement, their shapes are sent to every page when allocated.
+final Map<String, ElementCreator> _definedWidgetElements = {};
+
+void _registerWidgetElementShapeToPage(Pointer<Void> page, String tagName, ElementCreator creator) {
+  List<List<dynamic>> shape;
+  Type type;
+  Element? element;
+  try {
+    // A detached instance is enough to read the declared properties and methods.
+    element = creator(null);
+    if (element is! WidgetElement) return;
+    shape = element.shapeOfBindingObject;
+    type = element.runtimeType;
+  } catch (e) {
+    // Fallback to sync the shape when the element is first created from JS.
+    return;
+  } finally {
+    element?.dispose();
+  }
+
+  Pointer<NativeValue> arguments = malloc.allocate(sizeOf<NativeValue>() * shape.length);
+  for (int i = 0; i < shape.length; i++) {
+    toNativeValue(arguments.elementAt(i), shape[i]);
+  }
+  // The tag name is freed by native side.
+  _registerWidgetElementShape(page, stringToNativeString(tagName), shape.length, arguments);
+  malloc.free(arguments);
+  BindingObject.markWidgetElementSynced(type);
+}
+
+// Register the shape of a WidgetElement to native side ahead of its first creation, so the properties and methods
+// read from JS are answered without a round trip to dart side.
+void registerWidgetElementShape(String tagName, ElementCreator creator) {
+  _definedWidgetElements[tagName] = creator;
+  _allocatedPages.forEach((contextId, page) {
+    _registerWidgetElementShapeToPage(page, tagName, creator);
+  });
 }
 
 typedef NativeInitDartDynamicLinking = Void Function(Pointer<Void> data);
@@ -281,6 +437,34 @@ void registerPluginByteCode(Uint8List bytecode, String name) {
   _registerPluginByteCode(bytes, bytecode.length, name.toNativeUtf8());
 }
 
+typedef NativeRegisterWorkerByteCode = Void Function(Pointer<Uint8> bytes, Int32 length, Pointer<Utf8> scriptURL);
+typedef DartRegisterWorkerByteCode = void Function(Pointer<Uint8> bytes, int length, Pointer<Utf8> scriptURL);
+
+final DartRegisterWorkerByteCode _registerWorkerByteCode =
+    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeRegisterWorkerByteCode>>('registerWorkerByteCode').asFunction();
+
+// Registers the bytecode run by `new Worker(scriptURL)` in JavaScript.
+void registerWorkerByteCode(Uint8List bytecode, String scriptURL) {
+  Pointer<Uint8> bytes = malloc.allocate(sizeOf<Uint8>() * bytecode.length);
+  bytes.asTypedList(bytecode.length).setAll(0, bytecode);
+  _registerWorkerByteCode(bytes, bytecode.length, scriptURL.toNativeUtf8());
+}
+
+typedef NativeRegisterWorkerCode = Void Function(Pointer<Utf8> code, Int32 length, Pointer<Utf8> scriptURL);
+typedef DartRegisterWorkerCode = void Function(Pointer<Utf8> code, int length, Pointer<Utf8> scriptURL);
+
+final DartRegisterWorkerCode _registerWorkerCode =
+    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeRegisterWorkerCode>>('registerWorkerCode').asFunction();
+
+// Registers the script run by `new Worker(scriptURL)` in JavaScript.
+void registerWorkerCode(String code, String scriptURL) {
+  Pointer<Utf8> nativeCode = code.toNativeUtf8();
+  Pointer<Utf8> nativeScriptURL = scriptURL.toNativeUtf8();
+  _registerWorkerCode(nativeCode, nativeCode.length, nativeScriptURL);
+  malloc.free(nativeCode);
+  malloc.free(nativeScriptURL);
+}
+
 typedef NativeProfileModeEnabled = Int32 Function();
 typedef DartProfileModeEnabled = int Function();
 
@@ -293,6 +477,134 @@ bool profileModeEnabled() {
   return _profileModeEnabled() == _CODE_ENABLED;
 }
 
+typedef NativeSetUICommandStatsEnabled = Void Function(Pointer<Void>, Int8);
+typedef DartSetUICommandStatsEnabled = void Function(Pointer<Void>, int);
+
+final DartSetUICommandStatsEnabled _setUICommandStatsEnabled = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeSetUICommandStatsEnabled>>('setUICommandStatsEnabled')
+    .asFunction();
+
+// Count the ui commands and flushes at native side, enabling resets the counters.
+void setUICommandStatsEnabled(int contextId, bool enabled) {
+  assert(_allocatedPages.containsKey(contextId));
+  _setUICommandStatsEnabled(_allocatedPages[contextId]!, enabled ? 1 : 0);
+}
+
+typedef NativeGetUICommandStats = Pointer<Int64> Function(Pointer<Void>);
+typedef DartGetUICommandStats = Pointer<Int64> Function(Pointer<Void>);
+
+final DartGetUICommandStats _getUICommandStats =
+    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeGetUICommandStats>>('getUICommandStats').asFunction();
+
+typedef NativeGetUICommandEnumCount = Int32 Function();
+typedef DartGetUICommandEnumCount = int Function();
+
+final DartGetUICommandEnumCount _getUICommandTypeCount =
+    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeGetUICommandEnumCount>>('getUICommandTypeCount').asFunction();
+
+final DartGetUICommandEnumCount _getUICommandFlushReasonCount = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeGetUICommandEnumCount>>('getUICommandFlushReasonCount')
+    .asFunction();
+
+typedef NativeSetLayoutThrashingThreshold = Void Function(Pointer<Void>, Int32);
+typedef DartSetLayoutThrashingThreshold = void Function(Pointer<Void>, int);
+
+final DartSetLayoutThrashingThreshold _setLayoutThrashingThreshold = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeSetLayoutThrashingThreshold>>('setLayoutThrashingThreshold')
+    .asFunction();
+
+// Warn in console when the synchronous reads which flush pending DOM changes in one JS task reach the threshold.
+// 0 disables the detection.
+void setLayoutThrashingThreshold(int contextId, int threshold) {
+  assert(_allocatedPages.containsKey(contextId));
+  _setLayoutThrashingThreshold(_allocatedPages[contextId]!, threshold);
+}
+
+typedef NativeUpdateLayoutMetrics = Void Function(Pointer<Void>, Pointer<NativeLayoutMetrics>, Int32);
+typedef DartUpdateLayoutMetrics = void Function(Pointer<Void>, Pointer<NativeLayoutMetrics>, int);
+
+final DartUpdateLayoutMetrics _updateLayoutMetrics =
+    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeUpdateLayoutMetrics>>('updateLayoutMetrics').asFunction();
+
+// Refresh the geometry cached at native side for the elements JS has read the geometry of, after they were laid out.
+void updateLayoutMetrics(int contextId, Iterable<Element> elements) {
+  assert(_allocatedPages.containsKey(contextId));
+  if (elements.isEmpty) return;
+  Pointer<NativeLayoutMetrics> metrics = malloc.allocate(sizeOf<NativeLayoutMetrics>() * elements.length);
+  int index = 0;
+  for (Element element in elements) {
+    NativeLayoutMetrics entry = metrics.elementAt(index++).ref;
+    entry.bindingObject = element.pointer!;
+    List<double> values = element.layoutMetrics;
+    for (int i = 0; i < layoutMetricsCount; i++) {
+      entry.values[i] = values[i];
+    }
+  }
+  _updateLayoutMetrics(_allocatedPages[contextId]!, metrics, index);
+  malloc.free(metrics);
+}
+
+typedef NativeInvalidateLayoutMetrics = Void Function(Pointer<Void>);
+typedef DartInvalidateLayoutMetrics = void Function(Pointer<Void>);
+
+final DartInvalidateLayoutMetrics _invalidateLayoutMetrics = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeInvalidateLayoutMetrics>>('invalidateLayoutMetrics')
+    .asFunction();
+
+// The layout changed without JS side knowing it, e.g. scrolled by user, JS reads the geometry from dart side again.
+void invalidateLayoutMetrics(int contextId) {
+  if (!_allocatedPages.containsKey(contextId)) return;
+  _invalidateLayoutMetrics(_allocatedPages[contextId]!);
+}
+
+// Must be in sync with UICommandFlushReason at native side.
+enum UICommandFlushReason {
+  endOfFrame,
+  bindingCall,
+  layoutMetrics,
+  widgetElementShape,
+}
+
+// struct UICommandStats {
+//   int64_t command_count[kUICommandTypeCount];
+//   int64_t command_bytes[kUICommandTypeCount];
+//   int64_t flush_count[kUICommandFlushReasonCount];
+//   int64_t frames;
+//   int64_t current_frame_flushes;
+//   int64_t last_frame_flushes;
+//   int64_t max_frame_flushes;
+// };
+Map<String, dynamic> getUICommandStats(int contextId) {
+  assert(_allocatedPages.containsKey(contextId));
+  int typeCount = UICommandType.values.length;
+  int reasonCount = UICommandFlushReason.values.length;
+  // The stats are read with the lengths of the dart enums.
+  assert(typeCount == _getUICommandTypeCount(), 'UICommandType is out of sync with UICommand at native side.');
+  assert(reasonCount == _getUICommandFlushReasonCount(),
+      'UICommandFlushReason is out of sync with UICommandFlushReason at native side.');
+  Int64List stats = _getUICommandStats(_allocatedPages[contextId]!).asTypedList(typeCount * 2 + reasonCount + 4);
+
+  Map<String, int> commandCount = {};
+  Map<String, int> commandBytes = {};
+  for (int i = 0; i < typeCount; i++) {
+    commandCount[UICommandType.values[i].name] = stats[i];
+    commandBytes[UICommandType.values[i].name] = stats[typeCount + i];
+  }
+  Map<String, int> flushCount = {};
+  for (int i = 0; i < reasonCount; i++) {
+    flushCount[UICommandFlushReason.values[i].name] = stats[typeCount * 2 + i];
+  }
+  int offset = typeCount * 2 + reasonCount;
+  return {
+    'commandCount': commandCount,
+    'commandBytes': commandBytes,
+    'flushCount': flushCount,
+    'frames': stats[offset],
+    'lastFrameFlushes': stats[offset + 2],
+    'maxFrameFlushes': stats[offset + 3],
+  };
+}
+
 typedef NativeDispatchUITask = Void Function(Int32 contextId, Pointer<Void> context, Pointer<Void> callback);
 typedef DartDispatchUITask = void Function(int contextId, Pointer<Void> context, Pointer<Void> callback);
 
@@ -320,6 +632,9 @@ enum UICommandType {
   // perf optimize
   createSVGElement,
   createElementNS,
+  internString,
+  setStyleBatch,
+  createSubtree,
 }
 
 class UICommandItem extends Struct {
@@ -337,29 +652,62 @@ class UICommandItem extends Struct {
   external Pointer nativePtr;
 }
 
-typedef NativeGetUICommandItems = Pointer<Uint64> Function(Pointer<Void>);
-typedef DartGetUICommandItems = Pointer<Uint64> Function(Pointer<Void>);
+typedef NativeAcquireUICommandItems = Pointer<Pointer<Uint64>> Function(Pointer<Void>, Pointer<Int64>);
+typedef DartAcquireUICommandItems = Pointer<Pointer<Uint64>> Function(Pointer<Void>, Pointer<Int64>);
+
+final DartAcquireUICommandItems _acquireUICommandItems =
+    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeAcquireUICommandItems>>('acquireUICommandItems').asFunction();
+
+typedef NativeReleaseUICommandItems = Void Function(Pointer<Void>);
+typedef DartReleaseUICommandItems = void Function(Pointer<Void>);
+
+final DartReleaseUICommandItems _releaseUICommandItems =
+    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeReleaseUICommandItems>>('releaseUICommandItems').asFunction();
 
-final DartGetUICommandItems _getUICommandItems =
-    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeGetUICommandItems>>('getUICommandItems').asFunction();
+typedef NativeSetUICommandCoalescingEnabled = Void Function(Pointer<Void>, Int8);
+typedef DartSetUICommandCoalescingEnabled = void Function(Pointer<Void>, int);
 
-typedef NativeGetUICommandItemSize = Int64 Function(Pointer<Void>);
-typedef DartGetUICommandItemSize = int Function(Pointer<Void>);
+final DartSetUICommandCoalescingEnabled _setUICommandCoalescingEnabled = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeSetUICommandCoalescingEnabled>>('setUICommandCoalescingEnabled')
+    .asFunction();
+
+// Drop the ui commands which are cancelled out by later ones in the same batch at native side before flushing.
+void setUICommandCoalescingEnabled(int contextId, bool enabled) {
+  assert(_allocatedPages.containsKey(contextId));
+  _setUICommandCoalescingEnabled(_allocatedPages[contextId]!, enabled ? 1 : 0);
+}
 
-final DartGetUICommandItemSize _getUICommandItemSize =
-    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeGetUICommandItemSize>>('getUICommandItemSize').asFunction();
+typedef NativeGetUICommandCoalescingStats = Pointer<NativeUICommandCoalescingStats> Function(Pointer<Void>);
+typedef DartGetUICommandCoalescingStats = Pointer<NativeUICommandCoalescingStats> Function(Pointer<Void>);
 
-typedef NativeClearUICommandItems = Void Function(Pointer<Void>);
-typedef DartClearUICommandItems = void Function(Pointer<Void>);
+final DartGetUICommandCoalescingStats _getUICommandCoalescingStats = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeGetUICommandCoalescingStats>>('getUICommandCoalescingStats')
+    .asFunction();
 
-final DartClearUICommandItems _clearUICommandItems =
-    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeClearUICommandItems>>('clearUICommandItems').asFunction();
+Map<String, int> getUICommandCoalescingStats(int contextId) {
+  assert(_allocatedPages.containsKey(contextId));
+  NativeUICommandCoalescingStats stats = _getUICommandCoalescingStats(_allocatedPages[contextId]!).ref;
+  return {
+    'batches': stats.batches,
+    'inputCommands': stats.inputCommands,
+    'eliminatedCommands': stats.eliminatedCommands,
+    'deadNodeCommands': stats.deadNodeCommands,
+    'styleCommands': stats.styleCommands,
+    'attributeCommands': stats.attributeCommands,
+    'eventCommands': stats.eventCommands,
+  };
+}
 
 class UICommand {
   late final UICommandType type;
   late final String args;
   late final Pointer nativePtr;
   late final Pointer nativePtr2;
+  // The payloads pointed by nativePtr2 live in the arena of the batch, which is recycled once the batch is released,
+  // so they are decoded when reading the command.
+  String? value;
+  EventListenerOptions? eventListenerOptions;
+  List<Pointer<NativeBindingObject>>? nodes;
 
   @override
   String toString() {
@@ -375,6 +723,8 @@ class UICommand {
 //   void* nativePtr2;         // offset: 3
 // };
 const int nativeCommandSize = 4;
+// Native commands are stored in chunks of UI_COMMAND_CHUNK_SIZE items, see bridge/foundation/ui_command_buffer.h.
+const int uiCommandChunkSize = 2048;
 const int typeAndArgs01LenMemOffset = 0;
 const int args01StringMemOffset = 1;
 const int nativePtrMemOffset = 2;
@@ -382,58 +732,174 @@ const int native2PtrMemOffset = 3;
 
 final bool isEnabledLog = !kReleaseMode && Platform.environment['ENABLE_WEBF_JS_LOG'] == 'true';
 
+// Strings defined by internString commands, keyed by contextId and then the string id.
+final Map<int, Map<int, String>> _internedUICommandStrings = {};
+
+UICommand _readNativeUICommand(List<int> rawMemory, int i, Map<int, String> internedStrings) {
+  UICommand command = UICommand();
+
+  int typeArgs01Combine = rawMemory[i + typeAndArgs01LenMemOffset];
+
+  //      int32_t        int32_t
+  // +-------------+-----------------+
+  // |      type     | args_01_length  |
+  // +-------------+-----------------+
+  int args01Length = (typeArgs01Combine >> 32).toSigned(32);
+  int type = (typeArgs01Combine ^ (args01Length << 32)).toSigned(32);
+
+  command.type = UICommandType.values[type];
+
+  int args01StringMemory = rawMemory[i + args01StringMemOffset];
+  if (args01StringMemory != 0) {
+    Pointer<Uint16> args_01 = Pointer.fromAddress(args01StringMemory);
+    command.args = uint16ToString(args_01, args01Length);
+  } else if (args01Length < 0) {
+    // Negative length refers to a string defined by a previous internString command.
+    command.args = internedStrings[-args01Length - 1]!;
+  } else {
+    command.args = '';
+  }
+
+  int nativePtrValue = rawMemory[i + nativePtrMemOffset];
+  command.nativePtr = nativePtrValue != 0 ? Pointer.fromAddress(rawMemory[i + nativePtrMemOffset]) : nullptr;
+
+  int nativePtr2Value = rawMemory[i + native2PtrMemOffset];
+  command.nativePtr2 = nativePtr2Value != 0 ? Pointer.fromAddress(nativePtr2Value) : nullptr;
+
+  switch (command.type) {
+    case UICommandType.internString:
+      internedStrings[nativePtr2Value] = command.args;
+      break;
+    case UICommandType.setStyle:
+    case UICommandType.setAttribute:
+    case UICommandType.createElementNS:
+      command.value = nativePtr2Value != 0 ? nativeStringToString(command.nativePtr2.cast<NativeString>()) : '';
+      break;
+    case UICommandType.addEvent:
+      if (nativePtr2Value != 0) {
+        AddEventListenerOptions options = command.nativePtr2.cast<AddEventListenerOptions>().ref;
+        command.eventListenerOptions = EventListenerOptions(options.capture, options.passive, options.once);
+      }
+      break;
+    case UICommandType.createSubtree:
+      Pointer<Pointer<NativeBindingObject>> nodes = command.nativePtr2.cast<Pointer<NativeBindingObject>>();
+      int count = _countSubtreeNodes(command.args);
+      command.nodes = List.generate(count, (int index) => nodes[index], growable: false);
+      break;
+    default:
+      break;
+  }
+
+  if (isEnabledLog) {
+    String printMsg = 'nativePtr: ${command.nativePtr} type: ${command.type} args: ${command.args} nativePtr2: ${command.nativePtr2}';
+    print(printMsg);
+  }
+  return command;
+}
+
 // We found there are performance bottleneck of reading native memory with Dart FFI API.
-// So we align all UI instructions to a whole block of memory, and then convert them into a dart array at one time,
+// So we align all UI instructions to whole blocks of memory, and then convert each block into a dart array at one time,
 // To ensure the fastest subsequent random access.
-List<UICommand> readNativeUICommandToDart(Pointer<Uint64> nativeCommandItems, int commandLength, int contextId) {
-  List<int> rawMemory =
-      nativeCommandItems.cast<Int64>().asTypedList(commandLength * nativeCommandSize).toList(growable: false);
-  List<UICommand> results = List.generate(commandLength, (int _i) {
-    int i = _i * nativeCommandSize;
-    UICommand command = UICommand();
-
-    int typeArgs01Combine = rawMemory[i + typeAndArgs01LenMemOffset];
-
-    //      int32_t        int32_t
-    // +-------------+-----------------+
-    // |      type     | args_01_length  |
-    // +-------------+-----------------+
-    int args01Length = (typeArgs01Combine >> 32).toSigned(32);
-    int type = (typeArgs01Combine ^ (args01Length << 32)).toSigned(32);
-
-    command.type = UICommandType.values[type];
-
-    int args01StringMemory = rawMemory[i + args01StringMemOffset];
-    if (args01StringMemory != 0) {
-      Pointer<Uint16> args_01 = Pointer.fromAddress(args01StringMemory);
-      command.args = uint16ToString(args_01, args01Length);
-      malloc.free(args_01);
-    } else {
-      command.args = '';
+List<UICommand> readNativeUICommandToDart(
+    Pointer<Pointer<Uint64>> nativeCommandChunks, int commandLength, Map<int, String> internedStrings) {
+  List<UICommand> results = [];
+  for (int chunkStart = 0, chunkIndex = 0; chunkStart < commandLength; chunkStart += uiCommandChunkSize, chunkIndex++) {
+    int chunkLength = math.min(uiCommandChunkSize, commandLength - chunkStart);
+    List<int> rawMemory =
+        nativeCommandChunks[chunkIndex].cast<Int64>().asTypedList(chunkLength * nativeCommandSize).toList(growable: false);
+    for (int i = 0; i < chunkLength; i++) {
+      results.add(_readNativeUICommand(rawMemory, i * nativeCommandSize, internedStrings));
     }
+  }
 
-    int nativePtrValue = rawMemory[i + nativePtrMemOffset];
-    command.nativePtr = nativePtrValue != 0 ? Pointer.fromAddress(rawMemory[i + nativePtrMemOffset]) : nullptr;
+  return results;
+}
+
+// Returns the number of nodes described by a createSubtree command, which is the length of its node list.
+int _countSubtreeNodes(String description) {
+  List<String> fields = description.split('\u0000');
+  int field = 0;
+  int count = 0;
+  while (field < fields.length - 1) {
+    UICommandType type = UICommandType.values[int.parse(fields[field])];
+    // Skip type, parent index and text.
+    field += 3;
+    if (type != UICommandType.createTextNode && type != UICommandType.createComment) {
+      if (type == UICommandType.createElementNS) field++;
+      field += int.parse(fields[field]) * 2 + 1;
+      field += int.parse(fields[field]) * 2 + 1;
+    }
+    count++;
+  }
+  return count;
+}
+
+// Build the nodes described by a createSubtree command, see SubtreeCommandScope at native side for the layout.
+// Nodes are created and attached to their parents in preorder, so every parent exists before its children. The roots
+// are inserted into the target at last.
+void _createSubtree(WebFViewController view, Pointer<NativeBindingObject> parentPtr, String description,
+    List<Pointer<NativeBindingObject>> nodes, Map<int, bool> pendingStylePropertiesTargets, Set<int> pendingRecalculateTargets) {
+  List<String> fields = description.split('\u0000');
+  List<Pointer<NativeBindingObject>> roots = [];
+  int field = 0;
+  int index = 0;
+  // The description ends with a separator, so the last field is always empty.
+  while (field < fields.length - 1) {
+    UICommandType type = UICommandType.values[int.parse(fields[field++])];
+    int parentIndex = int.parse(fields[field++]);
+    String text = fields[field++];
+    Pointer<NativeBindingObject> nodePtr = nodes[index++];
+
+    if (type == UICommandType.createTextNode) {
+      view.createTextNode(nodePtr, text);
+    } else if (type == UICommandType.createComment) {
+      view.createComment(nodePtr);
+    } else {
+      if (type == UICommandType.createSVGElement) {
+        view.createElementNS(nodePtr, SVG_ELEMENT_URI, text);
+      } else if (type == UICommandType.createElementNS) {
+        view.createElementNS(nodePtr, fields[field++], text);
+      } else {
+        view.createElement(nodePtr, text);
+      }
 
-    int nativePtr2Value = rawMemory[i + native2PtrMemOffset];
-    command.nativePtr2 = nativePtr2Value != 0 ? Pointer.fromAddress(nativePtr2Value) : nullptr;
+      int attributeCount = int.parse(fields[field++]);
+      for (int i = 0; i < attributeCount; i++, field += 2) {
+        view.setAttribute(nodePtr, fields[field], fields[field + 1]);
+      }
+      if (attributeCount > 0) {
+        pendingRecalculateTargets.add(nodePtr.address);
+      }
 
-    if (isEnabledLog) {
-      String printMsg = 'nativePtr: ${command.nativePtr} type: ${command.type} args: ${command.args} nativePtr2: ${command.nativePtr2}';
-      print(printMsg);
+      int styleCount = int.parse(fields[field++]);
+      for (int i = 0; i < styleCount; i++, field += 2) {
+        view.setInlineStyle(nodePtr, fields[field], fields[field + 1]);
+      }
+      if (styleCount > 0) {
+        pendingStylePropertiesTargets[nodePtr.address] = true;
+      }
     }
-    return command;
-  }, growable: false);
 
-  // Clear native command.
-  _clearUICommandItems(_allocatedPages[contextId]!);
+    if (parentIndex < 0) {
+      roots.add(nodePtr);
+    } else {
+      view.insertAdjacentNode(nodes[parentIndex], 'beforeend', nodePtr);
+    }
+  }
 
-  return results;
+  if (parentPtr != nullptr) {
+    for (Pointer<NativeBindingObject> root in roots) {
+      view.insertAdjacentNode(parentPtr, 'beforeend', root);
+    }
+  }
 }
 
+// Drop the pending ui commands of a page going away, by taking the batch and giving it back unread.
 void clearUICommand(int contextId) {
   assert(_allocatedPages.containsKey(contextId));
-  _clearUICommandItems(_allocatedPages[contextId]!);
+  Pointer<Void> page = _allocatedPages[contextId]!;
+  _acquireUICommandItems(page, _uiCommandLength);
+  _releaseUICommandItems(page);
 }
 
 void flushUICommandWithContextId(int contextId) {
@@ -443,16 +909,25 @@ void flushUICommandWithContextId(int contextId) {
   }
 }
 
+final Pointer<Int64> _uiCommandLength = malloc.allocate(sizeOf<Int64>());
+
 void flushUICommand(WebFViewController view) {
   assert(_allocatedPages.containsKey(view.contextId));
-  Pointer<Uint64> nativeCommandItems = _getUICommandItems(_allocatedPages[view.contextId]!);
-  int commandLength = _getUICommandItemSize(_allocatedPages[view.contextId]!);
+  Pointer<Void> page = _allocatedPages[view.contextId]!;
+  // Take over the pending batch, JS side continues recording commands into a fresh one.
+  Pointer<Pointer<Uint64>> nativeCommandChunks = _acquireUICommandItems(page, _uiCommandLength);
+  int commandLength = _uiCommandLength.value;
 
-  if (commandLength == 0 || nativeCommandItems == nullptr) {
+  if (commandLength == 0 || nativeCommandChunks == nullptr) {
+    _releaseUICommandItems(page);
     return;
   }
 
-  List<UICommand> commands = readNativeUICommandToDart(nativeCommandItems, commandLength, view.contextId);
+  Map<int, String> internedStrings = _internedUICommandStrings.putIfAbsent(view.contextId, () => {});
+  List<UICommand> commands = readNativeUICommandToDart(nativeCommandChunks, commandLength, internedStrings);
+  // All the payloads had been decoded, hand the batch back to be recycled. Release before applying the commands
+  // because the element tree mutations below may trigger another flush.
+  _releaseUICommandItems(page);
 
   SchedulerBinding.instance.scheduleFrame();
 
@@ -486,8 +961,7 @@ void flushUICommand(WebFViewController view) {
           view.disposeBindingObject(nativePtr.cast<NativeBindingObject>());
           break;
         case UICommandType.addEvent:
-          Pointer<AddEventListenerOptions> eventListenerOptions = command.nativePtr2.cast<AddEventListenerOptions>();
-          view.addEvent(nativePtr.cast<NativeBindingObject>(), command.args, addEventListenerOptions: eventListenerOptions);
+          view.addEvent(nativePtr.cast<NativeBindingObject>(), command.args, eventListenerOptions: command.eventListenerOptions);
           break;
         case UICommandType.removeEvent:
           bool isCapture = command.nativePtr2.address == 1;
@@ -507,26 +981,27 @@ void flushUICommand(WebFViewController view) {
           view.cloneNode(nativePtr.cast<NativeBindingObject>(), command.nativePtr2.cast<NativeBindingObject>());
           break;
         case UICommandType.setStyle:
-          String value;
-          if (command.nativePtr2 != nullptr) {
-            Pointer<NativeString> nativeValue = command.nativePtr2.cast<NativeString>();
-            value = nativeStringToString(nativeValue);
-            freeNativeString(nativeValue);
-          } else {
-            value = '';
+          view.setInlineStyle(nativePtr, command.args, command.value!);
+          pendingStylePropertiesTargets[nativePtr.address] = true;
+          break;
+        case UICommandType.setStyleBatch:
+          // Packed as "name\u0000value\u0000" pairs, removed properties have empty values.
+          List<String> pairs = command.args.split('\u0000');
+          for (int i = 0; i + 1 < pairs.length; i += 2) {
+            view.setInlineStyle(nativePtr, pairs[i], pairs[i + 1]);
           }
-          view.setInlineStyle(nativePtr, command.args, value);
           pendingStylePropertiesTargets[nativePtr.address] = true;
           break;
+        case UICommandType.createSubtree:
+          _createSubtree(view, nativePtr.cast<NativeBindingObject>(), command.args,
+              command.nodes!, pendingStylePropertiesTargets, pendingRecalculateTargets);
+          break;
         case UICommandType.clearStyle:
           view.clearInlineStyle(nativePtr);
           pendingStylePropertiesTargets[nativePtr.address] = true;
           break;
         case UICommandType.setAttribute:
-          Pointer<NativeString> nativeKey = command.nativePtr2.cast<NativeString>();
-          String key = nativeStringToString(nativeKey);
-          freeNativeString(nativeKey);
-          view.setAttribute(nativePtr.cast<NativeBindingObject>(), key, command.args);
+          view.setAttribute(nativePtr.cast<NativeBindingObject>(), command.value!, command.args);
           pendingRecalculateTargets.add(nativePtr.address);
           break;
         case UICommandType.removeAttribute:
@@ -540,11 +1015,7 @@ void flushUICommand(WebFViewController view) {
           view.createElementNS(nativePtr.cast<NativeBindingObject>(), SVG_ELEMENT_URI, command.args);
           break;
         case UICommandType.createElementNS:
-          Pointer<NativeString> nativeNameSpaceUri = command.nativePtr2.cast<NativeString>();
-          String namespaceUri = nativeStringToString(nativeNameSpaceUri);
-          freeNativeString(nativeNameSpaceUri);
-
-          view.createElementNS(nativePtr.cast<NativeBindingObject>(), namespaceUri, command.args);
+          view.createElementNS(nativePtr.cast<NativeBindingObject>(), command.value!, command.args);
           break;
         default:
           break;
@@ -75,7 +75,10 @@ class AnimationTimeline {
   double? _currentTime;
   late Ticker _ticker;
 
-  AnimationTimeline() {
+  // Called after the animations have ticked, as the styles they drive have changed.
+  final VoidCallback? onTick;
+
+  AnimationTimeline({this.onTick}) {
     _ticker = Ticker(_onTick);
   }
 
@@ -98,6 +101,7 @@ class AnimationTimeline {
       for (Animation animation in [..._animations]) {
         animation._tick(_currentTime);
       }
+      onTick?.call();
     }
   }
 
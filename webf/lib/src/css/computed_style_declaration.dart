@@ -28,6 +28,7 @@ class ComputedCSSStyleDeclaration extends CSSStyleDeclaration {
   void initializeMethods(Map<String, BindingObjectMethod> methods) {
     super.initializeMethods(methods);
     methods['getPropertyValue'] = BindingObjectMethodSync(call: (args) => getPropertyValue(args[0]));
+    methods['getPropertyValues'] = BindingObjectMethodSync(call: (args) => getPropertyValues(args));
     methods['setProperty'] = BindingObjectMethodSync(call: (args) => setProperty(args[0], args[1]));
     methods['removeProperty'] = BindingObjectMethodSync(call: (args) => removeProperty(args[0]));
     methods['checkCSSProperty'] = BindingObjectMethodSync(call: (args) => checkCSSProperty(args[0]));
@@ -79,6 +80,13 @@ class ComputedCSSStyleDeclaration extends CSSStyleDeclaration {
     return _valueForPropertyInStyle(propertyID, needUpdateStyle: true);
   }
 
+  // Resolves all the requested properties in one call from native side, which keeps them as a snapshot until the
+  // style may have changed.
+  List<String> getPropertyValues(List<dynamic> propertyNames) {
+    _element.ownerDocument.updateStyleIfNeeded();
+    return propertyNames.map((propertyName) => getPropertyValue(propertyName)).toList();
+  }
+
   @override
   void setProperty(String propertyName, String? value, { bool? isImportant, String? baseHref }) {
     throw UnimplementedError('No Modification Allowed');
@@ -6,6 +6,7 @@ import 'dart:collection';
 import 'dart:io';
 import 'package:flutter/foundation.dart';
 import 'package:flutter/rendering.dart';
+import 'package:webf/bridge.dart';
 import 'package:webf/css.dart';
 import 'package:webf/dom.dart';
 import 'package:webf/html.dart';
@@ -64,7 +65,8 @@ enum VisibilityState { visible, hidden }
 
 class Document extends ContainerNode {
   final WebFController controller;
-  final AnimationTimeline animationTimeline = AnimationTimeline();
+  // The computed styles read by js are snapshots, which must be dropped when animations change the styles.
+  late final AnimationTimeline animationTimeline = AnimationTimeline(onTick: () => invalidateLayoutMetrics(contextId!));
   RenderViewportBox? _viewport;
   GestureListener? gestureListener;
 
@@ -492,6 +494,7 @@ class Document extends ContainerNode {
     styleSheets.clear();
     adoptedStyleSheets.clear();
     cookie.clearCookie();
+    _scriptRunner.dispose();
     super.dispose();
   }
 
@@ -4,6 +4,7 @@
  */
 
 import 'dart:async';
+import 'dart:ffi' show Pointer, Double, DoublePointer;
 import 'dart:ui';
 
 import 'package:flutter/foundation.dart';
@@ -311,6 +312,7 @@ abstract class Element extends ContainerNode with ElementBase, ElementEventMixin
   @override
   void initializeMethods(Map<String, BindingObjectMethod> methods) {
     methods['getBoundingClientRect'] = BindingObjectMethodSync(call: (_) => getBoundingClientRect());
+    methods['getLayoutMetrics'] = BindingObjectMethodSync(call: (args) => getLayoutMetrics(args[0]));
     methods['scroll'] =
         BindingObjectMethodSync(call: (args) => scroll(castToType<double>(args[0]), castToType<double>(args[1])));
     methods['scrollBy'] =
@@ -643,6 +645,48 @@ abstract class Element extends ContainerNode with ElementBase, ElementEventMixin
 
   BoundingClientRect getBoundingClientRect() => boundingClientRect;
 
+  // Writes all the geometry JS reads into the buffer of native side at once, which is cached there until the layout
+  // may have changed. The cache of this element is refreshed after every frame from now on.
+  void getLayoutMetrics(Pointer values) {
+    flushLayout();
+    values.cast<Double>().asTypedList(layoutMetricsCount).setAll(0, layoutMetrics);
+    ownerDocument.controller.view.watchLayoutMetrics(this);
+  }
+
+  // In the order of LayoutMetric at native side. Read from the render box as it is, callers flush the layout first.
+  List<double> get layoutMetrics {
+    Offset offset = Offset.zero;
+    Offset clientOffset = Offset.zero;
+    Size size = Size.zero;
+    if (isRendererAttached) {
+      RenderBoxModel renderBox = renderBoxModel!;
+      offset = _getOffsetWithoutLayout(renderBox, ancestor: offsetParent);
+      if (renderBox.hasSize) {
+        clientOffset =
+            _getOffsetWithoutLayout(renderBox, ancestor: ownerDocument.documentElement, excludeScrollOffset: true);
+        size = renderBox.size;
+      }
+    }
+    return [
+      offset.dy,
+      offset.dx,
+      offsetWidth,
+      offsetHeight,
+      clientTop,
+      clientLeft,
+      clientWidth,
+      clientHeight,
+      scrollTop,
+      scrollLeft,
+      scrollWidth,
+      scrollHeight,
+      clientOffset.dx,
+      clientOffset.dy,
+      size.width,
+      size.height,
+    ];
+  }
+
   bool _shouldConsumeScrollTicker = false;
 
   void _consumeScrollTicker(_) {
@@ -659,6 +703,7 @@ abstract class Element extends ContainerNode with ElementBase, ElementEventMixin
 
   void _handleScroll(double scrollOffset, AxisDirection axisDirection) {
     if (renderBoxModel == null) return;
+    invalidateLayoutMetrics(contextId!);
     _applyStickyChildrenOffset();
     _applyFixedChildrenOffset(scrollOffset, axisDirection);
 
@@ -942,6 +987,10 @@ abstract class Element extends ContainerNode with ElementBase, ElementEventMixin
 
   @override
   Future<void> dispose() async {
+    // Only elements created from JS are watched, a detached instance may not have an owner document.
+    if (pointer != null) {
+      ownerDocument.controller.view.unwatchLayoutMetrics(this);
+    }
     renderStyle.detach();
     style.dispose();
     attributes.clear();
@@ -1995,7 +2044,10 @@ abstract class Element extends ContainerNode with ElementBase, ElementEventMixin
   Offset _getOffset(RenderBoxModel renderBox, {Element? ancestor, bool excludeScrollOffset = false}) {
     // Need to flush layout to get correct size.
     flushLayout();
+    return _getOffsetWithoutLayout(renderBox, ancestor: ancestor, excludeScrollOffset: excludeScrollOffset);
+  }
 
+  Offset _getOffsetWithoutLayout(RenderBoxModel renderBox, {Element? ancestor, bool excludeScrollOffset = false}) {
     // Returns (0, 0) when ancestor is null.
     if (ancestor == null || ancestor.renderBoxModel == null) {
       return Offset.zero;
@@ -25,11 +25,23 @@ typedef BindingPropertySetter = void Function(dynamic value);
 typedef BindingMethodCallback = dynamic Function(List args);
 typedef AsyncBindingMethodCallback = Future<dynamic> Function(List args);
 
+// How native side caches the value of a WidgetElement property, must be in sync with WidgetPropertyCachePolicy at
+// native side.
+enum BindingPropertyCachePolicy {
+  // Read from dart side every time.
+  none,
+  // The value never changes once read.
+  immutable,
+  // The value is read again after any UI command was flushed to dart side.
+  invalidateOnCommand,
+}
+
 class BindingObjectProperty {
-  BindingObjectProperty({required this.getter, this.setter});
+  BindingObjectProperty({required this.getter, this.setter, this.cachePolicy = BindingPropertyCachePolicy.none});
 
   final BindingPropertyGetter getter;
   final BindingPropertySetter? setter;
+  final BindingPropertyCachePolicy cachePolicy;
 }
 
 abstract class BindingObjectMethod {
@@ -70,7 +82,7 @@ abstract class BindingObject<T> extends Iterable<T> {
     initializeProperties(_properties);
     initializeMethods(_methods);
 
-    if (this is WidgetElement && !_alreadySyncWidgetElements.containsKey(runtimeType)) {
+    if (this is WidgetElement && pointer != null && !_alreadySyncWidgetElements.containsKey(runtimeType)) {
       bool success = _syncPropertiesAndMethodsToNativeSlow();
       if (success) {
         _alreadySyncWidgetElements[runtimeType] = true;
@@ -78,11 +90,16 @@ abstract class BindingObject<T> extends Iterable<T> {
     }
   }
 
-  bool _syncPropertiesAndMethodsToNativeSlow() {
-    assert(pointer != null);
-    if (pointer!.ref.invokeBindingMethodFromDart == nullptr) return false;
+  // The shape was registered eagerly when the page was allocated, see registerWidgetElementShapes().
+  static void markWidgetElementSynced(Type type) {
+    _alreadySyncWidgetElements[type] = true;
+  }
 
+  // The properties, sync methods, async methods and the cache policies of properties, which form the shape of a
+  // WidgetElement at native side.
+  List<List<dynamic>> get shapeOfBindingObject {
     List<String> properties = _properties.keys.toList(growable: false);
+    List<int> cachePolicies = _properties.values.map((property) => property.cachePolicy.index).toList(growable: false);
     List<String> syncMethods = [];
     List<String> asyncMethods = [];
 
@@ -94,17 +111,25 @@ abstract class BindingObject<T> extends Iterable<T> {
       }
     });
 
-    Pointer<NativeValue> arguments = malloc.allocate(sizeOf<NativeValue>() * 3);
-    toNativeValue(arguments.elementAt(0), properties);
-    toNativeValue(arguments.elementAt(1), syncMethods);
-    toNativeValue(arguments.elementAt(2), asyncMethods);
+    return [properties, syncMethods, asyncMethods, cachePolicies];
+  }
+
+  bool _syncPropertiesAndMethodsToNativeSlow() {
+    assert(pointer != null);
+    if (pointer!.ref.invokeBindingMethodFromDart == nullptr) return false;
+
+    List<List<dynamic>> shape = shapeOfBindingObject;
+    Pointer<NativeValue> arguments = malloc.allocate(sizeOf<NativeValue>() * shape.length);
+    for (int i = 0; i < shape.length; i++) {
+      toNativeValue(arguments.elementAt(i), shape[i]);
+    }
 
     DartInvokeBindingMethodsFromDart f = pointer!.ref.invokeBindingMethodFromDart.asFunction();
     Pointer<NativeValue> returnValue = malloc.allocate(sizeOf<NativeValue>());
 
     Pointer<NativeValue> method = malloc.allocate(sizeOf<NativeValue>());
-    toNativeValue(method, 'syncPropertiesAndMethods');
-    f(pointer!, returnValue, method, 3, arguments, {});
+    toNativeValue(method, bindingCallMethodId(BindingCallMethods.ksyncPropertiesAndMethods));
+    f(pointer!, returnValue, method, shape.length, arguments, {});
     malloc.free(arguments);
     return fromNativeValue(returnValue) == true;
   }
@@ -201,7 +226,7 @@ abstract class BindingObject<T> extends Iterable<T> {
 dynamic getterBindingCall(BindingObject bindingObject, List<dynamic> args) {
   assert(args.length == 1);
 
-  BindingObjectProperty? property = bindingObject._properties[args[0]];
+  BindingObjectProperty? property = bindingObject._properties[bindingCallMethodName(args[0])];
 
   Stopwatch? stopwatch;
   if (isEnabledLog && property != null) {
@@ -211,20 +236,25 @@ dynamic getterBindingCall(BindingObject bindingObject, List<dynamic> args) {
   if (property != null) {
     dynamic result = property.getter();
     if (isEnabledLog) {
-      print('$bindingObject getBindingProperty key: ${args[0]} result: ${property.getter()} time: ${stopwatch!.elapsedMicroseconds}us');
+      print('$bindingObject getBindingProperty key: ${bindingCallMethodName(args[0])} result: ${property.getter()} time: ${stopwatch!.elapsedMicroseconds}us');
     }
     return result;
   }
   return null;
 }
 
+// Read several properties with one call, the values are returned in the order of the names.
+dynamic gettersBindingCall(BindingObject bindingObject, List<dynamic> args) {
+  return args.map((name) => getterBindingCall(bindingObject, [name])).toList(growable: false);
+}
+
 dynamic setterBindingCall(BindingObject bindingObject, List<dynamic> args) {
   assert(args.length == 2);
   if (isEnabledLog) {
-    print('$bindingObject setBindingProperty key: ${args[0]} value: ${args[1]}');
+    print('$bindingObject setBindingProperty key: ${bindingCallMethodName(args[0])} value: ${args[1]}');
   }
 
-  String key = args[0];
+  String key = bindingCallMethodName(args[0]);
   dynamic value = args[1];
   BindingObjectProperty? property = bindingObject._properties[key];
   if (property != null && property.setter != null) {
@@ -273,6 +303,42 @@ dynamic invokeBindingMethodAsync(BindingObject bindingObject, List<dynamic> args
   return bindingObject._invokeBindingMethodAsync(args[0], args.slice(1));
 }
 
+// The async methods called in one JS task, each call is a list of the binding object, the method name and the
+// arguments. The results are returned with one callback once all the calls settled, each result is a list of the
+// value and the error message.
+dynamic invokeBindingMethodsAsyncBatch(BindingObject bindingObject, List<dynamic> args) {
+  int contextId = args[0];
+  Pointer<Void> callbackContext = (args[1] as Pointer).cast<Void>();
+  DartAsyncAnonymousFunctionCallback callback =
+      (args[2] as Pointer).cast<NativeFunction<NativeAsyncAnonymousFunctionCallback>>().asFunction();
+  List<dynamic> calls = args[3];
+
+  Stopwatch? stopwatch;
+  if (isEnabledLog) {
+    stopwatch = Stopwatch()..start();
+  }
+
+  Iterable<Future<List<dynamic>>> results = calls.map((call) {
+    BindingObject? target = call[0];
+    String method = call[1];
+    BindingObjectMethod? fn = target?._methods[method];
+    if (fn is! AsyncBindingObjectMethod) {
+      return Future.value([null, 'Failed to call async method $method: not found.']);
+    }
+    return fn.call(call.sublist(2)).then((result) => [result, null], onError: (e, stack) => [null, '$e\n$stack']);
+  });
+
+  Future.wait(results).then((values) {
+    Pointer<NativeValue> nativeValue = malloc.allocate(sizeOf<NativeValue>());
+    toNativeValue(nativeValue, values);
+    callback(callbackContext, nativeValue, contextId, nullptr);
+    if (isEnabledLog) {
+      print('$bindingObject invokeBindingMethodsAsyncBatch calls: ${calls.length} time: ${stopwatch!.elapsedMicroseconds}us');
+    }
+  });
+  return null;
+}
+
 // This function receive calling from binding side.
 void invokeBindingMethodFromNativeImpl(Pointer<NativeBindingObject> nativeBindingObject,
     Pointer<NativeValue> returnValue, Pointer<NativeValue> nativeMethod, int argc, Pointer<NativeValue> argv) {
@@ -286,7 +352,7 @@ void invokeBindingMethodFromNativeImpl(Pointer<NativeBindingObject> nativeBindin
   var result = null;
   try {
     // Method is binding call method operations from internal.
-    if (method is int) {
+    if (method is int && method < bindingCallMethodIdOffset) {
       // Get and setter ops
       result = bindingCallMethodDispatchTable[method](bindingObject, values);
     } else {
@@ -296,7 +362,7 @@ void invokeBindingMethodFromNativeImpl(Pointer<NativeBindingObject> nativeBindin
       if (isEnabledLog) {
         stopwatch = Stopwatch()..start();
       }
-      result = bindingObject._invokeBindingMethodSync(method, values);
+      result = bindingObject._invokeBindingMethodSync(bindingCallMethodName(method), values);
       if (isEnabledLog) {
         print('$bindingObject invokeBindingMethod method: $method args: $values result: $result time: ${stopwatch!.elapsedMicroseconds}us');
       }
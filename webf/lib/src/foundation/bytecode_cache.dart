@@ -154,6 +154,10 @@ class QuickJSByteCodeCache {
     }
 
     await cacheObject.read();
+    // Keep a cache read from disk, so the script is not read again when evaluated.
+    if (cacheObject.valid) {
+      _caches[hash] = cacheObject;
+    }
 
     return cacheObject;
   }
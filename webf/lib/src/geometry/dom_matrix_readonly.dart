@@ -1,17 +0,0 @@
-/*
- * Copyright (C) 2022-present The WebF authors. All rights reserved.
- */
-
-import 'package:webf/foundation.dart';
-
-class DOMMatrixReadonly extends BindingObject {
-  DOMMatrixReadonly(BindingContext context, List<dynamic> domMatrixInit): super(context);
-
-  @override
-  void initializeMethods(Map<String, BindingObjectMethod> methods) {
-  }
-
-  @override
-  void initializeProperties(Map<String, BindingObjectProperty> properties) {
-  }
-}
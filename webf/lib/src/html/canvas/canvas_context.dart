@@ -10,6 +10,7 @@ import 'dart:ffi' as ffi;
 
 import 'package:flutter/painting.dart';
 import 'package:meta/meta.dart';
+import 'package:vector_math/vector_math_64.dart' show Matrix4;
 import 'package:webf/webf.dart';
 import 'package:webf/css.dart';
 
@@ -183,18 +184,19 @@ class CanvasPattern extends BindingObject {
   @override
   get pointer => _pointer;
 
-  // opaque object
-  void setTransform(DOMMatrix domMatrix) {
-    print('setTransform: $domMatrix');
+  Matrix4 _transform = Matrix4.identity();
+  Matrix4 get transform => _transform;
+
+  // The DOMMatrix is kept at native side, only its 16 values in column-major order are sent here.
+  void setTransform(List<double> values) {
+    _transform = Matrix4.fromList(values);
   }
 
   @override
   void initializeMethods(Map<String, BindingObjectMethod> methods) {
     methods['setTransform'] = BindingObjectMethodSync(call: (args) {
-      BindingObject domMatrix = args[0];
-      if (domMatrix is DOMMatrix) {
-        return setTransform(domMatrix);
-      }
+      List values = args[0];
+      return setTransform(values.map((value) => (value as num).toDouble()).toList());
     });
   }
 
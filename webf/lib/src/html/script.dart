@@ -38,11 +38,25 @@ class ScriptRunner {
   // Indicate the sync pending scripts.
   int _resolvingCount = 0;
 
-  static Future<void> _evaluateScriptBundle(int contextId, WebFBundle bundle, {bool async = false}) async {
+  // The scripts compiled ahead of their execution, freed by dispose() if their tasks never run.
+  final Set<CompiledScript> _pendingCompiledScripts = {};
+  bool _disposed = false;
+
+  void dispose() {
+    _disposed = true;
+    for (CompiledScript compiledScript in _pendingCompiledScripts) {
+      compiledScript.dispose();
+    }
+    _pendingCompiledScripts.clear();
+    _syncScriptTasks.clear();
+  }
+
+  static Future<void> _evaluateScriptBundle(int contextId, WebFBundle bundle,
+      {bool async = false, String? code, CompiledScript? compiledScript}) async {
     // Evaluate bundle.
     if (bundle.isJavascript) {
-      final String contentInString = await resolveStringFromData(bundle.data!, preferSync: !async);
-      bool result = await evaluateScripts(contextId, contentInString, url: bundle.url);
+      final String contentInString = code ?? await resolveStringFromData(bundle.data!, preferSync: !async);
+      bool result = await evaluateScripts(contextId, contentInString, url: bundle.url, compiledScript: compiledScript);
       if (!result) {
         throw FlutterError('Script code are not valid to evaluate.');
       }
@@ -84,13 +98,19 @@ class ScriptRunner {
     }
 
     element.readyState = ScriptReadyState.interactive;
+    // The code of a javascript bundle, compiled in background once resolved.
+    String? code;
+    CompiledScript? compiledScript;
     // The bundle execution task.
     Future<void> task(bool async) async {
       // If bundle is not resolved, should wait for it resolve to prevent the next script running.
       assert(bundle.isResolved, '${bundle.url} is not resolved');
+      // A script freed by dispose() is evaluated from the code.
+      CompiledScript? pendingScript =
+          compiledScript != null && _pendingCompiledScripts.remove(compiledScript) ? compiledScript : null;
 
       try {
-        await _evaluateScriptBundle(_contextId, bundle, async: async);
+        await _evaluateScriptBundle(_contextId, bundle, async: async, code: code, compiledScript: pendingScript);
       } catch (err, stack) {
         debugPrint('$err\n$stack');
         _document.decrementDOMContentLoadedEventDelayCount();
@@ -126,6 +146,17 @@ class ScriptRunner {
       if (!bundle.isResolved) {
         throw FlutterError('Network error.');
       }
+
+      // Start parsing while the scripts before it are still loading or running.
+      if (bundle.isJavascript) {
+        code = await resolveStringFromData(bundle.data!, preferSync: !shouldAsync);
+        compiledScript = await compileScriptUnlessCached(code!, url: bundle.url);
+        if (_disposed) {
+          compiledScript?.dispose();
+        } else if (compiledScript != null) {
+          _pendingCompiledScripts.add(compiledScript!);
+        }
+      }
     } catch (e, st) {
       // A load error occurred.
       debugPrint('Failed to load: $url, reason: $e\n$st');
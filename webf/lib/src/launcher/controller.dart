@@ -132,6 +132,7 @@ class WebFViewController implements WidgetsBindingObserver {
   set viewportWidth(double value) {
     if (value != _viewportWidth) {
       _viewportWidth = value;
+      invalidateLayoutMetrics(_contextId);
       viewport.viewportSize = ui.Size(_viewportWidth, _viewportHeight);
     }
   }
@@ -141,6 +142,7 @@ class WebFViewController implements WidgetsBindingObserver {
   set viewportHeight(double value) {
     if (value != _viewportHeight) {
       _viewportHeight = value;
+      invalidateLayoutMetrics(_contextId);
       viewport.viewportSize = ui.Size(_viewportWidth, _viewportHeight);
     }
   }
@@ -186,10 +188,23 @@ class WebFViewController implements WidgetsBindingObserver {
 
   void _postFrameCallback(Duration timeStamp) {
     if (disposed) return;
+    if (_layoutMetricsElements.isNotEmpty) {
+      // Elements out of the tree are dropped, native side reads their geometry again when JS asks for it.
+      _layoutMetricsElements.removeWhere((element) => element.disposed || !element.isConnected);
+      // The elements had been laid out, refresh their geometry before applying the commands which may change it.
+      // One flush covers the layout dirtied by the other post frame callbacks.
+      viewport.owner?.flushLayout();
+      updateLayoutMetrics(_contextId, _layoutMetricsElements);
+    }
     flushUICommand(this);
     SchedulerBinding.instance.addPostFrameCallback(_postFrameCallback);
   }
 
+  // Elements whose geometry is cached at native side, see Element.getLayoutMetrics.
+  final Set<Element> _layoutMetricsElements = {};
+  void watchLayoutMetrics(Element element) => _layoutMetricsElements.add(element);
+  void unwatchLayoutMetrics(Element element) => _layoutMetricsElements.remove(element);
+
   // Index value which identify javascript runtime context.
   late int _contextId;
   int get contextId => _contextId;
@@ -376,11 +391,11 @@ class WebFViewController implements WidgetsBindingObserver {
     document.createDocumentFragment(BindingContext(_contextId, nativePtr));
   }
 
-  void addEvent(Pointer<NativeBindingObject> nativePtr, String eventType, {Pointer<AddEventListenerOptions>? addEventListenerOptions}) {
+  void addEvent(Pointer<NativeBindingObject> nativePtr, String eventType, {EventListenerOptions? eventListenerOptions}) {
     if (!BindingBridge.hasBindingObject(nativePtr)) return;
     EventTarget? target = BindingBridge.getBindingObject<EventTarget>(nativePtr);
     if (target != null) {
-      BindingBridge.listenEvent(target, eventType, addEventListenerOptions: addEventListenerOptions);
+      BindingBridge.listenEvent(target, eventType, eventListenerOptions: eventListenerOptions);
     }
   }
 
@@ -770,6 +785,10 @@ class WebFController {
 
   final ui.FlutterView ownerFlutterView;
 
+  // Controllers with the same group run their JavaScript on the same native thread when [javaScriptThreadCount] is
+  // larger than 1, other controllers are put on the least loaded thread.
+  final int? jsThreadGroup;
+
   String? _name;
   String? get name => _name;
   set name(String? value) {
@@ -809,6 +828,7 @@ class WebFController {
     this.devToolsService,
     this.uriParser,
     this.initialCookies,
+    this.jsThreadGroup,
     required this.ownerFlutterView,
   })  : _name = name,
         _entrypoint = entrypoint,
@@ -898,7 +918,7 @@ class WebFController {
       // RenderViewportBox will not disposed when reload, just remove all children and clean all resources.
       _view.viewport.reload();
 
-      allocateNewPage(_view.contextId);
+      allocateNewPage(_view.contextId, jsThreadGroup);
 
       _view = WebFViewController(view.viewportWidth, view.viewportHeight,
           background: _view.background,
@@ -89,6 +89,7 @@ class WebF extends StatefulWidget {
       throw ArgumentError('The element name "$tagName" is not valid.');
     }
     defineElement(tagName.toUpperCase(), creator);
+    registerWidgetElementShape(tagName.toUpperCase(), creator);
   }
 
   Future<void> load(WebFBundle bundle) async {
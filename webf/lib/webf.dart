@@ -12,4 +12,3 @@ export 'module.dart';
 export 'widget.dart';
 export 'dom.dart' hide Element;
 export 'html.dart';
-export 'geometry.dart';